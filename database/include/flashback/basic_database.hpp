@@ -1,14 +1,35 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <vector>
 #include <map>
 #include <string>
 #include <string_view>
+#include <stop_token>
+#include <google/protobuf/repeated_ptr_field.h>
 #include <types.pb.h>
 
 namespace flashback
 {
+// a study or practice event waiting to be written, practice events also carry the milestone they were made in
+struct progress_event
+{
+    enum class kind: uint8_t { study, practice };
+
+    kind type;
+    uint64_t user_id;
+    uint64_t card_id;
+    uint64_t milestone_id;
+    expertise_level milestone_level;
+    uint64_t duration;
+    // seconds since the epoch when the card was studied, zero when it happened just now,
+    // kept for ordering and the journal since the procedures stamp progress with the time it reaches the database
+    uint64_t timestamp;
+
+    bool operator==(progress_event const&) const = default;
+};
+
 class basic_database
 {
 public:
@@ -40,16 +61,19 @@ public:
     [[nodiscard]] virtual std::vector<Roadmap> get_roadmaps(uint64_t user_id) const = 0;
     virtual void rename_roadmap(uint64_t roadmap_id, std::string_view modified_name) const = 0;
     virtual void remove_roadmap(uint64_t roadmap_id) const = 0;
-    [[nodiscard]] virtual std::map<uint64_t, Roadmap> search_roadmaps(std::uint64_t user_id, std::string_view search_pattern) const = 0;
+    [[nodiscard]] virtual std::vector<Roadmap> search_roadmaps(std::uint64_t user_id, std::string_view search_pattern, uint64_t limit, uint64_t offset) const = 0;
     [[nodiscard]] virtual Roadmap clone_roadmap(uint64_t user_id, uint64_t roadmap_id) const = 0;
 
     // milestones
     [[nodiscard]] virtual Milestone add_milestone(uint64_t subject_id, expertise_level subject_level, uint64_t roadmap_id) const = 0;
     [[nodiscard]] virtual Milestone add_milestone(uint64_t subject_id, expertise_level subject_level, uint64_t roadmap_id, uint64_t position) const = 0;
     [[nodiscard]] virtual std::vector<Milestone> get_milestones(uint64_t roadmap_id) const = 0;
+    virtual void get_milestones(uint64_t roadmap_id, uint64_t after, uint64_t limit, google::protobuf::RepeatedPtrField<Milestone>& milestones) const = 0;
     virtual void add_requirement(uint64_t roadmap_id, Milestone milestone, Milestone required_milestone) const = 0;
     [[nodiscard]] virtual std::vector<Milestone> get_requirements(uint64_t roadmap_id, uint64_t subject_id, expertise_level subject_level) const = 0;
+    [[nodiscard]] virtual std::vector<Requirement> get_roadmap_requirements(uint64_t roadmap_id) const = 0;
     virtual void reorder_milestone(uint64_t roadmap_id, uint64_t current_position, uint64_t target_position) const = 0;
+    virtual void apply_milestone_ordering(uint64_t roadmap_id, std::vector<uint64_t> const& order) const = 0;
     virtual void remove_milestone(uint64_t roadmap_id, uint64_t subject_id) const = 0;
     virtual void change_milestone_level(uint64_t roadmap_id, uint64_t subject_id, expertise_level level) const = 0;
 
@@ -58,19 +82,22 @@ public:
     virtual void rename_subject(uint64_t subject_id, std::string name) const = 0;
     virtual void remove_subject(uint64_t subject_id) const = 0;
     virtual void merge_subjects(uint64_t source, uint64_t target) const = 0;
-    [[nodiscard]] virtual std::map<uint64_t, Subject> search_subjects(std::string_view search_pattern) const = 0;
+    [[nodiscard]] virtual std::vector<Subject> search_subjects(std::string_view search_pattern, uint64_t limit, uint64_t offset) const = 0;
+    [[nodiscard]] virtual std::vector<Subject> get_subjects() const = 0;
     //add_alias
     //remove_alias
 
-    // topics
+    // topics, positions are numbered within a subject and level and every call below covers exactly the topics of the given level
     [[nodiscard]] virtual Topic create_topic(uint64_t subject_id, std::string name, expertise_level level, uint64_t position) const = 0;
     [[nodiscard]] virtual std::map<uint64_t, Topic> get_topics(uint64_t subject_id, expertise_level level) const = 0;
+    virtual void get_topics(uint64_t subject_id, expertise_level level, uint64_t after, uint64_t limit, google::protobuf::RepeatedPtrField<Topic>& topics) const = 0;
     virtual void reorder_topic(uint64_t subject_id, expertise_level level, uint64_t source_position, uint64_t target_position) const = 0;
+    virtual void apply_topic_ordering(uint64_t subject_id, expertise_level level, std::vector<uint64_t> const& order) const = 0;
     virtual void remove_topic(uint64_t subject_id, expertise_level level, uint64_t position) const = 0;
     virtual void merge_topics(uint64_t subject_id, expertise_level level, uint64_t source_position, uint64_t target_position) const = 0;
     virtual void rename_topic(uint64_t subject_id, expertise_level level, uint64_t position, std::string name) const = 0;
     virtual void move_topic(uint64_t subject_id, expertise_level level, uint64_t position, uint64_t target_subject_id, expertise_level target_level, uint64_t target_position) const = 0;
-    [[nodiscard]] virtual std::map<uint64_t, Topic> search_topics(uint64_t subject_id, expertise_level level, std::string_view search_pattern) const = 0;
+    [[nodiscard]] virtual std::vector<Topic> search_topics(uint64_t subject_id, expertise_level level, std::string_view search_pattern, uint64_t limit, uint64_t offset) const = 0;
     virtual void change_topic_level(uint64_t subject_id, uint64_t position, expertise_level level, expertise_level target) const = 0;
     [[nodiscard]] virtual Topic get_topic(uint64_t subject_id, expertise_level level, uint64_t position) const = 0;
 
@@ -78,8 +105,9 @@ public:
     [[nodiscard]] virtual Resource create_resource(Resource const& resource) const = 0;
     virtual void add_resource_to_subject(uint64_t resource_id, uint64_t subject_id) const = 0;
     [[nodiscard]] virtual std::vector<Resource> get_resources(uint64_t user_id, uint64_t subject_id) const = 0;
+    [[nodiscard]] virtual std::vector<Resource> get_resources() const = 0;
     virtual void drop_resource_from_subject(uint64_t resource_id, uint64_t subject_id) const = 0;
-    [[nodiscard]] virtual std::map<uint64_t, Resource> search_resources(std::string_view search_pattern) const = 0;
+    [[nodiscard]] virtual std::vector<Resource> search_resources(std::string_view search_pattern, uint64_t limit, uint64_t offset) const = 0;
     virtual void edit_resource_link(uint64_t resource_id, std::string link) const = 0;
     virtual void change_resource_type(uint64_t resource_id, Resource::resource_type type) const = 0;
     virtual void change_section_pattern(uint64_t resource_id, Resource::section_pattern pattern) const = 0;
@@ -93,8 +121,10 @@ public:
     [[nodiscard]] virtual Provider create_provider(std::string name) const = 0;
     virtual void add_provider(uint64_t resource_id, uint64_t provider_id) const = 0;
     virtual void drop_provider(uint64_t resource_id, uint64_t provider_id) const = 0;
-    [[nodiscard]] virtual std::map<uint64_t, Provider> search_providers(std::string_view search_pattern) const = 0;
+    [[nodiscard]] virtual std::vector<Provider> search_providers(std::string_view search_pattern, uint64_t limit, uint64_t offset) const = 0;
     [[nodiscard]] virtual std::vector<Provider> get_providers(std::uint64_t resource_id) const = 0;
+    [[nodiscard]] virtual std::vector<Provider> get_providers() const = 0;
+    virtual void get_providers(std::uint64_t resource_id, google::protobuf::RepeatedPtrField<Provider>& providers) const = 0;
     virtual void rename_provider(uint64_t provider_id, std::string name) const = 0;
     virtual void remove_provider(uint64_t provider_id) const = 0;
     virtual void merge_providers(uint64_t source_id, uint64_t target_id) const =0;
@@ -103,8 +133,10 @@ public:
     [[nodiscard]] virtual Presenter create_presenter(std::string name) const = 0;
     virtual void add_presenter(uint64_t resource_id, uint64_t presenter_id) const = 0;
     virtual void drop_presenter(uint64_t resource_id, uint64_t presenter_id) const = 0;
-    [[nodiscard]] virtual std::map<uint64_t, Presenter> search_presenters(std::string_view search_pattern) const = 0;
+    [[nodiscard]] virtual std::vector<Presenter> search_presenters(std::string_view search_pattern, uint64_t limit, uint64_t offset) const = 0;
     [[nodiscard]] virtual std::vector<Presenter> get_presenters(std::uint64_t resource_id) const = 0;
+    [[nodiscard]] virtual std::vector<Presenter> get_presenters() const = 0;
+    virtual void get_presenters(std::uint64_t resource_id, google::protobuf::RepeatedPtrField<Presenter>& presenters) const = 0;
     virtual void rename_presenter(uint64_t presenter_id, std::string name) const = 0;
     virtual void remove_presenter(uint64_t presenter_id) const = 0;
     virtual void merge_presenters(uint64_t source_id, uint64_t target_id) const = 0;
@@ -112,12 +144,15 @@ public:
     // sections
     [[nodiscard]] virtual Section create_section(uint64_t resource_id, uint64_t position, std::string name, std::string link) const = 0;
     [[nodiscard]] virtual std::map<uint64_t, Section> get_sections(uint64_t resource_id) const = 0;
+    virtual void get_sections(uint64_t resource_id, google::protobuf::RepeatedPtrField<Section>& sections) const = 0;
+    virtual void get_sections(uint64_t resource_id, uint64_t after, uint64_t limit, google::protobuf::RepeatedPtrField<Section>& sections) const = 0;
     virtual void remove_section(uint64_t resource_id, uint64_t position) const = 0;
     virtual void reorder_section(uint64_t resource_id, uint64_t current_position, uint64_t target_position) const = 0;
+    virtual void apply_section_ordering(uint64_t resource_id, std::vector<uint64_t> const& order) const = 0;
     virtual void merge_sections(uint64_t resource_id, uint64_t source_position, uint64_t target_position) const = 0;
     virtual void rename_section(uint64_t resource_id, uint64_t position, std::string name) const = 0;
     virtual void move_section(uint64_t resource_id, uint64_t position, uint64_t target_resource_id, uint64_t target_position) const = 0;
-    [[nodiscard]] virtual std::map<uint64_t, Section> search_sections(uint64_t resource_id, std::string_view search_pattern) const = 0;
+    [[nodiscard]] virtual std::vector<Section> search_sections(uint64_t resource_id, std::string_view search_pattern, uint64_t limit, uint64_t offset) const = 0;
     virtual void edit_section_link(uint64_t resource_id, uint64_t position, std::string link) const = 0;
     [[nodiscard]] virtual Section get_section(uint64_t resource_id, uint64_t position) const = 0;
     //remove_section_with_cards
@@ -129,26 +164,37 @@ public:
     virtual void edit_card_headline(uint64_t card_id, std::string headline) const = 0;
     virtual void remove_card(uint64_t card_id) const = 0;
     virtual void merge_cards(uint64_t source_id, uint64_t target_id, std::string headline) const = 0;
-    [[nodiscard]] virtual std::map<uint64_t, Card> search_cards(uint64_t subject_id, expertise_level level, std::string_view search_pattern) const = 0;
+    // a stop requested while the search runs cancels it on the database server and yields no cards
+    [[nodiscard]] virtual std::vector<Card> search_cards(uint64_t subject_id, expertise_level level, std::string_view search_pattern, uint64_t limit, uint64_t offset,
+                                                         std::stop_token stop) const = 0;
     virtual void move_card_to_section(uint64_t card_id, uint64_t resource_id, uint64_t section_position, uint64_t target_resource_id, uint64_t target_section_position) const = 0;
     virtual void move_card_to_topic(uint64_t card_id, uint64_t subject_id, uint64_t topic_position, expertise_level topic_level, uint64_t target_subject, uint64_t target_position,
                                     expertise_level targe_level) const = 0;
     [[nodiscard]] virtual std::vector<SectionCard> get_section_cards(uint64_t resource_id, uint64_t sections_position) const = 0;
+    virtual void get_section_cards(uint64_t resource_id, uint64_t sections_position, uint64_t after, uint64_t limit, google::protobuf::RepeatedPtrField<SectionCard>& cards) const = 0;
     [[nodiscard]] virtual std::vector<Card> get_topic_cards(uint64_t subject_id, uint64_t topic_position, expertise_level topic_level) const = 0;
+    virtual void get_topic_cards(uint64_t subject_id, uint64_t topic_position, expertise_level topic_level, google::protobuf::RepeatedPtrField<Card>& cards) const = 0;
+    virtual void get_topic_cards(uint64_t subject_id, uint64_t topic_position, expertise_level topic_level, uint64_t after, uint64_t limit,
+                                 google::protobuf::RepeatedPtrField<Card>& cards) const = 0;
     [[nodiscard]] virtual Card get_card(uint64_t card_id) const = 0;
 
     // blocks
     [[nodiscard]] virtual Block create_block(uint64_t card_id, Block block) const = 0;
     [[nodiscard]] virtual std::map<uint64_t, Block> get_blocks(uint64_t card_id) const = 0;
+    virtual void get_blocks(uint64_t card_id, google::protobuf::RepeatedPtrField<Block>& blocks) const = 0;
+    virtual void get_blocks(std::vector<Card*> const& cards) const = 0;
     virtual void remove_block(uint64_t card_id, uint64_t block_position) const = 0;
     virtual void edit_block_content(uint64_t card_id, uint64_t block_position, std::string content) const = 0;
     virtual void change_block_type(uint64_t card_id, uint64_t block_position, Block::content_type type) const = 0;
     virtual void edit_block_extension(uint64_t card_id, uint64_t block_position, std::string extension) const = 0;
     virtual void edit_block_metadata(uint64_t card_id, uint64_t block_position, std::string metadata) const = 0;
     virtual void reorder_block(uint64_t card_id, uint64_t block_position, uint64_t target_position) const = 0;
+    virtual void apply_block_ordering(uint64_t card_id, std::vector<uint64_t> const& order) const = 0;
     virtual void merge_blocks(uint64_t card_id, uint64_t source_position, uint64_t target_position) const = 0;
     [[nodiscard]] virtual std::map<uint64_t, Block> split_block(uint64_t card_id, uint64_t block_position) const = 0;
+    virtual void apply_card_edits(uint64_t card_id, google::protobuf::RepeatedPtrField<CardEdit> const& edits, google::protobuf::RepeatedPtrField<Block>& blocks) const = 0;
     virtual void move_block(uint64_t card_id, uint64_t block_position, uint64_t target_card_id, uint64_t target_position) const = 0;
+    [[nodiscard]] virtual std::vector<BlockSearchResult> search_blocks(uint64_t user_id, std::string_view search_pattern, uint64_t limit, uint64_t offset) const = 0;
     [[nodiscard]] virtual Block get_block(uint64_t card_id, uint64_t position) const = 0;
 
     // progress
@@ -158,11 +204,18 @@ public:
     [[nodiscard]] virtual std::vector<Topic> get_practice_topics(uint64_t user_id, uint64_t roadmap_id, uint64_t milestone_id, expertise_level milestone_level) const = 0;
     [[nodiscard]] virtual std::vector<Card> get_practice_cards(uint64_t user_id, uint64_t roadmap_id, uint64_t subject_id, expertise_level level, uint64_t topic_position) const =
     0;
+    virtual void get_practice_cards(uint64_t user_id, uint64_t roadmap_id, uint64_t subject_id, expertise_level level, uint64_t topic_position,
+                                    google::protobuf::RepeatedPtrField<Card>& cards) const = 0;
     virtual void mark_section_as_reviewed(uint64_t resource_id, uint64_t section_position) const = 0;
     virtual void mark_section_as_completed(uint64_t resource_id, uint64_t section_position) const = 0;
     [[nodiscard]] virtual closure_state get_resource_state(uint64_t resource_id) const = 0;
     virtual void study(uint64_t user_id, uint64_t card_id, std::chrono::seconds duration) const = 0;
+    virtual void record_progress(std::vector<progress_event> const& events) const = 0;
     [[nodiscard]] virtual std::vector<Resource> get_study_resources(uint64_t user_id) const = 0;
+    // study resources and nerves are listed with their providers, presenters and related milestones
+    virtual void get_study_resources(uint64_t user_id, google::protobuf::RepeatedPtrField<StudyResource>& resources) const = 0;
+    virtual void get_home_bundle(uint64_t user_id, google::protobuf::RepeatedPtrField<Roadmap>& roadmaps, google::protobuf::RepeatedPtrField<StudyResource>& studies,
+                                 google::protobuf::RepeatedPtrField<Nerve>& nerves) const = 0;
     virtual void mark_card_as_reviewed(uint64_t card_id) const = 0;
     virtual void mark_card_as_completed(uint64_t card_id) const = 0;
     virtual void mark_card_as_approved(uint64_t card_id) const = 0;
@@ -177,15 +230,25 @@ public:
     virtual void diminish_assessment(uint64_t assessment_id, uint64_t subject_id, expertise_level level, uint64_t topic_position) const = 0;
     [[nodiscard]] virtual std::vector<Topic> get_topic_coverage(uint64_t subject_id, uint64_t assessment_id) const = 0;
     [[nodiscard]] virtual std::vector<Coverage> get_assessment_coverage(uint64_t subject_id, uint64_t topic_position, expertise_level max_level) const = 0;
+    [[nodiscard]] virtual std::vector<TopicCoverage> get_subject_coverage(uint64_t subject_id) const = 0;
     [[nodiscard]] virtual std::map<uint64_t, Assimilation> get_assimilation_coverage(uint64_t user_id, uint64_t subject_id, uint64_t assessment_id) const = 0;
     [[nodiscard]] virtual std::vector<Card> get_topic_assessments(uint64_t user_id, uint64_t subject_id, uint64_t topic_position, expertise_level max_level) const = 0;
     [[nodiscard]] virtual std::vector<Assessment> get_assessments(uint64_t user_id, uint64_t subject_id, expertise_level topic_level, uint64_t topic_position) const = 0;
+    virtual void get_assessments(uint64_t user_id, uint64_t subject_id, expertise_level topic_level, uint64_t topic_position, uint64_t after, uint64_t limit,
+                                 google::protobuf::RepeatedPtrField<Assessment>& assessments) const = 0;
     [[nodiscard]] virtual bool is_assimilated(uint64_t user_id, uint64_t subject_id, expertise_level topic_level, uint64_t topic_position) const = 0;
     [[nodiscard]] virtual std::vector<Card> get_subject_assessments(uint64_t subject_id, expertise_level max_level) const = 0;
+    virtual void get_subject_assessments(uint64_t subject_id, expertise_level max_level, uint64_t after, uint64_t limit, google::protobuf::RepeatedPtrField<Card>& cards) const = 0;
 
     // nerves
     [[nodiscard]] virtual Resource create_nerve(uint64_t user_id, std::string resource_name, uint64_t subject_id) const = 0;
     [[nodiscard]] virtual std::vector<Resource> get_nerves(uint64_t user_id) const = 0;
+    virtual void get_nerves(uint64_t user_id, google::protobuf::RepeatedPtrField<Nerve>& nerves) const = 0;
+
+    // exports, rows are handed over as they arrive and a consumer returning false stops the export
+    virtual void export_subject_cards(uint64_t subject_id, std::function<bool(Topic const&, Card const&)> const& consume) const = 0;
+    virtual void export_resource_blocks(uint64_t resource_id, std::function<bool(Card const&, Block const&)> const& consume) const = 0;
+    virtual void export_subject_assessments(uint64_t subject_id, expertise_level max_level, std::function<bool(Card const&)> const& consume) const = 0;
 
     // anomaly detection
     //get_duplicate_cards
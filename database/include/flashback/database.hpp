@@ -1,5 +1,9 @@
 #pragma once
 
+#include <array>
+#include <format>
+#include <optional>
+#include <tuple>
 #include <pqxx/pqxx>
 #include <server.grpc.pb.h>
 #include <flashback/basic_database.hpp>
@@ -41,11 +45,12 @@ public:
     [[nodiscard]] std::vector<Roadmap> get_roadmaps(uint64_t user_id) const override;
     void rename_roadmap(uint64_t roadmap_id, std::string_view modified_name) const override;
     void remove_roadmap(uint64_t roadmap_id) const override;
-    [[nodiscard]] std::map<uint64_t, Roadmap> search_roadmaps(std::uint64_t user_id, std::string_view search_pattern) const override;
+    [[nodiscard]] std::vector<Roadmap> search_roadmaps(std::uint64_t user_id, std::string_view search_pattern, uint64_t limit, uint64_t offset) const override;
 
     // subjects
     [[nodiscard]] Subject create_subject(std::string name) const override;
-    [[nodiscard]] std::map<uint64_t, Subject> search_subjects(std::string_view search_pattern) const override;
+    [[nodiscard]] std::vector<Subject> search_subjects(std::string_view search_pattern, uint64_t limit, uint64_t offset) const override;
+    [[nodiscard]] std::vector<Subject> get_subjects() const override;
     void rename_subject(uint64_t subject_id, std::string name) const override;
     void remove_subject(uint64_t subject_id) const override;
     void merge_subjects(uint64_t source, uint64_t target) const override;
@@ -54,10 +59,13 @@ public:
     [[nodiscard]] Milestone add_milestone(uint64_t subject_id, expertise_level subject_level, uint64_t roadmap_id) const override;
     [[nodiscard]] Milestone add_milestone(uint64_t subject_id, expertise_level subject_level, uint64_t roadmap_id, uint64_t position) const override;
     [[nodiscard]] std::vector<Milestone> get_milestones(uint64_t roadmap_id) const override;
+    void get_milestones(uint64_t roadmap_id, uint64_t after, uint64_t limit, google::protobuf::RepeatedPtrField<Milestone>& milestones) const override;
     void add_requirement(uint64_t roadmap_id, Milestone milestone, Milestone required_milestone) const override;
     [[nodiscard]] std::vector<Milestone> get_requirements(uint64_t roadmap_id, uint64_t subject_id, expertise_level subject_level) const override;
+    [[nodiscard]] std::vector<Requirement> get_roadmap_requirements(uint64_t roadmap_id) const override;
     [[nodiscard]] Roadmap clone_roadmap(uint64_t user_id, uint64_t roadmap_id) const override;
     void reorder_milestone(uint64_t roadmap_id, uint64_t current_position, uint64_t target_position) const override;
+    void apply_milestone_ordering(uint64_t roadmap_id, std::vector<uint64_t> const& order) const override;
     void remove_milestone(uint64_t roadmap_id, uint64_t subject_id) const override;
     void change_milestone_level(uint64_t roadmap_id, uint64_t subject_id, expertise_level level) const override;
 
@@ -65,9 +73,10 @@ public:
     [[nodiscard]] Resource create_resource(Resource const& resource) const override;
     void add_resource_to_subject(uint64_t resource_id, uint64_t subject_id) const override;
     [[nodiscard]] std::vector<Resource> get_resources(uint64_t user_id, uint64_t subject_id) const override;
+    [[nodiscard]] std::vector<Resource> get_resources() const override;
     [[nodiscard]] Resource get_resource(uint64_t resource_id) const override;
     void drop_resource_from_subject(uint64_t resource_id, uint64_t subject_id) const override;
-    [[nodiscard]] std::map<uint64_t, Resource> search_resources(std::string_view search_pattern) const override;
+    [[nodiscard]] std::vector<Resource> search_resources(std::string_view search_pattern, uint64_t limit, uint64_t offset) const override;
     void edit_resource_link(uint64_t resource_id, std::string link) const override;
     void change_resource_type(uint64_t resource_id, Resource::resource_type type) const override;
     void change_section_pattern(uint64_t resource_id, Resource::section_pattern pattern) const override;
@@ -79,31 +88,38 @@ public:
     // sections
     [[nodiscard]] Section create_section(uint64_t resource_id, uint64_t position, std::string name, std::string link) const override;
     [[nodiscard]] std::map<uint64_t, Section> get_sections(uint64_t resource_id) const override;
+    void get_sections(uint64_t resource_id, google::protobuf::RepeatedPtrField<Section>& sections) const override;
+    void get_sections(uint64_t resource_id, uint64_t after, uint64_t limit, google::protobuf::RepeatedPtrField<Section>& sections) const override;
     void remove_section(uint64_t resource_id, uint64_t position) const override;
     void reorder_section(uint64_t resource_id, uint64_t current_position, uint64_t target_position) const override;
+    void apply_section_ordering(uint64_t resource_id, std::vector<uint64_t> const& order) const override;
     void merge_sections(uint64_t resource_id, uint64_t source_position, uint64_t target_position) const override;
     void rename_section(uint64_t resource_id, uint64_t position, std::string name) const override;
     void move_section(uint64_t resource_id, uint64_t position, uint64_t target_resource_id, uint64_t target_position) const override;
-    [[nodiscard]] std::map<uint64_t, Section> search_sections(uint64_t resource_id, std::string_view search_pattern) const override;
+    [[nodiscard]] std::vector<Section> search_sections(uint64_t resource_id, std::string_view search_pattern, uint64_t limit, uint64_t offset) const override;
     void edit_section_link(uint64_t resource_id, uint64_t position, std::string link) const override;
 
     // topics
     [[nodiscard]] Topic create_topic(uint64_t subject_id, std::string name, expertise_level level, uint64_t position) const override;
     [[nodiscard]] std::map<uint64_t, Topic> get_topics(uint64_t subject_id, expertise_level level) const override;
+    void get_topics(uint64_t subject_id, expertise_level level, uint64_t after, uint64_t limit, google::protobuf::RepeatedPtrField<Topic>& topics) const override;
     void reorder_topic(uint64_t subject_id, expertise_level level, uint64_t source_position, uint64_t target_position) const override;
+    void apply_topic_ordering(uint64_t subject_id, expertise_level level, std::vector<uint64_t> const& order) const override;
     void remove_topic(uint64_t subject_id, expertise_level level, uint64_t position) const override;
     void merge_topics(uint64_t subject_id, expertise_level level, uint64_t source_position, uint64_t target_position) const override;
     void rename_topic(uint64_t subject_id, expertise_level level, uint64_t position, std::string name) const override;
     void move_topic(uint64_t subject_id, expertise_level level, uint64_t position, uint64_t target_subject_id, expertise_level target_level, uint64_t target_position) const override;
-    [[nodiscard]] std::map<uint64_t, Topic> search_topics(uint64_t subject_id, expertise_level level, std::string_view search_pattern) const override;
+    [[nodiscard]] std::vector<Topic> search_topics(uint64_t subject_id, expertise_level level, std::string_view search_pattern, uint64_t limit, uint64_t offset) const override;
     void change_topic_level(uint64_t subject_id, uint64_t position, flashback::expertise_level level, flashback::expertise_level target) const override;
 
     // providers
     [[nodiscard]] Provider create_provider(std::string name) const override;
     void add_provider(uint64_t resource_id, uint64_t provider_id) const override;
     void drop_provider(uint64_t resource_id, uint64_t provider_id) const override;
-    [[nodiscard]] std::map<uint64_t, Provider> search_providers(std::string_view search_pattern) const override;
+    [[nodiscard]] std::vector<Provider> search_providers(std::string_view search_pattern, uint64_t limit, uint64_t offset) const override;
     [[nodiscard]] std::vector<Provider> get_providers(std::uint64_t resource_id) const override;
+    [[nodiscard]] std::vector<Provider> get_providers() const override;
+    void get_providers(std::uint64_t resource_id, google::protobuf::RepeatedPtrField<Provider>& providers) const override;
     void rename_provider(uint64_t provider_id, std::string name) const override;
     void remove_provider(uint64_t provider_id) const override;
     void merge_providers(uint64_t source_id, uint64_t target_id) const override;
@@ -112,8 +128,10 @@ public:
     [[nodiscard]] Presenter create_presenter(std::string name) const override;
     void add_presenter(uint64_t resource_id, uint64_t presenter_id) const override;
     void drop_presenter(uint64_t resource_id, uint64_t presenter_id) const override;
-    [[nodiscard]] std::map<uint64_t, Presenter> search_presenters(std::string_view search_pattern) const override;
+    [[nodiscard]] std::vector<Presenter> search_presenters(std::string_view search_pattern, uint64_t limit, uint64_t offset) const override;
     [[nodiscard]] std::vector<Presenter> get_presenters(std::uint64_t resource_id) const override;
+    [[nodiscard]] std::vector<Presenter> get_presenters() const override;
+    void get_presenters(std::uint64_t resource_id, google::protobuf::RepeatedPtrField<Presenter>& presenters) const override;
     void rename_presenter(uint64_t presenter_id, std::string name) const override;
     void remove_presenter(uint64_t presenter_id) const override;
     void merge_presenters(uint64_t source_id, uint64_t target_id) const override;
@@ -125,38 +143,59 @@ public:
     void edit_card_headline(uint64_t card_id, std::string headline) const override;
     void remove_card(uint64_t card_id) const override;
     void merge_cards(uint64_t source_id, uint64_t target_id, std::string) const override;
-    [[nodiscard]] std::map<uint64_t, Card> search_cards(uint64_t subject_id, expertise_level level, std::string_view search_pattern) const override;
+    [[nodiscard]] std::vector<Card> search_cards(uint64_t subject_id, expertise_level level, std::string_view search_pattern, uint64_t limit, uint64_t offset,
+                                                 std::stop_token stop) const override;
     void move_card_to_section(uint64_t card_id, uint64_t resource_id, uint64_t section_position, uint64_t target_resource_id, uint64_t target_section_position) const override;
     void move_card_to_topic(uint64_t card_id, uint64_t subject_id, uint64_t topic_position, expertise_level topic_level, uint64_t target_subject, uint64_t target_position,
                             expertise_level target_level) const override;
     [[nodiscard]] std::vector<SectionCard> get_section_cards(uint64_t resource_id, uint64_t sections_position) const override;
+    void get_section_cards(uint64_t resource_id, uint64_t sections_position, uint64_t after, uint64_t limit, google::protobuf::RepeatedPtrField<SectionCard>& cards) const override;
     [[nodiscard]] std::vector<Card> get_topic_cards(uint64_t subject_id, uint64_t topic_position, expertise_level topic_level) const override;
+    void get_topic_cards(uint64_t subject_id, uint64_t topic_position, expertise_level topic_level, google::protobuf::RepeatedPtrField<Card>& cards) const override;
+    void get_topic_cards(uint64_t subject_id, uint64_t topic_position, expertise_level topic_level, uint64_t after, uint64_t limit, google::protobuf::RepeatedPtrField<Card>& cards) const override;
 
     // blocks
     [[nodiscard]] Block create_block(uint64_t card_id, Block block) const override;
     [[nodiscard]] std::map<uint64_t, Block> get_blocks(uint64_t card_id) const override;
+    void get_blocks(uint64_t card_id, google::protobuf::RepeatedPtrField<Block>& blocks) const override;
+    void get_blocks(std::vector<Card*> const& cards) const override;
     void remove_block(uint64_t card_id, uint64_t block_position) const override;
     void edit_block_content(uint64_t card_id, uint64_t block_position, std::string content) const override;
     void change_block_type(uint64_t card_id, uint64_t block_position, Block::content_type type) const override;
     void edit_block_extension(uint64_t card_id, uint64_t block_position, std::string extension) const override;
     void edit_block_metadata(uint64_t card_id, uint64_t block_position, std::string metadata) const override;
     void reorder_block(uint64_t card_id, uint64_t block_position, uint64_t target_position) const override;
+    void apply_block_ordering(uint64_t card_id, std::vector<uint64_t> const& order) const override;
     void merge_blocks(uint64_t card_id, uint64_t source_position, uint64_t target_position) const override;
     [[nodiscard]] std::map<uint64_t, Block> split_block(uint64_t card_id, uint64_t block_position) const override;
+    void apply_card_edits(uint64_t card_id, google::protobuf::RepeatedPtrField<CardEdit> const& edits, google::protobuf::RepeatedPtrField<Block>& blocks) const override;
     void move_block(uint64_t card_id, uint64_t block_position, uint64_t target_card_id, uint64_t target_position) const override;
+    [[nodiscard]] std::vector<BlockSearchResult> search_blocks(uint64_t user_id, std::string_view search_pattern, uint64_t limit, uint64_t offset) const override;
 
     // nerves
     [[nodiscard]] Resource create_nerve(uint64_t user_id, std::string resource_name, uint64_t subject_id) const override;
     [[nodiscard]] std::vector<Resource> get_nerves(uint64_t user_id) const override;
+    void get_nerves(uint64_t user_id, google::protobuf::RepeatedPtrField<Nerve>& nerves) const override;
+
+    // exports
+    void export_subject_cards(uint64_t subject_id, std::function<bool(Topic const&, Card const&)> const& consume) const override;
+    void export_resource_blocks(uint64_t resource_id, std::function<bool(Card const&, Block const&)> const& consume) const override;
+    void export_subject_assessments(uint64_t subject_id, expertise_level max_level, std::function<bool(Card const&)> const& consume) const override;
 
     // practices
     [[nodiscard]] expertise_level get_user_cognitive_level(uint64_t user_id, uint64_t roadmap_id, uint64_t subject_id) const override;
     [[nodiscard]] practice_mode get_practice_mode(uint64_t user_id, uint64_t subject_id, expertise_level level) const override;
     [[nodiscard]] std::vector<Topic> get_practice_topics(uint64_t user_id, uint64_t roadmap_id, uint64_t milestone_id, expertise_level milestone_level) const override;
     [[nodiscard]] std::vector<Card> get_practice_cards(uint64_t user_id, uint64_t roadmap_id, uint64_t subject_id, expertise_level level, uint64_t topic_position) const override;
+    void get_practice_cards(uint64_t user_id, uint64_t roadmap_id, uint64_t subject_id, expertise_level level, uint64_t topic_position,
+                            google::protobuf::RepeatedPtrField<Card>& cards) const override;
     [[nodiscard]] closure_state get_resource_state(uint64_t resource_id) const override;
     void study(uint64_t user_id, uint64_t card_id, std::chrono::seconds duration) const override;
+    void record_progress(std::vector<progress_event> const& events) const override;
     [[nodiscard]] std::vector<Resource> get_study_resources(uint64_t user_id) const override;
+    void get_study_resources(uint64_t user_id, google::protobuf::RepeatedPtrField<StudyResource>& resources) const override;
+    void get_home_bundle(uint64_t user_id, google::protobuf::RepeatedPtrField<Roadmap>& roadmaps, google::protobuf::RepeatedPtrField<StudyResource>& studies,
+                         google::protobuf::RepeatedPtrField<Nerve>& nerves) const override;
     void mark_card_as_reviewed(uint64_t card_id) const override;
     void mark_card_as_completed(uint64_t card_id) const override;
     void mark_section_as_reviewed(uint64_t resource_id, uint64_t section_position) const override;
@@ -174,11 +213,15 @@ public:
     void diminish_assessment(uint64_t assessment_id, uint64_t subject_id, expertise_level level, uint64_t topic_position) const override;
     [[nodiscard]] std::vector<Topic> get_topic_coverage(uint64_t subject_id, uint64_t assessment_id) const override;
     [[nodiscard]] std::vector<Coverage> get_assessment_coverage(uint64_t subject_id, uint64_t topic_position, expertise_level max_level) const override;
+    [[nodiscard]] std::vector<TopicCoverage> get_subject_coverage(uint64_t subject_id) const override;
     [[nodiscard]] std::map<uint64_t, Assimilation> get_assimilation_coverage(uint64_t user_id, uint64_t subject_id, uint64_t assessment_id) const override;
     [[nodiscard]] std::vector<Card> get_topic_assessments(uint64_t user_id, uint64_t subject_id, uint64_t topic_position, expertise_level max_level) const override;
     [[nodiscard]] std::vector<Assessment> get_assessments(uint64_t user_id, uint64_t subject_id, expertise_level topic_level, uint64_t topic_position) const override;
+    void get_assessments(uint64_t user_id, uint64_t subject_id, expertise_level topic_level, uint64_t topic_position, uint64_t after, uint64_t limit,
+                         google::protobuf::RepeatedPtrField<Assessment>& assessments) const override;
     [[nodiscard]] bool is_assimilated(uint64_t user_id, uint64_t subject_id, expertise_level topic_level, uint64_t topic_position) const override;
     [[nodiscard]] virtual std::vector<Card> get_subject_assessments(uint64_t subject_id, expertise_level max_level) const override;
+    void get_subject_assessments(uint64_t subject_id, expertise_level max_level, uint64_t after, uint64_t limit, google::protobuf::RepeatedPtrField<Card>& cards) const override;
 
     [[nodiscard]] Topic get_topic(uint64_t subject_id, expertise_level level, uint64_t position) const override;
     [[nodiscard]] Section get_section(uint64_t resource_id, uint64_t position) const override;
@@ -220,9 +263,47 @@ private:
         work.commit();
     }
 
+    // walks an ordered query in fixed batches so large exports never hold the whole result,
+    // each batch continues after the ordering keys of the last row read, which are bound after the arguments and are null for the first batch,
+    // so a batch costs the same wherever it starts instead of reading past every row before it
+    // every batch is its own transaction on a pooled connection borrowed only while it is read, so a slow consumer never keeps one,
+    // which makes an export a walk over successive snapshots rather than one: rows written behind the last key read are not seen,
+    // rows written ahead of it are, and a row that keeps its keys throughout is neither skipped nor repeated
+    // returns false when the consumer declined more rows
+    template <std::size_t Keys, typename Consumer, typename... Args>
+    bool fetch(std::array<std::string_view, Keys> const& key_columns, Consumer&& consume, std::string_view const format, Args const&... args) const
+    {
+        std::string const statement{std::format("{} limit {}", format, fetch_batch_size)};
+        std::array<std::optional<uint64_t>, Keys> after{};
+
+        for (;;)
+        {
+            pqxx::result const batch{std::apply([this, &statement, &args...](auto const&... keys) { return query(statement, args..., keys...); }, after)};
+
+            if (!batch.empty() && !consume(batch))
+            {
+                return false;
+            }
+
+            if (batch.size() < fetch_batch_size)
+            {
+                return true;
+            }
+
+            pqxx::row const last{batch[batch.size() - 1]};
+
+            for (std::size_t key{}; key < Keys; ++key)
+            {
+                after[key] = last.at(key_columns[key]).template as<uint64_t>();
+            }
+        }
+    }
+
     void throw_back_progress(uint64_t user_id, uint64_t card_id, uint64_t days) const;
 
 private:
+    static constexpr std::size_t fetch_batch_size{256};
+
     std::shared_ptr<connection_pool> m_pool;
     friend class ::test_database;
 };
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+namespace flashback
+{
+// true when order lists each of the positions 1 to its size exactly once
+[[nodiscard]] bool is_complete_ordering(std::span<uint64_t const> order);
+} // namespace flashback
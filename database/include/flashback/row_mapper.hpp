@@ -0,0 +1,190 @@
+#pragma once
+
+#include <pqxx/pqxx>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+namespace flashback
+{
+// column name usable as a template argument, kept null terminated for pqxx lookups
+template <std::size_t Size>
+struct column_name
+{
+    consteval column_name(char const (&name)[Size])
+    {
+        std::copy_n(name, Size, value);
+    }
+
+    char value[Size]{};
+};
+
+// maps enum labels stored in the database to protobuf enums through a perfect hash computed at compile time
+template <typename Enum, std::size_t Size>
+class enum_table
+{
+public:
+    using entry = std::pair<std::string_view, Enum>;
+
+    consteval explicit enum_table(std::array<entry, Size> const& entries)
+        : m_entries{entries}
+    {
+        while (!try_seed(m_seed))
+        {
+            ++m_seed;
+        }
+    }
+
+    [[nodiscard]] constexpr std::optional<Enum> find(std::string_view const label) const noexcept
+    {
+        std::optional<Enum> value{};
+
+        if (std::uint8_t const slot{m_slots[hash(label, m_seed) & mask]}; slot != 0 && m_entries[slot - 1].first == label)
+        {
+            value = m_entries[slot - 1].second;
+        }
+
+        return value;
+    }
+
+private:
+    static constexpr std::size_t capacity{std::bit_ceil(Size * 2)};
+    static constexpr std::size_t mask{capacity - 1};
+
+    [[nodiscard]] static constexpr std::uint32_t hash(std::string_view const label, std::uint32_t const seed) noexcept
+    {
+        std::uint32_t hash{2166136261u ^ seed};
+
+        for (char const c: label)
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 16777619u;
+        }
+
+        return hash;
+    }
+
+    // throwing during constant evaluation turns an exhausted seed search into a compile error
+    consteval bool try_seed(std::uint32_t const seed)
+    {
+        if (seed > 0xffff)
+        {
+            throw "no perfect hash seed found for enum labels";
+        }
+
+        m_slots.fill(0);
+
+        for (std::size_t index{}; index < Size; ++index)
+        {
+            std::uint8_t& slot{m_slots[hash(m_entries[index].first, seed) & mask]};
+
+            if (slot != 0)
+            {
+                return false;
+            }
+
+            slot = static_cast<std::uint8_t>(index + 1);
+        }
+
+        return true;
+    }
+
+    std::array<entry, Size> m_entries;
+    std::array<std::uint8_t, capacity> m_slots{};
+    std::uint32_t m_seed{};
+};
+
+template <typename Enum, std::size_t Size>
+enum_table(std::array<std::pair<std::string_view, Enum>, Size> const&) -> enum_table<Enum, Size>;
+
+template <typename Setter>
+struct setter_traits;
+
+template <typename Message, typename Value>
+struct setter_traits<void (Message::*)(Value)>
+{
+    using message_type = Message;
+    using value_type = Value;
+};
+
+// numeric and boolean fields assigned through their generated setter
+template <column_name Name, auto Setter>
+struct value_column
+{
+    static constexpr char const* name{Name.value};
+
+    template <typename Message>
+    static void assign(pqxx::field const& field, Message& message)
+    {
+        (message.*Setter)(field.as<typename setter_traits<decltype(Setter)>::value_type>());
+    }
+};
+
+// string fields assigned in place, null values become empty strings
+template <column_name Name, auto Mutable>
+struct text_column
+{
+    static constexpr char const* name{Name.value};
+
+    template <typename Message>
+    static void assign(pqxx::field const& field, Message& message)
+    {
+        if (field.is_null())
+        {
+            (message.*Mutable)()->clear();
+        }
+        else
+        {
+            (message.*Mutable)()->assign(field.c_str(), field.size());
+        }
+    }
+};
+
+// enum fields decoded from their database label without intermediate strings
+template <column_name Name, auto Setter, auto Decoder>
+struct enum_column
+{
+    static constexpr char const* name{Name.value};
+
+    template <typename Message>
+    static void assign(pqxx::field const& field, Message& message)
+    {
+        (message.*Setter)(Decoder(field.view()));
+    }
+};
+
+// resolves column indices once per result so each row is mapped without name lookups
+template <typename Message, typename... Columns>
+class row_mapper
+{
+public:
+    explicit row_mapper(pqxx::result const& result)
+        : m_columns{result.column_number(Columns::name)...}
+    {}
+
+    void operator()(pqxx::row const& row, Message& message) const
+    {
+        assign(row, message, std::index_sequence_for<Columns...>{});
+    }
+
+    [[nodiscard]] Message operator()(pqxx::row const& row) const
+    {
+        Message message{};
+        assign(row, message, std::index_sequence_for<Columns...>{});
+        return message;
+    }
+
+private:
+    template <std::size_t... Index>
+    void assign(pqxx::row const& row, Message& message, std::index_sequence<Index...>) const
+    {
+        (Columns::assign(row[m_columns[Index]], message), ...);
+    }
+
+    std::array<pqxx::row::size_type, sizeof...(Columns)> m_columns;
+};
+} // namespace flashback
@@ -1,12 +1,235 @@
 #include <format>
 #include <iostream>
 #include <chrono>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
 #include <flashback/database.hpp>
 #include <flashback/exception.hpp>
+#include <flashback/row_mapper.hpp>
 #include <google/protobuf/util/time_util.h>
 
 using namespace flashback;
 
+namespace
+{
+constexpr enum_table expertise_levels{std::to_array<std::pair<std::string_view, expertise_level>>({
+    {"surface", expertise_level::surface},
+    {"depth", expertise_level::depth},
+    {"origin", expertise_level::origin},
+})};
+
+constexpr enum_table resource_types{std::to_array<std::pair<std::string_view, Resource::resource_type>>({
+    {"book", Resource::book},
+    {"website", Resource::website},
+    {"course", Resource::course},
+    {"video", Resource::video},
+    {"channel", Resource::channel},
+    {"mailing list", Resource::mailing_list},
+    {"manual", Resource::manual},
+    {"slides", Resource::slides},
+    {"nerve", Resource::nerve},
+})};
+
+constexpr enum_table section_patterns{std::to_array<std::pair<std::string_view, Resource::section_pattern>>({
+    {"chapter", Resource::chapter},
+    {"page", Resource::page},
+    {"session", Resource::session},
+    {"episode", Resource::episode},
+    {"playlist", Resource::playlist},
+    {"post", Resource::post},
+    {"synapse", Resource::synapse},
+})};
+
+constexpr enum_table card_states{std::to_array<std::pair<std::string_view, Card::card_state>>({
+    {"draft", Card::draft},
+    {"reviewed", Card::reviewed},
+    {"completed", Card::completed},
+    {"approved", Card::approved},
+    {"released", Card::released},
+    {"rejected", Card::rejected},
+})};
+
+constexpr enum_table content_types{std::to_array<std::pair<std::string_view, Block::content_type>>({
+    {"code", Block::code},
+    {"text", Block::text},
+    {"image", Block::image},
+    {"math", Block::math},
+    {"diagram", Block::diagram},
+})};
+
+constexpr enum_table closure_states{std::to_array<std::pair<std::string_view, closure_state>>({
+    {"draft", closure_state::draft},
+    {"reviewed", closure_state::reviewed},
+    {"completed", closure_state::completed},
+})};
+
+constexpr enum_table practice_modes{std::to_array<std::pair<std::string_view, practice_mode>>({
+    {"aggressive", practice_mode::aggressive},
+    {"progressive", practice_mode::progressive},
+    {"selective", practice_mode::selective},
+})};
+
+using roadmap_mapper = row_mapper<Roadmap, value_column<"id", &Roadmap::set_id>, text_column<"name", &Roadmap::mutable_name>>;
+
+using roadmap_match_mapper = row_mapper<Roadmap, value_column<"roadmap", &Roadmap::set_id>, text_column<"name", &Roadmap::mutable_name>>;
+
+using subject_mapper = row_mapper<Subject, value_column<"id", &Subject::set_id>, text_column<"name", &Subject::mutable_name>>;
+
+using milestone_mapper = row_mapper<Milestone, value_column<"id", &Milestone::set_id>, text_column<"name", &Milestone::mutable_name>,
+                                    value_column<"position", &Milestone::set_position>, enum_column<"level", &Milestone::set_level, &database::to_level>>;
+
+using related_milestone_mapper = row_mapper<Milestone, value_column<"id", &Milestone::set_id>, text_column<"name", &Milestone::mutable_name>,
+                                            enum_column<"level", &Milestone::set_level, &database::to_level>>;
+
+using resource_mapper = row_mapper<Resource, value_column<"id", &Resource::set_id>, text_column<"name", &Resource::mutable_name>,
+                                   enum_column<"type", &Resource::set_type, &database::to_resource_type>,
+                                   enum_column<"pattern", &Resource::set_pattern, &database::to_section_pattern>, text_column<"link", &Resource::mutable_link>>;
+
+using section_mapper = row_mapper<Section, value_column<"position", &Section::set_position>, enum_column<"state", &Section::set_state, &database::to_closure_state>,
+                                  text_column<"name", &Section::mutable_name>, text_column<"link", &Section::mutable_link>>;
+
+using section_match_mapper = row_mapper<Section, value_column<"position", &Section::set_position>, text_column<"name", &Section::mutable_name>,
+                                        text_column<"link", &Section::mutable_link>>;
+
+using topic_mapper = row_mapper<Topic, value_column<"position", &Topic::set_position>, text_column<"name", &Topic::mutable_name>,
+                                enum_column<"level", &Topic::set_level, &database::to_level>>;
+
+using provider_mapper = row_mapper<Provider, value_column<"id", &Provider::set_id>, text_column<"name", &Provider::mutable_name>>;
+
+using presenter_mapper = row_mapper<Presenter, value_column<"id", &Presenter::set_id>, text_column<"name", &Presenter::mutable_name>>;
+
+using provider_match_mapper = row_mapper<Provider, value_column<"provider", &Provider::set_id>, text_column<"name", &Provider::mutable_name>>;
+
+using presenter_match_mapper = row_mapper<Presenter, value_column<"presenter", &Presenter::set_id>, text_column<"name", &Presenter::mutable_name>>;
+
+using card_mapper = row_mapper<Card, value_column<"id", &Card::set_id>, enum_column<"state", &Card::set_state, &database::to_card_state>,
+                               text_column<"headline", &Card::mutable_headline>>;
+
+using section_card_mapper = row_mapper<SectionCard, value_column<"is_assignable", &SectionCard::set_is_assignable>>;
+
+using assessment_mapper = row_mapper<Assessment, value_column<"assimilations", &Assessment::set_assimilations>>;
+
+using block_mapper = row_mapper<Block, value_column<"position", &Block::set_position>, enum_column<"type", &Block::set_type, &database::to_content_type>,
+                                text_column<"extension", &Block::mutable_extension>, text_column<"metadata", &Block::mutable_metadata>,
+                                text_column<"content", &Block::mutable_content>>;
+
+using block_snippet_mapper = row_mapper<BlockSearchResult, text_column<"snippet", &BlockSearchResult::mutable_snippet>>;
+
+// the whole ordering commits at once, so nobody reads a list halfway through its moves
+// entries are inserted under a key share lock on the row they belong to, so locking that row first keeps the list from changing between the count and the update
+// positions are unique within a list and checked row by row, so every entry first moves past the end of the list and then lands on its target in one update
+template <typename... Keys>
+void apply_ordering(pqxx::work& work, std::string_view owner, std::string_view list, std::string_view scope, std::vector<uint64_t> const& order, uint64_t const owner_id,
+                    Keys const&... keys)
+{
+    constexpr std::size_t shift_parameter{sizeof...(Keys) + 2};
+    auto const shift{static_cast<uint64_t>(order.size())};
+
+    work.exec(std::format("select id from {} where id = $1 for update", owner), pqxx::params{owner_id});
+
+    if (work.query_value<uint64_t>(std::format("select count(*) from {} where {}", list, scope), pqxx::params{owner_id, keys...}) != order.size())
+    {
+        throw client_exception("ordering does not cover every position");
+    }
+
+    work.exec(std::format("update {0} set position = position + ${1} where {2}", list, shift_parameter, scope), pqxx::params{owner_id, keys..., shift});
+    work.exec(std::format("update {0} set position = ordering.target from unnest(${2}::bigint[]) with ordinality as ordering(source, target) "
+                          "where {1} and {0}.position = ordering.source + ${3}",
+                          list, scope, shift_parameter + 1, shift_parameter),
+              pqxx::params{owner_id, keys..., shift, order});
+    work.commit();
+}
+
+// providers, presenters and related milestones of every listed resource take one query each however many resources are listed
+template <typename Entry>
+void read_resource_details(pqxx::work& work, uint64_t const user_id, std::string_view const resources, google::protobuf::RepeatedPtrField<Entry>& entries)
+{
+    std::unordered_map<uint64_t, Entry*> listed{};
+    listed.reserve(static_cast<std::size_t>(entries.size()));
+
+    for (Entry& entry: entries)
+    {
+        listed.emplace(entry.resource().id(), &entry);
+    }
+
+    if (listed.empty())
+    {
+        return;
+    }
+
+    pqxx::result const providers{work.exec(std::format("select resources.id as resource, providers.id, providers.name from {} as resources "
+                                                       "cross join lateral get_providers(resources.id) as providers",
+                                                       resources),
+                                           pqxx::params{user_id})};
+    provider_mapper const map_provider{providers};
+
+    for (pqxx::row const& row: providers)
+    {
+        if (auto const entry{listed.find(row.at("resource").as<uint64_t>())}; entry != listed.end())
+        {
+            map_provider(row, *entry->second->mutable_resource()->add_providers());
+        }
+    }
+
+    pqxx::result const presenters{work.exec(std::format("select resources.id as resource, presenters.id, presenters.name from {} as resources "
+                                                        "cross join lateral get_presenters(resources.id) as presenters",
+                                                        resources),
+                                            pqxx::params{user_id})};
+    presenter_mapper const map_presenter{presenters};
+
+    for (pqxx::row const& row: presenters)
+    {
+        if (auto const entry{listed.find(row.at("resource").as<uint64_t>())}; entry != listed.end())
+        {
+            map_presenter(row, *entry->second->mutable_resource()->add_presenters());
+        }
+    }
+
+    pqxx::result const milestones{work.exec(std::format("select resources.id as resource, milestones.id, milestones.name, milestones.level from {} as resources "
+                                                        "cross join lateral get_related_milestone($1, resources.id) as milestones",
+                                                        resources),
+                                            pqxx::params{user_id})};
+    related_milestone_mapper const map_milestone{milestones};
+
+    for (pqxx::row const& row: milestones)
+    {
+        if (auto const entry{listed.find(row.at("resource").as<uint64_t>())}; entry != listed.end())
+        {
+            map_milestone(row, *entry->second->mutable_milestone());
+        }
+    }
+}
+
+void read_study_resources(pqxx::work& work, uint64_t const user_id, google::protobuf::RepeatedPtrField<StudyResource>& studies)
+{
+    pqxx::result const result{work.exec("select position, id, name, type, pattern, link from get_study_resources($1) order by position", pqxx::params{user_id})};
+    resource_mapper const map_resource{result};
+    studies.Reserve(studies.size() + static_cast<int>(result.size()));
+
+    for (pqxx::row const& row: result)
+    {
+        map_resource(row, *studies.Add()->mutable_resource());
+    }
+
+    read_resource_details(work, user_id, "get_study_resources($1)", studies);
+}
+
+void read_nerves(pqxx::work& work, uint64_t const user_id, google::protobuf::RepeatedPtrField<Nerve>& nerves)
+{
+    pqxx::result const result{work.exec("select id, name, type, pattern, link from get_nerves($1)", pqxx::params{user_id})};
+    resource_mapper const map_resource{result};
+    nerves.Reserve(nerves.size() + static_cast<int>(result.size()));
+
+    for (pqxx::row const& row: result)
+    {
+        map_resource(row, *nerves.Add()->mutable_resource());
+    }
+
+    read_resource_details(work, user_id, "get_nerves($1)", nerves);
+}
+} // namespace
+
 database::database(std::string client, std::string name, std::string address, std::string port)
 {
     try
@@ -245,12 +468,13 @@ std::vector<Roadmap> database::get_roadmaps(uint64_t const user_id) const
 {
     std::vector<Roadmap> roadmaps{};
 
-    for (pqxx::result const result{query("select id, name from get_roadmaps($1) order by name", user_id)}; pqxx::row row: result)
+    pqxx::result const result{query("select id, name from get_roadmaps($1) order by name", user_id)};
+    roadmap_mapper const map_roadmap{result};
+    roadmaps.reserve(result.size());
+
+    for (pqxx::row const& row: result)
     {
-        Roadmap roadmap{};
-        roadmap.set_id(row.at("id").as<std::uint64_t>());
-        roadmap.set_name(row.at("name").as<std::string>());
-        roadmaps.push_back(std::move(roadmap));
+        map_roadmap(row, roadmaps.emplace_back());
     }
 
     return roadmaps;
@@ -271,23 +495,26 @@ void database::remove_roadmap(uint64_t const roadmap_id) const
     exec("call remove_roadmap($1)", roadmap_id);
 }
 
-std::map<uint64_t, Roadmap> database::search_roadmaps(std::uint64_t user_id, std::string_view search_pattern) const
+std::vector<Roadmap> database::search_roadmaps(std::uint64_t const user_id, std::string_view search_pattern, uint64_t const limit, uint64_t const offset) const
 {
-    std::map<uint64_t, Roadmap> roadmaps;
+    std::vector<Roadmap> matched{};
 
     if (!search_pattern.empty())
     {
-        for (auto const result = query("select similarity, roadmap, name from search_roadmaps($1, $2) order by similarity", user_id, search_pattern); pqxx::row const& row: result)
+        pqxx::result const result{
+            query("select similarity, roadmap, name from search_roadmaps($1, $2) order by similarity, roadmap limit $3 offset $4",
+                  user_id, search_pattern, limit, offset)
+        };
+        roadmap_match_mapper const map_match{result};
+        matched.reserve(result.size());
+
+        for (pqxx::row const& row: result)
         {
-            uint64_t const similarity{row.at("similarity").as<uint64_t>()};
-            Roadmap roadmap{};
-            roadmap.set_id(row.at("roadmap").as<uint64_t>());
-            roadmap.set_name(row.at("name").as<std::string>());
-            roadmaps.insert({similarity, std::move(roadmap)});
+            map_match(row, matched.emplace_back());
         }
     }
 
-    return roadmaps;
+    return matched;
 }
 
 Subject database::create_subject(std::string name) const
@@ -305,22 +532,38 @@ Subject database::create_subject(std::string name) const
     return subject;
 }
 
-std::map<uint64_t, Subject> database::search_subjects(std::string_view search_pattern) const
+std::vector<Subject> database::search_subjects(std::string_view search_pattern, uint64_t const limit, uint64_t const offset) const
 {
-    std::map<uint64_t, Subject> subjects{};
+    std::vector<Subject> matched{};
 
     if (!search_pattern.empty())
     {
-        for (pqxx::row const& row: query("select similarity, id, name from search_subjects($1) order by similarity", search_pattern))
+        pqxx::result const result{query("select similarity, id, name from search_subjects($1) order by similarity, id limit $2 offset $3", search_pattern, limit, offset)};
+        subject_mapper const map_match{result};
+        matched.reserve(result.size());
+
+        for (pqxx::row const& row: result)
         {
-            uint64_t const similarity{row.at("similarity").as<uint64_t>()};
-            Subject subject{};
-            subject.set_id(row.at("id").as<uint64_t>());
-            subject.set_name(row.at("name").as<std::string>());
-            subjects.insert({similarity, subject});
+            map_match(row, matched.emplace_back());
         }
     }
 
+    return matched;
+}
+
+std::vector<Subject> database::get_subjects() const
+{
+    std::vector<Subject> subjects{};
+
+    pqxx::result const result{query("select id, name from get_subjects()")};
+    subject_mapper const map_subject{result};
+    subjects.reserve(result.size());
+
+    for (pqxx::row const& row: result)
+    {
+        map_subject(row, subjects.emplace_back());
+    }
+
     return subjects;
 }
 
@@ -382,24 +625,30 @@ std::vector<Milestone> database::get_milestones(uint64_t const roadmap_id) const
 {
     std::vector<Milestone> milestones{};
 
-    for (pqxx::row const& row: query("select level, position, id, name from get_milestones($1) order by position", roadmap_id))
-    {
-        uint64_t const id = row.at("id").as<uint64_t>();
-        uint64_t const position = row.at("position").as<uint64_t>();
-        std::string const level = row.at("level").as<std::string>();
-        std::string const name = row.at("name").as<std::string>();
+    pqxx::result const result{query("select level, position, id, name from get_milestones($1) order by position", roadmap_id)};
+    milestone_mapper const map_milestone{result};
+    milestones.reserve(result.size());
 
-        Milestone milestone{};
-        milestone.set_id(id);
-        milestone.set_name(name);
-        milestone.set_position(position);
-        milestone.set_level(to_level(level));
-        milestones.push_back(milestone);
+    for (pqxx::row const& row: result)
+    {
+        map_milestone(row, milestones.emplace_back());
     }
 
     return milestones;
 }
 
+void database::get_milestones(uint64_t const roadmap_id, uint64_t const after, uint64_t const limit, google::protobuf::RepeatedPtrField<Milestone>& milestones) const
+{
+    pqxx::result const result{query("select level, position, id, name from get_milestones($1) where position > $2 order by position limit $3", roadmap_id, after, limit)};
+    milestone_mapper const map_milestone{result};
+    milestones.Reserve(milestones.size() + result.size());
+
+    for (pqxx::row const& row: result)
+    {
+        map_milestone(row, *milestones.Add());
+    }
+}
+
 void database::add_requirement(uint64_t const roadmap_id, Milestone const milestone, Milestone const required_milestone) const
 {
     exec("call add_requirement($1, $2, $3, $4, $5)", roadmap_id, milestone.id(), level_to_string(milestone.level()), required_milestone.id(),
@@ -423,6 +672,31 @@ std::vector<Milestone> database::get_requirements(uint64_t const roadmap_id, uin
     return requirements;
 }
 
+std::vector<Requirement> database::get_roadmap_requirements(uint64_t const roadmap_id) const
+{
+    std::vector<Requirement> requirements{};
+
+    pqxx::result const result{query("select milestones.id as milestone, milestones.level as milestone_level, requirements.subject, requirements.position, requirements.name, "
+                                    "requirements.required_level "
+                                    "from get_milestones($1) as milestones cross join lateral get_requirements($1, milestones.id, milestones.level) as requirements",
+                                    roadmap_id)};
+    requirements.reserve(result.size());
+
+    for (pqxx::row const& row: result)
+    {
+        Requirement& requirement{requirements.emplace_back()};
+        requirement.set_milestone_id(row.at("milestone").as<uint64_t>());
+        requirement.set_milestone_level(to_level(row.at("milestone_level").as<std::string>()));
+        Milestone* required{requirement.mutable_required_milestone()};
+        required->set_id(row.at("subject").as<uint64_t>());
+        required->set_position(row.at("position").as<uint64_t>());
+        required->set_name(row.at("name").as<std::string>());
+        required->set_level(to_level(row.at("required_level").as<std::string>()));
+    }
+
+    return requirements;
+}
+
 Roadmap database::clone_roadmap(uint64_t const user_id, uint64_t const roadmap_id) const
 {
     Roadmap roadmap{};
@@ -444,6 +718,13 @@ void database::reorder_milestone(uint64_t const roadmap_id, uint64_t const curre
     exec("call reorder_milestone($1, $2, $3)", roadmap_id, current_position, target_position);
 }
 
+void database::apply_milestone_ordering(uint64_t const roadmap_id, std::vector<uint64_t> const& order) const
+{
+    auto conn_guard = m_pool->acquire();
+    pqxx::work work{*conn_guard};
+    apply_ordering(work, "roadmaps", "milestones", "milestones.roadmap = $1", order, roadmap_id);
+}
+
 void database::remove_milestone(uint64_t roadmap_id, uint64_t subject_id) const
 {
     exec("call remove_milestone($1, $2)", roadmap_id, subject_id);
@@ -477,19 +758,32 @@ void database::add_resource_to_subject(uint64_t const resource_id, uint64_t cons
 std::vector<Resource> database::get_resources(uint64_t user_id, uint64_t const subject_id) const
 {
     std::vector<Resource> resources{};
-    for (pqxx::row const& row: query("select id, name, type, pattern, link from get_resources($1, $2)", user_id, subject_id))
+    pqxx::result const result{query("select id, name, type, pattern, link from get_resources($1, $2)", user_id, subject_id)};
+    resource_mapper const map_resource{result};
+    resources.reserve(result.size());
+    for (pqxx::row const& row: result)
     {
-        Resource resource{};
-        resource.set_id(row.at("id").as<uint64_t>());
-        resource.set_name(row.at("name").as<std::string>());
-        resource.set_type(to_resource_type(row.at("type").as<std::string>()));
-        resource.set_pattern(to_section_pattern(row.at("pattern").as<std::string>()));
-        resource.set_link(row.at("link").is_null() ? "" : row.at("link").as<std::string>());
-        resources.push_back(resource);
+        map_resource(row, resources.emplace_back());
     }
     return resources;
 }
 
+std::vector<Resource> database::get_resources() const
+{
+    std::vector<Resource> resources{};
+
+    pqxx::result const result{query("select id, name, type, pattern, link from get_resources()")};
+    resource_mapper const map_resource{result};
+    resources.reserve(result.size());
+
+    for (pqxx::row const& row: result)
+    {
+        map_resource(row, resources.emplace_back());
+    }
+
+    return resources;
+}
+
 Resource database::get_resource(uint64_t resource_id) const
 {
     Resource resource{};
@@ -510,22 +804,22 @@ void database::drop_resource_from_subject(uint64_t const resource_id, uint64_t c
     exec("call drop_resource_from_subject($1, $2)", resource_id, subject_id);
 }
 
-std::map<uint64_t, Resource> database::search_resources(std::string_view search_pattern) const
+std::vector<Resource> database::search_resources(std::string_view search_pattern, uint64_t const limit, uint64_t const offset) const
 {
-    std::map<uint64_t, Resource> matched{};
+    std::vector<Resource> matched{};
 
     if (!search_pattern.empty())
     {
-        for (pqxx::row const& row: query("select similarity, id, name, type, pattern, link from search_resources($1) order by similarity", search_pattern))
+        pqxx::result const result{
+            query("select similarity, id, name, type, pattern, link from search_resources($1) order by similarity, id limit $2 offset $3",
+                  search_pattern, limit, offset)
+        };
+        resource_mapper const map_match{result};
+        matched.reserve(result.size());
+
+        for (pqxx::row const& row: result)
         {
-            uint64_t const similarity{row.at("similarity").as<uint64_t>()};
-            Resource resource{};
-            resource.set_id(row.at("id").as<uint64_t>());
-            resource.set_name(row.at("name").as<std::string>());
-            resource.set_type(to_resource_type(row.at("type").as<std::string>()));
-            resource.set_pattern(to_section_pattern(row.at("pattern").as<std::string>()));
-            resource.set_link(row.at("link").is_null() ? "" : row.at("link").as<std::string>());
-            matched.insert({similarity, resource});
+            map_match(row, matched.emplace_back());
         }
     }
 
@@ -603,20 +897,42 @@ Section database::create_section(uint64_t const resource_id, uint64_t const posi
 std::map<uint64_t, Section> database::get_sections(uint64_t const resource_id) const
 {
     std::map<uint64_t, Section> sections{};
+    google::protobuf::RepeatedPtrField<Section> rows{};
+    get_sections(resource_id, rows);
 
-    for (pqxx::row const& row: query("select position, state, name, link from get_sections($1) order by position", resource_id))
+    for (Section& section: rows)
     {
-        Section section{};
-        section.set_position(row.at("position").as<uint64_t>());
-        section.set_state(to_closure_state(row.at("state").as<std::string>()));
-        section.set_name(row.at("name").is_null() ? "" : row.at("name").as<std::string>());
-        section.set_link(row.at("link").is_null() ? "" : row.at("link").as<std::string>());
-        sections.insert({section.position(), section});
+        uint64_t const position{section.position()};
+        sections.emplace_hint(sections.end(), position, std::move(section));
     }
 
     return sections;
 }
 
+void database::get_sections(uint64_t const resource_id, google::protobuf::RepeatedPtrField<Section>& sections) const
+{
+    pqxx::result const result{query("select position, state, name, link from get_sections($1) order by position", resource_id)};
+    section_mapper const map_section{result};
+    sections.Reserve(sections.size() + result.size());
+
+    for (pqxx::row const& row: result)
+    {
+        map_section(row, *sections.Add());
+    }
+}
+
+void database::get_sections(uint64_t const resource_id, uint64_t const after, uint64_t const limit, google::protobuf::RepeatedPtrField<Section>& sections) const
+{
+    pqxx::result const result{query("select position, state, name, link from get_sections($1) where position > $2 order by position limit $3", resource_id, after, limit)};
+    section_mapper const map_section{result};
+    sections.Reserve(sections.size() + result.size());
+
+    for (pqxx::row const& row: result)
+    {
+        map_section(row, *sections.Add());
+    }
+}
+
 void database::remove_section(uint64_t const resource_id, uint64_t const position) const
 {
     exec("call remove_section($1, $2)", resource_id, position);
@@ -627,6 +943,13 @@ void database::reorder_section(uint64_t const resource_id, uint64_t const curren
     exec("call reorder_section($1, $2, $3)", resource_id, current_position, target_position);
 }
 
+void database::apply_section_ordering(uint64_t const resource_id, std::vector<uint64_t> const& order) const
+{
+    auto conn_guard = m_pool->acquire();
+    pqxx::work work{*conn_guard};
+    apply_ordering(work, "resources", "sections", "sections.resource = $1", order, resource_id);
+}
+
 void database::merge_sections(uint64_t const resource_id, uint64_t const source_position, uint64_t const target_position) const
 {
     exec("call merge_sections($1, $2, $3)", resource_id, source_position, target_position);
@@ -642,24 +965,26 @@ void database::move_section(uint64_t const resource_id, uint64_t const position,
     exec("call move_section($1, $2, $3, $4)", resource_id, position, target_resource_id, target_position);
 }
 
-std::map<uint64_t, Section> database::search_sections(uint64_t const resource_id, std::string_view search_pattern) const
+std::vector<Section> database::search_sections(uint64_t const resource_id, std::string_view search_pattern, uint64_t const limit, uint64_t const offset) const
 {
-    std::map<uint64_t, Section> sections{};
+    std::vector<Section> matched{};
 
     if (!search_pattern.empty())
     {
-        for (pqxx::row const& row: query("select similarity, position, name, link from search_sections($1, $2) order by similarity", resource_id, search_pattern))
+        pqxx::result const result{
+            query("select similarity, position, name, link from search_sections($1, $2) order by similarity, position limit $3 offset $4",
+                  resource_id, search_pattern, limit, offset)
+        };
+        section_match_mapper const map_match{result};
+        matched.reserve(result.size());
+
+        for (pqxx::row const& row: result)
         {
-            uint64_t const similarity{row.at("similarity").as<uint64_t>()};
-            Section section{};
-            section.set_position(row.at("position").as<uint64_t>());
-            section.set_name(row.at("name").is_null() ? "" : row.at("name").as<std::string>());
-            section.set_link(row.at("link").is_null() ? "" : row.at("link").as<std::string>());
-            sections.insert({similarity, section});
+            map_match(row, matched.emplace_back());
         }
     }
 
-    return sections;
+    return matched;
 }
 
 void database::edit_section_link(uint64_t resource_id, uint64_t position, std::string link) const
@@ -694,23 +1019,45 @@ std::map<uint64_t, Topic> database::get_topics(uint64_t const subject_id, expert
 {
     std::map<uint64_t, Topic> topics{};
 
-    for (pqxx::row const& row: query("select position, name, level from get_topics($1, $2) order by position", subject_id, level_to_string(level)))
+    pqxx::result const result{query("select position, name, level from get_topics($1, $2) order by position", subject_id, level_to_string(level))};
+    topic_mapper const map_topic{result};
+
+    for (pqxx::row const& row: result)
     {
-        Topic topic{};
-        topic.set_position(row.at("position").as<uint64_t>());
-        topic.set_name(row.at("name").as<std::string>());
-        topic.set_level(to_level(row.at("level").as<std::string>()));
-        topics.insert({topic.position(), topic});
+        Topic topic{map_topic(row)};
+        uint64_t const position{topic.position()};
+        topics.emplace_hint(topics.end(), position, std::move(topic));
     }
 
     return topics;
 }
 
+void database::get_topics(uint64_t const subject_id, expertise_level const level, uint64_t const after, uint64_t const limit, google::protobuf::RepeatedPtrField<Topic>& topics) const
+{
+    pqxx::result const result{
+        query("select position, name, level from get_topics($1, $2) where position > $3 order by position limit $4", subject_id, level_to_string(level), after, limit)
+    };
+    topic_mapper const map_topic{result};
+    topics.Reserve(topics.size() + result.size());
+
+    for (pqxx::row const& row: result)
+    {
+        map_topic(row, *topics.Add());
+    }
+}
+
 void database::reorder_topic(uint64_t const subject_id, expertise_level const level, uint64_t const source_position, uint64_t const target_position) const
 {
     exec("call reorder_topic($1, $2, $3, $4)", subject_id, level_to_string(level), source_position, target_position);
 }
 
+void database::apply_topic_ordering(uint64_t const subject_id, expertise_level const level, std::vector<uint64_t> const& order) const
+{
+    auto conn_guard = m_pool->acquire();
+    pqxx::work work{*conn_guard};
+    apply_ordering(work, "subjects", "topics", "topics.subject = $1 and topics.level = $2", order, subject_id, level_to_string(level));
+}
+
 void database::remove_topic(uint64_t const subject_id, expertise_level const level, uint64_t const position) const
 {
     exec("call remove_topic($1, $2, $3)", subject_id, level_to_string(level), position);
@@ -731,25 +1078,27 @@ void database::move_topic(uint64_t const subject_id, expertise_level const level
     exec("call move_topic($1, $2, $3, $4, $5, $6)", subject_id, level_to_string(level), position, target_subject_id, level_to_string(target_level), target_position);
 }
 
-std::map<uint64_t, Topic> database::search_topics(uint64_t const subject_id, expertise_level const level, std::string_view search_pattern) const
+std::vector<Topic> database::search_topics(uint64_t const subject_id, expertise_level const level, std::string_view search_pattern,
+                                           uint64_t const limit, uint64_t const offset) const
 {
-    std::map<uint64_t, Topic> topics{};
+    std::vector<Topic> matched{};
 
     if (!search_pattern.empty())
     {
-        for (pqxx::row const& row: query("select similarity, position, name, level from search_topics($1, $2, $3) order by similarity", subject_id, level_to_string(level),
-                                         search_pattern))
+        pqxx::result const result{
+            query("select similarity, position, name, level from search_topics($1, $2, $3) order by similarity, position limit $4 offset $5",
+                  subject_id, level_to_string(level), search_pattern, limit, offset)
+        };
+        topic_mapper const map_match{result};
+        matched.reserve(result.size());
+
+        for (pqxx::row const& row: result)
         {
-            uint64_t const similarity{row.at("similarity").as<uint64_t>()};
-            Topic topic{};
-            topic.set_position(row.at("position").as<uint64_t>());
-            topic.set_name(row.at("name").as<std::string>());
-            topic.set_level(to_level(row.at("level").as<std::string>()));
-            topics.insert({similarity, topic});
+            map_match(row, matched.emplace_back());
         }
     }
 
-    return topics;
+    return matched;
 }
 
 void database::change_topic_level(uint64_t const subject_id, uint64_t const position, flashback::expertise_level const level, flashback::expertise_level const target) const
@@ -761,17 +1110,46 @@ std::vector<Provider> database::get_providers(std::uint64_t resource_id) const
 {
     std::vector<Provider> providers{};
 
-    for (pqxx::row const& result: query("select id, name from get_providers($1)", resource_id))
+    pqxx::result const result{query("select id, name from get_providers($1)", resource_id)};
+    provider_mapper const map_provider{result};
+    providers.reserve(result.size());
+
+    for (pqxx::row const& row: result)
+    {
+        map_provider(row, providers.emplace_back());
+    }
+
+    return providers;
+}
+
+std::vector<Provider> database::get_providers() const
+{
+    std::vector<Provider> providers{};
+
+    pqxx::result const result{query("select id, name from get_providers()")};
+    provider_mapper const map_provider{result};
+    providers.reserve(result.size());
+
+    for (pqxx::row const& row: result)
     {
-        Provider provider{};
-        provider.set_id(result.at("id").as<uint64_t>());
-        provider.set_name(result.at("name").as<std::string>());
-        providers.push_back(std::move(provider));
+        map_provider(row, providers.emplace_back());
     }
 
     return providers;
 }
 
+void database::get_providers(std::uint64_t const resource_id, google::protobuf::RepeatedPtrField<Provider>& providers) const
+{
+    pqxx::result const result{query("select id, name from get_providers($1)", resource_id)};
+    provider_mapper const map_provider{result};
+    providers.Reserve(providers.size() + result.size());
+
+    for (pqxx::row const& row: result)
+    {
+        map_provider(row, *providers.Add());
+    }
+}
+
 Provider database::create_provider(std::string name) const
 {
     Provider provider{};
@@ -800,19 +1178,22 @@ void database::drop_provider(uint64_t const resource_id, uint64_t const provider
     exec("call drop_provider($1, $2)", resource_id, provider_id);
 }
 
-std::map<uint64_t, Provider> database::search_providers(std::string_view search_pattern) const
+std::vector<Provider> database::search_providers(std::string_view search_pattern, uint64_t const limit, uint64_t const offset) const
 {
-    std::map<uint64_t, Provider> matched{};
+    std::vector<Provider> matched{};
 
     if (!search_pattern.empty())
     {
-        for (pqxx::row const& row: query("select similarity, provider, name from search_providers($1) order by similarity", search_pattern))
+        pqxx::result const result{
+            query("select similarity, provider, name from search_providers($1) order by similarity, provider limit $2 offset $3",
+                  search_pattern, limit, offset)
+        };
+        provider_match_mapper const map_match{result};
+        matched.reserve(result.size());
+
+        for (pqxx::row const& row: result)
         {
-            uint64_t const similarity{row.at("similarity").as<uint64_t>()};
-            Provider provider{};
-            provider.set_id(row.at("provider").as<uint64_t>());
-            provider.set_name(row.at("name").as<std::string>());
-            matched.insert({similarity, provider});
+            map_match(row, matched.emplace_back());
         }
     }
 
@@ -838,17 +1219,46 @@ std::vector<Presenter> database::get_presenters(std::uint64_t resource_id) const
 {
     std::vector<Presenter> presenters{};
 
-    for (pqxx::row const& result: query("select id, name from get_presenters($1)", resource_id))
+    pqxx::result const result{query("select id, name from get_presenters($1)", resource_id)};
+    presenter_mapper const map_presenter{result};
+    presenters.reserve(result.size());
+
+    for (pqxx::row const& row: result)
+    {
+        map_presenter(row, presenters.emplace_back());
+    }
+
+    return presenters;
+}
+
+std::vector<Presenter> database::get_presenters() const
+{
+    std::vector<Presenter> presenters{};
+
+    pqxx::result const result{query("select id, name from get_presenters()")};
+    presenter_mapper const map_presenter{result};
+    presenters.reserve(result.size());
+
+    for (pqxx::row const& row: result)
     {
-        Presenter presenter{};
-        presenter.set_id(result.at("id").as<uint64_t>());
-        presenter.set_name(result.at("name").as<std::string>());
-        presenters.push_back(std::move(presenter));
+        map_presenter(row, presenters.emplace_back());
     }
 
     return presenters;
 }
 
+void database::get_presenters(std::uint64_t const resource_id, google::protobuf::RepeatedPtrField<Presenter>& presenters) const
+{
+    pqxx::result const result{query("select id, name from get_presenters($1)", resource_id)};
+    presenter_mapper const map_presenter{result};
+    presenters.Reserve(presenters.size() + result.size());
+
+    for (pqxx::row const& row: result)
+    {
+        map_presenter(row, *presenters.Add());
+    }
+}
+
 Presenter database::create_presenter(std::string name) const
 {
     Presenter presenter{};
@@ -877,19 +1287,22 @@ void database::drop_presenter(uint64_t const resource_id, uint64_t const present
     exec("call drop_presenter($1, $2)", resource_id, presenter_id);
 }
 
-std::map<uint64_t, Presenter> database::search_presenters(std::string_view search_pattern) const
+std::vector<Presenter> database::search_presenters(std::string_view search_pattern, uint64_t const limit, uint64_t const offset) const
 {
-    std::map<uint64_t, Presenter> matched{};
+    std::vector<Presenter> matched{};
 
     if (!search_pattern.empty())
     {
-        for (pqxx::row const& row: query("select similarity, presenter, name from search_presenters($1) order by similarity", search_pattern))
+        pqxx::result const result{
+            query("select similarity, presenter, name from search_presenters($1) order by similarity, presenter limit $2 offset $3",
+                  search_pattern, limit, offset)
+        };
+        presenter_match_mapper const map_match{result};
+        matched.reserve(result.size());
+
+        for (pqxx::row const& row: result)
         {
-            uint64_t const similarity{row.at("similarity").as<uint64_t>()};
-            Presenter presenter{};
-            presenter.set_id(row.at("presenter").as<uint64_t>());
-            presenter.set_name(row.at("name").as<std::string>());
-            matched.insert({similarity, presenter});
+            map_match(row, matched.emplace_back());
         }
     }
 
@@ -948,20 +1361,46 @@ void database::merge_cards(uint64_t const source_id, uint64_t const target_id, s
     exec("call merge_cards($1, $2, $3)", source_id, target_id, std::move(headline));
 }
 
-std::map<uint64_t, Card> database::search_cards(uint64_t const subject_id, expertise_level const level, std::string_view search_pattern) const
+std::vector<Card> database::search_cards(uint64_t const subject_id, expertise_level const level, std::string_view search_pattern, uint64_t const limit, uint64_t const offset,
+                                         std::stop_token const stop) const
 {
-    std::map<uint64_t, Card> matched{};
+    std::vector<Card> matched{};
 
     if (!search_pattern.empty())
     {
-        for (pqxx::row const& row: query("select similarity, id, state, headline from search_cards($1, $2, $3) order by similarity", subject_id, level_to_string(level),
-                                         search_pattern))
+        auto conn_guard = m_pool->acquire();
+        pqxx::work work{*conn_guard};
+        pqxx::result result{};
+        // the callback runs on the thread requesting the stop, libpq sends the cancellation over a connection of its own
+        std::stop_callback const cancel{stop, [&conn_guard] { conn_guard->cancel_query(); }};
+
+        if (stop.stop_requested())
+        {
+            return matched;
+        }
+
+        try
+        {
+            result = work.exec("select similarity, id, state, headline from search_cards($1, $2, $3) order by similarity, id limit $4 offset $5",
+                               pqxx::params{subject_id, level_to_string(level), search_pattern, limit, offset});
+            work.commit();
+        }
+        catch (pqxx::sql_error const&)
         {
-            uint64_t const similarity{row.at("similarity").as<uint64_t>()};
-            Card card{};
-            card.set_id(row.at("id").as<uint64_t>());
-            card.set_headline(row.at("headline").as<std::string>());
-            matched.insert({similarity, card});
+            if (stop.stop_requested())
+            {
+                return matched;
+            }
+
+            throw;
+        }
+
+        card_mapper const map_match{result};
+        matched.reserve(result.size());
+
+        for (pqxx::row const& row: result)
+        {
+            map_match(row, matched.emplace_back());
         }
     }
 
@@ -984,36 +1423,75 @@ std::vector<SectionCard> database::get_section_cards(uint64_t const resource_id,
 {
     std::vector<SectionCard> cards{};
 
-    for (pqxx::result const result{query("select id, state, headline, is_assignable from get_section_cards($1, $2)", resource_id, sections_position)}; pqxx::row const& row: result)
+    pqxx::result const result{query("select id, state, headline, is_assignable from get_section_cards($1, $2)", resource_id, sections_position)};
+    card_mapper const map_card{result};
+    section_card_mapper const map_section_card{result};
+    cards.reserve(result.size());
+
+    for (pqxx::row const& row: result)
     {
-        SectionCard section_card{};
-        Card card{};
-        card.set_id(row.at("id").as<uint64_t>());
-        card.set_state(to_card_state(row.at("state").as<std::string>()));
-        card.set_headline(row.at("headline").as<std::string>());
-        *section_card.mutable_card() = card;
-        section_card.set_is_assignable(row.at("is_assignable").as<bool>());
-        cards.push_back(section_card);
+        SectionCard& section_card{cards.emplace_back()};
+        map_card(row, *section_card.mutable_card());
+        map_section_card(row, section_card);
     }
 
     return cards;
 }
 
+// cards carry no position of their own, the ordinal of each row in the listing serves as the seek key
+void database::get_section_cards(uint64_t const resource_id, uint64_t const sections_position, uint64_t const after, uint64_t const limit,
+                                 google::protobuf::RepeatedPtrField<SectionCard>& cards) const
+{
+    pqxx::result const result{
+        query("select id, state, headline, is_assignable from get_section_cards($1, $2) with ordinality where ordinality > $3 order by ordinality limit $4",
+              resource_id, sections_position, after, limit)
+    };
+    card_mapper const map_card{result};
+    section_card_mapper const map_section_card{result};
+    cards.Reserve(cards.size() + result.size());
+
+    for (pqxx::row const& row: result)
+    {
+        SectionCard* section_card{cards.Add()};
+        map_card(row, *section_card->mutable_card());
+        map_section_card(row, *section_card);
+    }
+}
+
 std::vector<Card> database::get_topic_cards(uint64_t const subject_id, uint64_t const topic_position, expertise_level const topic_level) const
 {
-    std::vector<Card> cards{};
+    google::protobuf::RepeatedPtrField<Card> cards{};
+    get_topic_cards(subject_id, topic_position, topic_level, cards);
+    return {std::make_move_iterator(cards.begin()), std::make_move_iterator(cards.end())};
+}
+
+void database::get_topic_cards(uint64_t const subject_id, uint64_t const topic_position, expertise_level const topic_level,
+                               google::protobuf::RepeatedPtrField<Card>& cards) const
+{
+    pqxx::result const result{query("select id, state, headline from get_topic_cards($1, $2, $3)", subject_id, topic_position, level_to_string(topic_level))};
+    card_mapper const map_card{result};
+    cards.Reserve(cards.size() + result.size());
 
-    for (pqxx::result const result{query("select id, state, headline from get_topic_cards($1, $2, $3)", subject_id, topic_position, level_to_string(topic_level))};
-         pqxx::row const& row: result)
+    for (pqxx::row const& row: result)
     {
-        Card card{};
-        card.set_id(row.at("id").as<uint64_t>());
-        card.set_state(to_card_state(row.at("state").as<std::string>()));
-        card.set_headline(row.at("headline").as<std::string>());
-        cards.push_back(card);
+        map_card(row, *cards.Add());
     }
+}
 
-    return cards;
+void database::get_topic_cards(uint64_t const subject_id, uint64_t const topic_position, expertise_level const topic_level, uint64_t const after, uint64_t const limit,
+                               google::protobuf::RepeatedPtrField<Card>& cards) const
+{
+    pqxx::result const result{
+        query("select id, state, headline from get_topic_cards($1, $2, $3) with ordinality where ordinality > $4 order by ordinality limit $5",
+              subject_id, topic_position, level_to_string(topic_level), after, limit)
+    };
+    card_mapper const map_card{result};
+    cards.Reserve(cards.size() + result.size());
+
+    for (pqxx::row const& row: result)
+    {
+        map_card(row, *cards.Add());
+    }
 }
 
 Block database::create_block(uint64_t const card_id, Block block) const
@@ -1041,22 +1519,67 @@ Block database::create_block(uint64_t const card_id, Block block) const
 std::map<uint64_t, Block> database::get_blocks(uint64_t const card_id) const
 {
     std::map<uint64_t, Block> blocks{};
+    google::protobuf::RepeatedPtrField<Block> rows{};
+    get_blocks(card_id, rows);
 
-    for (pqxx::result const result{query("select position, type, extension, metadata, content from get_blocks($1)", card_id)}; pqxx::row const& row: result)
+    for (Block& block: rows)
     {
-        Block block{};
-        uint64_t const position{row.at("position").as<uint64_t>()};
-        block.set_position(position);
-        block.set_type(to_content_type(row.at("type").as<std::string>()));
-        block.set_extension(row.at("extension").as<std::string>());
-        block.set_metadata(row.at("metadata").is_null() ? "" : row.at("metadata").as<std::string>());
-        block.set_content(row.at("content").as<std::string>());
-        blocks.insert({position, block});
+        uint64_t const position{block.position()};
+        blocks.insert_or_assign(position, std::move(block));
     }
 
     return blocks;
 }
 
+void database::get_blocks(uint64_t const card_id, google::protobuf::RepeatedPtrField<Block>& blocks) const
+{
+    pqxx::result const result{query("select position, type, extension, metadata, content from get_blocks($1) order by position", card_id)};
+    block_mapper const map_block{result};
+    blocks.Reserve(blocks.size() + result.size());
+
+    for (pqxx::row const& row: result)
+    {
+        map_block(row, *blocks.Add());
+    }
+}
+
+// fills the blocks of every given card with a single query instead of one round trip per card
+void database::get_blocks(std::vector<Card*> const& cards) const
+{
+    if (cards.empty())
+    {
+        return;
+    }
+
+    std::vector<uint64_t> card_ids{};
+    std::unordered_map<uint64_t, Card*> owners{};
+    card_ids.reserve(cards.size());
+    owners.reserve(cards.size());
+
+    for (Card* card: cards)
+    {
+        card->clear_blocks();
+        card_ids.push_back(card->id());
+        owners.emplace(card->id(), card);
+    }
+
+    pqxx::result const result{
+        query("select cards.card, blocks.position, blocks.type, blocks.extension, blocks.metadata, blocks.content "
+              "from unnest($1::bigint[]) as cards(card) cross join lateral get_blocks(cards.card) as blocks order by cards.card, blocks.position",
+              card_ids)
+    };
+    block_mapper const map_block{result};
+    pqxx::row::size_type const card_column{result.column_number("card")};
+
+    for (pqxx::row const& row: result)
+    {
+        if (auto const owner{owners.find(row.at(card_column).as<uint64_t>())}; owner != owners.end())
+        {
+            map_block(row, *owner->second->add_blocks());
+        }
+    }
+}
+
 void database::remove_block(uint64_t const card_id, uint64_t const block_position) const
 {
     exec("call remove_block($1, $2)", card_id, block_position);
@@ -1087,6 +1610,13 @@ void database::reorder_block(uint64_t const card_id, uint64_t const block_positi
     exec("call reorder_block($1, $2, $3)", card_id, block_position, target_position);
 }
 
+void database::apply_block_ordering(uint64_t const card_id, std::vector<uint64_t> const& order) const
+{
+    auto conn_guard = m_pool->acquire();
+    pqxx::work work{*conn_guard};
+    apply_ordering(work, "cards", "blocks", "blocks.card = $1", order, card_id);
+}
+
 void database::merge_blocks(uint64_t const card_id, uint64_t const source_position, uint64_t const target_position) const
 {
     exec("call merge_blocks($1, $2, $3)", card_id, source_position, target_position);
@@ -1096,27 +1626,156 @@ std::map<uint64_t, Block> database::split_block(uint64_t const card_id, uint64_t
 {
     std::map<uint64_t, Block> blocks{};
     pqxx::result const result{query("select position, type, extension, metadata, content from split_block($1, $2)", card_id, block_position)};
-    int const rows{result.size()};
+    block_mapper const map_block{result};
 
     for (pqxx::row const& row: result)
     {
-        Block block{};
-        block.set_position(row.at("position").as<uint64_t>());
-        block.set_type(to_content_type(row.at("type").as<std::string>()));
-        block.set_extension(row.at("extension").as<std::string>());
-        block.set_metadata(row.at("metadata").is_null() ? "" : row.at("metadata").as<std::string>());
-        block.set_content(row.at("content").as<std::string>());
-        blocks.insert({block.position(), block});
+        Block block{map_block(row)};
+        uint64_t const position{block.position()};
+        blocks.insert_or_assign(position, std::move(block));
     }
 
     return blocks;
 }
 
+void database::apply_card_edits(uint64_t const card_id, google::protobuf::RepeatedPtrField<CardEdit> const& edits, google::protobuf::RepeatedPtrField<Block>& blocks) const
+{
+    // edits refer to positions left by the ones before them, so they run in order on one transaction and the blocks are read back before it commits
+    auto conn_guard = m_pool->acquire();
+    pqxx::work work{*conn_guard};
+
+    for (CardEdit const& edit: edits)
+    {
+        Block const& block{edit.block()};
+
+        switch (edit.type())
+        {
+        case CardEdit::edit_card:
+            work.exec("call edit_card_headline($1, $2)", pqxx::params{card_id, edit.card().headline()});
+            break;
+        case CardEdit::create_block:
+            if (block.position() > 0)
+            {
+                work.exec("call create_block($1, $2, $3, $4, $5, $6)",
+                          pqxx::params{card_id, content_type_to_string(block.type()), block.extension(), block.content(), block.metadata(), block.position()});
+            }
+            else
+            {
+                work.exec("select create_block($1, $2, $3, $4, $5)", pqxx::params{card_id, content_type_to_string(block.type()), block.extension(), block.content(), block.metadata()});
+            }
+            break;
+        case CardEdit::edit_block:
+        {
+            // like editing a single block, only the fields that differ from the stored block are written
+            pqxx::result const result{work.exec("select type, extension, metadata, content from get_block($1, $2)", pqxx::params{card_id, block.position()})};
+
+            if (result.size() != 1)
+            {
+                throw client_exception("edited block does not exist");
+            }
+
+            pqxx::row const& stored{result.at(0)};
+
+            if (block.type() != to_content_type(stored.at("type").as<std::string>()))
+            {
+                work.exec("call change_block_type($1, $2, $3)", pqxx::params{card_id, block.position(), content_type_to_string(block.type())});
+            }
+
+            if (block.extension() != stored.at("extension").as<std::string>())
+            {
+                work.exec("call edit_block_extension($1, $2, $3)", pqxx::params{card_id, block.position(), block.extension()});
+            }
+
+            if (block.content() != stored.at("content").as<std::string>())
+            {
+                work.exec("call edit_block_content($1, $2, $3)", pqxx::params{card_id, block.position(), block.content()});
+            }
+
+            if (block.metadata() != (stored.at("metadata").is_null() ? "" : stored.at("metadata").as<std::string>()))
+            {
+                work.exec("call edit_block_metadata($1, $2, $3)", pqxx::params{card_id, block.position(), block.metadata()});
+            }
+            break;
+        }
+        case CardEdit::remove_block:
+            work.exec("call remove_block($1, $2)", pqxx::params{card_id, block.position()});
+            break;
+        case CardEdit::merge_blocks:
+            work.exec("call merge_blocks($1, $2, $3)", pqxx::params{card_id, block.position(), edit.target().position()});
+            break;
+        case CardEdit::split_block:
+            work.exec("select position from split_block($1, $2)", pqxx::params{card_id, block.position()});
+            break;
+        default:
+            throw client_exception("unknown card edit");
+        }
+    }
+
+    pqxx::result const result{work.exec("select position, type, extension, metadata, content from get_blocks($1) order by position", pqxx::params{card_id})};
+    work.commit();
+
+    block_mapper const map_block{result};
+    blocks.Reserve(blocks.size() + result.size());
+
+    for (pqxx::row const& row: result)
+    {
+        map_block(row, *blocks.Add());
+    }
+}
+
 void database::move_block(uint64_t const card_id, uint64_t const block_position, uint64_t const target_card_id, uint64_t const target_position) const
 {
     exec("call move_block($1, $2, $3, $4)", card_id, block_position, target_card_id, target_position);
 }
 
+std::vector<BlockSearchResult> database::search_blocks(uint64_t const user_id, std::string_view search_pattern, uint64_t const limit, uint64_t const offset) const
+{
+    std::vector<BlockSearchResult> matched{};
+
+    if (!search_pattern.empty())
+    {
+        // only cards the user reaches through the topics of their roadmaps or the sections of their study resources are searched,
+        // cards outside of both are not found since cards have no owner to reach them by, snippets are highlighted for the requested page alone
+        // the schema keeps no stored tsvector or text index on blocks, so every search parses each reachable block once,
+        // its cost grows with the blocks the user reaches rather than with the matches until such an index exists
+        pqxx::result const result{
+            query("with cards as ("
+                  "select cards.id, cards.state, cards.headline from get_roadmaps($1) as roadmaps "
+                  "cross join lateral get_milestones(roadmaps.id) as milestones "
+                  "cross join lateral get_topics(milestones.id, milestones.level) as topics "
+                  "cross join lateral get_topic_cards(milestones.id, topics.position, topics.level) as cards "
+                  "union "
+                  "select cards.id, cards.state, cards.headline from get_study_resources($1) as resources "
+                  "cross join lateral get_sections(resources.id) as sections "
+                  "cross join lateral get_section_cards(resources.id, sections.position) as cards), "
+                  "matches as ("
+                  "select ts_rank(documents.document, websearch_to_tsquery($2)) as rank, cards.id, cards.state, cards.headline, "
+                  "blocks.position, blocks.type, blocks.extension, blocks.metadata, blocks.content "
+                  "from cards cross join lateral get_blocks(cards.id) as blocks cross join lateral to_tsvector(blocks.content) as documents(document) "
+                  "where documents.document @@ websearch_to_tsquery($2) "
+                  "order by rank desc, cards.id, blocks.position limit $3 offset $4) "
+                  "select id, state, headline, position, type, extension, metadata, content, "
+                  "ts_headline(content, websearch_to_tsquery($2), 'MaxFragments=2, MinWords=5, MaxWords=20') as snippet "
+                  "from matches order by rank desc, id, position",
+                  user_id, search_pattern, limit, offset)
+        };
+        card_mapper const map_card{result};
+        block_mapper const map_block{result};
+        block_snippet_mapper const map_snippet{result};
+        matched.reserve(result.size());
+
+        for (pqxx::row const& row: result)
+        {
+            BlockSearchResult& match{matched.emplace_back()};
+            map_card(row, *match.mutable_card());
+            map_block(row, *match.mutable_block());
+            map_snippet(row, match);
+        }
+    }
+
+    return matched;
+}
+
 Resource database::create_nerve(uint64_t const user_id, std::string resource_name, uint64_t const subject_id) const
 {
     Resource resource{};
@@ -1134,19 +1793,121 @@ Resource database::create_nerve(uint64_t const user_id, std::string resource_nam
 std::vector<Resource> database::get_nerves(uint64_t user_id) const
 {
     std::vector<Resource> resources{};
-    for (pqxx::row const& row: query("select id, name, type, pattern, link from get_nerves($1)", user_id))
+    pqxx::result const result{query("select id, name, type, pattern, link from get_nerves($1)", user_id)};
+    resource_mapper const map_resource{result};
+    resources.reserve(result.size());
+    for (pqxx::row const& row: result)
     {
-        Resource resource{};
-        resource.set_id(row.at("id").as<uint64_t>());
-        resource.set_name(row.at("name").as<std::string>());
-        resource.set_type(to_resource_type(row.at("type").as<std::string>()));
-        resource.set_pattern(to_section_pattern(row.at("pattern").as<std::string>()));
-        resource.set_link(row.at("link").is_null() ? "" : row.at("link").as<std::string>());
-        resources.push_back(resource);
+        map_resource(row, resources.emplace_back());
     }
     return resources;
 }
 
+void database::get_nerves(uint64_t const user_id, google::protobuf::RepeatedPtrField<Nerve>& nerves) const
+{
+    auto conn_guard = m_pool->acquire();
+    pqxx::work work{*conn_guard};
+    read_nerves(work, user_id, nerves);
+    work.commit();
+}
+
+void database::export_subject_cards(uint64_t const subject_id, std::function<bool(Topic const&, Card const&)> const& consume) const
+{
+    Topic topic{};
+    Card card{};
+
+    auto const consume_batch{
+        [&consume, &topic, &card](pqxx::result const& batch) {
+            topic_mapper const map_topic{batch};
+            card_mapper const map_card{batch};
+
+            for (pqxx::row const& row: batch)
+            {
+                map_topic(row, topic);
+                map_card(row, card);
+
+                if (!consume(topic, card))
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    };
+
+    for (expertise_level const level: {expertise_level::surface, expertise_level::depth, expertise_level::origin})
+    {
+        // the bound on topics alone lets earlier topics be skipped before their cards are read
+        if (!fetch(std::array<std::string_view, 2>{"position", "id"}, consume_batch,
+                   "select topics.position, topics.name, topics.level, cards.id, cards.state, cards.headline from get_topics($1, $2) as topics "
+                   "cross join lateral get_topic_cards($1, topics.position, topics.level) as cards "
+                   "where topics.position >= coalesce($3::bigint, 0) and ($3::bigint is null or (topics.position, cards.id) > ($3::bigint, $4::bigint)) "
+                   "order by topics.position, cards.id",
+                   subject_id, level_to_string(level)))
+        {
+            break;
+        }
+    }
+}
+
+void database::export_resource_blocks(uint64_t const resource_id, std::function<bool(Card const&, Block const&)> const& consume) const
+{
+    Card card{};
+    Block block{};
+
+    fetch(
+        std::array<std::string_view, 3>{"section_position", "id", "position"},
+        [&consume, &card, &block](pqxx::result const& batch) {
+            card_mapper const map_card{batch};
+            block_mapper const map_block{batch};
+
+            for (pqxx::row const& row: batch)
+            {
+                map_card(row, card);
+                map_block(row, block);
+
+                if (!consume(card, block))
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        },
+        "select sections.position as section_position, cards.id, cards.state, cards.headline, blocks.position, blocks.type, blocks.extension, blocks.metadata, "
+        "blocks.content from get_sections($1) as sections cross join lateral get_section_cards($1, sections.position) as cards "
+        "cross join lateral get_blocks(cards.id) as blocks "
+        "where sections.position >= coalesce($2::bigint, 0) and ($2::bigint is null or (sections.position, cards.id, blocks.position) > ($2::bigint, $3::bigint, $4::bigint)) "
+        "order by sections.position, cards.id, blocks.position",
+        resource_id);
+}
+
+void database::export_subject_assessments(uint64_t const subject_id, expertise_level const max_level, std::function<bool(Card const&)> const& consume) const
+{
+    Card card{};
+
+    fetch(
+        std::array<std::string_view, 1>{"id"},
+        [&consume, &card](pqxx::result const& batch) {
+            card_mapper const map_card{batch};
+
+            for (pqxx::row const& row: batch)
+            {
+                map_card(row, card);
+
+                if (!consume(card))
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        },
+        "select id, state, headline from get_subject_assessments($1, $2) where $3::bigint is null or id > $3::bigint order by id", subject_id,
+        level_to_string(max_level));
+}
+
 expertise_level database::get_user_cognitive_level(uint64_t const user_id, uint64_t const roadmap_id, uint64_t const subject_id) const
 {
     auto level{expertise_level::surface};
@@ -1181,15 +1942,14 @@ practice_mode database::get_practice_mode(uint64_t const user_id, uint64_t const
 std::vector<Topic> database::get_practice_topics(uint64_t const user_id, uint64_t const roadmap_id, uint64_t const milestone_id, expertise_level const milestone_level) const
 {
     std::vector<Topic> topics{};
-    for (pqxx::result const result{
-             query("select position, name, level from get_practice_topics($1, $2, $3, $4) order by position", user_id, roadmap_id, milestone_id, level_to_string(milestone_level))
-         }; pqxx::row const& row: result)
+    pqxx::result const result{
+        query("select position, name, level from get_practice_topics($1, $2, $3, $4) order by position", user_id, roadmap_id, milestone_id, level_to_string(milestone_level))
+    };
+    topic_mapper const map_topic{result};
+    topics.reserve(result.size());
+    for (pqxx::row const& row: result)
     {
-        Topic topic{};
-        topic.set_position(row.at("position").as<uint64_t>());
-        topic.set_name(row.at("name").as<std::string>());
-        topic.set_level(to_level(row.at("level").as<std::string>()));
-        topics.push_back(topic);
+        map_topic(row, topics.emplace_back());
     }
     return topics;
 }
@@ -1197,37 +1957,67 @@ std::vector<Topic> database::get_practice_topics(uint64_t const user_id, uint64_
 std::vector<Card> database::get_practice_cards(uint64_t const user_id, uint64_t const roadmap_id, uint64_t const subject_id, expertise_level const level,
                                                uint64_t const topic_position) const
 {
-    std::vector<Card> cards{};
-    for (pqxx::result const result{
-             query("select id, state, headline from get_practice_cards($1, $2, $3, $4, $5)", user_id, roadmap_id, subject_id, level_to_string(level), topic_position)
-         }; pqxx::row const& row: result)
+    google::protobuf::RepeatedPtrField<Card> cards{};
+    get_practice_cards(user_id, roadmap_id, subject_id, level, topic_position, cards);
+    return {std::make_move_iterator(cards.begin()), std::make_move_iterator(cards.end())};
+}
+
+void database::get_practice_cards(uint64_t const user_id, uint64_t const roadmap_id, uint64_t const subject_id, expertise_level const level, uint64_t const topic_position,
+                                  google::protobuf::RepeatedPtrField<Card>& cards) const
+{
+    pqxx::result const result{
+        query("select id, state, headline from get_practice_cards($1, $2, $3, $4, $5)",
+              user_id, roadmap_id, subject_id, level_to_string(level), topic_position)
+    };
+    card_mapper const map_card{result};
+    cards.Reserve(cards.size() + result.size());
+    for (pqxx::row const& row: result)
     {
-        Card card{};
-        card.set_id(row.at("id").as<uint64_t>());
-        card.set_state(to_card_state(row.at("state").as<std::string>()));
-        card.set_headline(row.at("headline").as<std::string>());
-        cards.push_back(card);
+        map_card(row, *cards.Add());
     }
-    return cards;
 }
 
 std::vector<Resource> database::get_study_resources(uint64_t const user_id) const
 {
     std::vector<Resource> resources;
-    for (pqxx::row const& row: query("select position, id, name, type, pattern, link from get_study_resources($1) order by position", user_id))
+    pqxx::result const result{query("select position, id, name, type, pattern, link from get_study_resources($1) order by position", user_id)};
+    resource_mapper const map_resource{result};
+    resources.reserve(result.size());
+    for (pqxx::row const& row: result)
     {
-        Resource resource{};
-        auto const position(row.at("position").as<uint64_t>());
-        resource.set_id(row.at("id").as<uint64_t>());
-        resource.set_name(row.at("name").as<std::string>());
-        resource.set_type(to_resource_type(row.at("type").as<std::string>()));
-        resource.set_pattern(to_section_pattern(row.at("pattern").as<std::string>()));
-        resource.set_link(row.at("link").is_null() ? "" : row.at("link").as<std::string>());
-        resources.push_back(resource);
+        map_resource(row, resources.emplace_back());
     }
     return resources;
 }
 
+void database::get_study_resources(uint64_t const user_id, google::protobuf::RepeatedPtrField<StudyResource>& resources) const
+{
+    auto conn_guard = m_pool->acquire();
+    pqxx::work work{*conn_guard};
+    read_study_resources(work, user_id, resources);
+    work.commit();
+}
+
+void database::get_home_bundle(uint64_t const user_id, google::protobuf::RepeatedPtrField<Roadmap>& roadmaps, google::protobuf::RepeatedPtrField<StudyResource>& studies,
+                               google::protobuf::RepeatedPtrField<Nerve>& nerves) const
+{
+    // the whole home screen is read on one connection, so a bundle never holds more than one pooled connection
+    auto conn_guard = m_pool->acquire();
+    pqxx::work work{*conn_guard};
+    pqxx::result const result{work.exec("select id, name from get_roadmaps($1) order by name", pqxx::params{user_id})};
+    roadmap_mapper const map_roadmap{result};
+    roadmaps.Reserve(roadmaps.size() + static_cast<int>(result.size()));
+
+    for (pqxx::row const& row: result)
+    {
+        map_roadmap(row, *roadmaps.Add());
+    }
+
+    read_study_resources(work, user_id, studies);
+    read_nerves(work, user_id, nerves);
+    work.commit();
+}
+
 void database::mark_card_as_reviewed(uint64_t const card_id) const
 {
     exec("call mark_card_as_reviewed($1)", card_id);
@@ -1273,6 +2063,37 @@ void database::study(uint64_t user_id, uint64_t card_id, std::chrono::seconds du
     exec("call study($1, $2, $3)", user_id, card_id, duration.count());
 }
 
+void database::record_progress(std::vector<progress_event> const& events) const
+{
+    // the schema has no bulk entry point for progress, so the calls of a batch are pipelined in one transaction
+    // and share a round trip instead of waiting for each other, progress is stamped when it reaches the database
+    auto conn_guard = m_pool->acquire();
+    pqxx::work work{*conn_guard};
+    pqxx::pipeline pipeline{work};
+
+    for (progress_event const& event: events)
+    {
+        if (event.type == progress_event::kind::practice)
+        {
+            pipeline.insert(std::format("call make_progress({}, {}, {}, {}, {})", work.quote(event.user_id), work.quote(event.milestone_id),
+                                        work.quote(level_to_string(event.milestone_level)), work.quote(event.card_id), work.quote(event.duration)));
+        }
+        else
+        {
+            pipeline.insert(std::format("call study({}, {}, {})", work.quote(event.user_id), work.quote(event.card_id), work.quote(event.duration)));
+        }
+    }
+
+    // a refused call surfaces as its result is retrieved, which aborts the whole batch
+    while (!pipeline.empty())
+    {
+        std::ignore = pipeline.retrieve();
+    }
+
+    pipeline.complete();
+    work.commit();
+}
+
 std::vector<Weight> database::get_progress_weight(uint64_t const user_id) const
 {
     std::vector<Weight> weights;
@@ -1338,6 +2159,41 @@ std::vector<Coverage> database::get_assessment_coverage(uint64_t const subject_i
     return assessment_coverage;
 }
 
+std::vector<TopicCoverage> database::get_subject_coverage(uint64_t const subject_id) const
+{
+    std::vector<TopicCoverage> subject_coverage{};
+    for (expertise_level const level: {expertise_level::surface, expertise_level::depth, expertise_level::origin})
+    {
+        pqxx::result const result{query(
+            "select topics.position, topics.level, topics.name, assessments.id, assessments.state, assessments.headline from get_topics($1, $2) as topics "
+            "left join lateral get_assessment_coverage($1, topics.position, topics.level) as assessments on true where topics.level = $2 order by topics.position",
+            subject_id, level_to_string(level))};
+
+        for (pqxx::row const& row: result)
+        {
+            auto const position{row.at("position").as<uint64_t>()};
+
+            if (subject_coverage.empty() || subject_coverage.back().topic().level() != level || subject_coverage.back().topic().position() != position)
+            {
+                auto topic{std::make_unique<Topic>()};
+                topic->set_position(position);
+                topic->set_level(to_level(row.at("level").as<std::string>()));
+                topic->set_name(row.at("name").as<std::string>());
+                subject_coverage.emplace_back().set_allocated_topic(topic.release());
+            }
+
+            if (!row.at("id").is_null())
+            {
+                Card* assessment{subject_coverage.back().add_assessment()};
+                assessment->set_id(row.at("id").as<uint64_t>());
+                assessment->set_state(to_card_state(row.at("state").as<std::string>()));
+                assessment->set_headline(row.at("headline").as<std::string>());
+            }
+        }
+    }
+    return subject_coverage;
+}
+
 std::map<uint64_t, Assimilation> database::get_assimilation_coverage(uint64_t const user_id, uint64_t subject_id, uint64_t const assessment_id) const
 {
     std::map<uint64_t, Assimilation> assimilation_coverage{};
@@ -1359,16 +2215,15 @@ std::map<uint64_t, Assimilation> database::get_assimilation_coverage(uint64_t co
 std::vector<Card> database::get_topic_assessments(uint64_t const user_id, uint64_t const subject_id, uint64_t const topic_position, expertise_level const max_level) const
 {
     std::vector<Card> cards{};
-    for (pqxx::result const result{
-             query("select id, state, headline, level from get_topic_assessments($1, $2, $3, $4)", user_id, subject_id, topic_position, level_to_string(max_level))
-         }; pqxx::row const& row: result)
+    pqxx::result const result{
+        query("select id, state, headline, level from get_topic_assessments($1, $2, $3, $4)",
+              user_id, subject_id, topic_position, level_to_string(max_level))
+    };
+    card_mapper const map_card{result};
+    cards.reserve(result.size());
+    for (pqxx::row const& row: result)
     {
-        Card card{};
-        auto level(to_level(row.at("level").as<std::string>()));
-        card.set_id(row.at("id").as<uint64_t>());
-        card.set_state(to_card_state(row.at("state").as<std::string>()));
-        card.set_headline(row.at("headline").as<std::string>());
-        cards.push_back(card);
+        map_card(row, cards.emplace_back());
     }
     return cards;
 }
@@ -1376,22 +2231,39 @@ std::vector<Card> database::get_topic_assessments(uint64_t const user_id, uint64
 std::vector<Assessment> database::get_assessments(uint64_t const user_id, uint64_t const subject_id, expertise_level topic_level, uint64_t const topic_position) const
 {
     std::vector<Assessment> assessments{};
-    for (pqxx::row const& row: query("select id, state, headline, assimilations from get_assessments($1, $2, $3, $4)", user_id, subject_id, level_to_string(topic_level),
-                                     topic_position))
+    pqxx::result const result{query("select id, state, headline, assimilations from get_assessments($1, $2, $3, $4)", user_id, subject_id, level_to_string(topic_level),
+                                    topic_position)};
+    card_mapper const map_card{result};
+    assessment_mapper const map_assessment{result};
+    assessments.reserve(result.size());
+    for (pqxx::row const& row: result)
     {
-        Assessment assessment{};
-        auto card{std::make_unique<Card>()};
-        auto const assimilations{row.at("assimilations").as<uint64_t>()};
-        card->set_id(row.at("id").as<uint64_t>());
-        card->set_state(to_card_state(row.at("state").as<std::string>()));
-        card->set_headline(row.at("headline").as<std::string>());
-        assessment.set_allocated_card(card.release());
-        assessment.set_assimilations(assimilations);
-        assessments.push_back(assessment);
+        Assessment& assessment{assessments.emplace_back()};
+        map_card(row, *assessment.mutable_card());
+        map_assessment(row, assessment);
     }
     return assessments;
 }
 
+void database::get_assessments(uint64_t const user_id, uint64_t const subject_id, expertise_level const topic_level, uint64_t const topic_position, uint64_t const after,
+                               uint64_t const limit, google::protobuf::RepeatedPtrField<Assessment>& assessments) const
+{
+    pqxx::result const result{
+        query("select id, state, headline, assimilations from get_assessments($1, $2, $3, $4) with ordinality where ordinality > $5 order by ordinality limit $6",
+              user_id, subject_id, level_to_string(topic_level), topic_position, after, limit)
+    };
+    card_mapper const map_card{result};
+    assessment_mapper const map_assessment{result};
+    assessments.Reserve(assessments.size() + result.size());
+
+    for (pqxx::row const& row: result)
+    {
+        Assessment* assessment{assessments.Add()};
+        map_card(row, *assessment->mutable_card());
+        map_assessment(row, *assessment);
+    }
+}
+
 bool database::is_assimilated(uint64_t user_id, uint64_t subject_id, expertise_level topic_level, uint64_t topic_position) const
 {
     bool assimilated{};
@@ -1407,18 +2279,34 @@ std::vector<Card> database::get_subject_assessments(uint64_t subject_id, experti
 {
     std::vector<Card> cards{};
 
-    for (pqxx::result const result{query("select id, state, headline from get_subject_assessments($1, $2)", subject_id, level_to_string(max_level))}; pqxx::row const& row: result)
+    pqxx::result const result{query("select id, state, headline from get_subject_assessments($1, $2)", subject_id, level_to_string(max_level))};
+    card_mapper const map_card{result};
+    cards.reserve(result.size());
+
+    for (pqxx::row const& row: result)
     {
-        Card card{};
-        card.set_id(row.at("id").as<uint64_t>());
-        card.set_state(to_card_state(row.at("state").as<std::string>()));
-        card.set_headline(row.at("headline").as<std::string>());
-        cards.push_back(card);
+        map_card(row, cards.emplace_back());
     }
 
     return cards;
 }
 
+void database::get_subject_assessments(uint64_t const subject_id, expertise_level const max_level, uint64_t const after, uint64_t const limit,
+                                       google::protobuf::RepeatedPtrField<Card>& cards) const
+{
+    pqxx::result const result{
+        query("select id, state, headline from get_subject_assessments($1, $2) with ordinality where ordinality > $3 order by ordinality limit $4",
+              subject_id, level_to_string(max_level), after, limit)
+    };
+    card_mapper const map_card{result};
+    cards.Reserve(cards.size() + result.size());
+
+    for (pqxx::row const& row: result)
+    {
+        map_card(row, *cards.Add());
+    }
+}
+
 Topic database::get_topic(uint64_t subject_id, expertise_level level, uint64_t position) const
 {
     Topic topic{};
@@ -1491,14 +2379,14 @@ void database::throw_back_progress(uint64_t const user_id, uint64_t const card_i
 
 expertise_level database::to_level(std::string_view const level)
 {
-    expertise_level result{};
+    std::optional<expertise_level> const result{expertise_levels.find(level)};
 
-    if (level == "surface") { result = expertise_level::surface; }
-    else if (level == "depth") { result = expertise_level::depth; }
-    else if (level == "origin") { result = expertise_level::origin; }
-    else { throw std::runtime_error{"invalid expertise level"}; }
+    if (!result)
+    {
+        throw std::runtime_error{"invalid expertise level"};
+    }
 
-    return result;
+    return *result;
 }
 
 std::string database::level_to_string(expertise_level const level)
@@ -1551,20 +2439,14 @@ std::string database::resource_type_to_string(Resource::resource_type const type
 
 Resource::resource_type database::to_resource_type(std::string_view const type_string)
 {
-    Resource::resource_type type{};
+    std::optional<Resource::resource_type> const type{resource_types.find(type_string)};
 
-    if (type_string == "book") { type = Resource::book; }
-    else if (type_string == "website") { type = Resource::website; }
-    else if (type_string == "course") { type = Resource::course; }
-    else if (type_string == "video") { type = Resource::video; }
-    else if (type_string == "channel") { type = Resource::channel; }
-    else if (type_string == "mailing list") { type = Resource::mailing_list; }
-    else if (type_string == "manual") { type = Resource::manual; }
-    else if (type_string == "slides") { type = Resource::slides; }
-    else if (type_string == "nerve") { type = Resource::nerve; }
-    else { throw std::runtime_error(std::format("invalid resource type {}", type_string)); }
+    if (!type)
+    {
+        throw std::runtime_error{std::format("invalid resource type {}", type_string)};
+    }
 
-    return type;
+    return *type;
 }
 
 std::string database::section_pattern_to_string(Resource::section_pattern const pattern)
@@ -1595,33 +2477,26 @@ std::string database::section_pattern_to_string(Resource::section_pattern const
 
 Resource::section_pattern database::to_section_pattern(std::string_view const pattern_string)
 {
-    Resource::section_pattern pattern{};
+    std::optional<Resource::section_pattern> const pattern{section_patterns.find(pattern_string)};
 
-    if (pattern_string == "chapter") { pattern = Resource::chapter; }
-    else if (pattern_string == "page") { pattern = Resource::page; }
-    else if (pattern_string == "session") { pattern = Resource::session; }
-    else if (pattern_string == "episode") { pattern = Resource::episode; }
-    else if (pattern_string == "playlist") { pattern = Resource::playlist; }
-    else if (pattern_string == "post") { pattern = Resource::post; }
-    else if (pattern_string == "synapse") { pattern = Resource::synapse; }
-    else { throw std::runtime_error("invalid section pattern"); }
+    if (!pattern)
+    {
+        throw std::runtime_error{"invalid section pattern"};
+    }
 
-    return pattern;
+    return *pattern;
 }
 
 Card::card_state database::to_card_state(std::string_view const state_string)
 {
-    Card::card_state state{};
+    std::optional<Card::card_state> const state{card_states.find(state_string)};
 
-    if (state_string == "draft") { state = Card::draft; }
-    else if (state_string == "reviewed") { state = Card::reviewed; }
-    else if (state_string == "completed") { state = Card::completed; }
-    else if (state_string == "approved") { state = Card::approved; }
-    else if (state_string == "released") { state = Card::released; }
-    else if (state_string == "rejected") { state = Card::rejected; }
-    else { throw std::runtime_error("invalid card state"); }
+    if (!state)
+    {
+        throw std::runtime_error{"invalid card state"};
+    }
 
-    return state;
+    return *state;
 }
 
 std::string database::card_state_to_string(Card::card_state const state)
@@ -1650,16 +2525,14 @@ std::string database::card_state_to_string(Card::card_state const state)
 
 Block::content_type database::to_content_type(std::string_view const type_string)
 {
-    Block::content_type type{};
+    std::optional<Block::content_type> const type{content_types.find(type_string)};
 
-    if (type_string == "code") { type = Block::code; }
-    else if (type_string == "text") { type = Block::text; }
-    else if (type_string == "image") { type = Block::image; }
-    else if (type_string == "math") { type = Block::math; }
-    else if (type_string == "diagram") { type = Block::diagram; }
-    else { throw std::runtime_error("invalid card state"); }
+    if (!type)
+    {
+        throw std::runtime_error{"invalid content type"};
+    }
 
-    return type;
+    return *type;
 }
 
 std::string database::content_type_to_string(Block::content_type const type)
@@ -1686,14 +2559,14 @@ std::string database::content_type_to_string(Block::content_type const type)
 
 closure_state database::to_closure_state(std::string_view const state_string)
 {
-    closure_state state{};
+    std::optional<closure_state> const state{closure_states.find(state_string)};
 
-    if (state_string == "draft") { state = closure_state::draft; }
-    else if (state_string == "reviewed") { state = closure_state::reviewed; }
-    else if (state_string == "completed") { state = closure_state::completed; }
-    else { throw std::runtime_error("invalid card state"); }
+    if (!state)
+    {
+        throw std::runtime_error{"invalid closure state"};
+    }
 
-    return state;
+    return *state;
 }
 
 std::string database::closure_state_to_string(closure_state const state)
@@ -1716,14 +2589,14 @@ std::string database::closure_state_to_string(closure_state const state)
 
 practice_mode database::to_practice_mode(std::string_view const mode_string)
 {
-    practice_mode mode{};
+    std::optional<practice_mode> const mode{practice_modes.find(mode_string)};
 
-    if (mode_string == "aggressive") { mode = practice_mode::aggressive; }
-    else if (mode_string == "progressive") { mode = practice_mode::progressive; }
-    else if (mode_string == "selective") { mode = practice_mode::selective; }
-    else { throw std::runtime_error{"invalid practice mode"}; }
+    if (!mode)
+    {
+        throw std::runtime_error{"invalid practice mode"};
+    }
 
-    return mode;
+    return *mode;
 }
 
 std::string database::practice_mode_to_string(practice_mode const mode)
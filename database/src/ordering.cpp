@@ -0,0 +1,21 @@
+#include <vector>
+#include <flashback/ordering.hpp>
+
+using namespace flashback;
+
+bool flashback::is_complete_ordering(std::span<uint64_t const> order)
+{
+    std::vector<bool> seen(order.size());
+
+    for (uint64_t const position: order)
+    {
+        if (position == 0 || position > order.size() || seen[position - 1])
+        {
+            return false;
+        }
+
+        seen[position - 1] = true;
+    }
+
+    return true;
+}
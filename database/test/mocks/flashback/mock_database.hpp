@@ -30,18 +30,20 @@ public:
     MOCK_METHOD(std::unique_ptr<User>, get_user, (std::string_view, std::string_view), (const, override));
     MOCK_METHOD(void, revoke_session, (uint64_t, std::string_view), (const, override));
     MOCK_METHOD(void, revoke_sessions_except, (uint64_t, std::string_view), (const, override));
+    MOCK_METHOD(void, delete_account, (uint64_t), (const, override));
 
     // roadmaps
     MOCK_METHOD(Roadmap, create_roadmap, (uint64_t, std::string), (const, override));
     MOCK_METHOD(std::vector<flashback::Roadmap>, get_roadmaps, (uint64_t), (const, override));
     MOCK_METHOD(void, rename_roadmap, (uint64_t, std::string_view), (const, override));
     MOCK_METHOD(void, remove_roadmap, (uint64_t), (const, override));
-    MOCK_METHOD((std::map<uint64_t, flashback::Roadmap>), search_roadmaps, (std::uint64_t, std::string_view), (const, override));
+    MOCK_METHOD(std::vector<Roadmap>, search_roadmaps, (std::uint64_t, std::string_view, uint64_t, uint64_t), (const, override));
     MOCK_METHOD(Roadmap, clone_roadmap, (uint64_t, uint64_t), (const, override));
 
     // subjects
     MOCK_METHOD(Subject, create_subject, (std::string), (const, override));
-    MOCK_METHOD((std::map<uint64_t, Subject>), search_subjects, (std::string_view), (const, override));
+    MOCK_METHOD(std::vector<Subject>, search_subjects, (std::string_view, uint64_t, uint64_t), (const, override));
+    MOCK_METHOD(std::vector<Subject>, get_subjects, (), (const, override));
     MOCK_METHOD(void, rename_subject, (uint64_t, std::string), (const, override));
     MOCK_METHOD(void, remove_subject, (uint64_t), (const, override));
     MOCK_METHOD(void, merge_subjects, (uint64_t, uint64_t), (const, override));
@@ -50,9 +52,12 @@ public:
     MOCK_METHOD(Milestone, add_milestone, (uint64_t, expertise_level, uint64_t), (const, override));
     MOCK_METHOD(Milestone, add_milestone, (uint64_t, expertise_level, uint64_t, uint64_t), (const, override));
     MOCK_METHOD(std::vector<Milestone>, get_milestones, (uint64_t), (const, override));
+    MOCK_METHOD(void, get_milestones, (uint64_t, uint64_t, uint64_t, google::protobuf::RepeatedPtrField<Milestone>&), (const, override));
     MOCK_METHOD(void, add_requirement, (uint64_t, Milestone, Milestone), (const, override));
     MOCK_METHOD(std::vector<Milestone>, get_requirements, (uint64_t, uint64_t, expertise_level), (const, override));
+    MOCK_METHOD(std::vector<Requirement>, get_roadmap_requirements, (uint64_t), (const, override));
     MOCK_METHOD(void, reorder_milestone, (uint64_t, uint64_t, uint64_t), (const, override));
+    MOCK_METHOD(void, apply_milestone_ordering, (uint64_t, std::vector<uint64_t> const&), (const, override));
     MOCK_METHOD(void, remove_milestone, (uint64_t, uint64_t), (const, override));
     MOCK_METHOD(void, change_milestone_level, (uint64_t, uint64_t, expertise_level), (const, override));
 
@@ -60,9 +65,10 @@ public:
     MOCK_METHOD(Resource, create_resource, (Resource const&), (const, override));
     MOCK_METHOD(void, add_resource_to_subject, (uint64_t, uint64_t), (const, override));
     MOCK_METHOD(std::vector<Resource>, get_resources, (uint64_t, uint64_t), (const, override));
+    MOCK_METHOD(std::vector<Resource>, get_resources, (), (const, override));
     MOCK_METHOD(Resource, get_resource, (uint64_t), (const, override));
     MOCK_METHOD(void, drop_resource_from_subject, (uint64_t, uint64_t), (const, override));
-    MOCK_METHOD((std::map<uint64_t, Resource>), search_resources, (std::string_view), (const, override));
+    MOCK_METHOD(std::vector<Resource>, search_resources, (std::string_view, uint64_t, uint64_t), (const, override));
     MOCK_METHOD(void, edit_resource_link, (uint64_t, std::string), (const, override));
     MOCK_METHOD(void, change_resource_type, (uint64_t, Resource::resource_type), (const, override));
     MOCK_METHOD(void, change_section_pattern, (uint64_t, Resource::section_pattern const pattern), (const, override));
@@ -73,20 +79,24 @@ public:
 
     // providers
     MOCK_METHOD(std::vector<Provider>, get_providers, (std::uint64_t), (const, override));
+    MOCK_METHOD(std::vector<Provider>, get_providers, (), (const, override));
+    MOCK_METHOD(void, get_providers, (std::uint64_t, google::protobuf::RepeatedPtrField<Provider>&), (const, override));
     MOCK_METHOD(Provider, create_provider, (std::string), (const, override));
     MOCK_METHOD(void, add_provider, (uint64_t, uint64_t), (const, override));
     MOCK_METHOD(void, drop_provider, (uint64_t, uint64_t), (const, override));
-    MOCK_METHOD((std::map<uint64_t, Provider>), search_providers, (std::string_view), (const, override));
+    MOCK_METHOD(std::vector<Provider>, search_providers, (std::string_view, uint64_t, uint64_t), (const, override));
     MOCK_METHOD(void, rename_provider, (uint64_t, std::string), (const, override));
     MOCK_METHOD(void, remove_provider, (uint64_t), (const, override));
     MOCK_METHOD(void, merge_providers, (uint64_t, uint64_t), (const, override));
 
     // presenters
     MOCK_METHOD(std::vector<Presenter>, get_presenters, (std::uint64_t), (const, override));
+    MOCK_METHOD(std::vector<Presenter>, get_presenters, (), (const, override));
+    MOCK_METHOD(void, get_presenters, (std::uint64_t, google::protobuf::RepeatedPtrField<Presenter>&), (const, override));
     MOCK_METHOD(Presenter, create_presenter, (std::string), (const, override));
     MOCK_METHOD(void, add_presenter, (uint64_t, uint64_t), (const, override));
     MOCK_METHOD(void, drop_presenter, (uint64_t, uint64_t), (const, override));
-    MOCK_METHOD((std::map<uint64_t, Presenter>), search_presenters, (std::string_view), (const, override));
+    MOCK_METHOD(std::vector<Presenter>, search_presenters, (std::string_view, uint64_t, uint64_t), (const, override));
     MOCK_METHOD(void, rename_presenter, (uint64_t, std::string), (const, override));
     MOCK_METHOD(void, remove_presenter, (uint64_t), (const, override));
     MOCK_METHOD(void, merge_presenters, (uint64_t, uint64_t), (const, override));
@@ -94,27 +104,38 @@ public:
     // nerves
     MOCK_METHOD(Resource, create_nerve, (uint64_t, std::string, uint64_t), (const, override));
     MOCK_METHOD(std::vector<Resource>, get_nerves, (uint64_t), (const, override));
+    MOCK_METHOD(void, get_nerves, (uint64_t, google::protobuf::RepeatedPtrField<Nerve>&), (const, override));
+
+    // exports
+    MOCK_METHOD(void, export_subject_cards, (uint64_t, (std::function<bool(Topic const&, Card const&)> const&)), (const, override));
+    MOCK_METHOD(void, export_resource_blocks, (uint64_t, (std::function<bool(Card const&, Block const&)> const&)), (const, override));
+    MOCK_METHOD(void, export_subject_assessments, (uint64_t, expertise_level, std::function<bool(Card const&)> const&), (const, override));
 
     // sections
     MOCK_METHOD(Section, create_section, (uint64_t, uint64_t, std::string, std::string), (const, override));
     MOCK_METHOD((std::map<uint64_t, Section>), get_sections, (uint64_t), (const, override));
+    MOCK_METHOD(void, get_sections, (uint64_t, google::protobuf::RepeatedPtrField<Section>&), (const, override));
+    MOCK_METHOD(void, get_sections, (uint64_t, uint64_t, uint64_t, google::protobuf::RepeatedPtrField<Section>&), (const, override));
     MOCK_METHOD(void, remove_section, (uint64_t, uint64_t), (const, override));
     MOCK_METHOD(void, reorder_section, (uint64_t, uint64_t, uint64_t), (const, override));
+    MOCK_METHOD(void, apply_section_ordering, (uint64_t, std::vector<uint64_t> const&), (const, override));
     MOCK_METHOD(void, merge_sections, (uint64_t, uint64_t, uint64_t), (const, override));
     MOCK_METHOD(void, rename_section, (uint64_t, uint64_t, std::string), (const, override));
     MOCK_METHOD(void, move_section, (uint64_t, uint64_t, uint64_t, uint64_t), (const, override));
-    MOCK_METHOD((std::map<uint64_t, Section>), search_sections, (uint64_t, std::string_view), (const, override));
+    MOCK_METHOD(std::vector<Section>, search_sections, (uint64_t, std::string_view, uint64_t, uint64_t), (const, override));
     MOCK_METHOD(void, edit_section_link, (uint64_t, uint64_t, std::string), (const, override));
 
     // topics
     MOCK_METHOD(Topic, create_topic, (uint64_t, std::string, flashback::expertise_level, uint64_t), (const, override));
     MOCK_METHOD((std::map<uint64_t, Topic>), get_topics, (uint64_t, flashback::expertise_level), (const, override));
+    MOCK_METHOD(void, get_topics, (uint64_t, flashback::expertise_level, uint64_t, uint64_t, google::protobuf::RepeatedPtrField<Topic>&), (const, override));
     MOCK_METHOD(void, reorder_topic, (uint64_t, flashback::expertise_level, uint64_t, uint64_t), (const, override));
+    MOCK_METHOD(void, apply_topic_ordering, (uint64_t, expertise_level, std::vector<uint64_t> const&), (const, override));
     MOCK_METHOD(void, remove_topic, (uint64_t, flashback::expertise_level, uint64_t), (const, override));
     MOCK_METHOD(void, merge_topics, (uint64_t, flashback::expertise_level, uint64_t, uint64_t), (const, override));
     MOCK_METHOD(void, rename_topic, (uint64_t, flashback::expertise_level, uint64_t, std::string), (const, override));
     MOCK_METHOD(void, move_topic, (uint64_t, flashback::expertise_level, uint64_t, uint64_t, expertise_level, uint64_t), (const, override));
-    MOCK_METHOD((std::map<uint64_t, Topic>), search_topics, (uint64_t, flashback::expertise_level, std::string_view), (const, override));
+    MOCK_METHOD(std::vector<Topic>, search_topics, (uint64_t, flashback::expertise_level, std::string_view, uint64_t, uint64_t), (const, override));
     MOCK_METHOD(void, change_topic_level, (uint64_t, uint64_t, flashback::expertise_level, flashback::expertise_level), (const, override));
 
     // cards
@@ -124,24 +145,32 @@ public:
     MOCK_METHOD(void, edit_card_headline, (uint64_t, std::string), (const, override));
     MOCK_METHOD(void, remove_card, (uint64_t), (const, override));
     MOCK_METHOD(void, merge_cards, (uint64_t, uint64_t, std::string), (const, override));
-    MOCK_METHOD((std::map<uint64_t, flashback::Card>), search_cards, (uint64_t, flashback::expertise_level, std::string_view), (const, override));
+    MOCK_METHOD(std::vector<Card>, search_cards, (uint64_t, flashback::expertise_level, std::string_view, uint64_t, uint64_t, std::stop_token), (const, override));
     MOCK_METHOD(void, move_card_to_section, (uint64_t, uint64_t, uint64_t, uint64_t, uint64_t), (const, override));
     MOCK_METHOD(void, move_card_to_topic, (uint64_t, uint64_t, uint64_t, flashback::expertise_level, uint64_t, uint64_t, flashback::expertise_level), (const, override));
     MOCK_METHOD(std::vector<SectionCard>, get_section_cards, (uint64_t, uint64_t), (const, override));
+    MOCK_METHOD(void, get_section_cards, (uint64_t, uint64_t, uint64_t, uint64_t, google::protobuf::RepeatedPtrField<SectionCard>&), (const, override));
     MOCK_METHOD(std::vector<Card>, get_topic_cards, (uint64_t, uint64_t, flashback::expertise_level), (const, override));
+    MOCK_METHOD(void, get_topic_cards, (uint64_t, uint64_t, flashback::expertise_level, google::protobuf::RepeatedPtrField<Card>&), (const, override));
+    MOCK_METHOD(void, get_topic_cards, (uint64_t, uint64_t, flashback::expertise_level, uint64_t, uint64_t, google::protobuf::RepeatedPtrField<Card>&), (const, override));
 
     // blocks
     MOCK_METHOD(flashback::Block, create_block, (uint64_t, flashback::Block), (const, override));
     MOCK_METHOD((std::map<uint64_t, flashback::Block>), get_blocks, (uint64_t), (const, override));
+    MOCK_METHOD(void, get_blocks, (uint64_t, google::protobuf::RepeatedPtrField<flashback::Block>&), (const, override));
+    MOCK_METHOD(void, get_blocks, (std::vector<flashback::Card*> const&), (const, override));
     MOCK_METHOD(void, remove_block, (uint64_t, uint64_t), (const, override));
     MOCK_METHOD(void, edit_block_content, (uint64_t, uint64_t, std::string), (const, override));
     MOCK_METHOD(void, change_block_type, (uint64_t, uint64_t, flashback::Block::content_type), (const, override));
     MOCK_METHOD(void, edit_block_extension, (uint64_t, uint64_t, std::string), (const, override));
     MOCK_METHOD(void, edit_block_metadata, (uint64_t, uint64_t, std::string), (const, override));
     MOCK_METHOD(void, reorder_block, (uint64_t, uint64_t, uint64_t), (const, override));
+    MOCK_METHOD(void, apply_block_ordering, (uint64_t, std::vector<uint64_t> const&), (const, override));
     MOCK_METHOD(void, merge_blocks, (uint64_t, uint64_t, uint64_t), (const, override));
     MOCK_METHOD((std::map<uint64_t, flashback::Block>), split_block, (uint64_t, uint64_t), (const, override));
+    MOCK_METHOD(void, apply_card_edits, (uint64_t, google::protobuf::RepeatedPtrField<flashback::CardEdit> const&, google::protobuf::RepeatedPtrField<flashback::Block>&), (const, override));
     MOCK_METHOD(void, move_block, (uint64_t, uint64_t, uint64_t, uint64_t), (const, override));
+    MOCK_METHOD(std::vector<BlockSearchResult>, search_blocks, (uint64_t, std::string_view, uint64_t, uint64_t), (const, override));
 
     // practices
     MOCK_METHOD(void, make_progress, (uint64_t, uint64_t, expertise_level, uint64_t, uint64_t), (const, override));
@@ -149,8 +178,13 @@ public:
     MOCK_METHOD(practice_mode, get_practice_mode, (uint64_t, uint64_t, expertise_level), (const, override));
     MOCK_METHOD(std::vector<Topic>, get_practice_topics, (uint64_t, uint64_t, uint64_t, expertise_level), (const, override));
     MOCK_METHOD(std::vector<Card>, get_practice_cards, (uint64_t, uint64_t, uint64_t, expertise_level, uint64_t), (const, override));
+    MOCK_METHOD(void, get_practice_cards, (uint64_t, uint64_t, uint64_t, expertise_level, uint64_t, google::protobuf::RepeatedPtrField<Card>&), (const, override));
     MOCK_METHOD(void, study, (uint64_t, uint64_t, std::chrono::seconds), (const, override));
-    MOCK_METHOD((std::map<uint64_t, Resource>), get_study_resources, (uint64_t), (const, override));
+    MOCK_METHOD(void, record_progress, (std::vector<progress_event> const&), (const, override));
+    MOCK_METHOD(std::vector<Resource>, get_study_resources, (uint64_t), (const, override));
+    MOCK_METHOD(void, get_study_resources, (uint64_t, google::protobuf::RepeatedPtrField<StudyResource>&), (const, override));
+    MOCK_METHOD(void, get_home_bundle, (uint64_t, google::protobuf::RepeatedPtrField<Roadmap>&, google::protobuf::RepeatedPtrField<StudyResource>&,
+                                        google::protobuf::RepeatedPtrField<Nerve>&), (const, override));
     MOCK_METHOD(void, mark_card_as_reviewed, (uint64_t), (const, override));
     MOCK_METHOD(void, mark_card_as_completed, (uint64_t), (const, override));
     MOCK_METHOD(void, mark_section_as_reviewed, (uint64_t, uint64_t), (const, override));
@@ -166,12 +200,15 @@ public:
     MOCK_METHOD(void, create_assessment, (uint64_t, expertise_level, uint64_t, uint64_t), (const, override));
     MOCK_METHOD(std::vector<Topic>, get_topic_coverage, (uint64_t, uint64_t), (const, override));
     MOCK_METHOD((std::vector<Coverage>), get_assessment_coverage, (uint64_t, uint64_t, expertise_level), (const, override));
+    MOCK_METHOD((std::vector<TopicCoverage>), get_subject_coverage, (uint64_t), (const, override));
     MOCK_METHOD((std::map<uint64_t, Assimilation>), get_assimilation_coverage, (uint64_t, uint64_t, uint64_t), (const, override));
     MOCK_METHOD(std::vector<Card>, get_topic_assessments, (uint64_t, uint64_t, uint64_t, expertise_level), (const, override));
     MOCK_METHOD(std::vector<Assessment>, get_assessments, (uint64_t, uint64_t, expertise_level, uint64_t), (const, override));
+    MOCK_METHOD(void, get_assessments, (uint64_t, uint64_t, expertise_level, uint64_t, uint64_t, uint64_t, google::protobuf::RepeatedPtrField<Assessment>&), (const, override));
     MOCK_METHOD(void, expand_assessment, (uint64_t, uint64_t, expertise_level, uint64_t), (const, override));
     MOCK_METHOD(void, diminish_assessment, (uint64_t, uint64_t, expertise_level, uint64_t), (const, override));
     MOCK_METHOD(bool, is_assimilated, (uint64_t, uint64_t, expertise_level, uint64_t), (const, override));
     MOCK_METHOD(std::vector<Card>, get_subject_assessments, (uint64_t, expertise_level), (const, override));
+    MOCK_METHOD(void, get_subject_assessments, (uint64_t, expertise_level, uint64_t, uint64_t, google::protobuf::RepeatedPtrField<Card>&), (const, override));
 };
 } // flashback
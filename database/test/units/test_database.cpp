@@ -111,6 +111,12 @@ protected:
         m_database->throw_back_progress(user_id, card_id, days.count());
     }
 
+    template <std::size_t Keys, typename Consumer, typename... Args>
+    bool fetch(std::array<std::string_view, Keys> const& key_columns, Consumer&& consume, std::string_view const format, Args const&... args) const
+    {
+        return m_database->fetch(key_columns, std::forward<Consumer>(consume), format, args...);
+    }
+
     std::unique_ptr<pqxx::connection> m_connection{nullptr};
     std::shared_ptr<flashback::database> m_database{nullptr};
     std::unique_ptr<flashback::User> m_user{nullptr};
@@ -385,7 +391,7 @@ TEST_F(test_database, SearchRoadmaps)
     };
     uint64_t user_id{};
     EXPECT_NO_THROW(user_id = m_database->create_user(m_user->name(), "sample@flashback.eu.com", m_user->hash()));
-    std::map<uint64_t, flashback::Roadmap> search_results;
+    std::vector<flashback::Roadmap> search_results;
 
     for (std::string const& roadmap_name: names)
     {
@@ -394,10 +400,10 @@ TEST_F(test_database, SearchRoadmaps)
         ASSERT_NO_THROW(roadmap = m_database->create_roadmap(user_id, roadmap_name));
     }
 
-    EXPECT_NO_THROW(search_results = m_database->search_roadmaps(m_user->id(), "Management"));
+    EXPECT_NO_THROW(search_results = m_database->search_roadmaps(m_user->id(), "Management", 10, 0));
     EXPECT_THAT(search_results, testing::SizeIs(testing::Ge(3)));
 
-    EXPECT_NO_THROW(search_results = m_database->search_roadmaps(m_user->id(), "Prompt Engineering"));
+    EXPECT_NO_THROW(search_results = m_database->search_roadmaps(m_user->id(), "Prompt Engineering", 10, 0));
     EXPECT_THAT(search_results, testing::IsEmpty()) << "Should not exist!";
 }
 
@@ -427,7 +433,7 @@ TEST_F(test_database, SearchSubjects)
     std::string const irrelevant_subject{"Linux Administration"};
     std::string const name_pattern{"lus"};
     flashback::Subject subject{};
-    std::map<uint64_t, flashback::Subject> matches{};
+    std::vector<flashback::Subject> matches{};
 
     ASSERT_NO_THROW(subject = m_database->create_subject(irrelevant_subject));
     ASSERT_EQ(subject.name(), irrelevant_subject) << "Subject sample 1 should be created before performing search";
@@ -437,13 +443,13 @@ TEST_F(test_database, SearchSubjects)
     ASSERT_THAT(subject.name(), Eq(subject_name));
     ASSERT_THAT(subject.id(), Gt(0));
 
-    EXPECT_NO_THROW(matches = m_database->search_subjects(name_pattern));
+    EXPECT_NO_THROW(matches = m_database->search_subjects(name_pattern, 10, 0));
     EXPECT_EQ(matches.size(), 1) << "Only one of the two existing objects should be similar";
-    EXPECT_NO_THROW(matches.at(1)) << "The first and only match should be in the first position";
-    EXPECT_THAT(matches.at(1).id(), Eq(subject.id()));
-    EXPECT_THAT(matches.at(1).name(), Eq(subject.name()));
+    EXPECT_NO_THROW(matches.at(0)) << "The first and only match should be in the first position";
+    EXPECT_THAT(matches.at(0).id(), Eq(subject.id()));
+    EXPECT_THAT(matches.at(0).name(), Eq(subject.name()));
 
-    EXPECT_NO_THROW(matches = m_database->search_subjects(""));
+    EXPECT_NO_THROW(matches = m_database->search_subjects("", 10, 0));
     EXPECT_TRUE(matches.empty()) << "Searching empty name should not have any results";
 }
 
@@ -452,8 +458,8 @@ TEST_F(test_database, RenameSubject)
     std::string const initial_name{"Container"};
     std::string const modified_name{"Docker"};
     std::string const irrelevant_name{"Linux"};
-    std::map<uint64_t, flashback::Subject> matches{};
-    constexpr uint64_t expected_position{1};
+    std::vector<flashback::Subject> matches{};
+    constexpr uint64_t expected_position{0};
     flashback::Subject subject{};
 
     ASSERT_NO_THROW(subject = m_database->create_subject(irrelevant_name));
@@ -464,15 +470,15 @@ TEST_F(test_database, RenameSubject)
     ASSERT_THAT(subject.name(), Eq(initial_name));
     ASSERT_THAT(subject.id(), Gt(0));
 
-    ASSERT_NO_THROW(matches = m_database->search_subjects(initial_name));
+    ASSERT_NO_THROW(matches = m_database->search_subjects(initial_name, 10, 0));
     ASSERT_EQ(matches.size(), 1) << "Irrelevant subject should not be visible in search results, there must be only one matching subject";
-    ASSERT_NO_THROW(matches = m_database->search_subjects(modified_name));
+    ASSERT_NO_THROW(matches = m_database->search_subjects(modified_name, 10, 0));
     ASSERT_EQ(matches.size(), 0) << "Modified name should not appear before actually modifying";
 
     EXPECT_NO_THROW(m_database->rename_subject(subject.id(), modified_name));
-    EXPECT_NO_THROW(matches = m_database->search_subjects(initial_name));
+    EXPECT_NO_THROW(matches = m_database->search_subjects(initial_name, 10, 0));
     EXPECT_EQ(matches.size(), 0) << "Previous name of the subject should not appear";
-    EXPECT_NO_THROW(matches = m_database->search_subjects(modified_name));
+    EXPECT_NO_THROW(matches = m_database->search_subjects(modified_name, 10, 0));
     ASSERT_EQ(matches.size(), 1) << "New name of the subject should be the only match";
     ASSERT_NO_THROW(matches.at(expected_position));
     EXPECT_THAT(matches.at(expected_position).name(), Eq(modified_name));
@@ -627,6 +633,36 @@ TEST_F(test_database, GetRequirements)
     EXPECT_THAT(requirements.at(0).id(), Eq(required_milestone.id()));
 }
 
+TEST_F(test_database, GetRoadmapRequirements)
+{
+    flashback::Roadmap roadmap{};
+    flashback::Subject dependent_subject{};
+    flashback::Subject required_subject{};
+    flashback::Milestone dependent_milestone{};
+    flashback::Milestone required_milestone{};
+    std::vector<flashback::Requirement> requirements{};
+    roadmap.set_name("Embedded Linux Engineer");
+    dependent_subject.set_name("Yocto Project");
+    required_subject.set_name("Buildroot");
+    dependent_milestone.set_level(flashback::expertise_level::depth);
+    required_milestone.set_level(flashback::expertise_level::surface);
+
+    ASSERT_NO_THROW(roadmap = m_database->create_roadmap(m_user->id(), roadmap.name()));
+    ASSERT_THAT(roadmap.id(), Gt(0));
+    EXPECT_NO_THROW(requirements = m_database->get_roadmap_requirements(roadmap.id()));
+    EXPECT_THAT(requirements.size(), Eq(0));
+    ASSERT_NO_THROW(dependent_subject = m_database->create_subject(dependent_subject.name()));
+    ASSERT_NO_THROW(required_subject = m_database->create_subject(required_subject.name()));
+    ASSERT_NO_THROW(dependent_milestone = m_database->add_milestone(dependent_subject.id(), dependent_milestone.level(), roadmap.id()));
+    ASSERT_NO_THROW(required_milestone = m_database->add_milestone(required_subject.id(), required_milestone.level(), roadmap.id()));
+    ASSERT_NO_THROW(m_database->add_requirement(roadmap.id(), dependent_milestone, required_milestone));
+    EXPECT_NO_THROW(requirements = m_database->get_roadmap_requirements(roadmap.id()));
+    ASSERT_THAT(requirements.size(), Eq(1));
+    EXPECT_THAT(requirements.at(0).milestone_id(), Eq(dependent_milestone.id()));
+    EXPECT_THAT(requirements.at(0).required_milestone().id(), Eq(required_milestone.id()));
+    EXPECT_THAT(requirements.at(0).required_milestone().position(), Eq(required_milestone.position()));
+}
+
 TEST_F(test_database, CloneRoadmap)
 {
     flashback::Roadmap roadmap{};
@@ -781,7 +817,7 @@ TEST_F(test_database, remove_subject)
     using testing::SizeIs;
 
     std::vector<flashback::Subject> subjects{};
-    std::map<uint64_t, flashback::Subject> matched_subjects{};
+    std::vector<flashback::Subject> matched_subjects{};
 
     for (std::string const& name: {"Calculus", "Linear Algebra", "Graph Theory"})
     {
@@ -793,10 +829,10 @@ TEST_F(test_database, remove_subject)
     flashback::Subject const subject = subjects.at(0);
     ASSERT_THAT(subject.id(), Gt(0));
     ASSERT_FALSE(subject.name().empty());
-    EXPECT_NO_THROW(matched_subjects = m_database->search_subjects(subject.name()));
+    EXPECT_NO_THROW(matched_subjects = m_database->search_subjects(subject.name(), 10, 0));
     EXPECT_THAT(matched_subjects, SizeIs(1)) << "Subject should appear in the search result before being removed";
     EXPECT_NO_THROW(m_database->remove_subject(subject.id()));
-    EXPECT_NO_THROW(matched_subjects = m_database->search_subjects(subject.name()));
+    EXPECT_NO_THROW(matched_subjects = m_database->search_subjects(subject.name(), 10, 0));
     EXPECT_THAT(matched_subjects, SizeIs(0)) << "There should be no search results for the subject that was removed earlier";
 }
 
@@ -806,22 +842,22 @@ TEST_F(test_database, merge_subjects)
 
     flashback::Subject source_subject{};
     flashback::Subject target_subject{};
-    std::map<uint64_t, flashback::Subject> matched_subjects{};
+    std::vector<flashback::Subject> matched_subjects{};
     source_subject.set_name("Basic Mathematics");
     target_subject.set_name("Calculus");
 
     ASSERT_NO_THROW(source_subject = m_database->create_subject(source_subject.name()));
     ASSERT_NO_THROW(target_subject = m_database->create_subject(target_subject.name()));
-    EXPECT_NO_THROW(matched_subjects = m_database->search_subjects(source_subject.name()));
+    EXPECT_NO_THROW(matched_subjects = m_database->search_subjects(source_subject.name(), 10, 0));
     ASSERT_THAT(matched_subjects, SizeIs(1));
-    ASSERT_NO_THROW(matched_subjects.at(1));
-    EXPECT_THAT(matched_subjects.at(1).id(), source_subject.id());
-    EXPECT_THAT(matched_subjects.at(1).name(), source_subject.name());
-    ASSERT_NO_THROW(matched_subjects = m_database->search_subjects(target_subject.name()));
+    ASSERT_NO_THROW(matched_subjects.at(0));
+    EXPECT_THAT(matched_subjects.at(0).id(), source_subject.id());
+    EXPECT_THAT(matched_subjects.at(0).name(), source_subject.name());
+    ASSERT_NO_THROW(matched_subjects = m_database->search_subjects(target_subject.name(), 10, 0));
     ASSERT_THAT(matched_subjects, SizeIs(1));
-    ASSERT_NO_THROW(matched_subjects.at(1));
-    EXPECT_THAT(matched_subjects.at(1).id(), target_subject.id());
-    EXPECT_THAT(matched_subjects.at(1).name(), target_subject.name());
+    ASSERT_NO_THROW(matched_subjects.at(0));
+    EXPECT_THAT(matched_subjects.at(0).id(), target_subject.id());
+    EXPECT_THAT(matched_subjects.at(0).name(), target_subject.name());
     EXPECT_NO_THROW(m_database->merge_subjects(source_subject.id(), target_subject.id()));
 }
 
@@ -966,7 +1002,7 @@ TEST_F(test_database, search_resources)
     auto const now{std::chrono::system_clock::now().time_since_epoch()};
     auto const later{std::chrono::system_clock::time_point(std::chrono::system_clock::now() + std::chrono::years{3}).time_since_epoch()};
     std::vector<flashback::Resource> resources{};
-    std::map<uint64_t, flashback::Resource> matched_resources{};
+    std::vector<flashback::Resource> matched_resources{};
     flashback::Subject subject{};
     subject.set_name("CMake");
 
@@ -988,9 +1024,9 @@ TEST_F(test_database, search_resources)
 
     EXPECT_NO_THROW(resources = m_database->get_resources(m_user->id(), subject.id()));
     EXPECT_THAT(resources, SizeIs(7));
-    EXPECT_NO_THROW(matched_resources = m_database->search_resources(search_pattern));
+    EXPECT_NO_THROW(matched_resources = m_database->search_resources(search_pattern, 10, 0));
     EXPECT_THAT(matched_resources, SizeIs(6));
-    EXPECT_NO_THROW(matched_resources = m_database->search_resources(irrelevant_name));
+    EXPECT_NO_THROW(matched_resources = m_database->search_resources(irrelevant_name, 10, 0));
     EXPECT_THAT(matched_resources, SizeIs(1));
 }
 
@@ -1322,7 +1358,7 @@ TEST_F(test_database, search_providers)
     using testing::IsEmpty;
 
     std::vector<flashback::Provider> existing_providers{};
-    std::map<uint64_t, flashback::Provider> matched_providers{};
+    std::vector<flashback::Provider> matched_providers{};
 
     for (auto const& name: {"John Doe", "Jane Doe", "Brian Salehi"})
     {
@@ -1335,16 +1371,39 @@ TEST_F(test_database, search_providers)
     }
 
     EXPECT_THAT(existing_providers, SizeIs(3));
-    EXPECT_NO_THROW(matched_providers = m_database->search_providers("Doe"));
+    EXPECT_NO_THROW(matched_providers = m_database->search_providers("Doe", 10, 0));
     EXPECT_THAT(matched_providers, SizeIs(2));
-    ASSERT_NO_THROW(matched_providers.at(1).id());
+    ASSERT_NO_THROW(matched_providers.at(0).id());
+    EXPECT_THAT(matched_providers.at(0).name(), Ne("Brian Salehi"));
     EXPECT_THAT(matched_providers.at(1).name(), Ne("Brian Salehi"));
-    EXPECT_THAT(matched_providers.at(2).name(), Ne("Brian Salehi"));
 
-    EXPECT_NO_THROW(matched_providers = m_database->search_providers(""));
+    EXPECT_NO_THROW(matched_providers = m_database->search_providers("", 10, 0));
     EXPECT_THAT(matched_providers, IsEmpty());
 }
 
+TEST_F(test_database, get_all_providers)
+{
+    using testing::SizeIs;
+    using testing::Contains;
+    using testing::Property;
+
+    std::vector<flashback::Provider> providers{};
+
+    EXPECT_NO_THROW(providers = m_database->get_providers());
+    EXPECT_THAT(providers, SizeIs(0));
+
+    for (auto const& name: {"John Doe", "Jane Doe", "Brian Salehi"})
+    {
+        flashback::Provider provider{};
+        ASSERT_NO_THROW(provider = m_database->create_provider(name));
+        ASSERT_THAT(provider.id(), Gt(0));
+    }
+
+    EXPECT_NO_THROW(providers = m_database->get_providers());
+    EXPECT_THAT(providers, SizeIs(3)) << "Every provider should be listed to build the search index";
+    EXPECT_THAT(providers, Contains(Property(&flashback::Provider::name, Eq("Brian Salehi"))));
+}
+
 TEST_F(test_database, rename_provider)
 {
     using testing::SizeIs;
@@ -1352,7 +1411,7 @@ TEST_F(test_database, rename_provider)
 
     constexpr auto modified_name{"Brian Salehi"};
     std::vector<flashback::Provider> existing_providers{};
-    std::map<uint64_t, flashback::Provider> matched_providers{};
+    std::vector<flashback::Provider> matched_providers{};
     flashback::Provider provider{};
     provider.set_name("John Doe");
     ASSERT_NO_THROW(provider = m_database->create_provider(provider.name()));
@@ -1360,9 +1419,9 @@ TEST_F(test_database, rename_provider)
     ASSERT_THAT(provider.name(), Ne(modified_name));
 
     EXPECT_NO_THROW(m_database->rename_provider(provider.id(), modified_name));
-    EXPECT_NO_THROW(matched_providers = m_database->search_providers("Doe"));
+    EXPECT_NO_THROW(matched_providers = m_database->search_providers("Doe", 10, 0));
     EXPECT_THAT(matched_providers, IsEmpty());
-    EXPECT_NO_THROW(matched_providers = m_database->search_providers("Brian"));
+    EXPECT_NO_THROW(matched_providers = m_database->search_providers("Brian", 10, 0));
     EXPECT_THAT(matched_providers, SizeIs(1));
 }
 
@@ -1371,7 +1430,7 @@ TEST_F(test_database, remove_provider)
     using testing::SizeIs;
     using testing::IsEmpty;
 
-    std::map<uint64_t, flashback::Provider> matched_providers{};
+    std::vector<flashback::Provider> matched_providers{};
 
     for (auto const& name: {"John Doe", "Jane Doe", "Brian Salehi"})
     {
@@ -1382,10 +1441,10 @@ TEST_F(test_database, remove_provider)
         ASSERT_THAT(provider.name(), Eq(name));
     }
 
-    EXPECT_NO_THROW(matched_providers = m_database->search_providers("Doe"));
+    EXPECT_NO_THROW(matched_providers = m_database->search_providers("Doe", 10, 0));
     EXPECT_THAT(matched_providers, SizeIs(2));
-    EXPECT_NO_THROW(m_database->remove_provider(matched_providers.at(1).id()));
-    EXPECT_NO_THROW(matched_providers = m_database->search_providers("Doe"));
+    EXPECT_NO_THROW(m_database->remove_provider(matched_providers.at(0).id()));
+    EXPECT_NO_THROW(matched_providers = m_database->search_providers("Doe", 10, 0));
     EXPECT_THAT(matched_providers, SizeIs(1));
 }
 
@@ -1394,7 +1453,7 @@ TEST_F(test_database, merge_providers)
     using testing::SizeIs;
     using testing::IsEmpty;
 
-    std::map<uint64_t, flashback::Provider> matched_providers{};
+    std::vector<flashback::Provider> matched_providers{};
 
     for (auto const& name: {"John Doe", "Jane Doe"})
     {
@@ -1405,12 +1464,12 @@ TEST_F(test_database, merge_providers)
         ASSERT_THAT(provider.name(), Eq(name));
     }
 
-    ASSERT_NO_THROW(matched_providers = m_database->search_providers("Doe"));
+    ASSERT_NO_THROW(matched_providers = m_database->search_providers("Doe", 10, 0));
     ASSERT_THAT(matched_providers, SizeIs(2));
+    ASSERT_NO_THROW(matched_providers.at(0).id());
     ASSERT_NO_THROW(matched_providers.at(1).id());
-    ASSERT_NO_THROW(matched_providers.at(2).id());
-    EXPECT_NO_THROW(m_database->merge_providers(matched_providers.at(1).id(), matched_providers.at(2).id()));
-    EXPECT_NO_THROW(matched_providers = m_database->search_providers("Doe"));
+    EXPECT_NO_THROW(m_database->merge_providers(matched_providers.at(0).id(), matched_providers.at(1).id()));
+    EXPECT_NO_THROW(matched_providers = m_database->search_providers("Doe", 10, 0));
     EXPECT_THAT(matched_providers, SizeIs(1));
 }
 
@@ -1420,7 +1479,7 @@ TEST_F(test_database, search_presenters)
     using testing::IsEmpty;
 
     std::vector<flashback::Presenter> existing_presenters{};
-    std::map<uint64_t, flashback::Presenter> matched_presenters{};
+    std::vector<flashback::Presenter> matched_presenters{};
 
     for (auto const& name: {"John Doe", "Jane Doe", "Brian Salehi"})
     {
@@ -1433,13 +1492,13 @@ TEST_F(test_database, search_presenters)
     }
 
     EXPECT_THAT(existing_presenters, SizeIs(3));
-    EXPECT_NO_THROW(matched_presenters = m_database->search_presenters("Doe"));
+    EXPECT_NO_THROW(matched_presenters = m_database->search_presenters("Doe", 10, 0));
     EXPECT_THAT(matched_presenters, SizeIs(2));
-    ASSERT_NO_THROW(matched_presenters.at(1).id());
+    ASSERT_NO_THROW(matched_presenters.at(0).id());
+    EXPECT_THAT(matched_presenters.at(0).name(), Ne("Brian Salehi"));
     EXPECT_THAT(matched_presenters.at(1).name(), Ne("Brian Salehi"));
-    EXPECT_THAT(matched_presenters.at(2).name(), Ne("Brian Salehi"));
 
-    EXPECT_NO_THROW(matched_presenters = m_database->search_presenters(""));
+    EXPECT_NO_THROW(matched_presenters = m_database->search_presenters("", 10, 0));
     EXPECT_THAT(matched_presenters, IsEmpty());
 }
 
@@ -1450,7 +1509,7 @@ TEST_F(test_database, rename_presenter)
 
     constexpr auto modified_name{"Brian Salehi"};
     std::vector<flashback::Presenter> existing_presenters{};
-    std::map<uint64_t, flashback::Presenter> matched_presenters{};
+    std::vector<flashback::Presenter> matched_presenters{};
     flashback::Presenter presenter{};
     presenter.set_name("John Doe");
     ASSERT_NO_THROW(presenter = m_database->create_presenter(presenter.name()));
@@ -1458,9 +1517,9 @@ TEST_F(test_database, rename_presenter)
     ASSERT_THAT(presenter.name(), Ne(modified_name));
 
     EXPECT_NO_THROW(m_database->rename_presenter(presenter.id(), modified_name));
-    EXPECT_NO_THROW(matched_presenters = m_database->search_presenters("Doe"));
+    EXPECT_NO_THROW(matched_presenters = m_database->search_presenters("Doe", 10, 0));
     EXPECT_THAT(matched_presenters, IsEmpty());
-    EXPECT_NO_THROW(matched_presenters = m_database->search_presenters("Brian"));
+    EXPECT_NO_THROW(matched_presenters = m_database->search_presenters("Brian", 10, 0));
     EXPECT_THAT(matched_presenters, SizeIs(1));
 }
 
@@ -1469,7 +1528,7 @@ TEST_F(test_database, remove_presenter)
     using testing::SizeIs;
     using testing::IsEmpty;
 
-    std::map<uint64_t, flashback::Presenter> matched_presenters{};
+    std::vector<flashback::Presenter> matched_presenters{};
 
     for (auto const& name: {"John Doe", "Jane Doe", "Brian Salehi"})
     {
@@ -1480,10 +1539,10 @@ TEST_F(test_database, remove_presenter)
         ASSERT_THAT(presenter.name(), Eq(name));
     }
 
-    EXPECT_NO_THROW(matched_presenters = m_database->search_presenters("Doe"));
+    EXPECT_NO_THROW(matched_presenters = m_database->search_presenters("Doe", 10, 0));
     EXPECT_THAT(matched_presenters, SizeIs(2));
-    EXPECT_NO_THROW(m_database->remove_presenter(matched_presenters.at(1).id()));
-    EXPECT_NO_THROW(matched_presenters = m_database->search_presenters("Doe"));
+    EXPECT_NO_THROW(m_database->remove_presenter(matched_presenters.at(0).id()));
+    EXPECT_NO_THROW(matched_presenters = m_database->search_presenters("Doe", 10, 0));
     EXPECT_THAT(matched_presenters, SizeIs(1));
 }
 
@@ -1492,7 +1551,7 @@ TEST_F(test_database, merge_presenters)
     using testing::SizeIs;
     using testing::IsEmpty;
 
-    std::map<uint64_t, flashback::Presenter> matched_presenters{};
+    std::vector<flashback::Presenter> matched_presenters{};
 
     for (auto const& name: {"John Doe", "Jane Doe"})
     {
@@ -1503,12 +1562,12 @@ TEST_F(test_database, merge_presenters)
         ASSERT_THAT(presenter.name(), Eq(name));
     }
 
-    ASSERT_NO_THROW(matched_presenters = m_database->search_presenters("Doe"));
+    ASSERT_NO_THROW(matched_presenters = m_database->search_presenters("Doe", 10, 0));
     ASSERT_THAT(matched_presenters, SizeIs(2));
+    ASSERT_NO_THROW(matched_presenters.at(0).id());
     ASSERT_NO_THROW(matched_presenters.at(1).id());
-    ASSERT_NO_THROW(matched_presenters.at(2).id());
-    EXPECT_NO_THROW(m_database->merge_presenters(matched_presenters.at(1).id(), matched_presenters.at(2).id()));
-    EXPECT_NO_THROW(matched_presenters = m_database->search_presenters("Doe"));
+    EXPECT_NO_THROW(m_database->merge_presenters(matched_presenters.at(0).id(), matched_presenters.at(1).id()));
+    EXPECT_NO_THROW(matched_presenters = m_database->search_presenters("Doe", 10, 0));
     EXPECT_THAT(matched_presenters, SizeIs(1));
 }
 
@@ -1558,6 +1617,60 @@ TEST_F(test_database, get_nerves)
     EXPECT_TRUE(resources.at(0).link().empty());
 }
 
+TEST_F(test_database, get_home_bundle)
+{
+    flashback::Roadmap roadmap{};
+    flashback::Subject subject{};
+    flashback::Milestone milestone{};
+    flashback::Topic topic{};
+    flashback::Resource resource{};
+    flashback::Resource nerve{};
+    flashback::Provider provider{};
+    flashback::Presenter presenter{};
+    flashback::Section section{};
+    flashback::Card card{};
+    google::protobuf::RepeatedPtrField<flashback::Roadmap> roadmaps{};
+    google::protobuf::RepeatedPtrField<flashback::StudyResource> studies{};
+    google::protobuf::RepeatedPtrField<flashback::Nerve> nerves{};
+    resource.set_name("C++ Book");
+    resource.set_type(flashback::Resource::book);
+    resource.set_pattern(flashback::Resource::chapter);
+    topic.set_name("Reflection");
+    topic.set_level(flashback::expertise_level::surface);
+    card.set_headline("Have you considered using Flashback?");
+
+    ASSERT_NO_THROW(roadmap = m_database->create_roadmap(m_user->id(), "C++ Software Engineer"));
+    ASSERT_NO_THROW(subject = m_database->create_subject("C++"));
+    ASSERT_NO_THROW(milestone = m_database->add_milestone(subject.id(), flashback::expertise_level::surface, roadmap.id()));
+    ASSERT_NO_THROW(topic = m_database->create_topic(subject.id(), topic.name(), topic.level(), 0));
+    ASSERT_NO_THROW(resource = m_database->create_resource(resource));
+    ASSERT_NO_THROW(m_database->add_resource_to_subject(resource.id(), subject.id()));
+    ASSERT_NO_THROW(provider = m_database->create_provider("Flashback Publications"));
+    ASSERT_NO_THROW(m_database->add_provider(resource.id(), provider.id()));
+    ASSERT_NO_THROW(presenter = m_database->create_presenter("Brian Salehi"));
+    ASSERT_NO_THROW(m_database->add_presenter(resource.id(), presenter.id()));
+    ASSERT_NO_THROW(nerve = m_database->create_nerve(m_user->id(), "Personal Knowledge", subject.id()));
+    ASSERT_NO_THROW(section = m_database->create_section(resource.id(), 0, "Chapter 1", ""));
+    ASSERT_NO_THROW(card = m_database->create_card(card));
+    ASSERT_NO_THROW(m_database->add_card_to_section(card.id(), resource.id(), section.position()));
+    ASSERT_NO_THROW(m_database->add_card_to_topic(card.id(), subject.id(), topic.position(), topic.level()));
+    ASSERT_NO_THROW(m_database->study(m_user->id(), card.id(), std::chrono::seconds{10}));
+
+    EXPECT_NO_THROW(m_database->get_home_bundle(m_user->id(), roadmaps, studies, nerves));
+    ASSERT_THAT(roadmaps, SizeIs(1));
+    EXPECT_THAT(roadmaps.at(0).id(), Eq(roadmap.id()));
+    ASSERT_THAT(studies, SizeIs(1));
+    EXPECT_THAT(studies.at(0).resource().id(), Eq(resource.id()));
+    ASSERT_THAT(studies.at(0).resource().providers(), SizeIs(1)) << "Providers should come with the studied resource";
+    EXPECT_THAT(studies.at(0).resource().providers(0).id(), Eq(provider.id()));
+    ASSERT_THAT(studies.at(0).resource().presenters(), SizeIs(1)) << "Presenters should come with the studied resource";
+    EXPECT_THAT(studies.at(0).resource().presenters(0).id(), Eq(presenter.id()));
+    EXPECT_THAT(studies.at(0).milestone().id(), Eq(subject.id())) << "The milestone related to the studied resource should be attached";
+    ASSERT_THAT(nerves, SizeIs(1));
+    EXPECT_THAT(nerves.at(0).resource().id(), Eq(nerve.id()));
+    EXPECT_THAT(nerves.at(0).resource().providers(), IsEmpty());
+}
+
 TEST_F(test_database, create_section)
 {
     using testing::SizeIs;
@@ -1613,6 +1726,40 @@ TEST_F(test_database, get_sections)
     EXPECT_THAT(sections, SizeIs(3));
 }
 
+TEST_F(test_database, get_sections_page)
+{
+    using testing::SizeIs;
+
+    google::protobuf::RepeatedPtrField<flashback::Section> sections{};
+    flashback::Section section{};
+    flashback::Resource resource{};
+    resource.set_name("C++");
+    resource.set_type(flashback::Resource::book);
+    resource.set_pattern(flashback::Resource::chapter);
+    resource.clear_link();
+
+    ASSERT_NO_THROW(resource = m_database->create_resource(resource));
+    ASSERT_THAT(resource.id(), Gt(0));
+
+    for (std::string const& name: {"Chapter 1", "Chapter 2", "Chapter 3"})
+    {
+        section.set_name(name);
+        section.clear_position();
+        section.clear_link();
+        ASSERT_NO_THROW(section = m_database->create_section(resource.id(), section.position(), section.name(), section.link()));
+        ASSERT_THAT(section.position(), Gt(0));
+    }
+
+    EXPECT_NO_THROW(m_database->get_sections(resource.id(), 0, 2, sections));
+    ASSERT_THAT(sections, SizeIs(2));
+    EXPECT_THAT(sections.at(0).position(), Eq(1));
+    EXPECT_THAT(sections.at(1).position(), Eq(2));
+
+    EXPECT_NO_THROW(m_database->get_sections(resource.id(), sections.at(1).position(), 2, sections));
+    ASSERT_THAT(sections, SizeIs(3)) << "Pages should be appended to the sink";
+    EXPECT_THAT(sections.at(2).name(), Eq("Chapter 3"));
+}
+
 TEST_F(test_database, remove_section)
 {
     using testing::SizeIs;
@@ -1821,6 +1968,7 @@ TEST_F(test_database, search_sections)
     using testing::SizeIs;
 
     std::map<uint64_t, flashback::Section> sections{};
+    std::vector<flashback::Section> matched_sections{};
     flashback::Section section{};
     flashback::Resource resource{};
     resource.set_name("C++");
@@ -1843,10 +1991,14 @@ TEST_F(test_database, search_sections)
 
     EXPECT_NO_THROW(sections = m_database->get_sections(resource.id()));
     ASSERT_THAT(sections, SizeIs(3));
-    EXPECT_NO_THROW(sections = m_database->search_sections(resource.id(), "chapter"));
-    ASSERT_THAT(sections, SizeIs(3));
-    EXPECT_NO_THROW(sections = m_database->search_sections(resource.id(), "1"));
-    ASSERT_THAT(sections, SizeIs(1));
+    EXPECT_NO_THROW(matched_sections = m_database->search_sections(resource.id(), "chapter", 10, 0));
+    ASSERT_THAT(matched_sections, SizeIs(3));
+    EXPECT_NO_THROW(matched_sections = m_database->search_sections(resource.id(), "1", 10, 0));
+    ASSERT_THAT(matched_sections, SizeIs(1));
+    EXPECT_NO_THROW(matched_sections = m_database->search_sections(resource.id(), "chapter", 2, 0));
+    ASSERT_THAT(matched_sections, SizeIs(2));
+    EXPECT_NO_THROW(matched_sections = m_database->search_sections(resource.id(), "chapter", 2, 2));
+    ASSERT_THAT(matched_sections, SizeIs(1));
 }
 
 TEST_F(test_database, edit_section_link)
@@ -2134,7 +2286,7 @@ TEST_F(test_database, search_topics)
 
     flashback::Subject subject{};
     flashback::Topic topic{};
-    std::map<uint64_t, flashback::Topic> topics{};
+    std::vector<flashback::Topic> topics{};
     constexpr auto topic_name{"C++"};
     constexpr auto level{flashback::expertise_level::surface};
     constexpr auto search_pattern{"chrono"};
@@ -2152,7 +2304,7 @@ TEST_F(test_database, search_topics)
         ASSERT_THAT(topic.position(), Gt(0));
     }
 
-    EXPECT_NO_THROW(topics = m_database->search_topics(subject.id(), level, search_pattern));
+    EXPECT_NO_THROW(topics = m_database->search_topics(subject.id(), level, search_pattern, 10, 0));
     EXPECT_THAT(topics, SizeIs(1));
 }
 
@@ -2621,13 +2773,13 @@ TEST_F(test_database, search_cards)
     ASSERT_THAT(topic_cards, testing::SizeIs(3));
     ASSERT_NO_THROW(section_cards = m_database->get_section_cards(resource.id(), section.position()));
     ASSERT_THAT(section_cards, testing::SizeIs(3));
-    std::map<uint64_t, flashback::Card> matched_cards{};
-    EXPECT_NO_THROW(matched_cards = m_database->search_cards(subject.id(), topic.level(), "flashback"));
+    std::vector<flashback::Card> matched_cards{};
+    EXPECT_NO_THROW(matched_cards = m_database->search_cards(subject.id(), topic.level(), "flashback", 10, 0, {}));
     EXPECT_THAT(matched_cards, testing::SizeIs(2));
-    EXPECT_NO_THROW(matched_cards = m_database->search_cards(subject.id(), topic.level(), "goals"));
+    EXPECT_NO_THROW(matched_cards = m_database->search_cards(subject.id(), topic.level(), "goals", 10, 0, {}));
     EXPECT_THAT(matched_cards, testing::SizeIs(1));
-    ASSERT_NO_THROW(matched_cards.at(1).id());
-    EXPECT_THAT(matched_cards.at(1).id(), Eq(third_card.id()));
+    ASSERT_NO_THROW(matched_cards.at(0).id());
+    EXPECT_THAT(matched_cards.at(0).id(), Eq(third_card.id()));
 }
 
 TEST_F(test_database, move_card_to_section)
@@ -3056,6 +3208,13 @@ TEST_F(test_database, get_blocks)
     EXPECT_THAT(blocks, testing::SizeIs(2));
     EXPECT_NO_THROW(blocks = m_database->get_blocks(third_card.id()));
     EXPECT_THAT(blocks, testing::IsEmpty());
+    std::vector<flashback::Card*> const cards{&first_card, &second_card, &third_card};
+    EXPECT_NO_THROW(m_database->get_blocks(cards));
+    EXPECT_THAT(first_card.blocks(), testing::SizeIs(3));
+    EXPECT_THAT(second_card.blocks(), testing::SizeIs(2));
+    EXPECT_THAT(third_card.blocks(), testing::IsEmpty());
+    ASSERT_THAT(second_card.blocks(), testing::Not(testing::IsEmpty()));
+    EXPECT_THAT(second_card.blocks(0).content(), Eq(fourth_block.content()));
 }
 
 TEST_F(test_database, remove_block)
@@ -3901,6 +4060,33 @@ TEST_F(test_database, reorder_block)
     EXPECT_THAT(blocks.at(3).type(), Eq(first_block.type()));
 }
 
+TEST_F(test_database, apply_block_ordering)
+{
+    flashback::Card card{};
+    card.set_state(flashback::Card::draft);
+    card.set_headline("Have you considered using Flashback?");
+    ASSERT_NO_THROW(card = m_database->create_card(card));
+
+    for (std::string const content: {"first", "second", "third"})
+    {
+        flashback::Block block{};
+        block.set_type(flashback::Block::text);
+        block.set_extension("txt");
+        block.set_content(content);
+        ASSERT_NO_THROW(block = m_database->create_block(card.id(), block));
+    }
+
+    EXPECT_THROW(m_database->apply_block_ordering(card.id(), {2, 1}), flashback::client_exception) << "Orderings missing an entry should be refused";
+    ASSERT_NO_THROW(m_database->apply_block_ordering(card.id(), {3, 1, 2}));
+
+    std::map<uint64_t, flashback::Block> blocks{};
+    ASSERT_NO_THROW(blocks = m_database->get_blocks(card.id()));
+    ASSERT_THAT(blocks, testing::SizeIs(3));
+    EXPECT_THAT(blocks.at(1).content(), Eq("third"));
+    EXPECT_THAT(blocks.at(2).content(), Eq("first"));
+    EXPECT_THAT(blocks.at(3).content(), Eq("second"));
+}
+
 TEST_F(test_database, merge_blocks)
 {
     flashback::Resource resource{};
@@ -4213,6 +4399,82 @@ TEST_F(test_database, split_block)
     ASSERT_THAT(blocks, IsEmpty()) << "Blocks of other cards should be left untouched";
 }
 
+TEST_F(test_database, apply_card_edits)
+{
+    flashback::Card card{};
+    flashback::Block first_block{};
+    flashback::Block second_block{};
+    google::protobuf::RepeatedPtrField<flashback::CardEdit> edits{};
+    google::protobuf::RepeatedPtrField<flashback::Block> edited_blocks{};
+    std::map<uint64_t, flashback::Block> blocks{};
+    card.set_state(flashback::Card::draft);
+    card.set_headline("Have you considered using Flashback?");
+    first_block.set_type(flashback::Block::code);
+    first_block.set_extension("cpp");
+    first_block.set_metadata("/path/to/file");
+    first_block.set_content("auto main() -> int { }");
+    second_block.set_type(flashback::Block::text);
+    second_block.set_extension("txt");
+    second_block.set_metadata("hint");
+    second_block.set_content("This will compile.");
+
+    ASSERT_NO_THROW(card = m_database->create_card(card));
+    ASSERT_THAT(card.id(), Gt(0));
+    ASSERT_NO_THROW(first_block = m_database->create_block(card.id(), first_block));
+    ASSERT_NO_THROW(second_block = m_database->create_block(card.id(), second_block));
+    ASSERT_THAT(first_block.position(), Eq(1));
+    ASSERT_THAT(second_block.position(), Eq(2));
+
+    // each edit addresses the positions left by the edits before it
+    flashback::CardEdit* headline{edits.Add()};
+    headline->set_type(flashback::CardEdit::edit_card);
+    headline->mutable_card()->set_headline("Haven't you started using Flashback yet?");
+    flashback::CardEdit* creation{edits.Add()};
+    creation->set_type(flashback::CardEdit::create_block);
+    creation->mutable_block()->set_type(flashback::Block::text);
+    creation->mutable_block()->set_extension("txt");
+    creation->mutable_block()->set_content("This does not do anything.\n\n\nIt returns zero.");
+    flashback::CardEdit* split{edits.Add()};
+    split->set_type(flashback::CardEdit::split_block);
+    split->mutable_block()->set_position(3);
+    flashback::CardEdit* merge{edits.Add()};
+    merge->set_type(flashback::CardEdit::merge_blocks);
+    merge->mutable_block()->set_position(1);
+    merge->mutable_target()->set_position(4);
+    flashback::CardEdit* content{edits.Add()};
+    content->set_type(flashback::CardEdit::edit_block);
+    *content->mutable_block() = second_block;
+    content->mutable_block()->set_position(1);
+    content->mutable_block()->set_content("This will compile and run.");
+
+    EXPECT_NO_THROW(m_database->apply_card_edits(card.id(), edits, edited_blocks));
+    ASSERT_THAT(edited_blocks, SizeIs(3)) << "Split adds one block and merge removes one";
+    EXPECT_THAT(edited_blocks.at(0).position(), Eq(1));
+    EXPECT_THAT(edited_blocks.at(0).content(), Eq("This will compile and run."));
+    EXPECT_THAT(edited_blocks.at(0).metadata(), Eq(second_block.metadata())) << "Fields left as they were should be kept";
+    EXPECT_THAT(edited_blocks.at(1).position(), Eq(2));
+    EXPECT_THAT(edited_blocks.at(1).content(), Eq("This does not do anything."));
+    EXPECT_THAT(edited_blocks.at(2).position(), Eq(3));
+    EXPECT_THAT(edited_blocks.at(2).content(), Eq(first_block.content() + "\n\n" + "It returns zero."));
+    EXPECT_THAT(m_database->get_card(card.id()).headline(), Eq(headline->card().headline()));
+    ASSERT_NO_THROW(blocks = m_database->get_blocks(card.id()));
+    EXPECT_THAT(blocks, SizeIs(3)) << "Blocks read back should match the committed card";
+
+    edits.Clear();
+    edited_blocks.Clear();
+    flashback::CardEdit* removal{edits.Add()};
+    removal->set_type(flashback::CardEdit::remove_block);
+    removal->mutable_block()->set_position(1);
+    flashback::CardEdit* missing{edits.Add()};
+    missing->set_type(flashback::CardEdit::edit_block);
+    *missing->mutable_block() = second_block;
+    missing->mutable_block()->set_position(9);
+
+    EXPECT_THROW(m_database->apply_card_edits(card.id(), edits, edited_blocks), flashback::client_exception);
+    ASSERT_NO_THROW(blocks = m_database->get_blocks(card.id()));
+    EXPECT_THAT(blocks, SizeIs(3)) << "A failing edit should roll back the whole batch";
+}
+
 TEST_F(test_database, move_block)
 {
     flashback::Resource resource{};
@@ -4388,6 +4650,66 @@ TEST_F(test_database, move_block)
     EXPECT_THAT(blocks.at(4).content(), Eq(first_block.content()));
 }
 
+TEST_F(test_database, search_blocks)
+{
+    using testing::SizeIs;
+    using testing::IsEmpty;
+    using testing::Not;
+
+    flashback::Card card{};
+    flashback::Block first_block{};
+    flashback::Block second_block{};
+    std::vector<flashback::BlockSearchResult> matches{};
+    card.clear_id();
+    card.set_state(flashback::Card::draft);
+    card.set_headline("How does Rust prevent data races?");
+    first_block.set_type(flashback::Block::text);
+    first_block.set_content("The borrow checker enforces ownership so that mutable references are never aliased.");
+    second_block.set_type(flashback::Block::code);
+    second_block.set_extension("rs");
+    second_block.set_content("let reference = &mut ownership_sample;");
+
+    ASSERT_NO_THROW(card = m_database->create_card(card));
+    ASSERT_THAT(card.id(), Gt(0));
+    ASSERT_NO_THROW(first_block = m_database->create_block(card.id(), first_block));
+    ASSERT_NO_THROW(second_block = m_database->create_block(card.id(), second_block));
+
+    EXPECT_NO_THROW(matches = m_database->search_blocks(m_user->id(), "borrow checker", 10, 0));
+    EXPECT_THAT(matches, IsEmpty()) << "Cards outside the roadmaps and resources of the user should not be searched";
+
+    flashback::Roadmap roadmap{};
+    flashback::Subject subject{};
+    flashback::Milestone milestone{};
+    flashback::Topic topic{};
+    uint64_t other_user_id{};
+    ASSERT_NO_THROW(roadmap = m_database->create_roadmap(m_user->id(), "Systems Programming"));
+    ASSERT_NO_THROW(subject = m_database->create_subject("Rust"));
+    ASSERT_NO_THROW(milestone = m_database->add_milestone(subject.id(), flashback::expertise_level::surface, roadmap.id()));
+    ASSERT_NO_THROW(topic = m_database->create_topic(subject.id(), "Ownership", flashback::expertise_level::surface, 0));
+    ASSERT_NO_THROW(m_database->add_card_to_topic(card.id(), subject.id(), topic.position(), topic.level()));
+
+    EXPECT_NO_THROW(matches = m_database->search_blocks(m_user->id(), "borrow checker", 10, 0));
+    ASSERT_THAT(matches, SizeIs(1));
+    EXPECT_THAT(matches.at(0).card().id(), Eq(card.id()));
+    EXPECT_THAT(matches.at(0).card().headline(), Eq(card.headline()));
+    EXPECT_THAT(matches.at(0).block().position(), Eq(first_block.position()));
+    EXPECT_THAT(matches.at(0).snippet(), Not(IsEmpty())) << "Matches should come with a highlighted snippet of the block content";
+
+    ASSERT_NO_THROW(other_user_id = m_database->create_user(m_user->name(), "another@flashback.eu.com", m_user->hash()));
+    EXPECT_NO_THROW(matches = m_database->search_blocks(other_user_id, "borrow checker", 10, 0));
+    EXPECT_THAT(matches, IsEmpty()) << "Cards of another user's roadmaps should not be visible";
+
+    EXPECT_NO_THROW(matches = m_database->search_blocks(m_user->id(), "lifetimes", 10, 0));
+    EXPECT_THAT(matches, IsEmpty());
+    EXPECT_NO_THROW(m_database->edit_block_content(card.id(), second_block.position(), "fn longest<'a>(x: &'a str) -> &'a str; // lifetimes"));
+    EXPECT_NO_THROW(matches = m_database->search_blocks(m_user->id(), "lifetimes", 10, 0));
+    ASSERT_THAT(matches, SizeIs(1)) << "Edited content should be searchable right away";
+    EXPECT_THAT(matches.at(0).block().position(), Eq(second_block.position()));
+
+    EXPECT_NO_THROW(matches = m_database->search_blocks(m_user->id(), "", 10, 0));
+    EXPECT_THAT(matches, IsEmpty());
+}
+
 TEST_F(test_database, make_progress)
 {
     auto constexpr roadmap_name{"C++ Software Engineer"};
@@ -5202,6 +5524,33 @@ TEST_F(test_database, study)
     EXPECT_NO_THROW(m_database->study(m_user->id(), card.id(), std::chrono::seconds{20}));
 }
 
+TEST_F(test_database, record_progress)
+{
+    auto constexpr level{flashback::expertise_level::surface};
+    flashback::Roadmap roadmap{};
+    flashback::Subject subject{};
+    flashback::Milestone milestone{};
+    flashback::Topic topic{};
+    flashback::Card card{};
+    std::vector<flashback::progress_event> events{};
+    card.set_headline("Is this recorded in a batch?");
+
+    ASSERT_NO_THROW(roadmap = m_database->create_roadmap(m_user->id(), "C++ Software Engineer"));
+    ASSERT_NO_THROW(subject = m_database->create_subject("C++"));
+    ASSERT_NO_THROW(milestone = m_database->add_milestone(subject.id(), level, roadmap.id()));
+    ASSERT_NO_THROW(topic = m_database->create_topic(subject.id(), "Coroutines", level, 0));
+    ASSERT_NO_THROW(card = m_database->create_card(card));
+    ASSERT_THAT(card.id(), Gt(0));
+    ASSERT_NO_THROW(m_database->add_card_to_topic(card.id(), subject.id(), topic.position(), topic.level()));
+
+    events.push_back(flashback::progress_event{flashback::progress_event::kind::study, m_user->id(), card.id(), 0, level, 20, 0});
+    events.push_back(flashback::progress_event{flashback::progress_event::kind::practice, m_user->id(), card.id(), milestone.id(), level, 10, 0});
+    events.push_back(flashback::progress_event{flashback::progress_event::kind::practice, m_user->id(), card.id(), milestone.id(), level, 15, 0});
+    events.push_back(flashback::progress_event{flashback::progress_event::kind::practice, m_user->id(), card.id(), milestone.id(), level, 25, 1700000000});
+    EXPECT_NO_THROW(m_database->record_progress(events)) << "Events submitted long after they happened should be accepted by the existing procedures";
+    EXPECT_NO_THROW(m_database->record_progress({}));
+}
+
 TEST_F(test_database, get_study_resources)
 {
     flashback::Roadmap roadmap{};
@@ -5219,7 +5568,7 @@ TEST_F(test_database, get_study_resources)
     flashback::Card third_card{};
     flashback::practice_mode mode{};
     std::vector<flashback::Resource> resources{};
-    std::map<uint64_t, flashback::Resource> studying_resources{};
+    std::vector<flashback::Resource> studying_resources{};
 
     roadmap.set_name("C++ Software Engineer");
     subject.set_name("C++");
@@ -5287,21 +5636,21 @@ TEST_F(test_database, get_study_resources)
     ASSERT_NO_THROW(m_database->study(m_user->id(), first_card.id(), std::chrono::seconds{10}));
     EXPECT_NO_THROW(studying_resources = m_database->get_study_resources(m_user->id()));
     EXPECT_THAT(studying_resources, SizeIs(1)) << "One card was studied so there should be one resource in the studied resources list";
-    ASSERT_NO_THROW(studying_resources.at(1).id());
-    EXPECT_THAT(studying_resources.at(1).id(), Eq(first_resource.id())) << "First resource was explicitly marked as studied and should be in the studied resources";
+    ASSERT_NO_THROW(studying_resources.at(0).id());
+    EXPECT_THAT(studying_resources.at(0).id(), Eq(first_resource.id())) << "First resource was explicitly marked as studied and should be in the studied resources";
     ASSERT_NO_THROW(m_database->study(m_user->id(), second_card.id(), std::chrono::seconds{10}));
     EXPECT_NO_THROW(studying_resources = m_database->get_study_resources(m_user->id()));
     EXPECT_THAT(studying_resources, SizeIs(2));
-    ASSERT_NO_THROW(studying_resources.at(1).id());
-    EXPECT_THAT(studying_resources.at(1).id(), Eq(second_resource.id())) << "Second resource was studied more recently, so it should appear as first studied resource";
-    EXPECT_THAT(studying_resources.at(2).id(), Eq(first_resource.id())) << "First resource was studied before the last, so it should appear as the second studied resource";
+    ASSERT_NO_THROW(studying_resources.at(0).id());
+    EXPECT_THAT(studying_resources.at(0).id(), Eq(second_resource.id())) << "Second resource was studied more recently, so it should appear as first studied resource";
+    EXPECT_THAT(studying_resources.at(1).id(), Eq(first_resource.id())) << "First resource was studied before the last, so it should appear as the second studied resource";
     ASSERT_NO_THROW(m_database->study(m_user->id(), third_card.id(), std::chrono::seconds{10}));
     EXPECT_NO_THROW(studying_resources = m_database->get_study_resources(m_user->id()));
     EXPECT_THAT(studying_resources, SizeIs(3)) << "Even if the resource is a nerve that belongs to the user it should appear as a studying resource";
-    ASSERT_NO_THROW(studying_resources.at(1).id());
-    EXPECT_THAT(studying_resources.at(1).id(), Eq(third_resource.id())) << "Third resource was studied more recently, so it should appear as first studied resource";
-    EXPECT_THAT(studying_resources.at(2).id(), Eq(second_resource.id())) << "Second resource was studied before the last, so it should appear as the second studied resource";
-    EXPECT_THAT(studying_resources.at(3).id(), Eq(first_resource.id())) << "First resource was studied first, so it should appear as the last studied resource";
+    ASSERT_NO_THROW(studying_resources.at(0).id());
+    EXPECT_THAT(studying_resources.at(0).id(), Eq(third_resource.id())) << "Third resource was studied more recently, so it should appear as first studied resource";
+    EXPECT_THAT(studying_resources.at(1).id(), Eq(second_resource.id())) << "Second resource was studied before the last, so it should appear as the second studied resource";
+    EXPECT_THAT(studying_resources.at(2).id(), Eq(first_resource.id())) << "First resource was studied first, so it should appear as the last studied resource";
 }
 
 TEST_F(test_database, mark_card_as_reviewed)
@@ -5956,6 +6305,87 @@ TEST_F(test_database, get_assessment_coverage)
     EXPECT_THAT(coverage, SizeIs(1));
 }
 
+TEST_F(test_database, get_subject_coverage)
+{
+    flashback::Roadmap roadmap{};
+    flashback::Subject subject{};
+    flashback::Milestone milestone{};
+    flashback::Topic first_topic{};
+    flashback::Topic second_topic{};
+    flashback::Topic third_topic{};
+    flashback::Resource resource{};
+    flashback::Section section{};
+    flashback::Card first_card{};
+    flashback::Card second_card{};
+    flashback::Card third_card{};
+    flashback::practice_mode mode{};
+
+    roadmap.set_name("C++ Software Engineer");
+    subject.set_name("C++");
+    milestone.set_level(flashback::expertise_level::depth);
+    first_topic.set_name("Reflection");
+    first_topic.set_level(flashback::expertise_level::surface);
+    second_topic.set_name("Coroutine");
+    second_topic.set_level(flashback::expertise_level::surface);
+    third_topic.set_name("Modules");
+    third_topic.set_level(flashback::expertise_level::surface);
+    resource.set_name("Personal Knowledge");
+    resource.set_type(flashback::Resource::nerve);
+    resource.set_pattern(flashback::Resource::synapse);
+    section.set_name("First C++ Resource Chapter 1");
+    first_card.set_headline("First Card");
+    second_card.set_headline("Second Card");
+    third_card.set_headline("Third Card");
+
+    ASSERT_NO_THROW(roadmap = m_database->create_roadmap(m_user->id(), roadmap.name()));
+    ASSERT_THAT(roadmap.id(), Gt(0));
+    ASSERT_NO_THROW(subject = m_database->create_subject(subject.name()));
+    ASSERT_THAT(subject.id(), Gt(0));
+    ASSERT_NO_THROW(milestone = m_database->add_milestone(subject.id(), milestone.level(), roadmap.id()));
+    ASSERT_THAT(milestone.position(), Eq(1));
+    ASSERT_NO_THROW(first_topic = m_database->create_topic(subject.id(), first_topic.name(), first_topic.level(), 0));
+    ASSERT_THAT(first_topic.position(), Eq(1));
+    ASSERT_NO_THROW(second_topic = m_database->create_topic(subject.id(), second_topic.name(), second_topic.level(), 0));
+    ASSERT_THAT(second_topic.position(), Eq(2));
+    ASSERT_NO_THROW(third_topic = m_database->create_topic(subject.id(), third_topic.name(), third_topic.level(), 0));
+    ASSERT_THAT(third_topic.position(), Eq(3));
+    ASSERT_NO_THROW(resource = m_database->create_resource(resource));
+    ASSERT_THAT(resource.id(), Gt(0));
+    ASSERT_NO_THROW(m_database->add_resource_to_subject(resource.id(), subject.id()));
+    ASSERT_NO_THROW(section = m_database->create_section(resource.id(), 0, section.name(), section.link()));
+    ASSERT_THAT(section.position(), Eq(1));
+    ASSERT_NO_THROW(first_card = m_database->create_card(first_card));
+    ASSERT_THAT(first_card.id(), Gt(0));
+    ASSERT_NO_THROW(second_card = m_database->create_card(second_card));
+    ASSERT_THAT(second_card.id(), Gt(0));
+    ASSERT_NO_THROW(third_card = m_database->create_card(third_card));
+    ASSERT_THAT(third_card.id(), Gt(0));
+    ASSERT_NO_THROW(m_database->add_card_to_section(first_card.id(), resource.id(), section.position()));
+    ASSERT_NO_THROW(m_database->add_card_to_section(second_card.id(), resource.id(), section.position()));
+    ASSERT_NO_THROW(m_database->add_card_to_section(third_card.id(), resource.id(), section.position()));
+    ASSERT_NO_THROW(m_database->add_card_to_topic(first_card.id(), subject.id(), first_topic.position(), first_topic.level()));
+    ASSERT_NO_THROW(m_database->add_card_to_topic(second_card.id(), subject.id(), second_topic.position(), second_topic.level()));
+    ASSERT_NO_THROW(m_database->add_card_to_topic(third_card.id(), subject.id(), third_topic.position(), third_topic.level()));
+    ASSERT_NO_THROW(mode = m_database->get_practice_mode(m_user->id(), subject.id(), milestone.level()));
+    ASSERT_THAT(mode, Eq(flashback::practice_mode::aggressive));
+    EXPECT_NO_THROW(m_database->make_progress(m_user->id(), subject.id(), first_topic.level(), first_card.id(), 20));
+    EXPECT_NO_THROW(m_database->make_progress(m_user->id(), subject.id(), second_topic.level(), second_card.id(), 20));
+    EXPECT_NO_THROW(m_database->make_progress(m_user->id(), subject.id(), third_topic.level(), third_card.id(), 20));
+    EXPECT_NO_THROW(m_database->create_assessment(subject.id(), first_topic.level(), first_topic.position(), first_card.id()));
+    EXPECT_NO_THROW(m_database->create_assessment(subject.id(), first_topic.level(), first_topic.position(), second_card.id()));
+    EXPECT_NO_THROW(m_database->create_assessment(subject.id(), third_topic.level(), third_topic.position(), third_card.id()));
+    std::vector<flashback::TopicCoverage> coverage{};
+    EXPECT_NO_THROW(coverage = m_database->get_subject_coverage(subject.id()));
+    ASSERT_THAT(coverage, SizeIs(3));
+    EXPECT_THAT(coverage.at(0).topic().position(), Eq(first_topic.position()));
+    EXPECT_THAT(coverage.at(0).assessment(), SizeIs(2));
+    EXPECT_THAT(coverage.at(1).topic().position(), Eq(second_topic.position()));
+    EXPECT_THAT(coverage.at(1).assessment(), IsEmpty());
+    EXPECT_THAT(coverage.at(2).topic().position(), Eq(third_topic.position()));
+    EXPECT_THAT(coverage.at(2).assessment(), SizeIs(1));
+    EXPECT_THAT(coverage.at(2).assessment(0).id(), Eq(third_card.id()));
+}
+
 TEST_F(test_database, get_assimilation_coverage)
 {
     flashback::Roadmap roadmap{};
@@ -6291,6 +6721,121 @@ TEST_F(test_database, get_assessments)
     EXPECT_TRUE(assimilation_coverage.at(3).assimilated());
 }
 
+TEST_F(test_database, export_subject_assessments)
+{
+    flashback::Subject subject{};
+    flashback::Topic topic{};
+    flashback::Resource resource{};
+    flashback::Section section{};
+    std::vector<flashback::Card> cards(3);
+    std::vector<flashback::Card> exported{};
+
+    subject.set_name("C++");
+    topic.set_name("Reflection");
+    topic.set_level(flashback::expertise_level::surface);
+    resource.set_name("Personal Knowledge");
+    resource.set_type(flashback::Resource::nerve);
+    resource.set_pattern(flashback::Resource::synapse);
+    section.set_name("First C++ Resource Chapter 1");
+
+    ASSERT_NO_THROW(subject = m_database->create_subject(subject.name()));
+    ASSERT_THAT(subject.id(), Gt(0));
+    ASSERT_NO_THROW(topic = m_database->create_topic(subject.id(), topic.name(), topic.level(), 0));
+    ASSERT_THAT(topic.position(), Eq(1));
+    ASSERT_NO_THROW(resource = m_database->create_resource(resource));
+    ASSERT_THAT(resource.id(), Gt(0));
+    ASSERT_NO_THROW(m_database->add_resource_to_subject(resource.id(), subject.id()));
+    ASSERT_NO_THROW(section = m_database->create_section(resource.id(), 0, section.name(), section.link()));
+    ASSERT_THAT(section.position(), Eq(1));
+
+    for (std::size_t index{}; index < cards.size(); ++index)
+    {
+        cards.at(index).set_headline(std::format("Card {}", index + 1));
+        ASSERT_NO_THROW(cards.at(index) = m_database->create_card(cards.at(index)));
+        ASSERT_THAT(cards.at(index).id(), Gt(0));
+        ASSERT_NO_THROW(m_database->add_card_to_section(cards.at(index).id(), resource.id(), section.position()));
+        ASSERT_NO_THROW(m_database->add_card_to_topic(cards.at(index).id(), subject.id(), topic.position(), topic.level()));
+        ASSERT_NO_THROW(m_database->create_assessment(subject.id(), topic.level(), topic.position(), cards.at(index).id()));
+    }
+
+    EXPECT_NO_THROW(m_database->export_subject_assessments(subject.id(), flashback::expertise_level::origin, [&exported](flashback::Card const& card) {
+        exported.push_back(card);
+        return true;
+    }));
+    EXPECT_THAT(exported, SizeIs(3));
+
+    exported.clear();
+    EXPECT_NO_THROW(m_database->export_subject_assessments(subject.id(), flashback::expertise_level::origin, [&exported](flashback::Card const& card) {
+        exported.push_back(card);
+        return false;
+    }));
+    EXPECT_THAT(exported, SizeIs(1)) << "Export should stop as soon as the consumer declines more rows";
+}
+
+TEST_F(test_database, export_subject_cards)
+{
+    flashback::Subject subject{};
+    flashback::Topic surface_topic{};
+    flashback::Topic depth_topic{};
+    std::vector<flashback::Card> cards(4);
+    std::vector<std::pair<flashback::Topic, flashback::Card>> exported{};
+
+    ASSERT_NO_THROW(subject = m_database->create_subject("C++"));
+    ASSERT_THAT(subject.id(), Gt(0));
+    ASSERT_NO_THROW(surface_topic = m_database->create_topic(subject.id(), "Templates", flashback::expertise_level::surface, 0));
+    ASSERT_NO_THROW(depth_topic = m_database->create_topic(subject.id(), "Template Instantiation", flashback::expertise_level::depth, 0));
+
+    for (std::size_t index{}; index < cards.size(); ++index)
+    {
+        flashback::Topic const& topic{index % 2 == 0 ? surface_topic : depth_topic};
+        cards.at(index).set_headline(std::format("Card {}", index + 1));
+        ASSERT_NO_THROW(cards.at(index) = m_database->create_card(cards.at(index)));
+        ASSERT_THAT(cards.at(index).id(), Gt(0));
+        ASSERT_NO_THROW(m_database->add_card_to_topic(cards.at(index).id(), subject.id(), topic.position(), topic.level()));
+    }
+
+    EXPECT_NO_THROW(m_database->export_subject_cards(subject.id(), [&exported](flashback::Topic const& topic, flashback::Card const& card) {
+        exported.emplace_back(topic, card);
+        return true;
+    }));
+    ASSERT_THAT(exported, SizeIs(4)) << "Cards of topics on every level should be exported";
+    EXPECT_THAT(exported.at(0).first.level(), Eq(flashback::expertise_level::surface));
+    EXPECT_THAT(exported.at(0).second.id(), Eq(cards.at(0).id()));
+    EXPECT_THAT(exported.at(1).second.id(), Eq(cards.at(2).id()));
+    EXPECT_THAT(exported.at(2).first.level(), Eq(flashback::expertise_level::depth));
+    EXPECT_THAT(exported.at(2).first.name(), Eq(depth_topic.name()));
+    EXPECT_THAT(exported.at(3).second.id(), Eq(cards.at(3).id()));
+
+    exported.clear();
+    EXPECT_NO_THROW(m_database->export_subject_cards(subject.id(), [&exported](flashback::Topic const& topic, flashback::Card const& card) {
+        exported.emplace_back(topic, card);
+        return false;
+    }));
+    EXPECT_THAT(exported, SizeIs(1)) << "Export should not move on to the next level once the consumer declines more rows";
+}
+
+TEST_F(test_database, fetch_after_last_keys)
+{
+    std::vector<std::pair<uint64_t, uint64_t>> fetched{};
+    auto const consume{[&fetched](pqxx::result const& batch) {
+        for (pqxx::row const& row: batch)
+        {
+            fetched.emplace_back(row.at("major").as<uint64_t>(), row.at("minor").as<uint64_t>());
+        }
+
+        return true;
+    }};
+
+    // more rows than two batches hold, with ties on the first key across every batch boundary
+    EXPECT_NO_THROW(std::ignore = fetch(std::array<std::string_view, 2>{"major", "minor"}, consume,
+                                        "select major, minor from generate_series(1, 3) as major cross join generate_series(1, $1::bigint) as minor "
+                                        "where $2::bigint is null or (major, minor) > ($2::bigint, $3::bigint) order by major, minor",
+                                        uint64_t{200}));
+    ASSERT_THAT(fetched, SizeIs(600)) << "Every row should be fetched once across batches";
+    EXPECT_THAT(std::ranges::is_sorted(fetched), Eq(true));
+    EXPECT_THAT(std::ranges::adjacent_find(fetched), Eq(fetched.end())) << "Batches should continue after the last row rather than repeat it";
+}
+
 TEST_F(test_database, is_assimilated)
 {
     flashback::Roadmap roadmap{};
@@ -6555,3 +7100,56 @@ TEST_F(test_database, user_is_verified)
 TEST_F(test_database, user_is_authorized)
 {
 }
+
+TEST(database_labels, decode_encoded_labels)
+{
+    for (auto const level: {flashback::expertise_level::surface, flashback::expertise_level::depth, flashback::expertise_level::origin})
+    {
+        EXPECT_THAT(flashback::database::to_level(flashback::database::level_to_string(level)), Eq(level));
+    }
+
+    for (int type{flashback::Resource::resource_type_MIN}; type <= flashback::Resource::resource_type_MAX; ++type)
+    {
+        auto const resource_type{static_cast<flashback::Resource::resource_type>(type)};
+        EXPECT_THAT(flashback::database::to_resource_type(flashback::database::resource_type_to_string(resource_type)), Eq(resource_type));
+    }
+
+    for (int pattern{flashback::Resource::section_pattern_MIN}; pattern <= flashback::Resource::section_pattern_MAX; ++pattern)
+    {
+        auto const section_pattern{static_cast<flashback::Resource::section_pattern>(pattern)};
+        EXPECT_THAT(flashback::database::to_section_pattern(flashback::database::section_pattern_to_string(section_pattern)), Eq(section_pattern));
+    }
+
+    for (int state{flashback::Card::card_state_MIN}; state <= flashback::Card::card_state_MAX; ++state)
+    {
+        auto const card_state{static_cast<flashback::Card::card_state>(state)};
+        EXPECT_THAT(flashback::database::to_card_state(flashback::database::card_state_to_string(card_state)), Eq(card_state));
+    }
+
+    for (int type{flashback::Block::content_type_MIN}; type <= flashback::Block::content_type_MAX; ++type)
+    {
+        auto const content_type{static_cast<flashback::Block::content_type>(type)};
+        EXPECT_THAT(flashback::database::to_content_type(flashback::database::content_type_to_string(content_type)), Eq(content_type));
+    }
+
+    for (auto const state: {flashback::closure_state::draft, flashback::closure_state::reviewed, flashback::closure_state::completed})
+    {
+        EXPECT_THAT(flashback::database::to_closure_state(flashback::database::closure_state_to_string(state)), Eq(state));
+    }
+
+    for (auto const mode: {flashback::practice_mode::aggressive, flashback::practice_mode::progressive, flashback::practice_mode::selective})
+    {
+        EXPECT_THAT(flashback::database::to_practice_mode(flashback::database::practice_mode_to_string(mode)), Eq(mode));
+    }
+}
+
+TEST(database_labels, reject_unknown_labels)
+{
+    EXPECT_THROW(std::ignore = flashback::database::to_level("surfaces"), std::runtime_error);
+    EXPECT_THROW(std::ignore = flashback::database::to_resource_type(""), std::runtime_error);
+    EXPECT_THROW(std::ignore = flashback::database::to_section_pattern("Chapter"), std::runtime_error);
+    EXPECT_THROW(std::ignore = flashback::database::to_card_state("draf"), std::runtime_error);
+    EXPECT_THROW(std::ignore = flashback::database::to_content_type("video"), std::runtime_error);
+    EXPECT_THROW(std::ignore = flashback::database::to_closure_state("released"), std::runtime_error);
+    EXPECT_THROW(std::ignore = flashback::database::to_practice_mode("passive"), std::runtime_error);
+}
@@ -0,0 +1,17 @@
+#include <cstdint>
+#include <vector>
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <flashback/ordering.hpp>
+
+using testing::IsTrue;
+using testing::IsFalse;
+
+TEST(ordering, validate_complete_ordering)
+{
+    EXPECT_THAT(flashback::is_complete_ordering(std::vector<uint64_t>{3, 1, 2}), IsTrue());
+    EXPECT_THAT(flashback::is_complete_ordering(std::vector<uint64_t>{}), IsTrue());
+    EXPECT_THAT(flashback::is_complete_ordering(std::vector<uint64_t>{1, 1, 2}), IsFalse()) << "Repeated positions should be refused";
+    EXPECT_THAT(flashback::is_complete_ordering(std::vector<uint64_t>{1, 4, 2}), IsFalse()) << "Positions beyond the list should be refused";
+    EXPECT_THAT(flashback::is_complete_ordering(std::vector<uint64_t>{0, 1}), IsFalse());
+}
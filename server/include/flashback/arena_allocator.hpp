@@ -0,0 +1,50 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <google/protobuf/arena.h>
+#include <grpcpp/support/message_allocator.h>
+
+namespace flashback
+{
+// allocates request and response of each call on a single arena, released in one go when the call completes
+template <typename Request, typename Response, std::size_t InitialBlockSize = 8192>
+class arena_allocator final: public grpc::MessageAllocator<Request, Response>
+{
+public:
+    grpc::MessageHolder<Request, Response>* AllocateMessages() override
+    {
+        return new holder{};
+    }
+
+private:
+    class holder final: public grpc::MessageHolder<Request, Response>
+    {
+    public:
+        holder()
+            : m_arena{options(m_initial_block)}
+        {
+            this->set_request(google::protobuf::Arena::CreateMessage<Request>(&m_arena));
+            this->set_response(google::protobuf::Arena::CreateMessage<Response>(&m_arena));
+        }
+
+        void Release() override
+        {
+            delete this;
+        }
+
+    private:
+        [[nodiscard]] static google::protobuf::ArenaOptions options(std::array<std::byte, InitialBlockSize>& initial_block)
+        {
+            google::protobuf::ArenaOptions options{};
+            options.initial_block = reinterpret_cast<char*>(initial_block.data());
+            options.initial_block_size = initial_block.size();
+            options.start_block_size = InitialBlockSize;
+            return options;
+        }
+
+        alignas(std::max_align_t) std::array<std::byte, InitialBlockSize> m_initial_block;
+        google::protobuf::Arena m_arena;
+    };
+};
+} // namespace flashback
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <types.pb.h>
+#include <flashback/keyed_cache.hpp>
+
+namespace flashback
+{
+struct assimilation_key
+{
+    uint64_t subject_id;
+    expertise_level level;
+    uint64_t topic_position;
+
+    bool operator==(assimilation_key const&) const = default;
+};
+
+struct assimilation_key_hash
+{
+    [[nodiscard]] std::size_t operator()(assimilation_key const& key) const noexcept;
+};
+
+// what an invalidation reached, a load is turned away when its user or its subject was invalidated after it started
+struct assimilation_scope
+{
+    enum class kind: uint8_t { user, subject };
+
+    kind type;
+    uint64_t id;
+
+    bool operator==(assimilation_scope const&) const = default;
+};
+
+struct assimilation_scope_hash
+{
+    [[nodiscard]] std::size_t operator()(assimilation_scope const& scope) const noexcept;
+};
+
+// assimilation of topics as last read from the database, grouped by user so that progress of one learner only drops their own topics
+// beyond the capacity an arbitrary user is dropped to make room for the next one
+class assimilation_state
+{
+public:
+    explicit assimilation_state(std::size_t capacity);
+
+    [[nodiscard]] std::optional<bool> find(uint64_t user_id, assimilation_key const& key) const;
+    // generation to pass back to assign, loads racing an invalidation of their user are not kept
+    [[nodiscard]] uint64_t generation() const;
+    void assign(uint64_t user_id, assimilation_key const& key, bool assimilated, uint64_t generation);
+    void invalidate(uint64_t user_id);
+    // drops the topics of every user in a subject whose topics were removed, merged, moved or reordered
+    void invalidate_subject(uint64_t subject_id);
+    // drops one topic of every user whose cards changed
+    void invalidate_topic(assimilation_key const& key);
+    void clear();
+
+private:
+    mutable std::mutex m_mutex;
+    std::unordered_map<uint64_t, std::unordered_map<assimilation_key, bool, assimilation_key_hash>> m_users;
+    invalidation_stamps<assimilation_scope, assimilation_scope_hash> m_stamps;
+    std::size_t m_capacity;
+};
+} // namespace flashback
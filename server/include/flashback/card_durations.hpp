@@ -0,0 +1,80 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <google/protobuf/repeated_ptr_field.h>
+#include <types.pb.h>
+#include <flashback/duration_sketch.hpp>
+
+namespace flashback
+{
+struct duration_estimate
+{
+    std::chrono::seconds typical;
+    std::chrono::seconds upper;
+    uint64_t cards;
+    // cards estimated from their own durations rather than those of all cards
+    uint64_t measured;
+
+    duration_estimate& operator+=(duration_estimate const& other) noexcept;
+};
+
+// study durations of each card as they are recorded, so estimating a session never reads the progress history back
+// at most capacity cards keep a sketch of their own, the least recently studied ones are forgotten and estimated from all cards again
+class card_durations
+{
+public:
+    static constexpr double typical_quantile{0.5};
+    static constexpr double upper_quantile{0.9};
+
+    // without a path the sketches only live as long as the process, otherwise they are restored from it
+    // and a background thread saves them every interval once something was recorded
+    card_durations(std::filesystem::path path, std::size_t capacity, std::chrono::seconds fallback, double compression, std::chrono::milliseconds save_interval);
+    ~card_durations();
+
+    card_durations(card_durations const&) = delete;
+    card_durations& operator=(card_durations const&) = delete;
+
+    void record(uint64_t card_id, std::chrono::seconds duration);
+    [[nodiscard]] duration_estimate estimate(uint64_t card_id) const;
+    [[nodiscard]] duration_estimate estimate(google::protobuf::RepeatedPtrField<Card> const& cards) const;
+    void save();
+
+private:
+    struct card
+    {
+        duration_sketch sketch;
+        std::list<uint64_t>::iterator recency;
+    };
+
+    [[nodiscard]] duration_estimate estimate_locked(uint64_t card_id, duration_estimate const& unmeasured) const;
+    [[nodiscard]] duration_estimate unmeasured_locked() const;
+    card& studied_locked(uint64_t card_id, duration_sketch sketch);
+    void load();
+    void save_periodically(std::stop_token const& stop);
+
+    std::filesystem::path m_path;
+    std::size_t m_capacity;
+    std::chrono::milliseconds m_save_interval;
+    mutable std::mutex m_mutex;
+    std::mutex m_save_mutex;
+    std::unordered_map<uint64_t, card> m_cards;
+    // most recently studied cards first
+    std::list<uint64_t> m_recency;
+    // cards never studied are estimated from all durations, or the fallback before anything is recorded
+    duration_sketch m_all;
+    std::chrono::seconds m_fallback;
+    double m_compression;
+    bool m_modified;
+    std::condition_variable_any m_save_signal;
+    std::jthread m_saver;
+};
+} // namespace flashback
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <google/protobuf/repeated_ptr_field.h>
+#include <types.pb.h>
+
+namespace flashback
+{
+// assessments of one subject by the topics they cover, kept both row and column wise as dense bitsets
+// so that coverage of an assessment or of a topic is a popcount over a few words
+class coverage_matrix
+{
+public:
+    explicit coverage_matrix(std::vector<TopicCoverage> const& topics);
+
+    // false when the assessment or the topic is not in the matrix, which then has to be reloaded
+    [[nodiscard]] bool assign(uint64_t assessment_id, expertise_level level, uint64_t topic_position, bool covered);
+    void topics_of(uint64_t assessment_id, google::protobuf::RepeatedPtrField<Topic>& topics) const;
+    [[nodiscard]] uint64_t assessment_coverage(uint64_t assessment_id) const;
+    [[nodiscard]] bool holds(uint64_t assessment_id) const;
+    [[nodiscard]] uint64_t topic_coverage(expertise_level level, uint64_t topic_position) const;
+    void fill(google::protobuf::RepeatedPtrField<TopicCoverage>& topics, google::protobuf::RepeatedPtrField<Coverage>& assessments) const;
+
+private:
+    [[nodiscard]] static uint64_t topic_key(expertise_level level, uint64_t topic_position) noexcept;
+    [[nodiscard]] bool covers(std::size_t row, std::size_t column) const noexcept;
+    void set(std::size_t row, std::size_t column, bool covered) noexcept;
+
+    std::vector<Topic> m_topics;
+    std::vector<Card> m_assessments;
+    std::unordered_map<uint64_t, std::size_t> m_topic_columns;
+    std::unordered_map<uint64_t, std::size_t> m_assessment_rows;
+    std::size_t m_row_words;
+    std::size_t m_column_words;
+    // one row of topic bits per assessment and one column of assessment bits per topic
+    std::vector<uint64_t> m_rows;
+    std::vector<uint64_t> m_columns;
+};
+} // namespace flashback
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace flashback
+{
+// merging t-digest of study durations, centroids near the tails stay small so that high quantiles remain accurate with a bounded number of centroids
+// quantiles merge the buffered samples once and reuse the merge until the next sample, so a sketch is not safe to share between threads
+class duration_sketch
+{
+public:
+    explicit duration_sketch(double compression);
+
+    void add(double value);
+    // interpolated value below which the given fraction of samples fall, zero while empty
+    [[nodiscard]] double quantile(double fraction) const;
+    [[nodiscard]] uint64_t count() const noexcept;
+    // merged centroids, sample count and extremes in host byte order, restoring rejects truncated or inconsistent contents
+    void serialize(std::string& contents) const;
+    [[nodiscard]] static std::optional<duration_sketch> deserialize(std::string_view& contents, double compression);
+
+private:
+    struct centroid
+    {
+        double mean;
+        double weight;
+    };
+
+    [[nodiscard]] std::vector<centroid> merged() const;
+    [[nodiscard]] std::vector<centroid> const& current() const;
+    [[nodiscard]] double scale(double fraction) const noexcept;
+
+    double m_compression;
+    std::vector<centroid> m_centroids;
+    std::vector<centroid> m_buffer;
+    uint64_t m_count;
+    double m_min;
+    double m_max;
+    // centroids with the buffer merged in, valid until the next sample
+    mutable std::vector<centroid> m_merged;
+    mutable bool m_merged_current;
+};
+} // namespace flashback
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstddef>
+
+namespace flashback
+{
+// mixes the hash of one more member into the hash of a composite key
+constexpr void hash_combine(std::size_t& seed, std::size_t const value) noexcept
+{
+    seed ^= value + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2);
+}
+} // namespace flashback
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace flashback
+{
+// stamps of the latest invalidation of each key, a load started at an older generation of its key is stale
+// stamps beyond the capacity are folded into one floor which turns away every load still in flight, callers hold their own lock
+template <typename Key, typename Hash = std::hash<Key>>
+class invalidation_stamps
+{
+public:
+    explicit invalidation_stamps(std::size_t const capacity)
+        : m_capacity{capacity}
+    {
+    }
+
+    [[nodiscard]] uint64_t generation() const noexcept
+    {
+        return m_clock;
+    }
+
+    [[nodiscard]] bool admits(Key const& key, uint64_t const generation) const
+    {
+        if (generation < m_floor)
+        {
+            return false;
+        }
+
+        auto const stamp{m_stamps.find(key)};
+        return stamp == m_stamps.end() || stamp->second <= generation;
+    }
+
+    void invalidate(Key const& key)
+    {
+        if (m_stamps.size() >= m_capacity && !m_stamps.contains(key))
+        {
+            invalidate();
+        }
+        else
+        {
+            m_stamps.insert_or_assign(key, ++m_clock);
+        }
+    }
+
+    void invalidate()
+    {
+        m_stamps.clear();
+        m_floor = ++m_clock;
+    }
+
+private:
+    std::unordered_map<Key, uint64_t, Hash> m_stamps;
+    std::size_t m_capacity;
+    uint64_t m_clock{};
+    uint64_t m_floor{};
+};
+
+// immutable values read from the database by key, replaced rather than modified so readers holding one never see a change half applied
+// a write only discards its own key, and once the capacity is reached an arbitrary entry makes room for the next load
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class keyed_cache
+{
+public:
+    explicit keyed_cache(std::size_t const capacity)
+        : m_stamps{capacity}
+        , m_capacity{capacity}
+    {
+    }
+
+    // the loader runs without the lock and its value is only kept when its key was not invalidated meanwhile
+    template <typename Loader>
+    [[nodiscard]] std::shared_ptr<Value const> load(Key const& key, Loader&& loader)
+    {
+        uint64_t generation{};
+
+        {
+            std::lock_guard const lock{m_mutex};
+
+            if (auto const cached{m_values.find(key)}; cached != m_values.end())
+            {
+                return cached->second;
+            }
+
+            generation = m_stamps.generation();
+        }
+
+        std::shared_ptr<Value const> value{std::invoke(std::forward<Loader>(loader))};
+        std::lock_guard const lock{m_mutex};
+
+        if (m_stamps.admits(key, generation))
+        {
+            if (m_values.size() >= m_capacity && !m_values.contains(key))
+            {
+                m_values.erase(m_values.begin());
+            }
+
+            m_values.insert_or_assign(key, value);
+        }
+
+        return value;
+    }
+
+    // the update returns the replacement of a cached value or nothing when the value has to be read again
+    template <typename Update>
+    void update(Key const& key, Update&& update)
+    {
+        std::lock_guard const lock{m_mutex};
+
+        if (auto const cached{m_values.find(key)}; cached != m_values.end())
+        {
+            if (std::shared_ptr<Value const> replacement{std::invoke(std::forward<Update>(update), *cached->second)})
+            {
+                cached->second = std::move(replacement);
+            }
+            else
+            {
+                m_values.erase(cached);
+            }
+        }
+
+        m_stamps.invalidate(key);
+    }
+
+    void invalidate(Key const& key)
+    {
+        std::lock_guard const lock{m_mutex};
+        m_values.erase(key);
+        m_stamps.invalidate(key);
+    }
+
+    // discards the cached values the predicate holds for, loads in flight cannot be told apart by value so all of them are turned away
+    template <typename Predicate>
+    void invalidate_if(Predicate&& predicate)
+    {
+        std::lock_guard const lock{m_mutex};
+        std::erase_if(m_values, [&predicate](auto const& entry) { return std::invoke(predicate, *entry.second); });
+        m_stamps.invalidate();
+    }
+
+    void clear()
+    {
+        std::lock_guard const lock{m_mutex};
+        m_values.clear();
+        m_stamps.invalidate();
+    }
+
+private:
+    std::mutex m_mutex;
+    std::unordered_map<Key, std::shared_ptr<Value const>, Hash> m_values;
+    invalidation_stamps<Key, Hash> m_stamps;
+    std::size_t m_capacity;
+};
+} // namespace flashback
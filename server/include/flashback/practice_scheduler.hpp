@@ -0,0 +1,94 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <google/protobuf/repeated_ptr_field.h>
+#include <types.pb.h>
+#include <flashback/keyed_cache.hpp>
+
+namespace flashback
+{
+struct practice_key
+{
+    uint64_t user_id;
+    uint64_t roadmap_id;
+    uint64_t subject_id;
+    expertise_level level;
+    uint64_t topic_position;
+
+    bool operator==(practice_key const&) const = default;
+};
+
+struct practice_key_hash
+{
+    [[nodiscard]] std::size_t operator()(practice_key const& key) const noexcept;
+};
+
+// what an invalidation reached, a load is turned away when its user, its subject or one of its cards was invalidated after it started
+struct practice_scope
+{
+    enum class kind: uint8_t { user, subject, card };
+
+    kind type;
+    uint64_t id;
+
+    bool operator==(practice_scope const&) const = default;
+};
+
+struct practice_scope_hash
+{
+    [[nodiscard]] std::size_t operator()(practice_scope const& scope) const noexcept;
+};
+
+// a cache of get_practice_cards results per user, subject, level and topic that expires a fixed lifetime after each read,
+// there is no due queue or timing wheel here, the database alone decides which cards are due and the cache only saves the round trip
+// practiced cards leave every deck of their user, and decks are read again once their lifetime passes to pick up cards that became due since,
+// headline edits are not followed so a cached deck may show an older headline until it expires
+class practice_scheduler
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    practice_scheduler(std::size_t capacity, clock::duration deck_lifetime);
+
+    // appends cards of the deck not practiced since it was read, false when the deck is not loaded or has expired and should be read from the database
+    [[nodiscard]] bool collect(practice_key const& key, clock::time_point now, google::protobuf::RepeatedPtrField<Card>& cards);
+    // generation to pass back to assign, loads racing progress or an invalidation of their user are not kept
+    [[nodiscard]] uint64_t generation() const;
+    void assign(practice_key const& key, google::protobuf::RepeatedPtrField<Card> const& cards, uint64_t generation, clock::time_point now);
+    void record(uint64_t user_id, uint64_t card_id, clock::time_point now);
+    // drops the decks of a user once their progress reaches the database, decks read before that may still hold practiced cards
+    void invalidate(uint64_t user_id);
+    // drops the decks of every user in a subject whose topics were removed, merged, moved or reordered
+    void invalidate_subject(uint64_t subject_id);
+    // drops the decks of every user on one topic whose cards changed
+    void invalidate_topic(uint64_t subject_id, expertise_level level, uint64_t topic_position);
+    // drops the decks of every user that hold a removed, merged or reviewed card
+    void invalidate_card(uint64_t card_id);
+    void clear();
+
+private:
+    struct deck
+    {
+        std::vector<Card> cards;
+        clock::time_point loaded;
+    };
+
+    struct learner
+    {
+        std::unordered_map<practice_key, deck, practice_key_hash> decks;
+        clock::time_point last_access;
+    };
+
+    void evict_idle_learner();
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<uint64_t, learner> m_learners;
+    invalidation_stamps<practice_scope, practice_scope_hash> m_stamps;
+    std::size_t m_capacity;
+    clock::duration m_deck_lifetime;
+};
+} // namespace flashback
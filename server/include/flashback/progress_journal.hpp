@@ -0,0 +1,77 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+#include <flashback/basic_database.hpp>
+
+namespace flashback
+{
+// write-behind log for study and practice events, appends are acknowledged once their group reaches the disk
+// and a background thread moves them to the database in batches, events left in the file are replayed on startup
+class progress_journal
+{
+public:
+    using delivery_callback = std::function<void(std::span<progress_event const>)>;
+
+    progress_journal(std::filesystem::path path, std::shared_ptr<basic_database> database, std::chrono::milliseconds flush_interval, delivery_callback delivered = {});
+    ~progress_journal();
+
+    progress_journal(progress_journal const&) = delete;
+    progress_journal& operator=(progress_journal const&) = delete;
+
+    void append(progress_event const& event);
+    void append(std::span<progress_event const> events);
+    [[nodiscard]] std::size_t pending() const;
+
+    static constexpr std::size_t flush_batch_size{512};
+    static constexpr uint32_t max_rejections{3};
+    static constexpr std::size_t compaction_threshold{1 << 20};
+
+private:
+    struct pending_event
+    {
+        progress_event event;
+        uint32_t rejections;
+    };
+
+    void replay();
+    void write_group(std::unique_lock<std::mutex>& lock);
+    void run(std::stop_token token);
+    [[nodiscard]] bool flush_to_database();
+    [[nodiscard]] bool deliver_individually(std::vector<pending_event>& batch);
+    // events the database keeps refusing are appended next to the journal for an operator to inspect
+    [[nodiscard]] bool dead_letter(progress_event const& event) const;
+    [[nodiscard]] std::filesystem::path dead_letter_path() const;
+    void compact(std::unique_lock<std::mutex>& lock);
+
+    std::filesystem::path m_path;
+    std::shared_ptr<basic_database> m_database;
+    std::chrono::milliseconds m_flush_interval;
+    delivery_callback m_delivered;
+    int m_descriptor;
+    std::size_t m_file_size;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_synced;
+    std::condition_variable_any m_wake;
+    std::string m_staged;
+    std::vector<progress_event> m_staged_events;
+    uint64_t m_staged_sequence;
+    uint64_t m_synced_sequence;
+    bool m_writing;
+    // set while a failed append could not be cut back to the last whole record
+    bool m_torn;
+    std::deque<pending_event> m_pending;
+    std::jthread m_flusher;
+};
+} // namespace flashback
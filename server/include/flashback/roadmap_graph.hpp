@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <google/protobuf/repeated_ptr_field.h>
+#include <types.pb.h>
+
+namespace flashback
+{
+// milestones of a roadmap with their requirements, kept as compressed adjacency rows and a bitset closure
+// a subject may be a milestone on several levels of one roadmap, so nodes are told apart by subject and level
+class roadmap_graph
+{
+public:
+    roadmap_graph(std::vector<Milestone> milestones, std::vector<Requirement> const& requirements);
+
+    // requirements precede the milestones depending on them, milestones caught in a stored cycle come last by position
+    [[nodiscard]] std::vector<Milestone> ordered_milestones() const;
+    [[nodiscard]] bool depends_on(Milestone const& milestone, Milestone const& required) const;
+    [[nodiscard]] bool would_form_cycle(Milestone const& milestone, Milestone const& required) const;
+    [[nodiscard]] bool is_acyclic() const noexcept;
+    void fill(google::protobuf::RepeatedPtrField<MilestoneNode>& nodes) const;
+
+private:
+    [[nodiscard]] static uint64_t node_key(uint64_t milestone_id, expertise_level level) noexcept;
+    [[nodiscard]] bool closure_contains(std::size_t row, std::size_t column) const noexcept;
+    void sort_topologically();
+    void close_transitively();
+
+    std::vector<Milestone> m_milestones;
+    std::unordered_map<uint64_t, std::size_t> m_indices;
+    std::vector<std::size_t> m_offsets;
+    std::vector<std::size_t> m_targets;
+    std::vector<Milestone> m_requirements;
+    std::vector<std::size_t> m_order;
+    std::vector<uint64_t> m_closure;
+    std::size_t m_words;
+    bool m_acyclic;
+};
+} // namespace flashback
@@ -1,16 +1,42 @@
 #pragma once
 
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <limits>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 #include <types.pb.h>
 #include <server.grpc.pb.h>
 #include <flashback/database.hpp>
+#include <flashback/arena_allocator.hpp>
+#include <flashback/trigram_index.hpp>
+#include <flashback/roadmap_graph.hpp>
+#include <flashback/practice_scheduler.hpp>
+#include <flashback/progress_journal.hpp>
+#include <flashback/assimilation_state.hpp>
+#include <flashback/coverage_matrix.hpp>
+#include <flashback/keyed_cache.hpp>
+#include <flashback/card_durations.hpp>
+#include <flashback/study_history.hpp>
+#include <flashback/task_executor.hpp>
 
 namespace flashback
 {
-class server: public Server::Service
+// calls returning large responses are served in callback mode so their messages can be allocated on arenas,
+// their database reads run on the executor of the server rather than on the callback threads of grpc
+using service = Server::WithCallbackMethod_GetStudyResources<Server::WithCallbackMethod_GetBlocks<Server::Service>>;
+
+class server: public service
 {
 public:
-    explicit server(std::shared_ptr<basic_database> database);
+    explicit server(std::shared_ptr<basic_database> database, std::filesystem::path journal_path = {}, std::filesystem::path history_path = {});
     ~server() override = default;
 
     // entry page
@@ -29,7 +55,9 @@ public:
 
     // home page
     grpc::Status GetRoadmaps(grpc::ServerContext* context, GetRoadmapsRequest const* request, GetRoadmapsResponse* response) override;
+    grpc::Status GetHomeBundle(grpc::ServerContext* context, GetHomeBundleRequest const* request, GetHomeBundleResponse* response) override;
     grpc::Status GetStudyResources(grpc::ServerContext* context, GetStudyResourcesRequest const* request, GetStudyResourcesResponse* response) override;
+    grpc::ServerUnaryReactor* GetStudyResources(grpc::CallbackServerContext* context, GetStudyResourcesRequest const* request, GetStudyResourcesResponse* response) override;
 
     // roadmap page
     grpc::Status CreateRoadmap(grpc::ServerContext* context, CreateRoadmapRequest const* request, CreateRoadmapResponse* response) override;
@@ -43,7 +71,9 @@ public:
     grpc::Status AddMilestone(grpc::ServerContext* context, AddMilestoneRequest const* request, AddMilestoneResponse* response) override;
     grpc::Status AddRequirement(grpc::ServerContext* context, AddRequirementRequest const* request, AddRequirementResponse* response) override;
     grpc::Status GetRequirements(grpc::ServerContext* context, GetRequirementsRequest const* request, GetRequirementsResponse* response) override;
+    grpc::Status GetRoadmapGraph(grpc::ServerContext* context, GetRoadmapGraphRequest const* request, GetRoadmapGraphResponse* response) override;
     grpc::Status ReorderMilestone(grpc::ServerContext* context, ReorderMilestoneRequest const* request, ReorderMilestoneResponse* response) override;
+    grpc::Status ApplyMilestoneOrdering(grpc::ServerContext* context, ApplyMilestoneOrderingRequest const* request, ApplyMilestoneOrderingResponse* response) override;
     grpc::Status RemoveMilestone(grpc::ServerContext* context, RemoveMilestoneRequest const* request, RemoveMilestoneResponse* response) override;
     grpc::Status ChangeMilestoneLevel(grpc::ServerContext* context, ChangeMilestoneLevelRequest const* request, ChangeMilestoneLevelResponse* response) override;
 
@@ -93,6 +123,7 @@ public:
     grpc::Status MergeTopics(grpc::ServerContext* context, MergeTopicsRequest const* request, MergeTopicsResponse* response) override;
     grpc::Status EditTopic(grpc::ServerContext* context, EditTopicRequest const* request, EditTopicResponse* response) override;
     grpc::Status MoveTopic(grpc::ServerContext* context, MoveTopicRequest const* request, MoveTopicResponse* response) override;
+    grpc::Status ApplyTopicOrdering(grpc::ServerContext* context, ApplyTopicOrderingRequest const* request, ApplyTopicOrderingResponse* response) override;
     grpc::Status SearchTopics(grpc::ServerContext* context, SearchTopicsRequest const* request, SearchTopicsResponse* response) override;
 
     // section page
@@ -102,6 +133,7 @@ public:
     grpc::Status MergeSections(grpc::ServerContext* context, MergeSectionsRequest const* request, MergeSectionsResponse* response) override;
     grpc::Status EditSection(grpc::ServerContext* context, EditSectionRequest const* request, EditSectionResponse* response) override;
     grpc::Status MoveSection(grpc::ServerContext* context, MoveSectionRequest const* request, MoveSectionResponse* response) override;
+    grpc::Status ApplySectionOrdering(grpc::ServerContext* context, ApplySectionOrderingRequest const* request, ApplySectionOrderingResponse* response) override;
     grpc::Status SearchSections(grpc::ServerContext* context, SearchSectionsRequest const* request, SearchSectionsResponse* response) override;
 
     // shared functions in section and topic pages
@@ -127,40 +159,167 @@ public:
     grpc::Status DiminishAssessment(grpc::ServerContext* context, DiminishAssessmentRequest const* request, DiminishAssessmentResponse* response) override;
     grpc::Status IsAssimilated(grpc::ServerContext* context, IsAssimilatedRequest const* request, IsAssimilatedResponse* response) override;
     grpc::Status GetTopicCoverage(grpc::ServerContext* context, GetTopicCoverageRequest const* request, GetTopicCoverageResponse* response) override;
+    grpc::Status GetSubjectCoverage(grpc::ServerContext* context, GetSubjectCoverageRequest const* request, GetSubjectCoverageResponse* response) override;
     grpc::Status GetSubjectAssessments(grpc::ServerContext* context, GetSubjectAssessmentsRequest const* request, GetSubjectAssessmentsResponse* response) override;
 
     // card page
     grpc::Status EditCard(grpc::ServerContext* context, EditCardRequest const* request, EditCardResponse* response) override;
     grpc::Status CreateBlock(grpc::ServerContext* context, CreateBlockRequest const* request, CreateBlockResponse* response) override;
     grpc::Status GetBlocks(grpc::ServerContext* context, GetBlocksRequest const* request, GetBlocksResponse* response) override;
+    grpc::ServerUnaryReactor* GetBlocks(grpc::CallbackServerContext* context, GetBlocksRequest const* request, GetBlocksResponse* response) override;
     grpc::Status RemoveBlock(grpc::ServerContext* context, RemoveBlockRequest const* request, RemoveBlockResponse* response) override;
     grpc::Status EditBlock(grpc::ServerContext* context, EditBlockRequest const* request, EditBlockResponse* response) override;
     grpc::Status ReorderBlock(grpc::ServerContext* context, ReorderBlockRequest const* request, ReorderBlockResponse* response) override;
+    grpc::Status ApplyBlockOrdering(grpc::ServerContext* context, ApplyBlockOrderingRequest const* request, ApplyBlockOrderingResponse* response) override;
     grpc::Status MergeBlocks(grpc::ServerContext* context, MergeBlocksRequest const* request, MergeBlocksResponse* response) override;
     grpc::Status SplitBlock(grpc::ServerContext* context, SplitBlockRequest const* request, SplitBlockResponse* response) override;
+    grpc::Status ApplyCardEdits(grpc::ServerContext* context, ApplyCardEditsRequest const* request, ApplyCardEditsResponse* response) override;
     grpc::Status MarkCardAsReviewed(grpc::ServerContext* context, MarkCardAsReviewedRequest const* request, MarkCardAsReviewedResponse* response) override;
     // grpc::Status GetVariations(grpc::ServerContext* context, GetVariationsRequest const* request, GetVariationsResponse* response) override;
     grpc::Status GetSectionCards(grpc::ServerContext* context, GetSectionCardsRequest const* request, GetSectionCardsResponse* response) override;
     grpc::Status GetTopicCards(grpc::ServerContext* context, GetTopicCardsRequest const* request, GetTopicCardsResponse* response) override;
     grpc::Status MoveBlock(grpc::ServerContext* context, MoveBlockRequest const* request, MoveBlockResponse* response) override;
+    grpc::Status SearchBlocks(grpc::ServerContext* context, SearchBlocksRequest const* request, SearchBlocksResponse* response) override;
+
+    // search
+    grpc::Status Typeahead(grpc::ServerContext* context, grpc::ServerReaderWriter<TypeaheadResponse, TypeaheadRequest>* stream) override;
+
+    // exports
+    grpc::Status ExportSubjectCards(grpc::ServerContext* context, ExportSubjectCardsRequest const* request, grpc::ServerWriter<ExportSubjectCardsResponse>* writer) override;
+    grpc::Status ExportResourceBlocks(grpc::ServerContext* context, ExportResourceBlocksRequest const* request, grpc::ServerWriter<ExportResourceBlocksResponse>* writer) override;
+    grpc::Status ExportSubjectAssessments(grpc::ServerContext* context, ExportSubjectAssessmentsRequest const* request,
+                                          grpc::ServerWriter<ExportSubjectAssessmentsResponse>* writer) override;
 
     // progress
     grpc::Status Study(grpc::ServerContext* context, StudyRequest const* request, StudyResponse* response) override;
     grpc::Status MakeProgress(grpc::ServerContext* context, MakeProgressRequest const* request, MakeProgressResponse* response) override;
+    grpc::Status SubmitStudyEvents(grpc::ServerContext* context, SubmitStudyEventsRequest const* request, SubmitStudyEventsResponse* response) override;
     grpc::Status GetProgressWeight(grpc::ServerContext* context, GetProgressWeightRequest const* request, GetProgressWeightResponse* response) override;
+    grpc::Status GetStudyHistory(grpc::ServerContext* context, GetStudyHistoryRequest const* request, GetStudyHistoryResponse* response) override;
+    grpc::Status EstimateCardTime(grpc::ServerContext* context, EstimateCardTimeRequest const* request, EstimateCardTimeResponse* response) override;
+    grpc::Status EstimateSessionTime(grpc::ServerContext* context, EstimateSessionTimeRequest const* request, EstimateSessionTimeResponse* response) override;
 
 protected:
+    static constexpr uint64_t default_page_size{20};
+    static constexpr uint64_t max_page_size{100};
+    static constexpr uint64_t max_list_page_size{1000};
+    // offsets and cursors decoded from page tokens leave room for one more page and still fit a bigint parameter
+    static constexpr uint64_t max_page_offset{static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) - max_list_page_size - 1};
+    static constexpr std::size_t practice_learner_capacity{4096};
+    static constexpr std::chrono::minutes practice_deck_lifetime{15};
+    static constexpr std::size_t database_workers{8};
+    static constexpr std::size_t roadmap_graphs_capacity{1024};
+    static constexpr std::size_t requirement_write_locks{64};
+    static constexpr std::size_t progress_weights_capacity{4096};
+    static constexpr std::size_t assimilation_users_capacity{4096};
+    static constexpr std::size_t coverage_matrices_capacity{1024};
+    static constexpr std::chrono::milliseconds progress_flush_interval{250};
+    static constexpr std::size_t max_submitted_events{1000};
+    static constexpr std::size_t max_card_edits{500};
+    static constexpr std::chrono::seconds card_duration_fallback{30};
+    static constexpr double card_duration_compression{50};
+    static constexpr std::size_t card_durations_capacity{65536};
+    static constexpr std::chrono::minutes card_durations_save_interval{5};
+    static constexpr std::size_t study_history_users_capacity{4096};
+    static constexpr std::chrono::minutes study_history_save_interval{5};
+
     [[nodiscard]] static size_t write_callback(void* contents, size_t size, size_t nmemb, std::string* response);
     [[nodiscard]] static std::string calculate_hash(std::string_view password);
     [[nodiscard]] static bool password_is_valid(std::string_view lhs, std::string_view rhs);
     [[nodiscard]] static std::string generate_token();
     [[nodiscard]] static uint64_t generate_code();
+    [[nodiscard]] static uint64_t wall_clock_seconds();
+    [[nodiscard]] static uint64_t page_limit(uint32_t requested_limit);
+    [[nodiscard]] static uint64_t list_page_limit(uint32_t requested_size);
+    [[nodiscard]] static std::string encode_page_token(uint64_t offset);
+    [[nodiscard]] static std::optional<uint64_t> decode_page_token(std::string_view token);
+
+    // search queries fetch one row past the page to detect whether another page follows
+    template <typename Match>
+    [[nodiscard]] static std::string next_page(std::vector<Match>& matches, uint64_t const offset, uint64_t const limit)
+    {
+        std::string token{};
+
+        if (matches.size() > limit)
+        {
+            matches.resize(limit);
+            token = encode_page_token(offset + limit);
+        }
+
+        return token;
+    }
+
+    // listings also fetch one row ahead, the next page resumes after the key of the last row kept
+    template <typename Entry, typename KeyOf>
+    [[nodiscard]] static std::string next_cursor(google::protobuf::RepeatedPtrField<Entry>& entries, uint64_t const limit, KeyOf&& key_of)
+    {
+        std::string token{};
+
+        if (static_cast<uint64_t>(entries.size()) > limit)
+        {
+            entries.DeleteSubrange(static_cast<int>(limit), entries.size() - static_cast<int>(limit));
+            token = encode_page_token(std::forward<KeyOf>(key_of)(entries.at(entries.size() - 1)));
+        }
+
+        return token;
+    }
+
     [[nodiscard]] bool session_is_valid(User const& user) const;
     [[nodiscard]] bool user_is_verified(User const& user) const;
     [[nodiscard]] bool user_is_authorized(User const& user) const;
+    void complete_typeahead(TypeaheadRequest const& request, std::stop_token const& stop, TypeaheadResponse& response) const;
+    void collect_practice_cards(practice_key const& key, google::protobuf::RepeatedPtrField<Card>& cards);
+    [[nodiscard]] std::shared_ptr<roadmap_graph const> load_roadmap_graph(uint64_t roadmap_id);
+    void invalidate_roadmap_graph(uint64_t roadmap_id);
+    void invalidate_roadmap_graphs();
+    [[nodiscard]] std::shared_ptr<std::vector<Weight> const> load_progress_weights(uint64_t user_id);
+    void invalidate_progress_weights(uint64_t user_id);
+    void invalidate_progress_weights();
+    [[nodiscard]] std::shared_ptr<coverage_matrix const> load_coverage_matrix(uint64_t subject_id);
+    void update_coverage_matrix(uint64_t subject_id, uint64_t assessment_id, expertise_level level, uint64_t topic_position, bool covered);
+    void invalidate_coverage_matrix(uint64_t subject_id);
+    void invalidate_assessment_coverage(uint64_t assessment_id);
+    // drop what practice decks, assimilation and coverage cached for a subject, one of its topics, or the subjects holding a card
+    void invalidate_subject_caches(uint64_t subject_id);
+    void invalidate_topic_caches(uint64_t subject_id, expertise_level level, uint64_t topic_position);
+    void invalidate_card_caches(uint64_t card_id);
+    // history follows progress as it reaches the database, so it is fed by journal delivery when there is a journal
+    void record_study_history(std::span<progress_event const> events);
     void send_verification_email(std::string domain, std::string email, uint64_t code);
     void send_deletion_email(std::string domain, std::string email, uint64_t code);
 
     std::shared_ptr<basic_database> m_database;
+    arena_allocator<GetStudyResourcesRequest, GetStudyResourcesResponse> m_study_resources_allocator;
+    arena_allocator<GetBlocksRequest, GetBlocksResponse> m_blocks_allocator;
+    trigram_index<Subject> m_subject_index;
+    trigram_index<Resource> m_resource_index;
+    trigram_index<Provider> m_provider_index;
+    trigram_index<Presenter> m_presenter_index;
+    // each held across a catalog write and its index update so the two cannot be reordered by concurrent calls
+    std::mutex m_subject_writes;
+    std::mutex m_resource_writes;
+    std::mutex m_provider_writes;
+    std::mutex m_presenter_writes;
+    // graphs are built on first use, roadmap ids come from clients so the cache is bounded
+    keyed_cache<uint64_t, roadmap_graph> m_roadmap_graphs{roadmap_graphs_capacity};
+    // requirements of one roadmap are checked for cycles and written one at a time, roadmaps share a fixed set of locks
+    std::array<std::mutex, requirement_write_locks> m_requirement_writes;
+    // a lifetime-bound cache of get_practice_cards, practiced cards leave its decks as progress is written through
+    practice_scheduler m_practice_scheduler{practice_learner_capacity, practice_deck_lifetime};
+    // weights of a user are dropped once their progress reaches the database and all of them when cards or resources change
+    keyed_cache<uint64_t, std::vector<Weight>> m_progress_weights{progress_weights_capacity};
+    // topics are assimilated through progress on their assessments, so progress drops the topics of its user and assessment changes drop all
+    assimilation_state m_assimilation_state{assimilation_users_capacity};
+    // assessment changes are applied to a copy of the matrix of their subject, other subjects stay cached
+    keyed_cache<uint64_t, coverage_matrix> m_coverage_matrices{coverage_matrices_capacity};
+    // durations are learned from events seen by this process and saved next to the study history, estimates fall back to all cards and then to a fixed duration
+    card_durations m_card_durations;
+    // daily rollups are saved as progress reaches the database, every few minutes and on shutdown
+    study_history m_study_history;
+    // study and practice events are acknowledged once journaled, without a journal they are written through,
+    // declared after the caches so that its final flush still finds the caches it invalidates
+    std::unique_ptr<progress_journal> m_progress_journal;
+    // callback handlers read the database here, declared last so that calls still queued finish before anything they use is gone
+    task_executor m_database_executor{database_workers};
 };
 } // flashback
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <chrono>
+#include <compare>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <google/protobuf/repeated_ptr_field.h>
+#include <types.pb.h>
+
+namespace flashback
+{
+// daily rollups of study and practice per user, subject and level, reads never touch the progress table
+// each series keeps its closed days as varint columns of day deltas, card counts and seconds, only the latest day stays decoded
+// at most capacity users stay resident, the least recently used ones that are saved are evicted and read back from their file on demand
+class study_history
+{
+public:
+    // without a directory the rollups only live as long as the process and evicted users are forgotten,
+    // otherwise each user is saved to a file of its own and a background thread saves the modified ones every interval
+    study_history(std::filesystem::path directory, std::size_t capacity, std::chrono::milliseconds save_interval);
+    ~study_history();
+
+    study_history(study_history const&) = delete;
+    study_history& operator=(study_history const&) = delete;
+
+    // plain studying is recorded without a subject
+    void record(uint64_t user_id, uint64_t subject_id, expertise_level level, std::chrono::sys_days day, uint64_t duration);
+    void collect(uint64_t user_id, std::chrono::sys_days since, std::chrono::sys_days until, history_granularity granularity,
+                 google::protobuf::RepeatedPtrField<StudyHistory>& history);
+    // writes the users modified since their last save, recording goes on meanwhile
+    void save();
+
+private:
+    struct series_key
+    {
+        uint64_t subject_id;
+        expertise_level level;
+
+        auto operator<=>(series_key const&) const = default;
+    };
+
+    struct row
+    {
+        uint64_t day;
+        uint64_t cards;
+        uint64_t seconds;
+    };
+
+    struct series
+    {
+        std::string days;
+        std::string cards;
+        std::string seconds;
+        uint64_t closed_day;
+        row open;
+    };
+
+    using user_series = std::map<series_key, series>;
+
+    struct user_history
+    {
+        user_series series;
+        // a user is modified while its version is ahead of the saved one, only saved users are evicted
+        uint64_t version;
+        uint64_t saved_version;
+        std::list<uint64_t>::iterator recency;
+    };
+
+    [[nodiscard]] static std::vector<row> decode(series const& columns);
+    static void close(series& columns, row const& closed);
+    // expects the lock to be held and releases it while the file of an absent user is read
+    user_history& resident(std::unique_lock<std::mutex>& lock, uint64_t user_id);
+    void evict();
+    [[nodiscard]] std::filesystem::path path_of(uint64_t user_id) const;
+    [[nodiscard]] user_series load(uint64_t user_id) const;
+    void save_periodically(std::stop_token const& stop);
+    [[nodiscard]] static std::string snapshot(user_series const& user);
+
+    std::filesystem::path m_directory;
+    std::size_t m_capacity;
+    std::chrono::milliseconds m_save_interval;
+    std::mutex m_mutex;
+    std::mutex m_save_mutex;
+    std::unordered_map<uint64_t, user_history> m_users;
+    // most recently used users first
+    std::list<uint64_t> m_recency;
+    std::condition_variable_any m_save_signal;
+    std::jthread m_saver;
+};
+} // namespace flashback
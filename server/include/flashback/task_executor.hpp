@@ -0,0 +1,35 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace flashback
+{
+// fixed set of threads running blocking work handed over by callback handlers, so the threads of grpc never wait on the database
+// tasks still queued when the executor is destroyed are run before its threads exit, every submitted task runs exactly once
+class task_executor
+{
+public:
+    explicit task_executor(std::size_t workers);
+    ~task_executor();
+
+    task_executor(task_executor const&) = delete;
+    task_executor& operator=(task_executor const&) = delete;
+
+    void submit(std::function<void()> task);
+
+private:
+    void run(std::stop_token const& stop);
+
+    std::mutex m_mutex;
+    std::condition_variable_any m_wake;
+    std::deque<std::function<void()>> m_tasks;
+    std::vector<std::jthread> m_workers;
+};
+} // namespace flashback
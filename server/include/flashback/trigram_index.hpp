@@ -0,0 +1,236 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace flashback
+{
+using trigram = std::uint32_t;
+
+// lowercased trigrams of each word padded like pg_trgm, sorted and without duplicates
+[[nodiscard]] std::vector<trigram> extract_trigrams(std::string_view text);
+
+// case insensitive substring test, names match queries typed from their middle like "lus" in "Calculus"
+[[nodiscard]] bool contains_ignoring_case(std::string_view text, std::string_view pattern) noexcept;
+
+// trigrams made only of word characters, padded ones only occur at word boundaries
+[[nodiscard]] constexpr bool is_inner_trigram(trigram const gram) noexcept
+{
+    return (gram >> 16 & 0xff) != ' ' && (gram >> 8 & 0xff) != ' ' && (gram & 0xff) != ' ';
+}
+
+// in-process replacement for pg_trgm over small catalogs keyed by id and searched by name
+template <typename Entity>
+class trigram_index
+{
+public:
+    void assign(std::vector<Entity> entities)
+    {
+        std::unique_lock const lock{m_mutex};
+        m_entities.clear();
+        m_trigram_counts.clear();
+        m_free_slots.clear();
+        m_slots.clear();
+        m_postings.clear();
+        m_loaded = true;
+        m_entities.reserve(entities.size());
+        m_trigram_counts.reserve(entities.size());
+
+        for (Entity& entity: entities)
+        {
+            insert(std::move(entity));
+        }
+    }
+
+    void upsert(Entity entity)
+    {
+        std::unique_lock const lock{m_mutex};
+        extract(entity.id());
+        insert(std::move(entity));
+    }
+
+    void erase(std::uint64_t const id)
+    {
+        std::unique_lock const lock{m_mutex};
+        extract(id);
+    }
+
+    [[nodiscard]] std::vector<Entity> search(std::string_view const pattern, std::uint64_t const limit, std::uint64_t const offset) const
+    {
+        std::vector<Entity> matches{};
+        std::vector<trigram> const query{extract_trigrams(pattern)};
+
+        if (query.empty())
+        {
+            return matches;
+        }
+
+        std::shared_lock const lock{m_mutex};
+        std::vector<std::uint16_t> shared(m_entities.size());
+        std::vector<std::uint16_t> inner(m_entities.size());
+        auto const inner_count{static_cast<std::size_t>(std::ranges::count_if(query, is_inner_trigram))};
+
+        // counting hits into a dense array keeps every posting list a straight run of increments
+        for (trigram const gram: query)
+        {
+            if (auto const postings{m_postings.find(gram)}; postings != m_postings.end())
+            {
+                for (std::uint32_t const slot: postings->second)
+                {
+                    ++shared[slot];
+                }
+
+                if (is_inner_trigram(gram))
+                {
+                    for (std::uint32_t const slot: postings->second)
+                    {
+                        ++inner[slot];
+                    }
+                }
+            }
+        }
+
+        std::vector<candidate> candidates{};
+        std::size_t const required{(query.size() * word_threshold_numerator + word_threshold_denominator - 1) / word_threshold_denominator};
+
+        // names containing the query stay matches below the threshold, only those holding every inner trigram are compared
+        // and queries too short to have any are compared against every name
+        for (std::uint32_t slot{}; slot < shared.size(); ++slot)
+        {
+            if (shared[slot] >= required || ((inner_count == 0 || inner[slot] == inner_count) && contains_ignoring_case(m_entities[slot].name(), pattern)))
+            {
+                candidates.push_back({slot, shared[slot], m_trigram_counts[slot]});
+            }
+        }
+
+        // ranks by shared / (query + target - shared) like pg_trgm similarity, compared without floating point
+        auto const ranked_before = [this, &query](candidate const& lhs, candidate const& rhs) {
+            std::uint64_t const lhs_score{static_cast<std::uint64_t>(lhs.shared) * (query.size() + rhs.trigrams - rhs.shared)};
+            std::uint64_t const rhs_score{static_cast<std::uint64_t>(rhs.shared) * (query.size() + lhs.trigrams - lhs.shared)};
+
+            if (lhs_score != rhs_score)
+            {
+                return lhs_score > rhs_score;
+            }
+
+            return m_entities[lhs.slot].id() < m_entities[rhs.slot].id();
+        };
+
+        if (offset < candidates.size())
+        {
+            std::size_t const end{static_cast<std::size_t>(std::min<std::uint64_t>(candidates.size(), offset + limit))};
+            std::partial_sort(candidates.begin(), candidates.begin() + end, candidates.end(), ranked_before);
+            matches.reserve(end - offset);
+
+            for (std::size_t index{offset}; index < end; ++index)
+            {
+                matches.push_back(m_entities[candidates[index].slot]);
+            }
+        }
+
+        return matches;
+    }
+
+    [[nodiscard]] std::size_t size() const
+    {
+        std::shared_lock const lock{m_mutex};
+        return m_slots.size();
+    }
+
+    // false until a catalog is assigned, searches should go to the database meanwhile
+    [[nodiscard]] bool loaded() const
+    {
+        std::shared_lock const lock{m_mutex};
+        return m_loaded;
+    }
+
+private:
+    // matches must contain at least this fraction of the query trigrams, the default word_similarity_threshold of pg_trgm
+    static constexpr std::size_t word_threshold_numerator{6};
+    static constexpr std::size_t word_threshold_denominator{10};
+
+    struct candidate
+    {
+        std::uint32_t slot;
+        std::uint32_t shared;
+        std::uint32_t trigrams;
+    };
+
+    void insert(Entity entity)
+    {
+        std::vector<trigram> const trigrams{extract_trigrams(entity.name())};
+        std::uint32_t slot{};
+
+        if (m_free_slots.empty())
+        {
+            slot = static_cast<std::uint32_t>(m_entities.size());
+            m_entities.push_back(std::move(entity));
+            m_trigram_counts.push_back(static_cast<std::uint32_t>(trigrams.size()));
+        }
+        else
+        {
+            slot = m_free_slots.back();
+            m_free_slots.pop_back();
+            m_entities[slot] = std::move(entity);
+            m_trigram_counts[slot] = static_cast<std::uint32_t>(trigrams.size());
+        }
+
+        m_slots[m_entities[slot].id()] = slot;
+
+        for (trigram const gram: trigrams)
+        {
+            std::vector<std::uint32_t>& postings{m_postings[gram]};
+            postings.insert(std::ranges::lower_bound(postings, slot), slot);
+        }
+    }
+
+    std::optional<Entity> extract(std::uint64_t const id)
+    {
+        std::optional<Entity> entity{};
+
+        if (auto const found{m_slots.find(id)}; found != m_slots.end())
+        {
+            std::uint32_t const slot{found->second};
+
+            for (trigram const gram: extract_trigrams(m_entities[slot].name()))
+            {
+                if (auto postings{m_postings.find(gram)}; postings != m_postings.end())
+                {
+                    if (auto const position{std::ranges::lower_bound(postings->second, slot)}; position != postings->second.end() && *position == slot)
+                    {
+                        postings->second.erase(position);
+                    }
+
+                    if (postings->second.empty())
+                    {
+                        m_postings.erase(postings);
+                    }
+                }
+            }
+
+            entity = std::move(m_entities[slot]);
+            m_entities[slot] = Entity{};
+            m_trigram_counts[slot] = 0;
+            m_free_slots.push_back(slot);
+            m_slots.erase(found);
+        }
+
+        return entity;
+    }
+
+    std::vector<Entity> m_entities;
+    std::vector<std::uint32_t> m_trigram_counts;
+    std::vector<std::uint32_t> m_free_slots;
+    std::unordered_map<std::uint64_t, std::uint32_t> m_slots;
+    std::unordered_map<trigram, std::vector<std::uint32_t>> m_postings;
+    bool m_loaded{};
+    mutable std::shared_mutex m_mutex;
+};
+} // namespace flashback
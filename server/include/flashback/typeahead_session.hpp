@@ -0,0 +1,78 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <utility>
+
+namespace flashback
+{
+// keeps only the latest query of a typing session, queries arriving while a lookup runs make its results stale
+// and request the lookup to stop through the token of its ticket
+template <typename Query>
+class typeahead_session
+{
+public:
+    struct ticket
+    {
+        Query query;
+        std::uint64_t generation;
+        std::stop_token stop;
+    };
+
+    void submit(Query query)
+    {
+        {
+            std::lock_guard const lock{m_mutex};
+            m_pending = std::move(query);
+            ++m_generation;
+            m_lookup.request_stop();
+        }
+
+        m_condition.notify_one();
+    }
+
+    void close()
+    {
+        {
+            std::lock_guard const lock{m_mutex};
+            m_closed = true;
+        }
+
+        m_condition.notify_one();
+    }
+
+    // blocks until a query is pending, pending queries are still served after the session is closed
+    [[nodiscard]] std::optional<ticket> take()
+    {
+        std::unique_lock lock{m_mutex};
+        m_condition.wait(lock, [this] { return m_pending.has_value() || m_closed; });
+        std::optional<ticket> next{};
+
+        if (m_pending)
+        {
+            m_lookup = std::stop_source{};
+            next.emplace(std::move(*m_pending), m_generation, m_lookup.get_token());
+            m_pending.reset();
+        }
+
+        return next;
+    }
+
+    [[nodiscard]] bool is_current(ticket const& taken) const
+    {
+        std::lock_guard const lock{m_mutex};
+        return taken.generation == m_generation;
+    }
+
+private:
+    mutable std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::optional<Query> m_pending;
+    std::stop_source m_lookup;
+    std::uint64_t m_generation{};
+    bool m_closed{};
+};
+} // namespace flashback
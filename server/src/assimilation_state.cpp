@@ -0,0 +1,102 @@
+#include <functional>
+#include <ranges>
+#include <flashback/assimilation_state.hpp>
+#include <flashback/hash_combine.hpp>
+
+using namespace flashback;
+
+std::size_t assimilation_key_hash::operator()(assimilation_key const& key) const noexcept
+{
+    std::size_t seed{std::hash<uint64_t>{}(key.subject_id)};
+    hash_combine(seed, std::hash<int>{}(key.level));
+    hash_combine(seed, std::hash<uint64_t>{}(key.topic_position));
+    return seed;
+}
+
+std::size_t assimilation_scope_hash::operator()(assimilation_scope const& scope) const noexcept
+{
+    std::size_t seed{std::hash<uint8_t>{}(static_cast<uint8_t>(scope.type))};
+    hash_combine(seed, std::hash<uint64_t>{}(scope.id));
+    return seed;
+}
+
+assimilation_state::assimilation_state(std::size_t const capacity)
+    : m_stamps{capacity}
+    , m_capacity{capacity}
+{
+}
+
+std::optional<bool> assimilation_state::find(uint64_t const user_id, assimilation_key const& key) const
+{
+    std::lock_guard const lock{m_mutex};
+
+    if (auto const user{m_users.find(user_id)}; user != m_users.end())
+    {
+        if (auto const topic{user->second.find(key)}; topic != user->second.end())
+        {
+            return topic->second;
+        }
+    }
+
+    return std::nullopt;
+}
+
+uint64_t assimilation_state::generation() const
+{
+    std::lock_guard const lock{m_mutex};
+    return m_stamps.generation();
+}
+
+void assimilation_state::assign(uint64_t const user_id, assimilation_key const& key, bool const assimilated, uint64_t const generation)
+{
+    std::lock_guard const lock{m_mutex};
+
+    if (m_stamps.admits(assimilation_scope{assimilation_scope::kind::user, user_id}, generation) &&
+        m_stamps.admits(assimilation_scope{assimilation_scope::kind::subject, key.subject_id}, generation))
+    {
+        if (m_users.size() >= m_capacity && !m_users.contains(user_id))
+        {
+            m_users.erase(m_users.begin());
+        }
+
+        m_users[user_id].insert_or_assign(key, assimilated);
+    }
+}
+
+void assimilation_state::invalidate(uint64_t const user_id)
+{
+    std::lock_guard const lock{m_mutex};
+    m_users.erase(user_id);
+    m_stamps.invalidate(assimilation_scope{assimilation_scope::kind::user, user_id});
+}
+
+void assimilation_state::invalidate_subject(uint64_t const subject_id)
+{
+    std::lock_guard const lock{m_mutex};
+    m_stamps.invalidate(assimilation_scope{assimilation_scope::kind::subject, subject_id});
+
+    for (auto& topics: m_users | std::views::values)
+    {
+        std::erase_if(topics, [subject_id](auto const& entry) { return entry.first.subject_id == subject_id; });
+    }
+}
+
+void assimilation_state::invalidate_topic(assimilation_key const& key)
+{
+    std::lock_guard const lock{m_mutex};
+
+    // loads in flight are told apart by subject alone, which turns away a few loads of other topics as well
+    m_stamps.invalidate(assimilation_scope{assimilation_scope::kind::subject, key.subject_id});
+
+    for (auto& topics: m_users | std::views::values)
+    {
+        topics.erase(key);
+    }
+}
+
+void assimilation_state::clear()
+{
+    std::lock_guard const lock{m_mutex};
+    m_users.clear();
+    m_stamps.invalidate();
+}
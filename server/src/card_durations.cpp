@@ -0,0 +1,266 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <string_view>
+#include <flashback/card_durations.hpp>
+
+using namespace flashback;
+
+namespace
+{
+constexpr std::string_view snapshot_magic{"FBDURS01"};
+
+void put(std::string& contents, uint64_t const value)
+{
+    contents.append(reinterpret_cast<char const*>(&value), sizeof value);
+}
+
+std::optional<uint64_t> take(std::string_view& contents) noexcept
+{
+    uint64_t value{};
+
+    if (contents.size() < sizeof value)
+    {
+        return std::nullopt;
+    }
+
+    std::memcpy(&value, contents.data(), sizeof value);
+    contents.remove_prefix(sizeof value);
+    return value;
+}
+
+std::chrono::seconds to_seconds(double const seconds) noexcept
+{
+    return std::chrono::seconds{std::llround(seconds)};
+}
+} // namespace
+
+duration_estimate& duration_estimate::operator+=(duration_estimate const& other) noexcept
+{
+    typical += other.typical;
+    upper += other.upper;
+    cards += other.cards;
+    measured += other.measured;
+    return *this;
+}
+
+card_durations::card_durations(std::filesystem::path path, std::size_t const capacity, std::chrono::seconds const fallback, double const compression,
+                               std::chrono::milliseconds const save_interval)
+    : m_path{std::move(path)}
+    , m_capacity{std::max(capacity, std::size_t{1})}
+    , m_save_interval{save_interval}
+    , m_all{compression}
+    , m_fallback{fallback}
+    , m_compression{compression}
+    , m_modified{}
+{
+    if (!m_path.empty())
+    {
+        load();
+        m_saver = std::jthread{[this](std::stop_token const& stop) { save_periodically(stop); }};
+    }
+}
+
+card_durations::~card_durations()
+{
+    if (m_saver.joinable())
+    {
+        m_saver.request_stop();
+        m_saver.join();
+    }
+
+    try
+    {
+        save();
+    }
+    catch (std::exception const& exp)
+    {
+        std::cerr << std::format("card durations: final save failed: {}\n", exp.what());
+    }
+}
+
+void card_durations::record(uint64_t const card_id, std::chrono::seconds const duration)
+{
+    auto const seconds{static_cast<double>(duration.count())};
+    std::lock_guard const lock{m_mutex};
+    studied_locked(card_id, duration_sketch{m_compression}).sketch.add(seconds);
+    m_all.add(seconds);
+    m_modified = true;
+}
+
+duration_estimate card_durations::estimate(uint64_t const card_id) const
+{
+    std::lock_guard const lock{m_mutex};
+    return estimate_locked(card_id, unmeasured_locked());
+}
+
+duration_estimate card_durations::estimate(google::protobuf::RepeatedPtrField<Card> const& cards) const
+{
+    duration_estimate total{};
+    std::lock_guard const lock{m_mutex};
+    duration_estimate const unmeasured{unmeasured_locked()};
+
+    for (Card const& card: cards)
+    {
+        total += estimate_locked(card.id(), unmeasured);
+    }
+
+    return total;
+}
+
+duration_estimate card_durations::estimate_locked(uint64_t const card_id, duration_estimate const& unmeasured) const
+{
+    if (auto const found{m_cards.find(card_id)}; found != m_cards.end())
+    {
+        duration_sketch const& sketch{found->second.sketch};
+        return duration_estimate{to_seconds(sketch.quantile(typical_quantile)), to_seconds(sketch.quantile(upper_quantile)), 1, 1};
+    }
+
+    return unmeasured;
+}
+
+duration_estimate card_durations::unmeasured_locked() const
+{
+    if (m_all.count() > 0)
+    {
+        return duration_estimate{to_seconds(m_all.quantile(typical_quantile)), to_seconds(m_all.quantile(upper_quantile)), 1, 0};
+    }
+
+    return duration_estimate{m_fallback, m_fallback, 1, 0};
+}
+
+void card_durations::save()
+{
+    std::lock_guard const save_lock{m_save_mutex};
+    std::string contents{snapshot_magic};
+
+    // recording waits for the bounded set of sketches to be encoded, writing happens without the lock
+    {
+        std::lock_guard const lock{m_mutex};
+
+        if (m_path.empty() || !m_modified)
+        {
+            return;
+        }
+
+        m_all.serialize(contents);
+        put(contents, m_cards.size());
+
+        // least recently studied first, so that restoring them in order rebuilds the recency
+        for (uint64_t const card_id: m_recency | std::views::reverse)
+        {
+            put(contents, card_id);
+            m_cards.at(card_id).sketch.serialize(contents);
+        }
+
+        m_modified = false;
+    }
+
+    try
+    {
+        // losing a save only costs estimates, so the file is replaced without syncing it
+        std::filesystem::path const staged{std::filesystem::path{m_path}.concat(".tmp")};
+        std::filesystem::create_directories(m_path.parent_path());
+        std::ofstream file{staged, std::ios::binary | std::ios::trunc};
+        file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+        file.close();
+
+        if (!file)
+        {
+            throw std::runtime_error{std::format("card durations {} cannot be written", staged.string())};
+        }
+
+        std::filesystem::rename(staged, m_path);
+    }
+    catch (...)
+    {
+        std::lock_guard const lock{m_mutex};
+        m_modified = true;
+        throw;
+    }
+}
+
+card_durations::card& card_durations::studied_locked(uint64_t const card_id, duration_sketch sketch)
+{
+    if (auto const found{m_cards.find(card_id)}; found != m_cards.end())
+    {
+        m_recency.splice(m_recency.begin(), m_recency, found->second.recency);
+        return found->second;
+    }
+
+    if (m_cards.size() >= m_capacity)
+    {
+        m_cards.erase(m_recency.back());
+        m_recency.pop_back();
+    }
+
+    m_recency.push_front(card_id);
+    return m_cards.emplace(card_id, card{std::move(sketch), m_recency.begin()}).first->second;
+}
+
+void card_durations::load()
+{
+    std::ifstream file{m_path, std::ios::binary};
+    std::string const contents{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    std::string_view remaining{contents};
+
+    if (contents.empty())
+    {
+        return;
+    }
+
+    bool valid{remaining.starts_with(snapshot_magic)};
+    remaining.remove_prefix(valid ? snapshot_magic.size() : remaining.size());
+    std::optional<duration_sketch> all{valid ? duration_sketch::deserialize(remaining, m_compression) : std::nullopt};
+    std::optional<uint64_t> const card_count{all ? take(remaining) : std::nullopt};
+    valid = card_count.has_value();
+
+    for (uint64_t loaded{}; valid && loaded < *card_count; ++loaded)
+    {
+        std::optional<uint64_t> const card_id{take(remaining)};
+        std::optional<duration_sketch> sketch{card_id ? duration_sketch::deserialize(remaining, m_compression) : std::nullopt};
+        valid = sketch.has_value();
+
+        if (valid)
+        {
+            studied_locked(*card_id, std::move(*sketch));
+        }
+    }
+
+    if (!valid || !remaining.empty())
+    {
+        std::cerr << std::format("card durations: {} is damaged, starting without durations\n", m_path.string());
+        m_cards.clear();
+        m_recency.clear();
+        return;
+    }
+
+    m_all = std::move(*all);
+}
+
+void card_durations::save_periodically(std::stop_token const& stop)
+{
+    std::unique_lock lock{m_mutex};
+
+    while (!m_save_signal.wait_for(lock, stop, m_save_interval, [&stop] { return stop.stop_requested(); }))
+    {
+        lock.unlock();
+
+        try
+        {
+            save();
+        }
+        catch (std::exception const& exp)
+        {
+            std::cerr << std::format("card durations: {}\n", exp.what());
+        }
+
+        lock.lock();
+    }
+}
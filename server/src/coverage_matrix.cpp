@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <bit>
+#include <numeric>
+#include <flashback/coverage_matrix.hpp>
+
+using namespace flashback;
+
+namespace
+{
+constexpr std::size_t word_bits{64};
+
+std::size_t words_for(std::size_t const bits) noexcept
+{
+    return (bits + word_bits - 1) / word_bits;
+}
+
+uint64_t popcount(std::vector<uint64_t> const& words, std::size_t const offset, std::size_t const count) noexcept
+{
+    return std::accumulate(words.begin() + static_cast<std::ptrdiff_t>(offset), words.begin() + static_cast<std::ptrdiff_t>(offset + count), uint64_t{},
+                           [](uint64_t const total, uint64_t const word) { return total + static_cast<uint64_t>(std::popcount(word)); });
+}
+} // namespace
+
+coverage_matrix::coverage_matrix(std::vector<TopicCoverage> const& topics)
+    : m_row_words{}
+    , m_column_words{}
+{
+    std::vector<TopicCoverage const*> ordered{};
+    ordered.reserve(topics.size());
+    std::ranges::transform(topics, std::back_inserter(ordered), [](TopicCoverage const& topic) { return &topic; });
+    std::ranges::stable_sort(ordered, {}, [](TopicCoverage const* topic) { return topic_key(topic->topic().level(), topic->topic().position()); });
+
+    for (TopicCoverage const* topic: ordered)
+    {
+        if (m_topic_columns.try_emplace(topic_key(topic->topic().level(), topic->topic().position()), m_topics.size()).second)
+        {
+            m_topics.push_back(topic->topic());
+        }
+
+        for (Card const& assessment: topic->assessment())
+        {
+            if (m_assessment_rows.try_emplace(assessment.id(), m_assessments.size()).second)
+            {
+                m_assessments.push_back(assessment);
+            }
+        }
+    }
+
+    m_row_words = words_for(m_topics.size());
+    m_column_words = words_for(m_assessments.size());
+    m_rows.resize(m_assessments.size() * m_row_words);
+    m_columns.resize(m_topics.size() * m_column_words);
+
+    for (TopicCoverage const& topic: topics)
+    {
+        std::size_t const column{m_topic_columns.at(topic_key(topic.topic().level(), topic.topic().position()))};
+
+        for (Card const& assessment: topic.assessment())
+        {
+            set(m_assessment_rows.at(assessment.id()), column, true);
+        }
+    }
+}
+
+bool coverage_matrix::assign(uint64_t const assessment_id, expertise_level const level, uint64_t const topic_position, bool const covered)
+{
+    auto const row{m_assessment_rows.find(assessment_id)};
+    auto const column{m_topic_columns.find(topic_key(level, topic_position))};
+
+    if (row == m_assessment_rows.end() || column == m_topic_columns.end())
+    {
+        return false;
+    }
+
+    set(row->second, column->second, covered);
+    return true;
+}
+
+void coverage_matrix::topics_of(uint64_t const assessment_id, google::protobuf::RepeatedPtrField<Topic>& topics) const
+{
+    if (auto const row{m_assessment_rows.find(assessment_id)}; row != m_assessment_rows.end())
+    {
+        for (std::size_t column{}; column < m_topics.size(); ++column)
+        {
+            if (covers(row->second, column))
+            {
+                *topics.Add() = m_topics[column];
+            }
+        }
+    }
+}
+
+uint64_t coverage_matrix::assessment_coverage(uint64_t const assessment_id) const
+{
+    auto const row{m_assessment_rows.find(assessment_id)};
+    return row == m_assessment_rows.end() ? 0 : popcount(m_rows, row->second * m_row_words, m_row_words);
+}
+
+bool coverage_matrix::holds(uint64_t const assessment_id) const
+{
+    return m_assessment_rows.contains(assessment_id);
+}
+
+uint64_t coverage_matrix::topic_coverage(expertise_level const level, uint64_t const topic_position) const
+{
+    auto const column{m_topic_columns.find(topic_key(level, topic_position))};
+    return column == m_topic_columns.end() ? 0 : popcount(m_columns, column->second * m_column_words, m_column_words);
+}
+
+void coverage_matrix::fill(google::protobuf::RepeatedPtrField<TopicCoverage>& topics, google::protobuf::RepeatedPtrField<Coverage>& assessments) const
+{
+    for (std::size_t column{}; column < m_topics.size(); ++column)
+    {
+        TopicCoverage* const topic{topics.Add()};
+        *topic->mutable_topic() = m_topics[column];
+
+        for (std::size_t row{}; row < m_assessments.size(); ++row)
+        {
+            if (covers(row, column))
+            {
+                *topic->add_assessment() = m_assessments[row];
+            }
+        }
+    }
+
+    for (std::size_t row{}; row < m_assessments.size(); ++row)
+    {
+        Coverage* const coverage{assessments.Add()};
+        *coverage->mutable_card() = m_assessments[row];
+        coverage->set_coverage(popcount(m_rows, row * m_row_words, m_row_words));
+    }
+}
+
+uint64_t coverage_matrix::topic_key(expertise_level const level, uint64_t const topic_position) noexcept
+{
+    // levels sort first so that columns follow the order topics are listed in
+    return static_cast<uint64_t>(level) << 56 | topic_position;
+}
+
+bool coverage_matrix::covers(std::size_t const row, std::size_t const column) const noexcept
+{
+    return m_rows[row * m_row_words + column / word_bits] >> (column % word_bits) & 1;
+}
+
+void coverage_matrix::set(std::size_t const row, std::size_t const column, bool const covered) noexcept
+{
+    uint64_t const row_bit{uint64_t{1} << (column % word_bits)};
+    uint64_t const column_bit{uint64_t{1} << (row % word_bits)};
+    uint64_t& row_word{m_rows[row * m_row_words + column / word_bits]};
+    uint64_t& column_word{m_columns[column * m_column_words + row / word_bits]};
+    row_word = covered ? row_word | row_bit : row_word & ~row_bit;
+    column_word = covered ? column_word | column_bit : column_word & ~column_bit;
+}
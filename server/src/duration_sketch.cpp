@@ -0,0 +1,196 @@
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <numbers>
+#include <flashback/duration_sketch.hpp>
+
+using namespace flashback;
+
+namespace
+{
+void put(std::string& contents, double const value)
+{
+    auto const bits{std::bit_cast<uint64_t>(value)};
+    contents.append(reinterpret_cast<char const*>(&bits), sizeof bits);
+}
+
+std::optional<double> take(std::string_view& contents) noexcept
+{
+    uint64_t bits{};
+
+    if (contents.size() < sizeof bits)
+    {
+        return std::nullopt;
+    }
+
+    std::memcpy(&bits, contents.data(), sizeof bits);
+    contents.remove_prefix(sizeof bits);
+    return std::bit_cast<double>(bits);
+}
+} // namespace
+
+duration_sketch::duration_sketch(double const compression)
+    : m_compression{compression}
+    , m_count{}
+    , m_min{}
+    , m_max{}
+    , m_merged_current{}
+{
+}
+
+void duration_sketch::add(double const value)
+{
+    m_min = m_count == 0 ? value : std::min(m_min, value);
+    m_max = m_count == 0 ? value : std::max(m_max, value);
+    ++m_count;
+    m_buffer.push_back(centroid{value, 1});
+    m_merged_current = false;
+
+    if (static_cast<double>(m_buffer.size()) >= m_compression)
+    {
+        m_centroids = merged();
+        m_buffer.clear();
+    }
+}
+
+double duration_sketch::quantile(double const fraction) const
+{
+    if (m_count == 0)
+    {
+        return 0;
+    }
+
+    std::vector<centroid> const& centroids{current()};
+    double const target{std::clamp(fraction, 0.0, 1.0) * static_cast<double>(m_count)};
+    double before{};
+
+    // values are interpolated between centroid centers, the extremes anchor both ends
+    double previous_center{};
+    double previous_mean{m_min};
+
+    for (centroid const& current: centroids)
+    {
+        double const center{before + current.weight / 2};
+
+        if (target < center)
+        {
+            double const span{center - previous_center};
+            return span > 0 ? previous_mean + (current.mean - previous_mean) * (target - previous_center) / span : current.mean;
+        }
+
+        before += current.weight;
+        previous_center = center;
+        previous_mean = current.mean;
+    }
+
+    double const span{static_cast<double>(m_count) - previous_center};
+    return span > 0 ? previous_mean + (m_max - previous_mean) * (target - previous_center) / span : m_max;
+}
+
+uint64_t duration_sketch::count() const noexcept
+{
+    return m_count;
+}
+
+void duration_sketch::serialize(std::string& contents) const
+{
+    std::vector<centroid> const& centroids{m_count == 0 ? m_centroids : current()};
+    put(contents, static_cast<double>(m_count));
+    put(contents, m_min);
+    put(contents, m_max);
+    put(contents, static_cast<double>(centroids.size()));
+
+    for (centroid const& saved: centroids)
+    {
+        put(contents, saved.mean);
+        put(contents, saved.weight);
+    }
+}
+
+std::optional<duration_sketch> duration_sketch::deserialize(std::string_view& contents, double const compression)
+{
+    std::optional<double> const count{take(contents)};
+    std::optional<double> const min{take(contents)};
+    std::optional<double> const max{take(contents)};
+    std::optional<double> const size{take(contents)};
+
+    if (!count || !min || !max || !size || *count < 0 || *size < 0 || *size * 2 * sizeof(double) > static_cast<double>(contents.size()))
+    {
+        return std::nullopt;
+    }
+
+    duration_sketch sketch{compression};
+    sketch.m_count = static_cast<uint64_t>(*count);
+    sketch.m_min = *min;
+    sketch.m_max = *max;
+    sketch.m_centroids.resize(static_cast<std::size_t>(*size));
+    double weights{};
+
+    for (centroid& restored: sketch.m_centroids)
+    {
+        restored = centroid{*take(contents), *take(contents)};
+        weights += restored.weight;
+    }
+
+    if (weights != *count || (sketch.m_count > 0 && sketch.m_centroids.empty()))
+    {
+        return std::nullopt;
+    }
+
+    return sketch;
+}
+
+std::vector<duration_sketch::centroid> const& duration_sketch::current() const
+{
+    if (m_buffer.empty())
+    {
+        return m_centroids;
+    }
+
+    if (!m_merged_current)
+    {
+        m_merged = merged();
+        m_merged_current = true;
+    }
+
+    return m_merged;
+}
+
+std::vector<duration_sketch::centroid> duration_sketch::merged() const
+{
+    std::vector<centroid> sorted{m_centroids};
+    sorted.insert(sorted.end(), m_buffer.begin(), m_buffer.end());
+    std::ranges::sort(sorted, {}, &centroid::mean);
+
+    std::vector<centroid> result{};
+    double const total{static_cast<double>(m_count)};
+    double before{};
+    double lower_bound{scale(0)};
+    centroid current{sorted.front()};
+
+    for (auto next{std::next(sorted.begin())}; next != sorted.end(); ++next)
+    {
+        if (scale((before + current.weight + next->weight) / total) - lower_bound <= 1)
+        {
+            current.weight += next->weight;
+            current.mean += (next->mean - current.mean) * next->weight / current.weight;
+        }
+        else
+        {
+            before += current.weight;
+            lower_bound = scale(before / total);
+            result.push_back(current);
+            current = *next;
+        }
+    }
+
+    result.push_back(current);
+    return result;
+}
+
+double duration_sketch::scale(double const fraction) const noexcept
+{
+    return m_compression / (2 * std::numbers::pi) * std::asin(2 * fraction - 1);
+}
@@ -3,6 +3,7 @@
 #include <string>
 #include <iostream>
 #include <exception>
+#include <filesystem>
 #include <flashback/server.hpp>
 #include <flashback/database.hpp>
 #include <grpcpp/grpcpp.h>
@@ -16,7 +17,12 @@ int main(int const argc, char** argv)
     {
         std::string database_host{std::getenv("DATABASE_HOST") ? std::getenv("DATABASE_HOST") : "localhost"};
         auto database{std::make_shared<flashback::database>("flashback_client", "flashback", database_host, "5432")};
-        auto const server{std::make_shared<flashback::server>(database)};
+        // systemd creates the state directory for the service, without it progress is written straight to the database
+        // and study history and card durations only live as long as the process
+        std::filesystem::path const state_directory{std::getenv("STATE_DIRECTORY") ? std::getenv("STATE_DIRECTORY") : ""};
+        std::filesystem::path journal_path{std::getenv("PROGRESS_JOURNAL") ? std::getenv("PROGRESS_JOURNAL") : state_directory.empty() ? "" : state_directory / "progress.journal"};
+        std::filesystem::path history_path{std::getenv("STUDY_HISTORY") ? std::getenv("STUDY_HISTORY") : state_directory.empty() ? "" : state_directory / "study-history"};
+        auto const server{std::make_shared<flashback::server>(database, journal_path, history_path)};
         auto const builder{std::make_unique<grpc::ServerBuilder>()};
 
         // grpc::SslServerCredentialsOptions opts;
@@ -0,0 +1,175 @@
+#include <algorithm>
+#include <functional>
+#include <ranges>
+#include <flashback/practice_scheduler.hpp>
+#include <flashback/hash_combine.hpp>
+
+using namespace flashback;
+
+std::size_t practice_key_hash::operator()(practice_key const& key) const noexcept
+{
+    std::size_t seed{std::hash<uint64_t>{}(key.user_id)};
+    hash_combine(seed, std::hash<uint64_t>{}(key.roadmap_id));
+    hash_combine(seed, std::hash<uint64_t>{}(key.subject_id));
+    hash_combine(seed, std::hash<int>{}(key.level));
+    hash_combine(seed, std::hash<uint64_t>{}(key.topic_position));
+    return seed;
+}
+
+std::size_t practice_scope_hash::operator()(practice_scope const& scope) const noexcept
+{
+    std::size_t seed{std::hash<uint8_t>{}(static_cast<uint8_t>(scope.type))};
+    hash_combine(seed, std::hash<uint64_t>{}(scope.id));
+    return seed;
+}
+
+practice_scheduler::practice_scheduler(std::size_t const capacity, clock::duration const deck_lifetime)
+    : m_stamps{capacity}
+    , m_capacity{capacity}
+    , m_deck_lifetime{deck_lifetime}
+{
+}
+
+bool practice_scheduler::collect(practice_key const& key, clock::time_point const now, google::protobuf::RepeatedPtrField<Card>& cards)
+{
+    std::lock_guard const lock{m_mutex};
+    auto const learner_entry{m_learners.find(key.user_id)};
+
+    if (learner_entry == m_learners.end())
+    {
+        return false;
+    }
+
+    auto const deck_entry{learner_entry->second.decks.find(key)};
+
+    if (deck_entry == learner_entry->second.decks.end())
+    {
+        return false;
+    }
+
+    if (now - deck_entry->second.loaded >= m_deck_lifetime)
+    {
+        learner_entry->second.decks.erase(deck_entry);
+        return false;
+    }
+
+    learner_entry->second.last_access = now;
+    cards.Reserve(cards.size() + static_cast<int>(deck_entry->second.cards.size()));
+
+    for (Card const& card: deck_entry->second.cards)
+    {
+        *cards.Add() = card;
+    }
+
+    return true;
+}
+
+uint64_t practice_scheduler::generation() const
+{
+    std::lock_guard const lock{m_mutex};
+    return m_stamps.generation();
+}
+
+void practice_scheduler::assign(practice_key const& key, google::protobuf::RepeatedPtrField<Card> const& cards, uint64_t const generation, clock::time_point const now)
+{
+    std::lock_guard const lock{m_mutex};
+
+    if (!m_stamps.admits(practice_scope{practice_scope::kind::user, key.user_id}, generation) ||
+        !m_stamps.admits(practice_scope{practice_scope::kind::subject, key.subject_id}, generation) ||
+        std::ranges::any_of(cards, [this, generation](Card const& card) { return !m_stamps.admits(practice_scope{practice_scope::kind::card, card.id()}, generation); }))
+    {
+        return;
+    }
+
+    if (!m_learners.contains(key.user_id) && m_learners.size() >= m_capacity)
+    {
+        evict_idle_learner();
+    }
+
+    learner& active{m_learners[key.user_id]};
+    active.last_access = now;
+    deck& loaded{active.decks[key] = deck{}};
+    loaded.loaded = now;
+    loaded.cards.assign(cards.begin(), cards.end());
+}
+
+void practice_scheduler::record(uint64_t const user_id, uint64_t const card_id, clock::time_point const now)
+{
+    std::lock_guard const lock{m_mutex};
+
+    // a load in flight may have read the card before its progress was written
+    m_stamps.invalidate(practice_scope{practice_scope::kind::user, user_id});
+
+    if (auto const learner_entry{m_learners.find(user_id)}; learner_entry != m_learners.end())
+    {
+        learner_entry->second.last_access = now;
+
+        for (deck& practiced: learner_entry->second.decks | std::views::values)
+        {
+            std::erase_if(practiced.cards, [card_id](Card const& card) { return card.id() == card_id; });
+        }
+    }
+}
+
+void practice_scheduler::invalidate(uint64_t const user_id)
+{
+    std::lock_guard const lock{m_mutex};
+    m_learners.erase(user_id);
+    m_stamps.invalidate(practice_scope{practice_scope::kind::user, user_id});
+}
+
+void practice_scheduler::invalidate_subject(uint64_t const subject_id)
+{
+    std::lock_guard const lock{m_mutex};
+    m_stamps.invalidate(practice_scope{practice_scope::kind::subject, subject_id});
+
+    for (learner& active: m_learners | std::views::values)
+    {
+        std::erase_if(active.decks, [subject_id](auto const& entry) { return entry.first.subject_id == subject_id; });
+    }
+}
+
+void practice_scheduler::invalidate_topic(uint64_t const subject_id, expertise_level const level, uint64_t const topic_position)
+{
+    std::lock_guard const lock{m_mutex};
+
+    // loads in flight are told apart by subject alone, which turns away a few loads of other topics as well
+    m_stamps.invalidate(practice_scope{practice_scope::kind::subject, subject_id});
+
+    for (learner& active: m_learners | std::views::values)
+    {
+        std::erase_if(active.decks, [subject_id, level, topic_position](auto const& entry) {
+            return entry.first.subject_id == subject_id && entry.first.level == level && entry.first.topic_position == topic_position;
+        });
+    }
+}
+
+void practice_scheduler::invalidate_card(uint64_t const card_id)
+{
+    std::lock_guard const lock{m_mutex};
+    m_stamps.invalidate(practice_scope{practice_scope::kind::card, card_id});
+
+    for (learner& active: m_learners | std::views::values)
+    {
+        std::erase_if(active.decks, [card_id](auto const& entry) {
+            return std::ranges::any_of(entry.second.cards, [card_id](Card const& card) { return card.id() == card_id; });
+        });
+    }
+}
+
+void practice_scheduler::clear()
+{
+    std::lock_guard const lock{m_mutex};
+    m_learners.clear();
+    m_stamps.invalidate();
+}
+
+void practice_scheduler::evict_idle_learner()
+{
+    auto const idle{std::ranges::min_element(m_learners, std::less{}, [](auto const& entry) { return entry.second.last_access; })};
+
+    if (idle != m_learners.end())
+    {
+        m_learners.erase(idle);
+    }
+}
@@ -0,0 +1,466 @@
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <system_error>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pqxx/pqxx>
+#include <flashback/progress_journal.hpp>
+
+using namespace flashback;
+
+namespace
+{
+// kind, level, format, a reserved byte, checksum, then user, card, milestone, duration and timestamp
+constexpr std::size_t record_size{48};
+constexpr char record_format{1};
+constexpr std::size_t format_offset{2};
+constexpr std::size_t checksum_offset{4};
+
+using record = std::array<char, record_size>;
+
+uint32_t checksum(std::span<char const> const bytes) noexcept
+{
+    uint32_t hash{2166136261u};
+
+    for (std::size_t index{}; index < bytes.size(); ++index)
+    {
+        bool const in_checksum{index >= checksum_offset && index < checksum_offset + sizeof(uint32_t)};
+        hash = (hash ^ static_cast<unsigned char>(in_checksum ? 0 : bytes[index])) * 16777619u;
+    }
+
+    return hash;
+}
+
+void encode(progress_event const& event, std::string& buffer)
+{
+    record bytes{};
+    bytes[0] = static_cast<char>(event.type);
+    bytes[1] = static_cast<char>(event.milestone_level);
+    bytes[format_offset] = record_format;
+    std::memcpy(bytes.data() + 8, &event.user_id, sizeof(uint64_t));
+    std::memcpy(bytes.data() + 16, &event.card_id, sizeof(uint64_t));
+    std::memcpy(bytes.data() + 24, &event.milestone_id, sizeof(uint64_t));
+    std::memcpy(bytes.data() + 32, &event.duration, sizeof(uint64_t));
+    std::memcpy(bytes.data() + 40, &event.timestamp, sizeof(uint64_t));
+    uint32_t const sum{checksum(bytes)};
+    std::memcpy(bytes.data() + checksum_offset, &sum, sizeof(uint32_t));
+    buffer.append(bytes.data(), bytes.size());
+}
+
+// records cut short by a crash or damaged on disk fail the checksum and end the replay
+std::optional<progress_event> decode(char const* data)
+{
+    record bytes{};
+    uint32_t sum{};
+    std::memcpy(bytes.data(), data, record_size);
+    std::memcpy(&sum, bytes.data() + checksum_offset, sizeof(uint32_t));
+
+    if (sum != checksum(bytes) || bytes[0] > static_cast<char>(progress_event::kind::practice) || !expertise_level_IsValid(bytes[1]) ||
+        bytes[format_offset] != record_format)
+    {
+        return std::nullopt;
+    }
+
+    progress_event event{};
+    event.type = static_cast<progress_event::kind>(bytes[0]);
+    event.milestone_level = static_cast<expertise_level>(bytes[1]);
+    std::memcpy(&event.user_id, bytes.data() + 8, sizeof(uint64_t));
+    std::memcpy(&event.card_id, bytes.data() + 16, sizeof(uint64_t));
+    std::memcpy(&event.milestone_id, bytes.data() + 24, sizeof(uint64_t));
+    std::memcpy(&event.duration, bytes.data() + 32, sizeof(uint64_t));
+    std::memcpy(&event.timestamp, bytes.data() + 40, sizeof(uint64_t));
+    return event;
+}
+
+void write_all(int const descriptor, std::string_view data)
+{
+    while (!data.empty())
+    {
+        ssize_t const written{::write(descriptor, data.data(), data.size())};
+
+        if (written < 0 && errno != EINTR)
+        {
+            throw std::system_error{errno, std::generic_category(), "progress journal write failed"};
+        }
+
+        data.remove_prefix(written < 0 ? 0 : static_cast<std::size_t>(written));
+    }
+
+    if (::fdatasync(descriptor) != 0)
+    {
+        throw std::system_error{errno, std::generic_category(), "progress journal sync failed"};
+    }
+}
+
+int open_journal(std::filesystem::path const& path, int const flags)
+{
+    int const descriptor{::open(path.c_str(), flags | O_CREAT | O_APPEND | O_CLOEXEC, 0600)};
+
+    if (descriptor < 0)
+    {
+        throw std::system_error{errno, std::generic_category(), std::format("progress journal {} cannot be opened", path.string())};
+    }
+
+    return descriptor;
+}
+} // namespace
+
+progress_journal::progress_journal(std::filesystem::path path, std::shared_ptr<basic_database> database, std::chrono::milliseconds const flush_interval,
+                                   delivery_callback delivered)
+    : m_path{std::move(path)}
+    , m_database{std::move(database)}
+    , m_flush_interval{flush_interval}
+    , m_delivered{std::move(delivered)}
+    , m_descriptor{-1}
+    , m_file_size{}
+    , m_staged_sequence{}
+    , m_synced_sequence{}
+    , m_writing{}
+    , m_torn{}
+{
+    if (m_path.has_parent_path())
+    {
+        std::filesystem::create_directories(m_path.parent_path());
+    }
+
+    m_descriptor = open_journal(m_path, O_RDWR);
+    replay();
+    m_flusher = std::jthread{[this](std::stop_token token) { run(std::move(token)); }};
+}
+
+progress_journal::~progress_journal()
+{
+    m_flusher.request_stop();
+
+    if (m_flusher.joinable())
+    {
+        m_flusher.join();
+    }
+
+    // whatever the database does not take now stays in the file for the next start
+    while (pending() > 0 && flush_to_database())
+    {
+    }
+
+    ::close(m_descriptor);
+}
+
+void progress_journal::append(progress_event const& event)
+{
+    append(std::span{&event, 1});
+}
+
+void progress_journal::append(std::span<progress_event const> const events)
+{
+    if (events.empty())
+    {
+        return;
+    }
+
+    std::unique_lock lock{m_mutex};
+
+    for (progress_event const& event: events)
+    {
+        encode(event, m_staged);
+        m_staged_events.push_back(event);
+    }
+
+    uint64_t const sequence{m_staged_sequence += events.size()};
+
+    // the first waiter writes every record staged so far with one sync, later arrivals ride along with the next group
+    while (m_synced_sequence < sequence)
+    {
+        if (m_writing)
+        {
+            m_synced.wait(lock);
+        }
+        else
+        {
+            write_group(lock);
+        }
+    }
+}
+
+std::size_t progress_journal::pending() const
+{
+    std::lock_guard const lock{m_mutex};
+    return m_pending.size() + m_staged_events.size();
+}
+
+void progress_journal::replay()
+{
+    std::ifstream file{m_path, std::ios::binary};
+    std::string const contents{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    std::size_t valid{};
+
+    for (; valid + record_size <= contents.size(); valid += record_size)
+    {
+        std::optional<progress_event> const event{decode(contents.data() + valid)};
+
+        if (!event)
+        {
+            break;
+        }
+
+        m_pending.push_back(pending_event{*event, 0});
+    }
+
+    if (valid != contents.size())
+    {
+        std::cerr << std::format("progress journal: dropping {} damaged bytes at the end of {}\n", contents.size() - valid, m_path.string());
+
+        if (::ftruncate(m_descriptor, static_cast<off_t>(valid)) != 0)
+        {
+            throw std::system_error{errno, std::generic_category(), std::format("progress journal {} cannot be repaired", m_path.string())};
+        }
+    }
+
+    if (!m_pending.empty())
+    {
+        std::clog << std::format("progress journal: replaying {} events from {}\n", m_pending.size(), m_path.string());
+    }
+
+    m_file_size = valid;
+}
+
+void progress_journal::write_group(std::unique_lock<std::mutex>& lock)
+{
+    m_writing = true;
+    std::string const group{std::exchange(m_staged, {})};
+    std::vector<progress_event> const events{std::exchange(m_staged_events, {})};
+    uint64_t const last_sequence{m_staged_sequence};
+    std::size_t const good_size{m_file_size};
+    bool durable{true};
+    lock.unlock();
+
+    try
+    {
+        // a failed rollback leaves a torn record that later appends would follow, so nothing is written until it succeeds
+        if (m_torn && ::ftruncate(m_descriptor, static_cast<off_t>(good_size)) != 0)
+        {
+            throw std::system_error{errno, std::generic_category(), "progress journal cannot cut off a torn record"};
+        }
+
+        m_torn = false;
+        write_all(m_descriptor, group);
+    }
+    catch (std::exception const& exp)
+    {
+        // losing the journal should not fail requests, the events are still delivered while the process lives
+        durable = false;
+        m_torn = ::ftruncate(m_descriptor, static_cast<off_t>(good_size)) != 0;
+        std::cerr << std::format("progress journal: {} events are kept in memory only: {}\n", events.size(), exp.what());
+    }
+
+    lock.lock();
+    m_file_size = durable ? good_size + group.size() : good_size;
+
+    for (progress_event const& event: events)
+    {
+        m_pending.push_back(pending_event{event, 0});
+    }
+
+    m_synced_sequence = last_sequence;
+    m_writing = false;
+    m_synced.notify_all();
+
+    if (m_pending.size() >= flush_batch_size)
+    {
+        m_wake.notify_one();
+    }
+}
+
+void progress_journal::run(std::stop_token token)
+{
+    std::unique_lock lock{m_mutex};
+    bool stalled{};
+
+    while (!token.stop_requested())
+    {
+        // a full batch flushes early unless the database was just unreachable, then the interval is a back-off
+        m_wake.wait_for(lock, token, m_flush_interval, [this, &stalled] { return !stalled && m_pending.size() >= flush_batch_size; });
+        lock.unlock();
+        stalled = !flush_to_database();
+        lock.lock();
+    }
+}
+
+bool progress_journal::flush_to_database()
+{
+    std::vector<pending_event> batch{};
+
+    {
+        std::lock_guard const lock{m_mutex};
+        auto const end{m_pending.begin() + static_cast<std::ptrdiff_t>(std::min(m_pending.size(), flush_batch_size))};
+        batch.assign(std::make_move_iterator(m_pending.begin()), std::make_move_iterator(end));
+        m_pending.erase(m_pending.begin(), end);
+    }
+
+    if (batch.empty())
+    {
+        return true;
+    }
+
+    bool reachable{true};
+
+    try
+    {
+        std::vector<progress_event> events{};
+        events.reserve(batch.size());
+        std::ranges::transform(batch, std::back_inserter(events), &pending_event::event);
+        m_database->record_progress(events);
+        batch.clear();
+
+        if (m_delivered)
+        {
+            m_delivered(events);
+        }
+    }
+    catch (pqxx::sql_error const& exp)
+    {
+        std::cerr << std::format("progress journal: batch of {} events was refused, retrying them one by one: {}\n", batch.size(), exp.what());
+        reachable = deliver_individually(batch);
+    }
+    catch (std::exception const& exp)
+    {
+        std::cerr << std::format("progress journal: database is unavailable, {} events stay journaled: {}\n", batch.size(), exp.what());
+        reachable = false;
+    }
+
+    std::unique_lock lock{m_mutex};
+    m_pending.insert(m_pending.begin(), std::make_move_iterator(batch.begin()), std::make_move_iterator(batch.end()));
+    compact(lock);
+    return reachable;
+}
+
+bool progress_journal::deliver_individually(std::vector<pending_event>& batch)
+{
+    std::vector<pending_event> retained{};
+
+    for (auto pending{batch.begin()}; pending != batch.end(); ++pending)
+    {
+        try
+        {
+            m_database->record_progress({pending->event});
+
+            if (m_delivered)
+            {
+                m_delivered(std::span{&pending->event, 1});
+            }
+        }
+        catch (pqxx::sql_error const& exp)
+        {
+            // refusals can be transient like deadlocks, so an event only moves aside after a few of them
+            // clients were told it is recorded, so it stays in the journal until the dead letter file holds it
+            if (++pending->rejections < max_rejections || !dead_letter(pending->event))
+            {
+                retained.push_back(*pending);
+            }
+            else
+            {
+                std::cerr << std::format("progress journal: moved event of user {} on card {} to {} after {} refusals: {}\n", pending->event.user_id,
+                                         pending->event.card_id, dead_letter_path().string(), pending->rejections, exp.what());
+            }
+        }
+        catch (std::exception const&)
+        {
+            retained.insert(retained.end(), pending, batch.end());
+            batch = std::move(retained);
+            return false;
+        }
+    }
+
+    batch = std::move(retained);
+    return true;
+}
+
+std::filesystem::path progress_journal::dead_letter_path() const
+{
+    return std::filesystem::path{m_path}.concat(".rejected");
+}
+
+bool progress_journal::dead_letter(progress_event const& event) const
+{
+    std::string contents{};
+    encode(event, contents);
+
+    try
+    {
+        int const descriptor{open_journal(dead_letter_path(), O_WRONLY)};
+
+        try
+        {
+            write_all(descriptor, contents);
+        }
+        catch (...)
+        {
+            ::close(descriptor);
+            throw;
+        }
+
+        ::close(descriptor);
+        return true;
+    }
+    catch (std::exception const& exp)
+    {
+        std::cerr << std::format("progress journal: refused event of user {} on card {} stays journaled: {}\n", event.user_id, event.card_id, exp.what());
+        return false;
+    }
+}
+
+void progress_journal::compact(std::unique_lock<std::mutex>& lock)
+{
+    m_synced.wait(lock, [this] { return !m_writing; });
+
+    // everything in the file reached the database once nothing is pending, staged records are not written yet
+    if (m_pending.empty())
+    {
+        if ((m_file_size > 0 || m_torn) && ::ftruncate(m_descriptor, 0) == 0)
+        {
+            m_file_size = 0;
+            m_torn = false;
+        }
+    }
+    else if (m_file_size > compaction_threshold)
+    {
+        std::filesystem::path const compacted{std::filesystem::path{m_path}.concat(".compact")};
+        std::string contents{};
+        contents.reserve(m_pending.size() * record_size);
+
+        for (pending_event const& pending: m_pending)
+        {
+            encode(pending.event, contents);
+        }
+
+        try
+        {
+            int const descriptor{open_journal(compacted, O_RDWR | O_TRUNC)};
+
+            try
+            {
+                write_all(descriptor, contents);
+                std::filesystem::rename(compacted, m_path);
+            }
+            catch (...)
+            {
+                ::close(descriptor);
+                throw;
+            }
+
+            ::close(std::exchange(m_descriptor, descriptor));
+            m_file_size = contents.size();
+            m_torn = false;
+        }
+        catch (std::exception const& exp)
+        {
+            std::cerr << std::format("progress journal: {} could not be compacted: {}\n", m_path.string(), exp.what());
+        }
+    }
+}
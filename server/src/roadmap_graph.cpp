@@ -0,0 +1,225 @@
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <queue>
+#include <flashback/roadmap_graph.hpp>
+
+using namespace flashback;
+
+namespace
+{
+constexpr std::size_t word_bits{64};
+} // namespace
+
+roadmap_graph::roadmap_graph(std::vector<Milestone> milestones, std::vector<Requirement> const& requirements)
+    : m_milestones{std::move(milestones)}
+    , m_offsets(m_milestones.size() + 1)
+    , m_words{(m_milestones.size() + word_bits - 1) / word_bits}
+    , m_acyclic{true}
+{
+    // indices follow positions so that every traversal below stays in roadmap order
+    std::ranges::stable_sort(m_milestones, std::less{}, &Milestone::position);
+    m_indices.reserve(m_milestones.size());
+
+    for (std::size_t index{}; index < m_milestones.size(); ++index)
+    {
+        m_indices.emplace(node_key(m_milestones[index].id(), m_milestones[index].level()), index);
+    }
+
+    std::vector<std::pair<std::size_t, Requirement const*>> edges{};
+    edges.reserve(requirements.size());
+
+    for (Requirement const& requirement: requirements)
+    {
+        auto const dependent{m_indices.find(node_key(requirement.milestone_id(), requirement.milestone_level()))};
+        auto const required{m_indices.find(node_key(requirement.required_milestone().id(), requirement.required_milestone().level()))};
+
+        if (dependent != m_indices.end() && required != m_indices.end())
+        {
+            edges.emplace_back(dependent->second, &requirement);
+            ++m_offsets[dependent->second + 1];
+        }
+    }
+
+    for (std::size_t index{1}; index < m_offsets.size(); ++index)
+    {
+        m_offsets[index] += m_offsets[index - 1];
+    }
+
+    std::vector<std::size_t> cursor(m_offsets.begin(), m_offsets.end() - 1);
+    m_targets.resize(edges.size());
+    m_requirements.resize(edges.size());
+
+    for (auto const& [dependent, requirement]: edges)
+    {
+        std::size_t const slot{cursor[dependent]++};
+        m_targets[slot] = m_indices.at(node_key(requirement->required_milestone().id(), requirement->required_milestone().level()));
+        m_requirements[slot] = requirement->required_milestone();
+    }
+
+    sort_topologically();
+    close_transitively();
+}
+
+std::vector<Milestone> roadmap_graph::ordered_milestones() const
+{
+    std::vector<Milestone> ordered{};
+    ordered.reserve(m_order.size());
+
+    for (std::size_t const index: m_order)
+    {
+        ordered.push_back(m_milestones[index]);
+    }
+
+    return ordered;
+}
+
+bool roadmap_graph::depends_on(Milestone const& milestone, Milestone const& required) const
+{
+    auto const dependent_index{m_indices.find(node_key(milestone.id(), milestone.level()))};
+    auto const required_index{m_indices.find(node_key(required.id(), required.level()))};
+
+    return dependent_index != m_indices.end() && required_index != m_indices.end() && closure_contains(dependent_index->second, required_index->second);
+}
+
+bool roadmap_graph::would_form_cycle(Milestone const& milestone, Milestone const& required) const
+{
+    return node_key(milestone.id(), milestone.level()) == node_key(required.id(), required.level()) || depends_on(required, milestone);
+}
+
+bool roadmap_graph::is_acyclic() const noexcept
+{
+    return m_acyclic;
+}
+
+void roadmap_graph::fill(google::protobuf::RepeatedPtrField<MilestoneNode>& nodes) const
+{
+    nodes.Reserve(nodes.size() + static_cast<int>(m_order.size()));
+
+    for (std::size_t const index: m_order)
+    {
+        MilestoneNode* node{nodes.Add()};
+        *node->mutable_milestone() = m_milestones[index];
+
+        for (std::size_t slot{m_offsets[index]}; slot < m_offsets[index + 1]; ++slot)
+        {
+            *node->add_requirements() = m_requirements[slot];
+        }
+
+        for (std::size_t word{}; word < m_words; ++word)
+        {
+            for (uint64_t bits{m_closure[index * m_words + word]}; bits != 0; bits &= bits - 1)
+            {
+                *node->add_prerequisites() = m_milestones[word * word_bits + static_cast<std::size_t>(std::countr_zero(bits))];
+            }
+        }
+    }
+}
+
+uint64_t roadmap_graph::node_key(uint64_t const milestone_id, expertise_level const level) noexcept
+{
+    return static_cast<uint64_t>(level) << 56 | milestone_id;
+}
+
+bool roadmap_graph::closure_contains(std::size_t const row, std::size_t const column) const noexcept
+{
+    return (m_closure[row * m_words + column / word_bits] >> (column % word_bits) & 1) != 0;
+}
+
+void roadmap_graph::sort_topologically()
+{
+    std::vector<std::size_t> pending(m_milestones.size());
+    std::vector<std::size_t> dependent_offsets(m_milestones.size() + 1);
+    std::vector<std::size_t> dependents(m_targets.size());
+    std::vector<bool> placed(m_milestones.size());
+    std::priority_queue<std::size_t, std::vector<std::size_t>, std::greater<>> ready{};
+
+    for (std::size_t index{}; index < m_milestones.size(); ++index)
+    {
+        pending[index] = m_offsets[index + 1] - m_offsets[index];
+
+        for (std::size_t slot{m_offsets[index]}; slot < m_offsets[index + 1]; ++slot)
+        {
+            ++dependent_offsets[m_targets[slot] + 1];
+        }
+    }
+
+    for (std::size_t index{1}; index < dependent_offsets.size(); ++index)
+    {
+        dependent_offsets[index] += dependent_offsets[index - 1];
+    }
+
+    std::vector<std::size_t> cursor(dependent_offsets.begin(), dependent_offsets.end() - 1);
+
+    for (std::size_t index{}; index < m_milestones.size(); ++index)
+    {
+        for (std::size_t slot{m_offsets[index]}; slot < m_offsets[index + 1]; ++slot)
+        {
+            dependents[cursor[m_targets[slot]]++] = index;
+        }
+
+        if (pending[index] == 0)
+        {
+            ready.push(index);
+        }
+    }
+
+    m_order.reserve(m_milestones.size());
+
+    while (!ready.empty())
+    {
+        std::size_t const index{ready.top()};
+        ready.pop();
+        m_order.push_back(index);
+        placed[index] = true;
+
+        for (std::size_t slot{dependent_offsets[index]}; slot < dependent_offsets[index + 1]; ++slot)
+        {
+            if (--pending[dependents[slot]] == 0)
+            {
+                ready.push(dependents[slot]);
+            }
+        }
+    }
+
+    // requirements stored before cycles were rejected may still loop, those milestones are kept rather than dropped
+    for (std::size_t index{}; index < m_milestones.size(); ++index)
+    {
+        if (!placed[index])
+        {
+            m_order.push_back(index);
+            m_acyclic = false;
+        }
+    }
+}
+
+void roadmap_graph::close_transitively()
+{
+    m_closure.assign(m_milestones.size() * m_words, 0);
+
+    // in topological order every requirement row is complete before it is merged, cycles need passes until nothing changes
+    for (bool changed{true}; changed;)
+    {
+        changed = false;
+
+        for (std::size_t const index: m_order)
+        {
+            uint64_t* const row{m_closure.data() + index * m_words};
+
+            for (std::size_t slot{m_offsets[index]}; slot < m_offsets[index + 1]; ++slot)
+            {
+                std::size_t const required{m_targets[slot]};
+                uint64_t const* const required_row{m_closure.data() + required * m_words};
+
+                for (std::size_t word{}; word < m_words; ++word)
+                {
+                    uint64_t const merged{row[word] | required_row[word] | (word == required / word_bits ? uint64_t{1} << (required % word_bits) : 0)};
+                    changed = changed || merged != row[word];
+                    row[word] = merged;
+                }
+            }
+        }
+
+        changed = changed && !m_acyclic;
+    }
+}
@@ -3,21 +3,81 @@
 #include <chrono>
 #include <format>
 #include <iostream>
+#include <iterator>
+#include <thread>
 #include <sodium.h>
 #include <curl/curl.h>
 #include <nlohmann/json.hpp>
 #include <flashback/server.hpp>
 #include <flashback/exception.hpp>
+#include <flashback/ordering.hpp>
+#include <flashback/typeahead_session.hpp>
 
 using namespace flashback;
 
-server::server(std::shared_ptr<basic_database> database)
+server::server(std::shared_ptr<basic_database> database, std::filesystem::path journal_path, std::filesystem::path history_path)
     : m_database{database}
+    , m_card_durations{history_path.empty() ? history_path : history_path / "card.durations", card_durations_capacity, card_duration_fallback, card_duration_compression,
+                       card_durations_save_interval}
+    , m_study_history{std::move(history_path), study_history_users_capacity, study_history_save_interval}
 {
     if (sodium_init() < 0)
     {
         throw std::runtime_error("server: sodium library cannot be initialized");
     }
+
+    SetMessageAllocatorFor_GetStudyResources(&m_study_resources_allocator);
+    SetMessageAllocatorFor_GetBlocks(&m_blocks_allocator);
+
+    // a catalog that cannot be listed stays unloaded and its searches go to the database,
+    // the schema has no argumentless get_subjects, get_resources, get_providers or get_presenters yet so all four fall back until it does
+    auto const load_index = [](auto& index, auto const& listing, std::string_view const catalog) {
+        try
+        {
+            index.assign(listing());
+        }
+        catch (std::exception const& exp)
+        {
+            std::cerr << std::format("server: {} are searched in the database, loading them failed: {}\n", catalog, exp.what());
+        }
+    };
+
+    load_index(m_subject_index, [this] { return m_database->get_subjects(); }, "subjects");
+    load_index(m_resource_index, [this] { return m_database->get_resources(); }, "resources");
+    load_index(m_provider_index, [this] { return m_database->get_providers(); }, "providers");
+    load_index(m_presenter_index, [this] { return m_database->get_presenters(); }, "presenters");
+
+    if (!journal_path.empty())
+    {
+        try
+        {
+            m_progress_journal = std::make_unique<progress_journal>(journal_path, database, progress_flush_interval, [this](std::span<progress_event const> events) {
+                for (progress_event const& event: events)
+                {
+                    invalidate_progress_weights(event.user_id);
+                    m_assimilation_state.invalidate(event.user_id);
+                    m_practice_scheduler.invalidate(event.user_id);
+                }
+
+                record_study_history(events);
+
+                // saved before the journal lets go of the events, a crash in between replays them into history as it does into the database
+                try
+                {
+                    m_study_history.save();
+                }
+                catch (std::exception const& exp)
+                {
+                    std::cerr << std::format("server: study history will be saved later: {}\n", exp.what());
+                }
+            });
+        }
+        catch (std::exception const& exp)
+        {
+            // progress is written straight to the database as it was before journaling
+            std::cerr << std::format("server: running without progress journal {}: {}\n", journal_path.string(), exp.what());
+        }
+    }
 }
 
 grpc::Status server::SignIn(grpc::ServerContext* context, const SignInRequest* request, SignInResponse* response)
@@ -603,9 +663,9 @@ grpc::Status server::GetRoadmaps(grpc::ServerContext* context, GetRoadmapsReques
     return status;
 }
 
-grpc::Status server::GetStudyResources(grpc::ServerContext* context, GetStudyResourcesRequest const* request, GetStudyResourcesResponse* response)
+grpc::Status server::GetHomeBundle(grpc::ServerContext* context, GetHomeBundleRequest const* request, GetHomeBundleResponse* response)
 {
-    grpc::Status status{grpc::StatusCode::INTERNAL, "internal error"};
+    grpc::Status status{grpc::StatusCode::INTERNAL, {}};
 
     try
     {
@@ -615,29 +675,58 @@ grpc::Status server::GetStudyResources(grpc::ServerContext* context, GetStudyRes
         }
         else if (!user_is_authorized(request->user()))
         {
-            std::clog << std::format("client {} unauthorized access to get study resource\n", request->user().token());
+            std::clog << std::format("client {} unauthorized access to get home bundle\n", request->user().token());
             status = grpc::Status{grpc::StatusCode::PERMISSION_DENIED, "user is not authorized"};
         }
         else
         {
             std::shared_ptr<User> const user{m_database->get_user(request->user().token(), request->user().device())};
-            for (Resource& resource: m_database->get_study_resources(user->id()))
+            uint64_t const user_id{user->id()};
+
+            m_database->get_home_bundle(user_id, *response->mutable_roadmap(), *response->mutable_study(), *response->mutable_nerve());
+
+            for (Weight const& weight: *load_progress_weights(user_id))
             {
-                StudyResource* study = response->add_study();
+                *response->add_weight() = weight;
+            }
 
-                for (Provider const& provider: m_database->get_providers(resource.id()))
-                {
-                    *resource.add_providers() = provider;
-                }
+            std::clog << std::format("client {} collected home bundle with {} roadmaps, {} study resources and {} nerves\n", request->user().token(),
+                                     response->roadmap_size(), response->study_size(), response->nerve_size());
+            status = grpc::Status{grpc::StatusCode::OK, {}};
+        }
+    }
+    catch (client_exception const& exp)
+    {
+        std::cerr << std::format("client {} {}\n", request->user().token(), exp.what());
+        status = grpc::Status{grpc::StatusCode::UNAVAILABLE, exp.what()};
+    }
+    catch (std::exception const& exp)
+    {
+        std::cerr << std::format("server: {}\n", exp.what());
+    }
 
-                for (Presenter const& presenter: m_database->get_presenters(resource.id()))
-                {
-                    *resource.add_presenters() = presenter;
-                }
+    return status;
+}
 
-                *study->mutable_resource() = resource;
-                *study->mutable_milestone() = m_database->get_related_milestone(user->id(), resource.id());
-            }
+grpc::Status server::GetStudyResources(grpc::ServerContext* context, GetStudyResourcesRequest const* request, GetStudyResourcesResponse* response)
+{
+    grpc::Status status{grpc::StatusCode::INTERNAL, "internal error"};
+
+    try
+    {
+        if (!request->has_user() || !session_is_valid(request->user()))
+        {
+            status = grpc::Status{grpc::StatusCode::UNAUTHENTICATED, "invalid user"};
+        }
+        else if (!user_is_authorized(request->user()))
+        {
+            std::clog << std::format("client {} unauthorized access to get study resource\n", request->user().token());
+            status = grpc::Status{grpc::StatusCode::PERMISSION_DENIED, "user is not authorized"};
+        }
+        else
+        {
+            std::shared_ptr<User> const user{m_database->get_user(request->user().token(), request->user().device())};
+            m_database->get_study_resources(user->id(), *response->mutable_study());
             std::clog << std::format("client {} collected {} study resources\n", user->token(), response->study_size());
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
@@ -654,6 +743,13 @@ grpc::Status server::GetStudyResources(grpc::ServerContext* context, GetStudyRes
     return status;
 }
 
+grpc::ServerUnaryReactor* server::GetStudyResources(grpc::CallbackServerContext* context, GetStudyResourcesRequest const* request, GetStudyResourcesResponse* response)
+{
+    grpc::ServerUnaryReactor* reactor{context->DefaultReactor()};
+    m_database_executor.submit([this, reactor, request, response] { reactor->Finish(GetStudyResources(static_cast<grpc::ServerContext*>(nullptr), request, response)); });
+    return reactor;
+}
+
 grpc::Status server::RenameRoadmap(grpc::ServerContext* context, RenameRoadmapRequest const* request, RenameRoadmapResponse* response)
 {
     grpc::Status status{grpc::StatusCode::INTERNAL, "internal error"};
@@ -718,6 +814,7 @@ grpc::Status server::RemoveRoadmap(grpc::ServerContext* context, RemoveRoadmapRe
             std::clog << std::format("client {} removed roadmap {}\n", request->user().token(), request->roadmap().id());
             std::shared_ptr<User> const user{m_database->get_user(request->user().token(), request->user().device())};
             m_database->remove_roadmap(request->roadmap().id());
+            invalidate_roadmap_graph(request->roadmap().id());
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -743,6 +840,10 @@ grpc::Status server::SearchRoadmaps(grpc::ServerContext* context, SearchRoadmaps
         {
             status = grpc::Status{grpc::StatusCode::UNAUTHENTICATED, "invalid user"};
         }
+        else if (!decode_page_token(request->page_token()))
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid page token"};
+        }
         else if (!user_is_authorized(request->user()))
         {
             std::clog << std::format("client {} unauthorized access to get search roadmaps\n", request->user().token());
@@ -751,11 +852,13 @@ grpc::Status server::SearchRoadmaps(grpc::ServerContext* context, SearchRoadmaps
         else
         {
             std::shared_ptr<User> const user{m_database->get_user(request->user().token(), request->user().device())};
-            for (auto const& [similarity, matched]: m_database->search_roadmaps(user->id(), request->token()))
+            uint64_t const offset{*decode_page_token(request->page_token())};
+            uint64_t const limit{page_limit(request->limit())};
+            std::vector<Roadmap> matches{m_database->search_roadmaps(user->id(), request->token(), limit + 1, offset)};
+            response->set_next_page_token(next_page(matches, offset, limit));
+            for (Roadmap& matched: matches)
             {
-                Roadmap* roadmap = response->add_roadmap();
-                roadmap->set_id(matched.id());
-                roadmap->set_name(matched.name());
+                *response->add_roadmap() = std::move(matched);
             }
             std::clog << std::format("client {} collected {} roadmaps by searching {}\n", request->user().token(), response->roadmap_size(), request->token());
             status = grpc::Status{grpc::StatusCode::OK, {}};
@@ -838,6 +941,10 @@ grpc::Status server::GetMilestones(grpc::ServerContext* context, GetMilestonesRe
         {
             status = grpc::Status{grpc::StatusCode::UNAUTHENTICATED, "invalid user"};
         }
+        else if (!decode_page_token(request->page_token()))
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid page token"};
+        }
         else if (!user_is_authorized(request->user()))
         {
             std::clog << std::format("client {} unauthorized access to get milestones\n", request->user().token());
@@ -845,10 +952,10 @@ grpc::Status server::GetMilestones(grpc::ServerContext* context, GetMilestonesRe
         }
         else
         {
-            for (Milestone const& milestone: m_database->get_milestones(request->roadmap_id()))
-            {
-                *response->add_milestones() = milestone;
-            }
+            uint64_t const after{*decode_page_token(request->page_token())};
+            uint64_t const limit{list_page_limit(request->page_size())};
+            m_database->get_milestones(request->roadmap_id(), after, limit + 1, *response->mutable_milestones());
+            response->set_next_page_token(next_cursor(*response->mutable_milestones(), limit, [](Milestone const& milestone) { return milestone.position(); }));
             std::clog << std::format("client {} collected {} milestones from roadmap {}\n", request->user().token(), response->milestones_size(), request->roadmap_id());
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
@@ -908,6 +1015,7 @@ grpc::Status server::AddMilestone(grpc::ServerContext* context, AddMilestoneRequ
                                          request->position());
                 *response->mutable_milestone() = milestone;
             }
+            invalidate_roadmap_graph(request->roadmap_id());
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -940,10 +1048,23 @@ grpc::Status server::AddRequirement(grpc::ServerContext* context, AddRequirement
         }
         else
         {
-            std::clog << std::format("client {} added milestone {} as a requirement for milestone {} in roadmap {}\n", request->user().token(), request->milestone().position(),
-                                     request->required_milestone().position(), request->roadmap().id());
-            m_database->add_requirement(request->roadmap().id(), request->milestone(), request->required_milestone());
-            status = grpc::Status{grpc::StatusCode::OK, {}};
+            // the cycle check and the write are one step for each roadmap, two requirements checked against the same graph could close a cycle together
+            std::lock_guard const lock{m_requirement_writes[request->roadmap().id() % m_requirement_writes.size()]};
+
+            if (load_roadmap_graph(request->roadmap().id())->would_form_cycle(request->milestone(), request->required_milestone()))
+            {
+                std::clog << std::format("client {} tried to make milestone {} depend on itself through milestone {} in roadmap {}\n", request->user().token(),
+                                         request->milestone().id(), request->required_milestone().id(), request->roadmap().id());
+                status = grpc::Status{grpc::StatusCode::FAILED_PRECONDITION, "requirement forms a cycle"};
+            }
+            else
+            {
+                std::clog << std::format("client {} added milestone {} as a requirement for milestone {} in roadmap {}\n", request->user().token(),
+                                         request->milestone().position(), request->required_milestone().position(), request->roadmap().id());
+                m_database->add_requirement(request->roadmap().id(), request->milestone(), request->required_milestone());
+                invalidate_roadmap_graph(request->roadmap().id());
+                status = grpc::Status{grpc::StatusCode::OK, {}};
+            }
         }
     }
     catch (client_exception const& exp)
@@ -996,6 +1117,46 @@ grpc::Status server::GetRequirements(grpc::ServerContext* context, GetRequiremen
     return status;
 }
 
+grpc::Status server::GetRoadmapGraph(grpc::ServerContext* context, GetRoadmapGraphRequest const* request, GetRoadmapGraphResponse* response)
+{
+    grpc::Status status{grpc::StatusCode::INTERNAL, {}};
+
+    try
+    {
+        if (!request->has_user() || !session_is_valid(request->user()))
+        {
+            status = grpc::Status{grpc::StatusCode::UNAUTHENTICATED, "invalid user"};
+        }
+        else if (!request->has_roadmap() || request->roadmap().id() == 0)
+        {
+            std::clog << std::format("client {} tried to get the graph of an invalid roadmap\n", request->user().token());
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid roadmap"};
+        }
+        else if (!user_is_authorized(request->user()))
+        {
+            std::clog << std::format("client {} unauthorized access to get roadmap graph\n", request->user().token());
+            status = grpc::Status{grpc::StatusCode::PERMISSION_DENIED, "user is not authorized"};
+        }
+        else
+        {
+            load_roadmap_graph(request->roadmap().id())->fill(*response->mutable_nodes());
+            status = grpc::Status{grpc::StatusCode::OK, {}};
+            std::clog << std::format("client {} collected {} milestones in dependency order from roadmap {}\n", request->user().token(), response->nodes_size(),
+                                     request->roadmap().id());
+        }
+    }
+    catch (client_exception const& exp)
+    {
+        std::cerr << std::format("client {} tried to get roadmap graph but failed: {}\n", request->user().token(), exp.what());
+    }
+    catch (std::exception const& exp)
+    {
+        std::cerr << std::format("server: {}\n", exp.what());
+    }
+
+    return status;
+}
+
 grpc::Status server::CreateSubject(grpc::ServerContext* context, CreateSubjectRequest const* request, CreateSubjectResponse* response)
 {
     grpc::Status status{grpc::StatusCode::INTERNAL, {}};
@@ -1018,7 +1179,10 @@ grpc::Status server::CreateSubject(grpc::ServerContext* context, CreateSubjectRe
         }
         else
         {
+            std::unique_lock writes{m_subject_writes};
             Subject const subject{m_database->create_subject(request->name())};
+            m_subject_index.upsert(subject);
+            writes.unlock();
             *response->mutable_subject() = subject;
             std::clog << std::format("client {} created subject {}\n", request->user().token(), subject.id());
             status = grpc::Status{grpc::StatusCode::OK, ""};
@@ -1055,6 +1219,10 @@ grpc::Status server::SearchSubjects(grpc::ServerContext* context, SearchSubjects
             std::clog << std::format("client {} tried to search subjects with empty search string\n", request->user().token());
             status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid search string"};
         }
+        else if (!decode_page_token(request->page_token()))
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid page token"};
+        }
         else if (!user_is_authorized(request->user()))
         {
             std::clog << std::format("client {} unauthorized access to x\n", request->user().token());
@@ -1062,11 +1230,15 @@ grpc::Status server::SearchSubjects(grpc::ServerContext* context, SearchSubjects
         }
         else
         {
-            for (auto const& [position, subject]: m_database->search_subjects(request->token()))
+            uint64_t const offset{*decode_page_token(request->page_token())};
+            uint64_t const limit{page_limit(request->limit())};
+            std::vector<Subject> matches{m_subject_index.loaded() ? m_subject_index.search(request->token(), limit + 1, offset) : m_database->search_subjects(request->token(), limit + 1, offset)};
+            response->set_next_page_token(next_page(matches, offset, limit));
+            for (uint64_t position{offset + 1}; Subject& subject: matches)
             {
                 MatchingSubject* matching_subject = response->add_subjects();
-                matching_subject->set_position(position);
-                matching_subject->set_allocated_subject(std::make_unique<Subject>(subject).release());
+                matching_subject->set_position(position++);
+                *matching_subject->mutable_subject() = std::move(subject);
             }
 
             std::clog << std::format("client {} collected {} subjects by searching {}\n", request->user().token(), response->subjects_size(), request->token());
@@ -1125,6 +1297,7 @@ grpc::Status server::ReorderMilestone(grpc::ServerContext* context, ReorderMiles
             std::clog << std::format("client {} reordered milestone {} to {} in roadmap {}\n", request->user().token(), request->current_position(), request->target_position(),
                                      request->roadmap().id());
             m_database->reorder_milestone(request->roadmap().id(), request->current_position(), request->target_position());
+            invalidate_roadmap_graph(request->roadmap().id());
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -1140,6 +1313,58 @@ grpc::Status server::ReorderMilestone(grpc::ServerContext* context, ReorderMiles
     return status;
 }
 
+grpc::Status server::ApplyMilestoneOrdering(grpc::ServerContext* context, ApplyMilestoneOrderingRequest const* request, ApplyMilestoneOrderingResponse* response)
+{
+    grpc::Status status{grpc::StatusCode::INTERNAL, {}};
+
+    try
+    {
+        if (!request->has_user() || !session_is_valid(request->user()))
+        {
+            status = grpc::Status{grpc::StatusCode::UNAUTHENTICATED, "invalid user"};
+        }
+        else if (!request->has_roadmap() || request->roadmap().id() == 0)
+        {
+            std::clog << std::format("client {} tried to order milestones of an invalid roadmap\n", request->user().token());
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid roadmap"};
+        }
+        else if (request->position().empty() || static_cast<uint64_t>(request->position_size()) > max_list_page_size ||
+                 !is_complete_ordering(std::span{request->position().data(), static_cast<std::size_t>(request->position_size())}))
+        {
+            std::clog << std::format("client {} tried to order milestones of roadmap {} with an incomplete ordering\n", request->user().token(), request->roadmap().id());
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid ordering"};
+        }
+        else if (!user_is_verified(request->user()))
+        {
+            std::clog << std::format("client {} tried to order milestones without verification\n", request->user().token());
+            status = grpc::Status{grpc::StatusCode::PERMISSION_DENIED, "user is not verified"};
+        }
+        else if (!user_is_authorized(request->user()))
+        {
+            std::clog << std::format("client {} unauthorized access to order milestones\n", request->user().token());
+            status = grpc::Status{grpc::StatusCode::PERMISSION_DENIED, "user is not authorized"};
+        }
+        else
+        {
+            std::clog << std::format("client {} ordered {} milestones of roadmap {}\n", request->user().token(), request->position_size(), request->roadmap().id());
+            m_database->apply_milestone_ordering(request->roadmap().id(), std::vector<uint64_t>{request->position().begin(), request->position().end()});
+            invalidate_roadmap_graph(request->roadmap().id());
+            status = grpc::Status{grpc::StatusCode::OK, {}};
+        }
+    }
+    catch (client_exception const& exp)
+    {
+        std::cerr << std::format("client {} {}\n", request->user().token(), exp.what());
+        status = grpc::Status{grpc::StatusCode::UNAVAILABLE, exp.what()};
+    }
+    catch (std::exception const& exp)
+    {
+        std::cerr << std::format("server: {}\n", exp.what());
+    }
+
+    return status;
+}
+
 grpc::Status server::RemoveMilestone(grpc::ServerContext* context, RemoveMilestoneRequest const* request, RemoveMilestoneResponse* response)
 {
     grpc::Status status{grpc::StatusCode::INTERNAL, {}};
@@ -1175,6 +1400,7 @@ grpc::Status server::RemoveMilestone(grpc::ServerContext* context, RemoveMilesto
             std::clog << std::format("client {} removed milestone {} in roadmap {}\n", request->user().token(), request->roadmap().id(), request->milestone().id(),
                                      request->roadmap().id());
             m_database->remove_milestone(request->roadmap().id(), request->milestone().id());
+            invalidate_roadmap_graph(request->roadmap().id());
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -1225,6 +1451,7 @@ grpc::Status server::ChangeMilestoneLevel(grpc::ServerContext* context, ChangeMi
             std::clog << std::format("client {} changed the level of milestone {} in roadmap {} to {}\n", request->user().token(), request->milestone().id(),
                                      request->roadmap().id(), database::level_to_string(request->milestone().level()));
             m_database->change_milestone_level(request->roadmap().id(), request->milestone().id(), request->milestone().level());
+            invalidate_roadmap_graph(request->roadmap().id());
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -1273,7 +1500,16 @@ grpc::Status server::RenameSubject(grpc::ServerContext* context, RenameSubjectRe
         else
         {
             std::clog << std::format("client {} renamed subject {} to {}\n", request->user().token(), request->id(), request->name());
-            m_database->rename_subject(request->id(), request->name());
+            Subject renamed{};
+            renamed.set_id(request->id());
+            renamed.set_name(request->name());
+            {
+                // the index sees subject writes in the order the database applied them
+                std::lock_guard const writes{m_subject_writes};
+                m_database->rename_subject(request->id(), request->name());
+                m_subject_index.upsert(std::move(renamed));
+            }
+            invalidate_roadmap_graphs();
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -1317,7 +1553,14 @@ grpc::Status server::RemoveSubject(grpc::ServerContext* context, RemoveSubjectRe
         else
         {
             std::clog << std::format("client {} removed subject {}\n", request->user().token(), request->subject().id());
-            m_database->remove_subject(request->subject().id());
+            {
+                std::lock_guard const writes{m_subject_writes};
+                m_database->remove_subject(request->subject().id());
+                m_subject_index.erase(request->subject().id());
+            }
+            invalidate_progress_weights();
+            invalidate_roadmap_graphs();
+            invalidate_subject_caches(request->subject().id());
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -1360,7 +1603,15 @@ grpc::Status server::MergeSubjects(grpc::ServerContext* context, MergeSubjectsRe
         else
         {
             std::clog << std::format("client {} merged subject {} to {}\n", request->user().token(), request->source_subject().id(), request->target_subject().id());
-            m_database->merge_subjects(request->source_subject().id(), request->target_subject().id());
+            {
+                std::lock_guard const writes{m_subject_writes};
+                m_database->merge_subjects(request->source_subject().id(), request->target_subject().id());
+                m_subject_index.erase(request->source_subject().id());
+            }
+            invalidate_progress_weights();
+            invalidate_roadmap_graphs();
+            invalidate_subject_caches(request->source_subject().id());
+            invalidate_subject_caches(request->target_subject().id());
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -1458,7 +1709,16 @@ grpc::Status server::CreateResource(grpc::ServerContext* context, CreateResource
         {
             std::shared_ptr<User> const user{m_database->get_user(request->user().token(), request->user().device())};
             Resource* resource = response->mutable_resource();
+            std::unique_lock writes{m_resource_writes};
             *resource = m_database->create_resource(request->resource());
+
+            if (resource->type() != Resource::nerve)
+            {
+                m_resource_index.upsert(*resource);
+            }
+
+            writes.unlock();
+
             std::clog << std::format("client {} created resource {}\n", request->user().token(), resource->id());
 
             std::clog << std::format("client {} added resource {} to subject {}\n", request->user().token(), resource->id(), request->subject().id());
@@ -1528,6 +1788,7 @@ grpc::Status server::AddResourceToSubject(grpc::ServerContext* context, AddResou
         {
             std::clog << std::format("client {} added resource {} to subject {}\n", request->user().token(), request->resource().id(), request->subject().id());
             m_database->add_resource_to_subject(request->resource().id(), request->subject().id());
+            invalidate_progress_weights();
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -1581,6 +1842,7 @@ grpc::Status server::DropResourceFromSubject(grpc::ServerContext* context, DropR
         {
             std::clog << std::format("client {} dropped resource {} from subject {}\n", request->user().token(), request->resource().id(), request->subject().id());
             m_database->drop_resource_from_subject(request->resource().id(), request->subject().id());
+            invalidate_progress_weights();
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -1610,6 +1872,10 @@ grpc::Status server::SearchResources(grpc::ServerContext* context, SearchResourc
         {
             status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid"};
         }
+        else if (!decode_page_token(request->page_token()))
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid page token"};
+        }
         else if (!user_is_authorized(request->user()))
         {
             std::clog << std::format("client {} unauthorized access to x\n", request->user().token());
@@ -1617,10 +1883,14 @@ grpc::Status server::SearchResources(grpc::ServerContext* context, SearchResourc
         }
         else
         {
-            for (auto [position, resource]: m_database->search_resources(request->search_token()))
+            uint64_t const offset{*decode_page_token(request->page_token())};
+            uint64_t const limit{page_limit(request->limit())};
+            std::vector<Resource> matches{m_resource_index.loaded() ? m_resource_index.search(request->search_token(), limit + 1, offset) : m_database->search_resources(request->search_token(), limit + 1, offset)};
+            response->set_next_page_token(next_page(matches, offset, limit));
+            for (uint64_t position{offset + 1}; Resource& resource: matches)
             {
                 ResourceSearchResult* result = response->add_results();
-                result->set_position(position);
+                result->set_position(position++);
 
                 for (Provider const& provider: m_database->get_providers(resource.id()))
                 {
@@ -1631,7 +1901,7 @@ grpc::Status server::SearchResources(grpc::ServerContext* context, SearchResourc
                 {
                     *resource.add_presenters() = presenter;
                 }
-                *result->mutable_resource() = resource;
+                *result->mutable_resource() = std::move(resource);
             }
             std::clog << std::format("client {} collected {} resources by searching\n", request->user().token(), response->results_size(), request->search_token());
             status = grpc::Status{grpc::StatusCode::OK, {}};
@@ -1680,7 +1950,12 @@ grpc::Status server::MergeResources(grpc::ServerContext* context, MergeResources
         else
         {
             std::clog << std::format("client {} merged resource {} to {}\n", request->user().token(), request->source().id(), request->target().id());
-            m_database->merge_resources(request->source().id(), request->target().id());
+            {
+                std::lock_guard const writes{m_resource_writes};
+                m_database->merge_resources(request->source().id(), request->target().id());
+                m_resource_index.erase(request->source().id());
+            }
+            invalidate_progress_weights();
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -1723,7 +1998,12 @@ grpc::Status server::RemoveResource(grpc::ServerContext* context, RemoveResource
         else
         {
             std::clog << std::format("client {} removed resource {}\n", request->user().token(), request->resource().id());
-            m_database->remove_resource(request->resource().id());
+            {
+                std::lock_guard const writes{m_resource_writes};
+                m_database->remove_resource(request->resource().id());
+                m_resource_index.erase(request->resource().id());
+            }
+            invalidate_progress_weights();
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -1766,12 +2046,15 @@ grpc::Status server::EditResource(grpc::ServerContext* context, EditResourceRequ
         else
         {
             bool modified{};
+            // the resource is read and written under the lock so the index ends with the state the database ended with
+            std::unique_lock writes{m_resource_writes};
             Resource resource{m_database->get_resource(request->resource().id())};
 
             if (resource.name() != request->resource().name())
             {
                 std::clog << std::format("client {} renamed resource {} to {}\n", request->user().token(), request->resource().id(), request->resource().name());
                 m_database->rename_resource(request->resource().id(), request->resource().name());
+                resource.set_name(request->resource().name());
                 modified = true;
             }
 
@@ -1779,13 +2062,15 @@ grpc::Status server::EditResource(grpc::ServerContext* context, EditResourceRequ
             {
                 std::clog << std::format("client {} edited link of resource {}\n", request->user().token(), request->resource().id());
                 m_database->edit_resource_link(request->resource().id(), request->resource().link());
+                resource.set_link(request->resource().link());
                 modified = true;
             }
 
             if (resource.type() != request->resource().type())
             {
                 std::clog << std::format("client {} changed type of resource {}\n", request->user().token(), request->resource().id());
-                m_database->change_resource_type(request->resource().type(), request->resource().type());
+                m_database->change_resource_type(request->resource().id(), request->resource().type());
+                resource.set_type(request->resource().type());
                 modified = true;
             }
 
@@ -1793,12 +2078,24 @@ grpc::Status server::EditResource(grpc::ServerContext* context, EditResourceRequ
             {
                 std::clog << std::format("client {} changed pattern of resource {}\n", request->user().token(), request->resource().id());
                 m_database->change_section_pattern(request->resource().id(), request->resource().pattern());
+                resource.set_pattern(request->resource().pattern());
                 modified = true;
             }
 
+            if (modified && resource.type() != Resource::nerve)
+            {
+                m_resource_index.upsert(resource);
+            }
+            else if (modified)
+            {
+                m_resource_index.erase(resource.id());
+            }
+
+            writes.unlock();
 
             if (modified)
             {
+                invalidate_progress_weights();
                 status = grpc::Status{grpc::StatusCode::OK, {}};
             }
             else
@@ -1837,22 +2134,7 @@ grpc::Status server::GetNerves(grpc::ServerContext* context, GetNervesRequest co
         else
         {
             std::shared_ptr<User> const user{m_database->get_user(request->user().token(), request->user().device())};
-            for (auto resource: m_database->get_nerves(user->id()))
-            {
-                Nerve* nerve = response->add_nerve();
-
-                for (Provider const& provider: m_database->get_providers(resource.id()))
-                {
-                    *resource.add_providers() = provider;
-                }
-
-                for (Presenter const& presenter: m_database->get_presenters(resource.id()))
-                {
-                    *resource.add_presenters() = presenter;
-                }
-                *nerve->mutable_milestone() = m_database->get_related_milestone(user->id(), resource.id());
-                *nerve->mutable_resource() = resource;
-            }
+            m_database->get_nerves(user->id(), *response->mutable_nerve());
             std::clog << std::format("client {} collected {} nerves\n", request->user().token(), response->nerve_size());
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
@@ -1900,7 +2182,10 @@ grpc::Status server::CreateProvider(grpc::ServerContext* context, CreateProvider
         }
         else
         {
+            std::unique_lock writes{m_provider_writes};
             Provider provider{m_database->create_provider(request->provider().name())};
+            m_provider_index.upsert(provider);
+            writes.unlock();
             std::clog << std::format("client {} created provider {}\n", request->user().token(), request->provider().id());
             *response->mutable_provider() = provider;
             status = grpc::Status{grpc::StatusCode::OK, {}};
@@ -2029,6 +2314,10 @@ grpc::Status server::SearchProviders(grpc::ServerContext* context, SearchProvide
         {
             status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "empty search not possible"};
         }
+        else if (!decode_page_token(request->page_token()))
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid page token"};
+        }
         else if (!user_is_authorized(request->user()))
         {
             std::clog << std::format("client {} unauthorized access to x\n", request->user().token());
@@ -2036,12 +2325,15 @@ grpc::Status server::SearchProviders(grpc::ServerContext* context, SearchProvide
         }
         else
         {
-            for (auto const& [position, provider]: m_database->search_providers(request->search_token()))
+            uint64_t const offset{*decode_page_token(request->page_token())};
+            uint64_t const limit{page_limit(request->limit())};
+            std::vector<Provider> matches{m_provider_index.loaded() ? m_provider_index.search(request->search_token(), limit + 1, offset) : m_database->search_providers(request->search_token(), limit + 1, offset)};
+            response->set_next_page_token(next_page(matches, offset, limit));
+            for (uint64_t position{offset + 1}; Provider& provider: matches)
             {
-                ProviderSearchResult result{};
-                result.set_position(position);
-                *result.mutable_provider() = provider;
-                *response->add_result() = result;
+                ProviderSearchResult* result{response->add_result()};
+                result->set_position(position++);
+                *result->mutable_provider() = std::move(provider);
             }
             std::clog << std::format("client {} collected {} providers by searching\n", request->user().token(), 0, request->search_token());
             status = grpc::Status{grpc::StatusCode::OK, {}};
@@ -2087,7 +2379,14 @@ grpc::Status server::RenameProvider(grpc::ServerContext* context, RenameProvider
         else
         {
             std::clog << std::format("client {} renamed provider {}\n", request->user().token(), 0, request->provider().id());
-            m_database->rename_provider(request->provider().id(), request->provider().name());
+            Provider renamed{};
+            renamed.set_id(request->provider().id());
+            renamed.set_name(request->provider().name());
+            {
+                std::lock_guard const writes{m_provider_writes};
+                m_database->rename_provider(request->provider().id(), request->provider().name());
+                m_provider_index.upsert(std::move(renamed));
+            }
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -2131,7 +2430,11 @@ grpc::Status server::RemoveProvider(grpc::ServerContext* context, RemoveProvider
         else
         {
             std::clog << std::format("client {} removed provider {}\n", request->user().token(), 0, request->provider().id());
-            m_database->remove_provider(request->provider().id());
+            {
+                std::lock_guard const writes{m_provider_writes};
+                m_database->remove_provider(request->provider().id());
+                m_provider_index.erase(request->provider().id());
+            }
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -2179,7 +2482,11 @@ grpc::Status server::MergeProviders(grpc::ServerContext* context, MergeProviders
         else
         {
             std::clog << std::format("client {} merged provider {} to {}\n", request->user().token(), 0, request->source().id(), request->target().id());
-            m_database->merge_providers(request->source().id(), request->target().id());
+            {
+                std::lock_guard const writes{m_provider_writes};
+                m_database->merge_providers(request->source().id(), request->target().id());
+                m_provider_index.erase(request->source().id());
+            }
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -2227,7 +2534,10 @@ grpc::Status server::CreatePresenter(grpc::ServerContext* context, CreatePresent
         else
         {
             std::clog << std::format("client {} created presenter {}\n", request->user().token(), 0, request->presenter().id());
+            std::unique_lock writes{m_presenter_writes};
             auto presenter{m_database->create_presenter(request->presenter().name())};
+            m_presenter_index.upsert(presenter);
+            writes.unlock();
             *response->mutable_presenter() = presenter;
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
@@ -2355,6 +2665,10 @@ grpc::Status server::SearchPresenters(grpc::ServerContext* context, SearchPresen
         {
             status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "empty search is not allowed"};
         }
+        else if (!decode_page_token(request->page_token()))
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid page token"};
+        }
         else if (!user_is_authorized(request->user()))
         {
             std::clog << std::format("client {} unauthorized access to x\n", request->user().token());
@@ -2362,12 +2676,15 @@ grpc::Status server::SearchPresenters(grpc::ServerContext* context, SearchPresen
         }
         else
         {
-            for (auto const& [position, presenter]: m_database->search_presenters(request->search_token()))
+            uint64_t const offset{*decode_page_token(request->page_token())};
+            uint64_t const limit{page_limit(request->limit())};
+            std::vector<Presenter> matches{m_presenter_index.loaded() ? m_presenter_index.search(request->search_token(), limit + 1, offset) : m_database->search_presenters(request->search_token(), limit + 1, offset)};
+            response->set_next_page_token(next_page(matches, offset, limit));
+            for (uint64_t position{offset + 1}; Presenter& presenter: matches)
             {
-                PresenterSearchResult result{};
-                result.set_position(position);
-                *result.mutable_presenter() = presenter;
-                *response->add_result() = result;
+                PresenterSearchResult* result{response->add_result()};
+                result->set_position(position++);
+                *result->mutable_presenter() = std::move(presenter);
             }
             std::clog << std::format("client {} collected {} presenters by searching {}\n", request->user().token(), 0, request->search_token());
             status = grpc::Status{grpc::StatusCode::OK, {}};
@@ -2413,7 +2730,14 @@ grpc::Status server::RenamePresenter(grpc::ServerContext* context, RenamePresent
         else
         {
             std::clog << std::format("client {} renamed presenter {}\n", request->user().token(), request->presenter().id());
-            m_database->rename_presenter(request->presenter().id(), request->presenter().name());
+            Presenter renamed{};
+            renamed.set_id(request->presenter().id());
+            renamed.set_name(request->presenter().name());
+            {
+                std::lock_guard const writes{m_presenter_writes};
+                m_database->rename_presenter(request->presenter().id(), request->presenter().name());
+                m_presenter_index.upsert(std::move(renamed));
+            }
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -2457,7 +2781,11 @@ grpc::Status server::RemovePresenter(grpc::ServerContext* context, RemovePresent
         else
         {
             std::clog << std::format("client {} removed presenter {}\n", request->user().token(), request->presenter().id());
-            m_database->remove_presenter(request->presenter().id());
+            {
+                std::lock_guard const writes{m_presenter_writes};
+                m_database->remove_presenter(request->presenter().id());
+                m_presenter_index.erase(request->presenter().id());
+            }
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -2505,7 +2833,11 @@ grpc::Status server::MergePresenters(grpc::ServerContext* context, MergePresente
         else
         {
             std::clog << std::format("client {} merged presenter {} to {}\n", request->user().token(), request->source().id(), request->target().id());
-            m_database->merge_presenters(request->source().id(), request->target().id());
+            {
+                std::lock_guard const writes{m_presenter_writes};
+                m_database->merge_presenters(request->source().id(), request->target().id());
+                m_presenter_index.erase(request->source().id());
+            }
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -2536,6 +2868,10 @@ grpc::Status server::GetTopics(grpc::ServerContext* context, GetTopicsRequest co
         {
             status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid subject"};
         }
+        else if (!decode_page_token(request->page_token()))
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid page token"};
+        }
         else if (!user_is_authorized(request->user()))
         {
             std::clog << std::format("client {} unauthorized access to x\n", request->user().token());
@@ -2543,10 +2879,10 @@ grpc::Status server::GetTopics(grpc::ServerContext* context, GetTopicsRequest co
         }
         else
         {
-            for (auto const& [position, topic]: m_database->get_topics(request->subject().id(), request->level()))
-            {
-                *response->add_topic() = topic;
-            }
+            uint64_t const after{*decode_page_token(request->page_token())};
+            uint64_t const limit{list_page_limit(request->page_size())};
+            m_database->get_topics(request->subject().id(), request->level(), after, limit + 1, *response->mutable_topic());
+            response->set_next_page_token(next_cursor(*response->mutable_topic(), limit, [](Topic const& topic) { return topic.position(); }));
             std::clog << std::format("client {} collected {} topics from subject {}\n", request->user().token(), response->topic().size(), request->subject().id());
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
@@ -2596,6 +2932,7 @@ grpc::Status server::CreateTopic(grpc::ServerContext* context, CreateTopicReques
         {
             Topic* topic{response->mutable_topic()};
             *topic = m_database->create_topic(request->subject().id(), request->topic().name(), request->topic().level(), request->topic().position());
+            invalidate_coverage_matrix(request->subject().id());
             std::clog << std::format("client {} created topic {} topics from subject {}\n", request->user().token(), response->topic().position(), request->subject().id());
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
@@ -2645,6 +2982,8 @@ grpc::Status server::RemoveTopic(grpc::ServerContext* context, RemoveTopicReques
         {
             std::clog << std::format("client {} removed topic {} in subject {}\n", request->user().token(), request->topic().position(), request->subject().id());
             m_database->remove_topic(request->subject().id(), request->topic().level(), request->topic().position());
+            invalidate_subject_caches(request->subject().id());
+            invalidate_progress_weights();
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -2698,6 +3037,8 @@ grpc::Status server::MergeTopics(grpc::ServerContext* context, MergeTopicsReques
             std::clog << std::format("client {} merged topics {} and {} in subject {}\n", request->user().token(), request->source().position(), request->target().position(),
                                      request->subject().id());
             m_database->merge_topics(request->subject().id(), request->source().level(), request->source().position(), request->target().position());
+            invalidate_subject_caches(request->subject().id());
+            invalidate_progress_weights();
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -2761,6 +3102,7 @@ grpc::Status server::EditTopic(grpc::ServerContext* context, EditTopicRequest co
                 std::clog << std::format("client {} edited name of topic {} in subject {}\n", request->user().token(), request->topic().position(), request->target().position(),
                                          request->subject().id());
                 m_database->rename_topic(request->subject().id(), request->topic().level(), request->topic().position(), request->topic().name());
+                invalidate_coverage_matrix(request->subject().id());
             }
 
             if (request->target().level() != topic.level())
@@ -2769,6 +3111,7 @@ grpc::Status server::EditTopic(grpc::ServerContext* context, EditTopicRequest co
                 std::clog << std::format("client {} edited level of topic {} in subject {} from {} to {}\n", request->user().token(), request->topic().position(),
                                          request->subject().id(), database::level_to_string(request->topic().level()), database::level_to_string(request->target().level()));
                 m_database->change_topic_level(request->subject().id(), request->topic().position(), request->topic().level(), request->target().level());
+                invalidate_subject_caches(request->subject().id());
             }
 
             if (modified)
@@ -2836,6 +3179,8 @@ grpc::Status server::MoveTopic(grpc::ServerContext* context, MoveTopicRequest co
                                      request->source_subject().id(), request->target_topic().position(), request->target_subject().id());
             m_database->move_topic(request->source_subject().id(), request->source_topic().level(), request->source_topic().position(), request->target_subject().id(),
                                    request->target_topic().level(), request->target_topic().position());
+            invalidate_subject_caches(request->source_subject().id());
+            invalidate_subject_caches(request->target_subject().id());
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -2852,7 +3197,7 @@ grpc::Status server::MoveTopic(grpc::ServerContext* context, MoveTopicRequest co
     return status;
 }
 
-grpc::Status server::SearchTopics(grpc::ServerContext* context, SearchTopicsRequest const* request, SearchTopicsResponse* response)
+grpc::Status server::ApplyTopicOrdering(grpc::ServerContext* context, ApplyTopicOrderingRequest const* request, ApplyTopicOrderingResponse* response)
 {
     grpc::Status status{grpc::StatusCode::INTERNAL, {}};
 
@@ -2862,30 +3207,37 @@ grpc::Status server::SearchTopics(grpc::ServerContext* context, SearchTopicsRequ
         {
             status = grpc::Status{grpc::StatusCode::UNAUTHENTICATED, "invalid user"};
         }
-        else if (request->subject().id() == 0)
+        else if (!request->has_subject() || request->subject().id() == 0)
         {
+            std::clog << std::format("client {} tried to order topics of an invalid subject\n", request->user().token());
             status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid subject"};
         }
-        else if (request->search_token().empty())
+        else if (!expertise_level_IsValid(request->level()))
         {
-            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "empty search not allowed"};
+            std::clog << std::format("client {} tried to order topics of an invalid level\n", request->user().token());
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid level"};
+        }
+        else if (request->position().empty() || static_cast<uint64_t>(request->position_size()) > max_list_page_size ||
+                 !is_complete_ordering(std::span{request->position().data(), static_cast<std::size_t>(request->position_size())}))
+        {
+            std::clog << std::format("client {} tried to order topics of subject {} with an incomplete ordering\n", request->user().token(), request->subject().id());
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid ordering"};
+        }
+        else if (!user_is_verified(request->user()))
+        {
+            std::clog << std::format("client {} tried to order topics without verification\n", request->user().token());
+            status = grpc::Status{grpc::StatusCode::PERMISSION_DENIED, "user is not verified"};
         }
         else if (!user_is_authorized(request->user()))
         {
-            std::clog << std::format("client {} unauthorized access to x\n", request->user().token());
+            std::clog << std::format("client {} unauthorized access to order topics\n", request->user().token());
             status = grpc::Status{grpc::StatusCode::PERMISSION_DENIED, "user is not authorized"};
         }
         else
         {
-            for (auto const& [position, topic]: m_database->search_topics(request->subject().id(), request->level(), request->search_token()))
-            {
-                TopicSearchResult result{};
-                *result.mutable_topic() = topic;
-                result.set_position(position);
-                *response->add_results() = result;
-            }
-            std::clog << std::format("client {} collected {} topics by searching {} in subject {} in level {}\n", request->user().token(), response->results_size(),
-                                     request->search_token(), request->subject().id(), database::level_to_string(request->level()));
+            std::clog << std::format("client {} ordered {} topics of subject {}\n", request->user().token(), request->position_size(), request->subject().id());
+            m_database->apply_topic_ordering(request->subject().id(), request->level(), std::vector<uint64_t>{request->position().begin(), request->position().end()});
+            invalidate_subject_caches(request->subject().id());
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -2902,7 +3254,7 @@ grpc::Status server::SearchTopics(grpc::ServerContext* context, SearchTopicsRequ
     return status;
 }
 
-grpc::Status server::GetSections(grpc::ServerContext* context, GetSectionsRequest const* request, GetSectionsResponse* response)
+grpc::Status server::SearchTopics(grpc::ServerContext* context, SearchTopicsRequest const* request, SearchTopicsResponse* response)
 {
     grpc::Status status{grpc::StatusCode::INTERNAL, {}};
 
@@ -2912,9 +3264,17 @@ grpc::Status server::GetSections(grpc::ServerContext* context, GetSectionsReques
         {
             status = grpc::Status{grpc::StatusCode::UNAUTHENTICATED, "invalid user"};
         }
-        else if (request->resource().id() == 0)
+        else if (request->subject().id() == 0)
         {
-            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid resource"};
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid subject"};
+        }
+        else if (request->search_token().empty())
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "empty search not allowed"};
+        }
+        else if (!decode_page_token(request->page_token()))
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid page token"};
         }
         else if (!user_is_authorized(request->user()))
         {
@@ -2923,11 +3283,18 @@ grpc::Status server::GetSections(grpc::ServerContext* context, GetSectionsReques
         }
         else
         {
-            for (auto const& [position, section]: m_database->get_sections(request->resource().id()))
+            uint64_t const offset{*decode_page_token(request->page_token())};
+            uint64_t const limit{page_limit(request->limit())};
+            std::vector<Topic> matches{m_database->search_topics(request->subject().id(), request->level(), request->search_token(), limit + 1, offset)};
+            response->set_next_page_token(next_page(matches, offset, limit));
+            for (uint64_t position{offset + 1}; Topic& topic: matches)
             {
-                *response->add_section() = section;
+                TopicSearchResult* result{response->add_results()};
+                *result->mutable_topic() = std::move(topic);
+                result->set_position(position++);
             }
-            std::clog << std::format("client {} collected {} sections from resource {}\n", request->user().token(), response->section_size(), request->resource().id());
+            std::clog << std::format("client {} collected {} topics by searching {} in subject {} in level {}\n", request->user().token(), response->results_size(),
+                                     request->search_token(), request->subject().id(), database::level_to_string(request->level()));
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -2944,7 +3311,7 @@ grpc::Status server::GetSections(grpc::ServerContext* context, GetSectionsReques
     return status;
 }
 
-grpc::Status server::CreateSection(grpc::ServerContext* context, CreateSectionRequest const* request, CreateSectionResponse* response)
+grpc::Status server::GetSections(grpc::ServerContext* context, GetSectionsRequest const* request, GetSectionsResponse* response)
 {
     grpc::Status status{grpc::StatusCode::INTERNAL, {}};
 
@@ -2958,11 +3325,57 @@ grpc::Status server::CreateSection(grpc::ServerContext* context, CreateSectionRe
         {
             status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid resource"};
         }
-        else if (request->section().name().empty())
+        else if (!decode_page_token(request->page_token()))
         {
-            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid section name"};
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid page token"};
         }
-        else if (!user_is_verified(request->user()))
+        else if (!user_is_authorized(request->user()))
+        {
+            std::clog << std::format("client {} unauthorized access to x\n", request->user().token());
+            status = grpc::Status{grpc::StatusCode::PERMISSION_DENIED, "user is not authorized"};
+        }
+        else
+        {
+            uint64_t const after{*decode_page_token(request->page_token())};
+            uint64_t const limit{list_page_limit(request->page_size())};
+            m_database->get_sections(request->resource().id(), after, limit + 1, *response->mutable_section());
+            response->set_next_page_token(next_cursor(*response->mutable_section(), limit, [](Section const& section) { return section.position(); }));
+            std::clog << std::format("client {} collected {} sections from resource {}\n", request->user().token(), response->section_size(), request->resource().id());
+            status = grpc::Status{grpc::StatusCode::OK, {}};
+        }
+    }
+    catch (client_exception const& exp)
+    {
+        std::cerr << std::format("client {} {}\n", request->user().token(), exp.what());
+        status = grpc::Status{grpc::StatusCode::UNAVAILABLE, exp.what()};
+    }
+    catch (std::exception const& exp)
+    {
+        std::cerr << std::format("server: {}\n", exp.what());
+    }
+
+    return status;
+}
+
+grpc::Status server::CreateSection(grpc::ServerContext* context, CreateSectionRequest const* request, CreateSectionResponse* response)
+{
+    grpc::Status status{grpc::StatusCode::INTERNAL, {}};
+
+    try
+    {
+        if (!request->has_user() || !session_is_valid(request->user()))
+        {
+            status = grpc::Status{grpc::StatusCode::UNAUTHENTICATED, "invalid user"};
+        }
+        else if (request->resource().id() == 0)
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid resource"};
+        }
+        else if (request->section().name().empty())
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid section name"};
+        }
+        else if (!user_is_verified(request->user()))
         {
             std::clog << std::format("client {} tried to x without verification\n", request->user().token());
             status = grpc::Status{grpc::StatusCode::PERMISSION_DENIED, "user is not verified"};
@@ -2976,6 +3389,7 @@ grpc::Status server::CreateSection(grpc::ServerContext* context, CreateSectionRe
         {
             Section* section{response->mutable_section()};
             *section = m_database->create_section(request->resource().id(), request->section().position(), request->section().name(), request->section().link());
+            invalidate_progress_weights();
             std::clog << std::format("client {} created section {} in resource {}\n", request->user().token(), section->position(), request->resource().id());
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
@@ -3025,6 +3439,7 @@ grpc::Status server::RemoveSection(grpc::ServerContext* context, RemoveSectionRe
         {
             std::clog << std::format("client {} removed section {} in resource {}\n", request->user().token(), request->section().position(), request->resource().id());
             m_database->remove_section(request->resource().id(), request->section().position());
+            invalidate_progress_weights();
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -3078,6 +3493,7 @@ grpc::Status server::MergeSections(grpc::ServerContext* context, MergeSectionsRe
             std::clog << std::format("client {} merged sections {} and {} in resource {}\n", request->user().token(), request->source().position(), request->target().position(),
                                      request->resource().id());
             m_database->merge_sections(request->resource().id(), request->source().position(), request->target().position());
+            invalidate_progress_weights();
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -3207,6 +3623,58 @@ grpc::Status server::MoveSection(grpc::ServerContext* context, MoveSectionReques
             std::clog << std::format("client {} moved section {} in resource {} to section {} in resource {}\n", request->user().token(), request->source_section().position(),
                                      request->source_resource().id(), request->target_section().position(), request->target_resource().id());
             m_database->move_section(request->source_resource().id(), request->source_section().position(), request->target_resource().id(), request->target_section().position());
+            invalidate_progress_weights();
+            status = grpc::Status{grpc::StatusCode::OK, {}};
+        }
+    }
+    catch (client_exception const& exp)
+    {
+        std::cerr << std::format("client {} {}\n", request->user().token(), exp.what());
+        status = grpc::Status{grpc::StatusCode::UNAVAILABLE, exp.what()};
+    }
+    catch (std::exception const& exp)
+    {
+        std::cerr << std::format("server: {}\n", exp.what());
+    }
+
+    return status;
+}
+
+grpc::Status server::ApplySectionOrdering(grpc::ServerContext* context, ApplySectionOrderingRequest const* request, ApplySectionOrderingResponse* response)
+{
+    grpc::Status status{grpc::StatusCode::INTERNAL, {}};
+
+    try
+    {
+        if (!request->has_user() || !session_is_valid(request->user()))
+        {
+            status = grpc::Status{grpc::StatusCode::UNAUTHENTICATED, "invalid user"};
+        }
+        else if (!request->has_resource() || request->resource().id() == 0)
+        {
+            std::clog << std::format("client {} tried to order sections of an invalid resource\n", request->user().token());
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid resource"};
+        }
+        else if (request->position().empty() || static_cast<uint64_t>(request->position_size()) > max_list_page_size ||
+                 !is_complete_ordering(std::span{request->position().data(), static_cast<std::size_t>(request->position_size())}))
+        {
+            std::clog << std::format("client {} tried to order sections of resource {} with an incomplete ordering\n", request->user().token(), request->resource().id());
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid ordering"};
+        }
+        else if (!user_is_verified(request->user()))
+        {
+            std::clog << std::format("client {} tried to order sections without verification\n", request->user().token());
+            status = grpc::Status{grpc::StatusCode::PERMISSION_DENIED, "user is not verified"};
+        }
+        else if (!user_is_authorized(request->user()))
+        {
+            std::clog << std::format("client {} unauthorized access to order sections\n", request->user().token());
+            status = grpc::Status{grpc::StatusCode::PERMISSION_DENIED, "user is not authorized"};
+        }
+        else
+        {
+            std::clog << std::format("client {} ordered {} sections of resource {}\n", request->user().token(), request->position_size(), request->resource().id());
+            m_database->apply_section_ordering(request->resource().id(), std::vector<uint64_t>{request->position().begin(), request->position().end()});
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -3241,6 +3709,10 @@ grpc::Status server::SearchSections(grpc::ServerContext* context, SearchSections
         {
             status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "empty search token not allowed"};
         }
+        else if (!decode_page_token(request->page_token()))
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid page token"};
+        }
         else if (!user_is_authorized(request->user()))
         {
             std::clog << std::format("client {} unauthorized access to x\n", request->user().token());
@@ -3248,11 +3720,15 @@ grpc::Status server::SearchSections(grpc::ServerContext* context, SearchSections
         }
         else
         {
-            for (auto const& [position, section]: m_database->search_sections(request->resource().id(), request->search_token()))
+            uint64_t const offset{*decode_page_token(request->page_token())};
+            uint64_t const limit{page_limit(request->limit())};
+            std::vector<Section> matches{m_database->search_sections(request->resource().id(), request->search_token(), limit + 1, offset)};
+            response->set_next_page_token(next_page(matches, offset, limit));
+            for (uint64_t position{offset + 1}; Section& section: matches)
             {
                 SectionSearchResult* result{response->add_result()};
-                *result->mutable_section() = section;
-                result->set_position(position);
+                *result->mutable_section() = std::move(section);
+                result->set_position(position++);
             }
             std::clog << std::format("client {} collected {} sections by searching {} in resource {}\n", request->user().token(), response->result_size(), request->search_token(),
                                      request->resource().id());
@@ -3358,6 +3834,7 @@ grpc::Status server::AddCardToSection(grpc::ServerContext* context, AddCardToSec
             std::clog << std::format("client {} added card {} to section {} in resource {}\n", request->user().token(), request->card().id(), request->section().position(),
                                      request->resource().id());
             m_database->add_card_to_section(request->card().id(), request->resource().id(), request->section().position());
+            invalidate_progress_weights();
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -3411,6 +3888,8 @@ grpc::Status server::AddCardToTopic(grpc::ServerContext* context, AddCardToTopic
             std::clog << std::format("client {} added card {} to topic {} in subject {}\n", request->user().token(), request->card().id(), request->topic().position(),
                                      request->subject().id());
             m_database->add_card_to_topic(request->card().id(), request->subject().id(), request->topic().position(), request->topic().level());
+            invalidate_topic_caches(request->subject().id(), request->topic().level(), request->topic().position());
+            invalidate_progress_weights();
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -3461,6 +3940,10 @@ grpc::Status server::RemoveCard(grpc::ServerContext* context, RemoveCardRequest
         {
             std::clog << std::format("client {} removed card {}\n", request->user().token(), request->card().id());
             m_database->remove_card(request->card().id());
+            invalidate_card_caches(request->card().id());
+            // the request names no topic and topics cannot be looked up by card, so assimilation of every topic is read again
+            m_assimilation_state.clear();
+            invalidate_progress_weights();
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -3513,6 +3996,11 @@ grpc::Status server::MergeCards(grpc::ServerContext* context, MergeCardsRequest
         {
             std::clog << std::format("client {} merged cards {} and {}\n", request->user().token(), request->source().id(), request->target().id());
             m_database->merge_cards(request->source().id(), request->target().id(), request->target().headline());
+            invalidate_card_caches(request->source().id());
+            invalidate_card_caches(request->target().id());
+            // the request names no topic and topics cannot be looked up by card, so assimilation of every topic is read again
+            m_assimilation_state.clear();
+            invalidate_progress_weights();
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -3547,6 +4035,10 @@ grpc::Status server::SearchCards(grpc::ServerContext* context, SearchCardsReques
         {
             status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "empty search token not allowed"};
         }
+        else if (!decode_page_token(request->page_token()))
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid page token"};
+        }
         else if (!user_is_authorized(request->user()))
         {
             std::clog << std::format("client {} unauthorized access to x\n", request->user().token());
@@ -3554,11 +4046,15 @@ grpc::Status server::SearchCards(grpc::ServerContext* context, SearchCardsReques
         }
         else
         {
-            for (auto const& [position, card]: m_database->search_cards(request->subject().id(), request->level(), request->search_token()))
+            uint64_t const offset{*decode_page_token(request->page_token())};
+            uint64_t const limit{page_limit(request->limit())};
+            std::vector<Card> matches{m_database->search_cards(request->subject().id(), request->level(), request->search_token(), limit + 1, offset, {})};
+            response->set_next_page_token(next_page(matches, offset, limit));
+            for (uint64_t position{offset + 1}; Card& card: matches)
             {
                 CardSearchResult* result{response->add_result()};
-                *result->mutable_card() = card;
-                result->set_position(position);
+                *result->mutable_card() = std::move(card);
+                result->set_position(position++);
             }
             std::clog << std::format("client {} collected {} cards by searching {} in subject {}\n", request->user().token(), response->result_size(), request->search_token(),
                                      request->subject().id());
@@ -3624,6 +4120,7 @@ grpc::Status server::MoveCardToSection(grpc::ServerContext* context, MoveCardToS
                                      request->source_section().position(), request->resource().id(), request->target_section().position(), request->target_resource().id());
             m_database->move_card_to_section(request->card().id(), request->resource().id(), request->source_section().position(), request->target_resource().id(),
                                              request->target_section().position());
+            invalidate_progress_weights();
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -3672,6 +4169,7 @@ grpc::Status server::MarkSectionAsReviewed(grpc::ServerContext* context, MarkSec
         {
             std::clog << std::format("client {} marked section {} in resource {} as reviewed\n", request->user().token(), request->section().position(), request->resource().id());
             m_database->mark_section_as_reviewed(request->resource().id(), request->section().position());
+            invalidate_progress_weights();
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -3720,6 +4218,7 @@ grpc::Status server::MarkSectionAsCompleted(grpc::ServerContext* context, MarkSe
         {
             std::clog << std::format("client {} marked section {} in resource {} as completed\n", request->user().token(), request->section().position(), request->resource().id());
             m_database->mark_section_as_completed(request->resource().id(), request->section().position());
+            invalidate_progress_weights();
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -3771,11 +4270,17 @@ grpc::Status server::GetPracticeCards(grpc::ServerContext* context, GetPracticeC
         else
         {
             std::shared_ptr<User> const user{m_database->get_user(request->user().token(), request->user().device())};
-            for (Card const& card: m_database->get_practice_cards(user->id(), request->roadmap().id(), request->subject().id(), request->topic().level(),
-                                                                  request->topic().position()))
+            collect_practice_cards(practice_key{user->id(), request->roadmap().id(), request->subject().id(), request->topic().level(), request->topic().position()},
+                                   *response->mutable_card());
+
+            if (request->include_blocks())
             {
-                *response->add_card() = card;
+                std::vector<Card*> cards{};
+                cards.reserve(response->card_size());
+                std::ranges::transform(*response->mutable_card(), std::back_inserter(cards), [](Card& card) { return &card; });
+                m_database->get_blocks(cards);
             }
+
             std::clog << std::format("client {} collected {} practice cards from topic {} in milestone {} with level {}\n", request->user().token(), response->card_size(),
                                      request->topic().position(), request->subject().id(), database::level_to_string(request->topic().level()));
             status = grpc::Status{grpc::StatusCode::OK, {}};
@@ -3893,6 +4398,9 @@ grpc::Status server::MoveCardToTopic(grpc::ServerContext* context, MoveCardToTop
                                      request->target_subject().id());
             m_database->move_card_to_topic(request->card().id(), request->subject().id(), request->topic().position(), request->topic().level(), request->target_subject().id(),
                                            request->target_topic().position(), request->target_topic().level());
+            invalidate_topic_caches(request->subject().id(), request->topic().level(), request->topic().position());
+            invalidate_topic_caches(request->target_subject().id(), request->target_topic().level(), request->target_topic().position());
+            invalidate_progress_weights();
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -3946,6 +4454,8 @@ grpc::Status server::CreateAssessment(grpc::ServerContext* context, CreateAssess
             std::clog << std::format("client {} created assessment {} in topic {} in subject {}\n", request->user().token(), request->card().id(), request->topic().position(),
                                      request->subject().id());
             m_database->create_assessment(request->subject().id(), request->topic().level(), request->topic().position(), request->card().id());
+            update_coverage_matrix(request->subject().id(), request->card().id(), request->topic().level(), request->topic().position(), true);
+            m_assimilation_state.invalidate_topic(assimilation_key{request->subject().id(), request->topic().level(), request->topic().position()});
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -3980,6 +4490,10 @@ grpc::Status server::GetAssessments(grpc::ServerContext* context, GetAssessments
         {
             status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid topic"};
         }
+        else if (!decode_page_token(request->page_token()))
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid page token"};
+        }
         else if (!user_is_authorized(request->user()))
         {
             std::clog << std::format("client {} unauthorized access to x\n", request->user().token());
@@ -3988,10 +4502,11 @@ grpc::Status server::GetAssessments(grpc::ServerContext* context, GetAssessments
         else
         {
             std::shared_ptr<User> const user{m_database->get_user(request->user().token(), request->user().device())};
-            for (Assessment assessment: m_database->get_assessments(user->id(), request->subject().id(), request->topic().level(), request->topic().position()))
-            {
-                *response->add_assessment() = assessment;
-            }
+            uint64_t const after{*decode_page_token(request->page_token())};
+            uint64_t const limit{list_page_limit(request->page_size())};
+            m_database->get_assessments(user->id(), request->subject().id(), request->topic().level(), request->topic().position(), after, limit + 1,
+                                        *response->mutable_assessment());
+            response->set_next_page_token(next_cursor(*response->mutable_assessment(), limit, [after, limit](auto const&) { return after + limit; }));
             std::clog << std::format("client {} collected {} assessments in topic {} {} in subject {}\n", request->user().token(), response->assessment_size(),
                                      request->topic().position(), database::level_to_string(request->topic().level()), request->subject().id());
             status = grpc::Status{grpc::StatusCode::OK, {}};
@@ -4047,6 +4562,8 @@ grpc::Status server::ExpandAssessment(grpc::ServerContext* context, ExpandAssess
             std::clog << std::format("client {} expanded assessment {} with topic {} {} in subject {}\n", request->user().token(), request->card().id(),
                                      request->topic().position(), database::level_to_string(request->topic().level()), request->subject().id());
             m_database->expand_assessment(request->card().id(), request->subject().id(), request->topic().level(), request->topic().position());
+            update_coverage_matrix(request->subject().id(), request->card().id(), request->topic().level(), request->topic().position(), true);
+            m_assimilation_state.invalidate_topic(assimilation_key{request->subject().id(), request->topic().level(), request->topic().position()});
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -4100,6 +4617,8 @@ grpc::Status server::DiminishAssessment(grpc::ServerContext* context, DiminishAs
             std::clog << std::format("client {} diminished assessment {} with topic {} {} in subject {}\n", request->user().token(), request->card().id(),
                                      request->topic().position(), database::level_to_string(request->topic().level()), request->subject().id());
             m_database->diminish_assessment(request->card().id(), request->subject().id(), request->topic().level(), request->topic().position());
+            update_coverage_matrix(request->subject().id(), request->card().id(), request->topic().level(), request->topic().position(), false);
+            m_assimilation_state.invalidate_topic(assimilation_key{request->subject().id(), request->topic().level(), request->topic().position()});
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -4144,7 +4663,19 @@ grpc::Status server::IsAssimilated(grpc::ServerContext* context, IsAssimilatedRe
             std::clog << std::format("client {} checking assimilation of topic {} {} in subject {}\n", request->user().token(), request->topic().position(),
                                      database::level_to_string(request->topic().level()), request->subject().id());
             std::shared_ptr<User> const user{m_database->get_user(request->user().token(), request->user().device())};
-            response->set_is_assimilated(m_database->is_assimilated(user->id(), request->subject().id(), request->topic().level(), request->topic().position()));
+            assimilation_key const key{request->subject().id(), request->topic().level(), request->topic().position()};
+
+            if (std::optional<bool> const assimilated{m_assimilation_state.find(user->id(), key)})
+            {
+                response->set_is_assimilated(*assimilated);
+            }
+            else
+            {
+                uint64_t const generation{m_assimilation_state.generation()};
+                response->set_is_assimilated(m_database->is_assimilated(user->id(), key.subject_id, key.level, key.topic_position));
+                m_assimilation_state.assign(user->id(), key, response->is_assimilated(), generation);
+            }
+
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -4186,10 +4717,7 @@ grpc::Status server::GetTopicCoverage(grpc::ServerContext* context, GetTopicCove
         }
         else
         {
-            for (Topic const& topic: m_database->get_topic_coverage(request->subject().id(), request->assessment().card().id()))
-            {
-                *response->add_topic() = topic;
-            }
+            load_coverage_matrix(request->subject().id())->topics_of(request->assessment().card().id(), *response->mutable_topic());
             std::clog << std::format("client {} collected {} topics in subject {} covered by assessment {}\n", request->user().token(), response->topic_size(),
                                      request->subject().id(), request->assessment().card().id());
             status = grpc::Status{grpc::StatusCode::OK, {}};
@@ -4209,6 +4737,46 @@ grpc::Status server::GetTopicCoverage(grpc::ServerContext* context, GetTopicCove
     return status;
 }
 
+grpc::Status server::GetSubjectCoverage(grpc::ServerContext* context, GetSubjectCoverageRequest const* request, GetSubjectCoverageResponse* response)
+{
+    grpc::Status status{grpc::StatusCode::INTERNAL, {}};
+
+    try
+    {
+        if (!request->has_user() || !session_is_valid(request->user()))
+        {
+            status = grpc::Status{grpc::StatusCode::UNAUTHENTICATED, "invalid user"};
+        }
+        else if (request->subject().id() == 0)
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid subject"};
+        }
+        else if (!user_is_authorized(request->user()))
+        {
+            std::clog << std::format("client {} unauthorized access to x\n", request->user().token());
+            status = grpc::Status{grpc::StatusCode::PERMISSION_DENIED, "user is not authorized"};
+        }
+        else
+        {
+            load_coverage_matrix(request->subject().id())->fill(*response->mutable_topic(), *response->mutable_assessment());
+            std::clog << std::format("client {} collected coverage of {} topics by {} assessments in subject {}\n", request->user().token(), response->topic_size(),
+                                     response->assessment_size(), request->subject().id());
+            status = grpc::Status{grpc::StatusCode::OK, {}};
+        }
+    }
+    catch (client_exception const& exp)
+    {
+        std::cerr << std::format("client {} {}\n", request->user().token(), exp.what());
+        status = grpc::Status{grpc::StatusCode::UNAVAILABLE, exp.what()};
+    }
+    catch (std::exception const& exp)
+    {
+        std::cerr << std::format("server: failed to collect coverage of subject {}, reason: {}\n", request->subject().id(), exp.what());
+    }
+
+    return status;
+}
+
 grpc::Status server::GetSubjectAssessments(grpc::ServerContext* context, GetSubjectAssessmentsRequest const* request, GetSubjectAssessmentsResponse* response)
 {
     grpc::Status status{grpc::StatusCode::INTERNAL, {}};
@@ -4223,6 +4791,10 @@ grpc::Status server::GetSubjectAssessments(grpc::ServerContext* context, GetSubj
         {
             status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid subject"};
         }
+        else if (!decode_page_token(request->page_token()))
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid page token"};
+        }
         else if (!user_is_authorized(request->user()))
         {
             std::clog << std::format("client {} unauthorized access to x\n", request->user().token());
@@ -4230,10 +4802,10 @@ grpc::Status server::GetSubjectAssessments(grpc::ServerContext* context, GetSubj
         }
         else
         {
-            for (Card const& card: m_database->get_subject_assessments(request->subject().id(), request->max_level()))
-            {
-                *response->add_card() = card;
-            }
+            uint64_t const after{*decode_page_token(request->page_token())};
+            uint64_t const limit{list_page_limit(request->page_size())};
+            m_database->get_subject_assessments(request->subject().id(), request->max_level(), after, limit + 1, *response->mutable_card());
+            response->set_next_page_token(next_cursor(*response->mutable_card(), limit, [after, limit](auto const&) { return after + limit; }));
             std::clog << std::format("client {} collected {} assessments from subject {}\n", request->user().token(), response->card_size(), request->subject().id());
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
@@ -4285,6 +4857,7 @@ grpc::Status server::EditCard(grpc::ServerContext* context, EditCardRequest cons
                 modified = true;
                 std::clog << std::format("client {} editing headline of card {}\n", request->user().token(), request->card().id());
                 m_database->edit_card_headline(request->card().id(), request->card().headline());
+                invalidate_assessment_coverage(request->card().id());
             }
 
             if (modified)
@@ -4384,10 +4957,7 @@ grpc::Status server::GetBlocks(grpc::ServerContext* context, GetBlocksRequest co
         }
         else
         {
-            for (auto const& [position, block]: m_database->get_blocks(request->card().id()))
-            {
-                *response->add_block() = block;
-            }
+            m_database->get_blocks(request->card().id(), *response->mutable_block());
             std::clog << std::format("client {} collected {} blocks from card {}\n", request->user().token(), response->block_size(), request->card().id());
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
@@ -4405,6 +4975,13 @@ grpc::Status server::GetBlocks(grpc::ServerContext* context, GetBlocksRequest co
     return status;
 }
 
+grpc::ServerUnaryReactor* server::GetBlocks(grpc::CallbackServerContext* context, GetBlocksRequest const* request, GetBlocksResponse* response)
+{
+    grpc::ServerUnaryReactor* reactor{context->DefaultReactor()};
+    m_database_executor.submit([this, reactor, request, response] { reactor->Finish(GetBlocks(static_cast<grpc::ServerContext*>(nullptr), request, response)); });
+    return reactor;
+}
+
 grpc::Status server::RemoveBlock(grpc::ServerContext* context, RemoveBlockRequest const* request, RemoveBlockResponse* response)
 {
     grpc::Status status{grpc::StatusCode::INTERNAL, {}};
@@ -4599,6 +5176,57 @@ grpc::Status server::ReorderBlock(grpc::ServerContext* context, ReorderBlockRequ
     return status;
 }
 
+grpc::Status server::ApplyBlockOrdering(grpc::ServerContext* context, ApplyBlockOrderingRequest const* request, ApplyBlockOrderingResponse* response)
+{
+    grpc::Status status{grpc::StatusCode::INTERNAL, {}};
+
+    try
+    {
+        if (!request->has_user() || !session_is_valid(request->user()))
+        {
+            status = grpc::Status{grpc::StatusCode::UNAUTHENTICATED, "invalid user"};
+        }
+        else if (!request->has_card() || request->card().id() == 0)
+        {
+            std::clog << std::format("client {} tried to order blocks of an invalid card\n", request->user().token());
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid card"};
+        }
+        else if (request->position().empty() || static_cast<uint64_t>(request->position_size()) > max_list_page_size ||
+                 !is_complete_ordering(std::span{request->position().data(), static_cast<std::size_t>(request->position_size())}))
+        {
+            std::clog << std::format("client {} tried to order blocks of card {} with an incomplete ordering\n", request->user().token(), request->card().id());
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid ordering"};
+        }
+        else if (!user_is_verified(request->user()))
+        {
+            std::clog << std::format("client {} tried to order blocks without verification\n", request->user().token());
+            status = grpc::Status{grpc::StatusCode::PERMISSION_DENIED, "user is not verified"};
+        }
+        else if (!user_is_authorized(request->user()))
+        {
+            std::clog << std::format("client {} unauthorized access to order blocks\n", request->user().token());
+            status = grpc::Status{grpc::StatusCode::PERMISSION_DENIED, "user is not authorized"};
+        }
+        else
+        {
+            std::clog << std::format("client {} ordered {} blocks of card {}\n", request->user().token(), request->position_size(), request->card().id());
+            m_database->apply_block_ordering(request->card().id(), std::vector<uint64_t>{request->position().begin(), request->position().end()});
+            status = grpc::Status{grpc::StatusCode::OK, {}};
+        }
+    }
+    catch (client_exception const& exp)
+    {
+        std::cerr << std::format("client {} {}\n", request->user().token(), exp.what());
+        status = grpc::Status{grpc::StatusCode::UNAVAILABLE, exp.what()};
+    }
+    catch (std::exception const& exp)
+    {
+        std::cerr << std::format("server: {}\n", exp.what());
+    }
+
+    return status;
+}
+
 grpc::Status server::MergeBlocks(grpc::ServerContext* context, MergeBlocksRequest const* request, MergeBlocksResponse* response)
 {
     grpc::Status status{grpc::StatusCode::INTERNAL, {}};
@@ -4704,12 +5332,15 @@ grpc::Status server::SplitBlock(grpc::ServerContext* context, SplitBlockRequest
     return status;
 }
 
-grpc::Status server::MarkCardAsReviewed(grpc::ServerContext* context, MarkCardAsReviewedRequest const* request, MarkCardAsReviewedResponse* response)
+grpc::Status server::ApplyCardEdits(grpc::ServerContext* context, ApplyCardEditsRequest const* request, ApplyCardEditsResponse* response)
 {
     grpc::Status status{grpc::StatusCode::INTERNAL, {}};
 
     try
     {
+        auto const on_block{[](CardEdit const& edit) { return edit.type() != CardEdit::edit_card && edit.type() != CardEdit::create_block; }};
+        auto const writes_block{[](CardEdit const& edit) { return edit.type() == CardEdit::create_block || edit.type() == CardEdit::edit_block; }};
+
         if (!request->has_user() || !session_is_valid(request->user()))
         {
             status = grpc::Status{grpc::StatusCode::UNAUTHENTICATED, "invalid user"};
@@ -4718,6 +5349,38 @@ grpc::Status server::MarkCardAsReviewed(grpc::ServerContext* context, MarkCardAs
         {
             status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid card"};
         }
+        else if (request->edit().empty())
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "no card edits"};
+        }
+        else if (static_cast<std::size_t>(request->edit_size()) > max_card_edits)
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "too many card edits", std::format("at most {} edits can be applied at once", max_card_edits)};
+        }
+        else if (std::ranges::any_of(request->edit(), [](CardEdit const& edit) { return !CardEdit_operation_IsValid(edit.type()) || edit.type() == CardEdit::unspecified; }))
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid edit"};
+        }
+        else if (std::ranges::any_of(request->edit(), [](CardEdit const& edit) { return edit.type() == CardEdit::edit_card && edit.card().headline().empty(); }))
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "empty headline not allowed"};
+        }
+        else if (std::ranges::any_of(request->edit(), [on_block](CardEdit const& edit) { return on_block(edit) && edit.block().position() == 0; }))
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid block"};
+        }
+        else if (std::ranges::any_of(request->edit(), [](CardEdit const& edit) { return edit.type() == CardEdit::merge_blocks && edit.target().position() == 0; }))
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid target block"};
+        }
+        else if (std::ranges::any_of(request->edit(), [writes_block](CardEdit const& edit) { return writes_block(edit) && edit.block().content().empty(); }))
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid content", "block content cannot be empty"};
+        }
+        else if (std::ranges::any_of(request->edit(), [writes_block](CardEdit const& edit) { return writes_block(edit) && edit.block().extension().empty(); }))
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid extension", "block extension cannot be empty"};
+        }
         else if (!user_is_verified(request->user()))
         {
             std::clog << std::format("client {} tried to x without verification\n", request->user().token());
@@ -4730,8 +5393,15 @@ grpc::Status server::MarkCardAsReviewed(grpc::ServerContext* context, MarkCardAs
         }
         else
         {
-            std::clog << std::format("client {} marked card {} as reviewed\n", request->user().token(), request->card().id());
-            m_database->mark_card_as_reviewed(request->card().id());
+            std::clog << std::format("client {} applied {} edits to card {}\n", request->user().token(), request->edit_size(), request->card().id());
+            m_database->apply_card_edits(request->card().id(), request->edit(), *response->mutable_block());
+
+            // due state and assimilation do not depend on headlines or blocks, only coverage keeps the headline of assessments
+            if (std::ranges::any_of(request->edit(), [](CardEdit const& edit) { return edit.type() == CardEdit::edit_card; }))
+            {
+                invalidate_assessment_coverage(request->card().id());
+            }
+
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -4748,7 +5418,7 @@ grpc::Status server::MarkCardAsReviewed(grpc::ServerContext* context, MarkCardAs
     return status;
 }
 
-grpc::Status server::GetSectionCards(grpc::ServerContext* context, flashback::GetSectionCardsRequest const* request, GetSectionCardsResponse* response)
+grpc::Status server::MarkCardAsReviewed(grpc::ServerContext* context, MarkCardAsReviewedRequest const* request, MarkCardAsReviewedResponse* response)
 {
     grpc::Status status{grpc::StatusCode::INTERNAL, {}};
 
@@ -4758,13 +5428,14 @@ grpc::Status server::GetSectionCards(grpc::ServerContext* context, flashback::Ge
         {
             status = grpc::Status{grpc::StatusCode::UNAUTHENTICATED, "invalid user"};
         }
-        else if (request->resource().id() == 0)
+        else if (request->card().id() == 0)
         {
-            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid resource"};
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid card"};
         }
-        else if (request->section().position() == 0)
+        else if (!user_is_verified(request->user()))
         {
-            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid section"};
+            std::clog << std::format("client {} tried to x without verification\n", request->user().token());
+            status = grpc::Status{grpc::StatusCode::PERMISSION_DENIED, "user is not verified"};
         }
         else if (!user_is_authorized(request->user()))
         {
@@ -4773,12 +5444,10 @@ grpc::Status server::GetSectionCards(grpc::ServerContext* context, flashback::Ge
         }
         else
         {
-            for (SectionCard const& section_card: m_database->get_section_cards(request->resource().id(), request->section().position()))
-            {
-                *response->add_card() = section_card;
-            }
-            std::clog << std::format("client {} collected {} cards from section {}:{}\n", request->user().token(), response->card_size(), request->resource().id(),
-                                     request->section().position());
+            std::clog << std::format("client {} marked card {} as reviewed\n", request->user().token(), request->card().id());
+            m_database->mark_card_as_reviewed(request->card().id());
+            invalidate_card_caches(request->card().id());
+            invalidate_progress_weights();
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -4795,7 +5464,7 @@ grpc::Status server::GetSectionCards(grpc::ServerContext* context, flashback::Ge
     return status;
 }
 
-grpc::Status server::GetTopicCards(grpc::ServerContext* context, flashback::GetTopicCardsRequest const* request, GetTopicCardsResponse* response)
+grpc::Status server::GetSectionCards(grpc::ServerContext* context, flashback::GetSectionCardsRequest const* request, GetSectionCardsResponse* response)
 {
     grpc::Status status{grpc::StatusCode::INTERNAL, {}};
 
@@ -4805,13 +5474,17 @@ grpc::Status server::GetTopicCards(grpc::ServerContext* context, flashback::GetT
         {
             status = grpc::Status{grpc::StatusCode::UNAUTHENTICATED, "invalid user"};
         }
-        else if (request->subject().id() == 0)
+        else if (request->resource().id() == 0)
         {
-            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid subject"};
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid resource"};
         }
-        else if (request->topic().position() == 0)
+        else if (request->section().position() == 0)
         {
-            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid topic"};
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid section"};
+        }
+        else if (!decode_page_token(request->page_token()))
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid page token"};
         }
         else if (!user_is_authorized(request->user()))
         {
@@ -4820,12 +5493,21 @@ grpc::Status server::GetTopicCards(grpc::ServerContext* context, flashback::GetT
         }
         else
         {
-            for (Card const& card: m_database->get_topic_cards(request->subject().id(), request->topic().position(), request->topic().level()))
+            uint64_t const after{*decode_page_token(request->page_token())};
+            uint64_t const limit{list_page_limit(request->page_size())};
+            m_database->get_section_cards(request->resource().id(), request->section().position(), after, limit + 1, *response->mutable_card());
+            response->set_next_page_token(next_cursor(*response->mutable_card(), limit, [after, limit](auto const&) { return after + limit; }));
+
+            if (request->include_blocks())
             {
-                *response->add_card() = card;
+                std::vector<Card*> cards{};
+                cards.reserve(response->card_size());
+                std::ranges::transform(*response->mutable_card(), std::back_inserter(cards), [](SectionCard& section_card) { return section_card.mutable_card(); });
+                m_database->get_blocks(cards);
             }
-            std::clog << std::format("client {} collected {} cards from topic {}:{}\n", request->user().token(), response->card_size(), request->subject().id(),
-                                     request->topic().position());
+
+            std::clog << std::format("client {} collected {} cards from section {}:{}\n", request->user().token(), response->card_size(), request->resource().id(),
+                                     request->section().position());
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -4842,7 +5524,7 @@ grpc::Status server::GetTopicCards(grpc::ServerContext* context, flashback::GetT
     return status;
 }
 
-grpc::Status server::MoveBlock(grpc::ServerContext* context, MoveBlockRequest const* request, MoveBlockResponse* response)
+grpc::Status server::GetTopicCards(grpc::ServerContext* context, flashback::GetTopicCardsRequest const* request, GetTopicCardsResponse* response)
 {
     grpc::Status status{grpc::StatusCode::INTERNAL, {}};
 
@@ -4852,21 +5534,511 @@ grpc::Status server::MoveBlock(grpc::ServerContext* context, MoveBlockRequest co
         {
             status = grpc::Status{grpc::StatusCode::UNAUTHENTICATED, "invalid user"};
         }
-        else if (request->card().id() == 0)
+        else if (request->subject().id() == 0)
         {
-            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid source card"};
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid subject"};
+        }
+        else if (request->topic().position() == 0)
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid topic"};
+        }
+        else if (!decode_page_token(request->page_token()))
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid page token"};
+        }
+        else if (!user_is_authorized(request->user()))
+        {
+            std::clog << std::format("client {} unauthorized access to x\n", request->user().token());
+            status = grpc::Status{grpc::StatusCode::PERMISSION_DENIED, "user is not authorized"};
+        }
+        else
+        {
+            uint64_t const after{*decode_page_token(request->page_token())};
+            uint64_t const limit{list_page_limit(request->page_size())};
+            m_database->get_topic_cards(request->subject().id(), request->topic().position(), request->topic().level(), after, limit + 1, *response->mutable_card());
+            response->set_next_page_token(next_cursor(*response->mutable_card(), limit, [after, limit](auto const&) { return after + limit; }));
+
+            if (request->include_blocks())
+            {
+                std::vector<Card*> cards{};
+                cards.reserve(response->card_size());
+                std::ranges::transform(*response->mutable_card(), std::back_inserter(cards), [](Card& card) { return &card; });
+                m_database->get_blocks(cards);
+            }
+
+            std::clog << std::format("client {} collected {} cards from topic {}:{}\n", request->user().token(), response->card_size(), request->subject().id(),
+                                     request->topic().position());
+            status = grpc::Status{grpc::StatusCode::OK, {}};
+        }
+    }
+    catch (client_exception const& exp)
+    {
+        std::cerr << std::format("client {} {}\n", request->user().token(), exp.what());
+        status = grpc::Status{grpc::StatusCode::UNAVAILABLE, exp.what()};
+    }
+    catch (std::exception const& exp)
+    {
+        std::cerr << std::format("server: {}\n", exp.what());
+    }
+
+    return status;
+}
+
+grpc::Status server::MoveBlock(grpc::ServerContext* context, MoveBlockRequest const* request, MoveBlockResponse* response)
+{
+    grpc::Status status{grpc::StatusCode::INTERNAL, {}};
+
+    try
+    {
+        if (!request->has_user() || !session_is_valid(request->user()))
+        {
+            status = grpc::Status{grpc::StatusCode::UNAUTHENTICATED, "invalid user"};
+        }
+        else if (request->card().id() == 0)
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid source card"};
         }
         else if (request->block().position() == 0)
         {
-            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid source block position"};
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid source block position"};
+        }
+        else if (request->target_card().id() == 0)
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid target card"};
+        }
+        else if (request->target_block().position() == 0)
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid target block position"};
+        }
+        else if (!user_is_verified(request->user()))
+        {
+            std::clog << std::format("client {} tried to x without verification\n", request->user().token());
+            status = grpc::Status{grpc::StatusCode::PERMISSION_DENIED, "user is not verified"};
+        }
+        else if (!user_is_authorized(request->user()))
+        {
+            std::clog << std::format("client {} unauthorized access to x\n", request->user().token());
+            status = grpc::Status{grpc::StatusCode::PERMISSION_DENIED, "user is not authorized"};
+        }
+        else
+        {
+            std::clog << std::format("client {} moved block from position {} in card {} to position {} in card {}\n", request->user().token(), request->block().position(),
+                                     request->card().id(), request->target_block().position(), request->target_card().id());
+            m_database->move_block(request->card().id(), request->block().position(), request->target_card().id(), request->target_block().position());
+            status = grpc::Status{grpc::StatusCode::OK, {}};
+        }
+    }
+    catch (client_exception const& exp)
+    {
+        std::cerr << std::format("client {} {}\n", request->user().token(), exp.what());
+        status = grpc::Status{grpc::StatusCode::UNAVAILABLE, exp.what()};
+    }
+    catch (std::exception const& exp)
+    {
+        std::cerr << std::format("server: {}\n", exp.what());
+    }
+
+    return status;
+}
+
+grpc::Status server::SearchBlocks(grpc::ServerContext* context, SearchBlocksRequest const* request, SearchBlocksResponse* response)
+{
+    grpc::Status status{grpc::StatusCode::INTERNAL, {}};
+
+    try
+    {
+        if (!request->has_user() || !session_is_valid(request->user()))
+        {
+            status = grpc::Status{grpc::StatusCode::UNAUTHENTICATED, "invalid user"};
+        }
+        else if (request->search_token().empty())
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "empty search token not allowed"};
+        }
+        else if (!decode_page_token(request->page_token()))
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid page token"};
+        }
+        else if (!user_is_authorized(request->user()))
+        {
+            std::clog << std::format("client {} unauthorized access to x\n", request->user().token());
+            status = grpc::Status{grpc::StatusCode::PERMISSION_DENIED, "user is not authorized"};
+        }
+        else
+        {
+            uint64_t const offset{*decode_page_token(request->page_token())};
+            uint64_t const limit{page_limit(request->limit())};
+            std::shared_ptr<User> const user{m_database->get_user(request->user().token(), request->user().device())};
+            std::vector<BlockSearchResult> matches{m_database->search_blocks(user->id(), request->search_token(), limit + 1, offset)};
+            response->set_next_page_token(next_page(matches, offset, limit));
+            for (uint64_t position{offset + 1}; BlockSearchResult& match: matches)
+            {
+                BlockSearchResult* result{response->add_result()};
+                *result = std::move(match);
+                result->set_position(position++);
+            }
+            std::clog << std::format("client {} collected {} blocks by searching {}\n", request->user().token(), response->result_size(), request->search_token());
+            status = grpc::Status{grpc::StatusCode::OK, {}};
+        }
+    }
+    catch (client_exception const& exp)
+    {
+        std::cerr << std::format("client {} {}\n", request->user().token(), exp.what());
+        status = grpc::Status{grpc::StatusCode::UNAVAILABLE, exp.what()};
+    }
+    catch (std::exception const& exp)
+    {
+        std::cerr << std::format("server: {}\n", exp.what());
+    }
+
+    return status;
+}
+
+grpc::Status server::Typeahead(grpc::ServerContext* context, grpc::ServerReaderWriter<TypeaheadResponse, TypeaheadRequest>* stream)
+{
+    grpc::Status status{grpc::StatusCode::INTERNAL, {}};
+    TypeaheadRequest request{};
+    std::string token{};
+
+    try
+    {
+        bool const opened{stream->Read(&request)};
+        token = request.user().token();
+
+        if (!opened)
+        {
+            status = grpc::Status{grpc::StatusCode::CANCELLED, "typeahead session closed before any query"};
+        }
+        else if (!request.has_user() || !session_is_valid(request.user()))
+        {
+            status = grpc::Status{grpc::StatusCode::UNAUTHENTICATED, "invalid user"};
+        }
+        else if (!user_is_authorized(request.user()))
+        {
+            std::clog << std::format("client {} unauthorized access to x\n", request.user().token());
+            status = grpc::Status{grpc::StatusCode::PERMISSION_DENIED, "user is not authorized"};
+        }
+        else
+        {
+            // the session is authenticated once, later queries only carry the prefix and scope
+            typeahead_session<TypeaheadRequest> session{};
+            session.submit(std::move(request));
+
+            std::jthread reader{[stream, &session] {
+                TypeaheadRequest next{};
+
+                while (stream->Read(&next))
+                {
+                    session.submit(std::move(next));
+                }
+
+                session.close();
+            }};
+
+            // unwinding would join the reader while it waits for the next query of the client, cancelling the call releases it
+            struct reader_guard
+            {
+                grpc::ServerContext* context;
+                std::jthread& reader;
+
+                ~reader_guard()
+                {
+                    if (reader.joinable())
+                    {
+                        context->TryCancel();
+                        reader.join();
+                    }
+                }
+            } const guard{context, reader};
+
+            uint64_t completed{};
+            uint64_t skipped{};
+
+            while (std::optional<typeahead_session<TypeaheadRequest>::ticket> const ticket{session.take()})
+            {
+                TypeaheadResponse response{};
+                response.set_sequence(ticket->query.sequence());
+                complete_typeahead(ticket->query, ticket->stop, response);
+
+                if (!session.is_current(*ticket))
+                {
+                    ++skipped;
+                }
+                else if (stream->Write(response))
+                {
+                    ++completed;
+                }
+            }
+
+            // the session only closes once the reader has seen the end of the stream
+            reader.join();
+            std::clog << std::format("client {} completed {} typeahead queries, {} outdated\n", token, completed, skipped);
+            status = grpc::Status{grpc::StatusCode::OK, {}};
+        }
+    }
+    catch (client_exception const& exp)
+    {
+        std::cerr << std::format("client {} {}\n", token, exp.what());
+        status = grpc::Status{grpc::StatusCode::UNAVAILABLE, exp.what()};
+    }
+    catch (std::exception const& exp)
+    {
+        std::cerr << std::format("server: {}\n", exp.what());
+    }
+
+    return status;
+}
+
+grpc::Status server::ExportSubjectCards(grpc::ServerContext* context, ExportSubjectCardsRequest const* request, grpc::ServerWriter<ExportSubjectCardsResponse>* writer)
+{
+    grpc::Status status{grpc::StatusCode::INTERNAL, {}};
+
+    try
+    {
+        if (!request->has_user() || !session_is_valid(request->user()))
+        {
+            status = grpc::Status{grpc::StatusCode::UNAUTHENTICATED, "invalid user"};
+        }
+        else if (request->subject().id() == 0)
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid subject"};
+        }
+        else if (!user_is_authorized(request->user()))
+        {
+            std::clog << std::format("client {} unauthorized access to x\n", request->user().token());
+            status = grpc::Status{grpc::StatusCode::PERMISSION_DENIED, "user is not authorized"};
+        }
+        else
+        {
+            ExportSubjectCardsResponse response{};
+            uint64_t exported{};
+            bool delivered{true};
+            m_database->export_subject_cards(request->subject().id(), [context, writer, &response, &exported, &delivered](Topic const& topic, Card const& card) {
+                *response.mutable_topic() = topic;
+                *response.mutable_card() = card;
+                delivered = !context->IsCancelled() && writer->Write(response);
+                exported += delivered;
+                return delivered;
+            });
+
+            if (delivered)
+            {
+                std::clog << std::format("client {} exported {} cards from subject {}\n", request->user().token(), exported, request->subject().id());
+                status = grpc::Status{grpc::StatusCode::OK, {}};
+            }
+            else
+            {
+                std::clog << std::format("client {} stopped reading after {} cards from subject {}\n", request->user().token(), exported, request->subject().id());
+                status = grpc::Status{grpc::StatusCode::CANCELLED, "export interrupted"};
+            }
+        }
+    }
+    catch (client_exception const& exp)
+    {
+        std::cerr << std::format("client {} {}\n", request->user().token(), exp.what());
+        status = grpc::Status{grpc::StatusCode::UNAVAILABLE, exp.what()};
+    }
+    catch (std::exception const& exp)
+    {
+        std::cerr << std::format("server: {}\n", exp.what());
+    }
+
+    return status;
+}
+
+grpc::Status server::ExportResourceBlocks(grpc::ServerContext* context, ExportResourceBlocksRequest const* request, grpc::ServerWriter<ExportResourceBlocksResponse>* writer)
+{
+    grpc::Status status{grpc::StatusCode::INTERNAL, {}};
+
+    try
+    {
+        if (!request->has_user() || !session_is_valid(request->user()))
+        {
+            status = grpc::Status{grpc::StatusCode::UNAUTHENTICATED, "invalid user"};
+        }
+        else if (request->resource().id() == 0)
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid resource"};
+        }
+        else if (!user_is_authorized(request->user()))
+        {
+            std::clog << std::format("client {} unauthorized access to x\n", request->user().token());
+            status = grpc::Status{grpc::StatusCode::PERMISSION_DENIED, "user is not authorized"};
+        }
+        else
+        {
+            ExportResourceBlocksResponse response{};
+            uint64_t exported{};
+            bool delivered{true};
+            m_database->export_resource_blocks(request->resource().id(), [context, writer, &response, &exported, &delivered](Card const& card, Block const& block) {
+                *response.mutable_card() = card;
+                *response.mutable_block() = block;
+                delivered = !context->IsCancelled() && writer->Write(response);
+                exported += delivered;
+                return delivered;
+            });
+
+            if (delivered)
+            {
+                std::clog << std::format("client {} exported {} blocks from resource {}\n", request->user().token(), exported, request->resource().id());
+                status = grpc::Status{grpc::StatusCode::OK, {}};
+            }
+            else
+            {
+                std::clog << std::format("client {} stopped reading after {} blocks from resource {}\n", request->user().token(), exported, request->resource().id());
+                status = grpc::Status{grpc::StatusCode::CANCELLED, "export interrupted"};
+            }
+        }
+    }
+    catch (client_exception const& exp)
+    {
+        std::cerr << std::format("client {} {}\n", request->user().token(), exp.what());
+        status = grpc::Status{grpc::StatusCode::UNAVAILABLE, exp.what()};
+    }
+    catch (std::exception const& exp)
+    {
+        std::cerr << std::format("server: {}\n", exp.what());
+    }
+
+    return status;
+}
+
+grpc::Status server::ExportSubjectAssessments(grpc::ServerContext* context, ExportSubjectAssessmentsRequest const* request, grpc::ServerWriter<ExportSubjectAssessmentsResponse>* writer)
+{
+    grpc::Status status{grpc::StatusCode::INTERNAL, {}};
+
+    try
+    {
+        if (!request->has_user() || !session_is_valid(request->user()))
+        {
+            status = grpc::Status{grpc::StatusCode::UNAUTHENTICATED, "invalid user"};
+        }
+        else if (request->subject().id() == 0)
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid subject"};
+        }
+        else if (!user_is_authorized(request->user()))
+        {
+            std::clog << std::format("client {} unauthorized access to x\n", request->user().token());
+            status = grpc::Status{grpc::StatusCode::PERMISSION_DENIED, "user is not authorized"};
+        }
+        else
+        {
+            ExportSubjectAssessmentsResponse response{};
+            uint64_t exported{};
+            bool delivered{true};
+            m_database->export_subject_assessments(request->subject().id(), request->max_level(), [context, writer, &response, &exported, &delivered](Card const& card) {
+                *response.mutable_card() = card;
+                delivered = !context->IsCancelled() && writer->Write(response);
+                exported += delivered;
+                return delivered;
+            });
+
+            if (delivered)
+            {
+                std::clog << std::format("client {} exported {} assessments from subject {}\n", request->user().token(), exported, request->subject().id());
+                status = grpc::Status{grpc::StatusCode::OK, {}};
+            }
+            else
+            {
+                std::clog << std::format("client {} stopped reading after {} assessments from subject {}\n", request->user().token(), exported, request->subject().id());
+                status = grpc::Status{grpc::StatusCode::CANCELLED, "export interrupted"};
+            }
+        }
+    }
+    catch (client_exception const& exp)
+    {
+        std::cerr << std::format("client {} {}\n", request->user().token(), exp.what());
+        status = grpc::Status{grpc::StatusCode::UNAVAILABLE, exp.what()};
+    }
+    catch (std::exception const& exp)
+    {
+        std::cerr << std::format("server: {}\n", exp.what());
+    }
+
+    return status;
+}
+
+grpc::Status server::Study(grpc::ServerContext* context, StudyRequest const* request, StudyResponse* response)
+{
+    grpc::Status status{grpc::StatusCode::INTERNAL, {}};
+
+    try
+    {
+        if (!request->has_user() || !session_is_valid(request->user()))
+        {
+            status = grpc::Status{grpc::StatusCode::UNAUTHENTICATED, "invalid user"};
+        }
+        else if (request->card().id() == 0)
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid card"};
+        }
+        else if (request->duration() < 3)
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid duration", "reading a card less than 3 seconds is not acceptable"};
+        }
+        else if (!user_is_authorized(request->user()))
+        {
+            std::clog << std::format("client {} unauthorized access to x\n", request->user().token());
+            status = grpc::Status{grpc::StatusCode::PERMISSION_DENIED, "user is not authorized"};
+        }
+        else
+        {
+            std::clog << std::format("client {} studied card {} in {} seconds\n", request->user().token(), request->card().id(), request->duration());
+            std::shared_ptr<User> const user{m_database->get_user(request->user().token(), request->user().device())};
+
+            if (m_progress_journal)
+            {
+                m_progress_journal->append(progress_event{progress_event::kind::study, user->id(), request->card().id(), 0, expertise_level::surface, request->duration(),
+                                                          wall_clock_seconds()});
+            }
+            else
+            {
+                m_database->study(user->id(), request->card().id(), std::chrono::seconds{request->duration()});
+                invalidate_progress_weights(user->id());
+                m_assimilation_state.invalidate(user->id());
+                m_study_history.record(user->id(), 0, expertise_level::surface, std::chrono::floor<std::chrono::days>(std::chrono::system_clock::now()), request->duration());
+            }
+
+            m_practice_scheduler.record(user->id(), request->card().id(), practice_scheduler::clock::now());
+            m_card_durations.record(request->card().id(), std::chrono::seconds{request->duration()});
+            status = grpc::Status{grpc::StatusCode::OK, {}};
+        }
+    }
+    catch (client_exception const& exp)
+    {
+        std::cerr << std::format("client {} {}\n", request->user().token(), exp.what());
+        status = grpc::Status{grpc::StatusCode::UNAVAILABLE, exp.what()};
+    }
+    catch (std::exception const& exp)
+    {
+        std::cerr << std::format("server: {}\n", exp.what());
+    }
+
+    return status;
+}
+
+grpc::Status server::MakeProgress(grpc::ServerContext* context, MakeProgressRequest const* request, MakeProgressResponse* response)
+{
+    grpc::Status status{grpc::StatusCode::INTERNAL, {}};
+
+    try
+    {
+        if (!request->has_user() || !session_is_valid(request->user()))
+        {
+            status = grpc::Status{grpc::StatusCode::UNAUTHENTICATED, "invalid user"};
+        }
+        else if (request->milestone().id() == 0)
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid milestone id"};
         }
-        else if (request->target_card().id() == 0)
+        else if (request->card().id() == 0)
         {
-            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid target card"};
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid card"};
         }
-        else if (request->target_block().position() == 0)
+        else if (request->duration() < 3)
         {
-            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid target block position"};
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid duration", "reading a card less than 3 seconds is not acceptable"};
         }
         else if (!user_is_verified(request->user()))
         {
@@ -4880,9 +6052,26 @@ grpc::Status server::MoveBlock(grpc::ServerContext* context, MoveBlockRequest co
         }
         else
         {
-            std::clog << std::format("client {} moved block from position {} in card {} to position {} in card {}\n", request->user().token(), request->block().position(),
-                                     request->card().id(), request->target_block().position(), request->target_card().id());
-            m_database->move_block(request->card().id(), request->block().position(), request->target_card().id(), request->target_block().position());
+            std::clog << std::format("client {} made progress on card {} in subject {} level {} in {} seconds\n", request->user().token(), request->card().id(),
+                                     request->milestone().id(), database::level_to_string(request->milestone().level()), request->duration());
+            std::shared_ptr<User> const user{m_database->get_user(request->user().token(), request->user().device())};
+
+            if (m_progress_journal)
+            {
+                m_progress_journal->append(progress_event{progress_event::kind::practice, user->id(), request->card().id(), request->milestone().id(),
+                                                          request->milestone().level(), request->duration(), wall_clock_seconds()});
+            }
+            else
+            {
+                m_database->make_progress(user->id(), request->milestone().id(), request->milestone().level(), request->card().id(), request->duration());
+                invalidate_progress_weights(user->id());
+                m_assimilation_state.invalidate(user->id());
+                m_study_history.record(user->id(), request->milestone().id(), request->milestone().level(),
+                                       std::chrono::floor<std::chrono::days>(std::chrono::system_clock::now()), request->duration());
+            }
+
+            m_practice_scheduler.record(user->id(), request->card().id(), practice_scheduler::clock::now());
+            m_card_durations.record(request->card().id(), std::chrono::seconds{request->duration()});
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -4899,24 +6088,39 @@ grpc::Status server::MoveBlock(grpc::ServerContext* context, MoveBlockRequest co
     return status;
 }
 
-grpc::Status server::Study(grpc::ServerContext* context, StudyRequest const* request, StudyResponse* response)
+grpc::Status server::SubmitStudyEvents(grpc::ServerContext* context, SubmitStudyEventsRequest const* request, SubmitStudyEventsResponse* response)
 {
     grpc::Status status{grpc::StatusCode::INTERNAL, {}};
 
     try
     {
+        auto const is_practice{[](StudyEvent const& event) { return event.milestone().id() != 0; }};
+
         if (!request->has_user() || !session_is_valid(request->user()))
         {
             status = grpc::Status{grpc::StatusCode::UNAUTHENTICATED, "invalid user"};
         }
-        else if (request->card().id() == 0)
+        else if (request->events().empty())
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "no study events"};
+        }
+        else if (static_cast<std::size_t>(request->events_size()) > max_submitted_events)
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "too many study events", std::format("at most {} events can be submitted at once", max_submitted_events)};
+        }
+        else if (std::ranges::any_of(request->events(), [](StudyEvent const& event) { return event.card().id() == 0; }))
         {
             status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid card"};
         }
-        else if (request->duration() < 3)
+        else if (std::ranges::any_of(request->events(), [](StudyEvent const& event) { return event.duration() < 3; }))
         {
             status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid duration", "reading a card less than 3 seconds is not acceptable"};
         }
+        else if (std::ranges::any_of(request->events(), is_practice) && !user_is_verified(request->user()))
+        {
+            std::clog << std::format("client {} tried to x without verification\n", request->user().token());
+            status = grpc::Status{grpc::StatusCode::PERMISSION_DENIED, "user is not verified"};
+        }
         else if (!user_is_authorized(request->user()))
         {
             std::clog << std::format("client {} unauthorized access to x\n", request->user().token());
@@ -4924,9 +6128,46 @@ grpc::Status server::Study(grpc::ServerContext* context, StudyRequest const* req
         }
         else
         {
-            std::clog << std::format("client {} studied card {} in {} seconds\n", request->user().token(), request->card().id(), request->duration());
+            std::clog << std::format("client {} submitted {} study events\n", request->user().token(), request->events_size());
             std::shared_ptr<User> const user{m_database->get_user(request->user().token(), request->user().device())};
-            m_database->study(user->id(), request->card().id(), std::chrono::seconds{request->duration()});
+            std::vector<StudyEvent const*> ordered{};
+            std::vector<progress_event> events{};
+            ordered.reserve(request->events_size());
+            events.reserve(request->events_size());
+
+            // offline sessions may arrive out of order, the scheduler needs them in the order they happened
+            std::ranges::transform(request->events(), std::back_inserter(ordered), [](StudyEvent const& event) { return &event; });
+            std::ranges::stable_sort(ordered, {}, [](StudyEvent const* event) { return event->timestamp(); });
+
+            uint64_t const submitted{wall_clock_seconds()};
+
+            for (StudyEvent const* event: ordered)
+            {
+                uint64_t const happened{event->timestamp() == 0 || event->timestamp() > submitted ? submitted : event->timestamp()};
+                events.push_back(progress_event{is_practice(*event) ? progress_event::kind::practice : progress_event::kind::study, user->id(), event->card().id(),
+                                                event->milestone().id(), event->milestone().level(), event->duration(), happened});
+            }
+
+            if (m_progress_journal)
+            {
+                m_progress_journal->append(events);
+            }
+            else
+            {
+                m_database->record_progress(events);
+                invalidate_progress_weights(user->id());
+                m_assimilation_state.invalidate(user->id());
+                record_study_history(events);
+            }
+
+            auto const now{practice_scheduler::clock::now()};
+
+            for (StudyEvent const* event: ordered)
+            {
+                m_practice_scheduler.record(user->id(), event->card().id(), now);
+                m_card_durations.record(event->card().id(), std::chrono::seconds{event->duration()});
+            }
+
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -4943,7 +6184,7 @@ grpc::Status server::Study(grpc::ServerContext* context, StudyRequest const* req
     return status;
 }
 
-grpc::Status server::MakeProgress(grpc::ServerContext* context, MakeProgressRequest const* request, MakeProgressResponse* response)
+grpc::Status server::GetProgressWeight(grpc::ServerContext* context, GetProgressWeightRequest const* request, GetProgressWeightResponse* response)
 {
     grpc::Status status{grpc::StatusCode::INTERNAL, {}};
 
@@ -4953,22 +6194,55 @@ grpc::Status server::MakeProgress(grpc::ServerContext* context, MakeProgressRequ
         {
             status = grpc::Status{grpc::StatusCode::UNAUTHENTICATED, "invalid user"};
         }
-        else if (request->milestone().id() == 0)
+        else if (!user_is_authorized(request->user()))
         {
-            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid milestone id"};
+            std::clog << std::format("client {} unauthorized access to x\n", request->user().token());
+            status = grpc::Status{grpc::StatusCode::PERMISSION_DENIED, "user is not authorized"};
         }
-        else if (request->card().id() == 0)
+        else
         {
-            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid card"};
+            std::shared_ptr<User> const user{m_database->get_user(request->user().token(), request->user().device())};
+            for (Weight const& weight: *load_progress_weights(user->id()))
+            {
+                *response->add_weight() = weight;
+            }
+            std::clog << std::format("client {} collected {} progress weights\n", request->user().token(), response->weight_size());
+            status = grpc::Status{grpc::StatusCode::OK, {}};
         }
-        else if (request->duration() < 3)
+    }
+    catch (client_exception const& exp)
+    {
+        std::cerr << std::format("client {} {}\n", request->user().token(), exp.what());
+        status = grpc::Status{grpc::StatusCode::UNAVAILABLE, exp.what()};
+    }
+    catch (std::exception const& exp)
+    {
+        std::cerr << std::format("server: {}\n", exp.what());
+    }
+
+    return status;
+}
+
+grpc::Status server::GetStudyHistory(grpc::ServerContext* context, GetStudyHistoryRequest const* request, GetStudyHistoryResponse* response)
+{
+    grpc::Status status{grpc::StatusCode::INTERNAL, {}};
+
+    try
+    {
+        std::chrono::sys_seconds const until{request->until() == 0 ? std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now())
+                                                                    : std::chrono::sys_seconds{std::chrono::seconds{request->until()}}};
+
+        if (!request->has_user() || !session_is_valid(request->user()))
         {
-            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid duration", "reading a card less than 3 seconds is not acceptable"};
+            status = grpc::Status{grpc::StatusCode::UNAUTHENTICATED, "invalid user"};
         }
-        else if (!user_is_verified(request->user()))
+        else if (std::chrono::sys_seconds{std::chrono::seconds{request->since()}} > until)
         {
-            std::clog << std::format("client {} tried to x without verification\n", request->user().token());
-            status = grpc::Status{grpc::StatusCode::PERMISSION_DENIED, "user is not verified"};
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid range", "beginning of the range cannot be after its end"};
+        }
+        else if (!history_granularity_IsValid(request->granularity()))
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid granularity"};
         }
         else if (!user_is_authorized(request->user()))
         {
@@ -4977,10 +6251,10 @@ grpc::Status server::MakeProgress(grpc::ServerContext* context, MakeProgressRequ
         }
         else
         {
-            std::clog << std::format("client {} made progress on card {} in subject {} level {} in {} seconds\n", request->user().token(), request->card().id(),
-                                     request->milestone().id(), database::level_to_string(request->milestone().level()), request->duration());
             std::shared_ptr<User> const user{m_database->get_user(request->user().token(), request->user().device())};
-            m_database->make_progress(user->id(), request->milestone().id(), request->milestone().level(), request->card().id(), request->duration());
+            m_study_history.collect(user->id(), std::chrono::floor<std::chrono::days>(std::chrono::sys_seconds{std::chrono::seconds{request->since()}}),
+                                    std::chrono::floor<std::chrono::days>(until), request->granularity(), *response->mutable_history());
+            std::clog << std::format("client {} collected {} study history points\n", request->user().token(), response->history_size());
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -4997,7 +6271,7 @@ grpc::Status server::MakeProgress(grpc::ServerContext* context, MakeProgressRequ
     return status;
 }
 
-grpc::Status server::GetProgressWeight(grpc::ServerContext* context, GetProgressWeightRequest const* request, GetProgressWeightResponse* response)
+grpc::Status server::EstimateCardTime(grpc::ServerContext* context, EstimateCardTimeRequest const* request, EstimateCardTimeResponse* response)
 {
     grpc::Status status{grpc::StatusCode::INTERNAL, {}};
 
@@ -5007,6 +6281,10 @@ grpc::Status server::GetProgressWeight(grpc::ServerContext* context, GetProgress
         {
             status = grpc::Status{grpc::StatusCode::UNAUTHENTICATED, "invalid user"};
         }
+        else if (request->card().id() == 0)
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid card"};
+        }
         else if (!user_is_authorized(request->user()))
         {
             std::clog << std::format("client {} unauthorized access to x\n", request->user().token());
@@ -5014,12 +6292,89 @@ grpc::Status server::GetProgressWeight(grpc::ServerContext* context, GetProgress
         }
         else
         {
-            std::shared_ptr<User> const user{m_database->get_user(request->user().token(), request->user().device())};
-            for (Weight weight: m_database->get_progress_weight(user->id()))
+            duration_estimate const estimate{m_card_durations.estimate(request->card().id())};
+            response->set_duration(estimate.typical.count());
+            response->set_upper_duration(estimate.upper.count());
+            response->set_measured(estimate.measured > 0);
+            std::clog << std::format("client {} estimated card {} at {} seconds\n", request->user().token(), request->card().id(), response->duration());
+            status = grpc::Status{grpc::StatusCode::OK, {}};
+        }
+    }
+    catch (client_exception const& exp)
+    {
+        std::cerr << std::format("client {} {}\n", request->user().token(), exp.what());
+        status = grpc::Status{grpc::StatusCode::UNAVAILABLE, exp.what()};
+    }
+    catch (std::exception const& exp)
+    {
+        std::cerr << std::format("server: {}\n", exp.what());
+    }
+
+    return status;
+}
+
+grpc::Status server::EstimateSessionTime(grpc::ServerContext* context, EstimateSessionTimeRequest const* request, EstimateSessionTimeResponse* response)
+{
+    grpc::Status status{grpc::StatusCode::INTERNAL, {}};
+
+    try
+    {
+        if (!request->has_user() || !session_is_valid(request->user()))
+        {
+            status = grpc::Status{grpc::StatusCode::UNAUTHENTICATED, "invalid user"};
+        }
+        else if (request->milestone().id() == 0)
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid milestone"};
+        }
+        else if (request->roadmap().id() == 0 && request->topic().position() == 0)
+        {
+            status = grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "invalid scope", "either a topic or a roadmap to practice the milestone in is required"};
+        }
+        else if (!user_is_authorized(request->user()))
+        {
+            std::clog << std::format("client {} unauthorized access to x\n", request->user().token());
+            status = grpc::Status{grpc::StatusCode::PERMISSION_DENIED, "user is not authorized"};
+        }
+        else
+        {
+            duration_estimate estimate{};
+
+            // without a roadmap the whole topic is read, with one only the cards due for practice in the topic or in every topic of the milestone
+            if (request->roadmap().id() == 0)
             {
-                *response->add_weight() = weight;
+                google::protobuf::RepeatedPtrField<Card> cards{};
+                m_database->get_topic_cards(request->milestone().id(), request->topic().position(), request->topic().level(), cards);
+                estimate = m_card_durations.estimate(cards);
             }
-            std::clog << std::format("client {} collected {} progress weights\n", request->user().token(), response->weight_size());
+            else
+            {
+                std::shared_ptr<User> const user{m_database->get_user(request->user().token(), request->user().device())};
+                std::vector<Topic> topics{};
+
+                if (request->topic().position() != 0)
+                {
+                    topics.push_back(request->topic());
+                }
+                else
+                {
+                    topics = m_database->get_practice_topics(user->id(), request->roadmap().id(), request->milestone().id(), request->milestone().level());
+                }
+
+                for (Topic const& topic: topics)
+                {
+                    google::protobuf::RepeatedPtrField<Card> cards{};
+                    collect_practice_cards(practice_key{user->id(), request->roadmap().id(), request->milestone().id(), topic.level(), topic.position()}, cards);
+                    estimate += m_card_durations.estimate(cards);
+                }
+            }
+
+            response->set_duration(estimate.typical.count());
+            response->set_upper_duration(estimate.upper.count());
+            response->set_cards(estimate.cards);
+            response->set_measured_cards(estimate.measured);
+            std::clog << std::format("client {} estimated {} cards in milestone {} at {} seconds\n", request->user().token(), response->cards(), request->milestone().id(),
+                                     response->duration());
             status = grpc::Status{grpc::StatusCode::OK, {}};
         }
     }
@@ -5207,6 +6562,193 @@ std::string server::generate_token()
     return std::string{token};
 }
 
+void server::collect_practice_cards(practice_key const& key, google::protobuf::RepeatedPtrField<Card>& cards)
+{
+    practice_scheduler::clock::time_point const now{practice_scheduler::clock::now()};
+
+    if (!m_practice_scheduler.collect(key, now, cards))
+    {
+        uint64_t const generation{m_practice_scheduler.generation()};
+        m_database->get_practice_cards(key.user_id, key.roadmap_id, key.subject_id, key.level, key.topic_position, cards);
+        m_practice_scheduler.assign(key, cards, generation, now);
+    }
+}
+
+std::shared_ptr<roadmap_graph const> server::load_roadmap_graph(uint64_t const roadmap_id)
+{
+    return m_roadmap_graphs.load(roadmap_id, [this, roadmap_id] {
+        return std::make_shared<roadmap_graph const>(m_database->get_milestones(roadmap_id), m_database->get_roadmap_requirements(roadmap_id));
+    });
+}
+
+void server::invalidate_roadmap_graph(uint64_t const roadmap_id)
+{
+    m_roadmap_graphs.invalidate(roadmap_id);
+}
+
+void server::invalidate_roadmap_graphs()
+{
+    m_roadmap_graphs.clear();
+}
+
+std::shared_ptr<std::vector<Weight> const> server::load_progress_weights(uint64_t const user_id)
+{
+    return m_progress_weights.load(user_id, [this, user_id] { return std::make_shared<std::vector<Weight> const>(m_database->get_progress_weight(user_id)); });
+}
+
+void server::invalidate_progress_weights(uint64_t const user_id)
+{
+    m_progress_weights.invalidate(user_id);
+}
+
+void server::invalidate_progress_weights()
+{
+    m_progress_weights.clear();
+}
+
+std::shared_ptr<coverage_matrix const> server::load_coverage_matrix(uint64_t const subject_id)
+{
+    return m_coverage_matrices.load(subject_id, [this, subject_id] { return std::make_shared<coverage_matrix const>(m_database->get_subject_coverage(subject_id)); });
+}
+
+void server::update_coverage_matrix(uint64_t const subject_id, uint64_t const assessment_id, expertise_level const level, uint64_t const topic_position, bool const covered)
+{
+    m_coverage_matrices.update(subject_id, [assessment_id, level, topic_position, covered](coverage_matrix const& cached) {
+        auto matrix{std::make_shared<coverage_matrix>(cached)};
+        return matrix->assign(assessment_id, level, topic_position, covered) ? std::shared_ptr<coverage_matrix const>{std::move(matrix)} : nullptr;
+    });
+}
+
+void server::invalidate_coverage_matrix(uint64_t const subject_id)
+{
+    m_coverage_matrices.invalidate(subject_id);
+}
+
+void server::invalidate_assessment_coverage(uint64_t const assessment_id)
+{
+    m_coverage_matrices.invalidate_if([assessment_id](coverage_matrix const& matrix) { return matrix.holds(assessment_id); });
+}
+
+void server::invalidate_subject_caches(uint64_t const subject_id)
+{
+    m_practice_scheduler.invalidate_subject(subject_id);
+    m_assimilation_state.invalidate_subject(subject_id);
+    invalidate_coverage_matrix(subject_id);
+}
+
+void server::invalidate_topic_caches(uint64_t const subject_id, expertise_level const level, uint64_t const topic_position)
+{
+    m_practice_scheduler.invalidate_topic(subject_id, level, topic_position);
+    m_assimilation_state.invalidate_topic(assimilation_key{subject_id, level, topic_position});
+    invalidate_coverage_matrix(subject_id);
+}
+
+void server::invalidate_card_caches(uint64_t const card_id)
+{
+    m_practice_scheduler.invalidate_card(card_id);
+    invalidate_assessment_coverage(card_id);
+}
+
+void server::record_study_history(std::span<progress_event const> const events)
+{
+    for (progress_event const& event: events)
+    {
+        // events carry wall clock seconds, history files them on the day they happened
+        std::chrono::sys_seconds const happened{std::chrono::seconds{event.timestamp == 0 ? wall_clock_seconds() : event.timestamp}};
+        m_study_history.record(event.user_id, event.milestone_id, event.milestone_level, std::chrono::floor<std::chrono::days>(happened), event.duration);
+    }
+}
+
+void server::complete_typeahead(TypeaheadRequest const& request, std::stop_token const& stop, TypeaheadResponse& response) const
+{
+    uint64_t const limit{page_limit(request.limit())};
+
+    if (request.prefix().empty())
+    {
+        std::clog << "client sent an empty typeahead prefix\n";
+    }
+    else if (request.scope() == TypeaheadRequest::subjects)
+    {
+        std::vector<Subject> matches{m_subject_index.loaded() ? m_subject_index.search(request.prefix(), limit, 0) : m_database->search_subjects(request.prefix(), limit, 0)};
+
+        for (uint64_t position{1}; Subject& subject: matches)
+        {
+            MatchingSubject* match{response.add_subjects()};
+            match->set_position(position++);
+            *match->mutable_subject() = std::move(subject);
+        }
+    }
+    else if (request.scope() == TypeaheadRequest::cards && request.subject().id() != 0)
+    {
+        for (uint64_t position{1}; Card& card: m_database->search_cards(request.subject().id(), request.level(), request.prefix(), limit, 0, stop))
+        {
+            CardSearchResult* match{response.add_cards()};
+            match->set_position(position++);
+            *match->mutable_card() = std::move(card);
+        }
+    }
+}
+
+uint64_t server::wall_clock_seconds()
+{
+    return static_cast<uint64_t>(std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now()).time_since_epoch().count());
+}
+
+uint64_t server::page_limit(uint32_t const requested_limit)
+{
+    return requested_limit == 0 ? default_page_size : std::min<uint64_t>(requested_limit, max_page_size);
+}
+
+// listings predate paging, so an unset page size still returns whole lists up to a bound
+uint64_t server::list_page_limit(uint32_t const requested_size)
+{
+    return requested_size == 0 ? max_list_page_size : std::min<uint64_t>(requested_size, max_list_page_size);
+}
+
+std::string server::encode_page_token(uint64_t const offset)
+{
+    unsigned char cursor[sizeof(offset)];
+    char token[sodium_base64_ENCODED_LEN(sizeof(cursor), sodium_base64_VARIANT_URLSAFE_NO_PADDING)];
+
+    for (std::size_t index{}; index < sizeof(cursor); ++index)
+    {
+        cursor[index] = static_cast<unsigned char>(offset >> (index * 8));
+    }
+
+    sodium_bin2base64(token, sizeof(token), cursor, sizeof(cursor), sodium_base64_VARIANT_URLSAFE_NO_PADDING);
+
+    return std::string{token};
+}
+
+std::optional<uint64_t> server::decode_page_token(std::string_view const token)
+{
+    std::optional<uint64_t> offset{};
+    unsigned char cursor[sizeof(uint64_t)];
+    std::size_t length{};
+
+    if (token.empty())
+    {
+        offset = 0;
+    }
+    else if (sodium_base642bin(cursor, sizeof(cursor), token.data(), token.size(), nullptr, &length, nullptr, sodium_base64_VARIANT_URLSAFE_NO_PADDING) == 0 &&
+             length == sizeof(cursor))
+    {
+        uint64_t decoded{};
+
+        for (std::size_t index{}; index < sizeof(cursor); ++index)
+        {
+            decoded |= static_cast<uint64_t>(cursor[index]) << (index * 8);
+        }
+
+        if (decoded <= max_page_offset)
+        {
+            offset = decoded;
+        }
+    }
+
+    return offset;
+}
+
 bool server::session_is_valid(User const& user) const
 {
     return nullptr != m_database->get_user(user.token(), user.device());
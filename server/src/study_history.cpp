@@ -0,0 +1,470 @@
+#include <algorithm>
+#include <cerrno>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <fcntl.h>
+#include <unistd.h>
+#include <flashback/study_history.hpp>
+
+using namespace flashback;
+
+namespace
+{
+// each user is saved to a file of its own that counts the series of the user first
+constexpr std::string_view snapshot_magic{"FBHIST03"};
+
+void put(std::string& column, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        column.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+
+    column.push_back(static_cast<char>(value));
+}
+
+std::optional<uint64_t> take(std::string_view& column) noexcept
+{
+    uint64_t value{};
+
+    for (unsigned shift{}; shift < 64 && !column.empty(); shift += 7)
+    {
+        auto const byte{static_cast<unsigned char>(column.front())};
+        column.remove_prefix(1);
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+
+        if ((byte & 0x80) == 0)
+        {
+            return value;
+        }
+    }
+
+    return std::nullopt;
+}
+
+std::optional<std::string> take_column(std::string_view& contents)
+{
+    std::optional<uint64_t> const size{take(contents)};
+
+    if (!size || *size > contents.size())
+    {
+        return std::nullopt;
+    }
+
+    std::string column{contents.substr(0, *size)};
+    contents.remove_prefix(*size);
+    return column;
+}
+
+std::optional<std::size_t> count_values(std::string_view column) noexcept
+{
+    std::size_t count{};
+
+    for (; !column.empty(); ++count)
+    {
+        if (!take(column))
+        {
+            return std::nullopt;
+        }
+    }
+
+    return count;
+}
+
+std::chrono::sys_days period_of(std::chrono::sys_days const day, history_granularity const granularity)
+{
+    switch (granularity)
+    {
+    case history_granularity::weekly:
+        return day - std::chrono::days{std::chrono::weekday{day}.iso_encoding() - 1};
+    case history_granularity::monthly:
+    {
+        std::chrono::year_month_day const date{day};
+        return std::chrono::sys_days{date.year() / date.month() / 1};
+    }
+    default:
+        return day;
+    }
+}
+
+void write_snapshot(std::filesystem::path const& path, std::string_view contents)
+{
+    int const descriptor{::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600)};
+
+    if (descriptor < 0)
+    {
+        throw std::system_error{errno, std::generic_category(), std::format("study history {} cannot be opened", path.string())};
+    }
+
+    while (!contents.empty())
+    {
+        ssize_t const written{::write(descriptor, contents.data(), contents.size())};
+
+        if (written < 0 && errno != EINTR)
+        {
+            ::close(descriptor);
+            throw std::system_error{errno, std::generic_category(), "study history write failed"};
+        }
+
+        contents.remove_prefix(written < 0 ? 0 : static_cast<std::size_t>(written));
+    }
+
+    if (::fdatasync(descriptor) != 0)
+    {
+        ::close(descriptor);
+        throw std::system_error{errno, std::generic_category(), "study history sync failed"};
+    }
+
+    ::close(descriptor);
+}
+} // namespace
+
+study_history::study_history(std::filesystem::path directory, std::size_t const capacity, std::chrono::milliseconds const save_interval)
+    : m_directory{std::move(directory)}
+    , m_capacity{std::max(capacity, std::size_t{1})}
+    , m_save_interval{save_interval}
+{
+    if (!m_directory.empty())
+    {
+        m_saver = std::jthread{[this](std::stop_token const& stop) { save_periodically(stop); }};
+    }
+}
+
+study_history::~study_history()
+{
+    if (m_saver.joinable())
+    {
+        m_saver.request_stop();
+        m_saver.join();
+    }
+
+    try
+    {
+        save();
+    }
+    catch (std::exception const& exp)
+    {
+        std::cerr << std::format("study history: final save failed: {}\n", exp.what());
+    }
+}
+
+void study_history::record(uint64_t const user_id, uint64_t const subject_id, expertise_level const level, std::chrono::sys_days const day, uint64_t const duration)
+{
+    auto const day_number{day.time_since_epoch().count() < 0 ? uint64_t{} : static_cast<uint64_t>(day.time_since_epoch().count())};
+    std::unique_lock lock{m_mutex};
+    user_history& user{resident(lock, user_id)};
+    series& columns{user.series.try_emplace(series_key{subject_id, level}, series{{}, {}, {}, 0, row{day_number, 0, 0}}).first->second};
+
+    if (day_number == columns.open.day)
+    {
+        ++columns.open.cards;
+        columns.open.seconds += duration;
+    }
+    else if (day_number > columns.open.day)
+    {
+        close(columns, columns.open);
+        columns.open = row{day_number, 1, duration};
+    }
+    else
+    {
+        // late events of offline sessions land on a closed day, which is rare enough to rebuild the series for
+        std::vector<row> rows{decode(columns)};
+        rows.push_back(columns.open);
+        auto const position{std::ranges::lower_bound(rows, day_number, {}, &row::day)};
+
+        if (position != rows.end() && position->day == day_number)
+        {
+            ++position->cards;
+            position->seconds += duration;
+        }
+        else
+        {
+            rows.insert(position, row{day_number, 1, duration});
+        }
+
+        columns = series{{}, {}, {}, 0, rows.back()};
+        rows.pop_back();
+
+        for (row const& closed: rows)
+        {
+            close(columns, closed);
+        }
+    }
+
+    ++user.version;
+}
+
+void study_history::collect(uint64_t const user_id, std::chrono::sys_days const since, std::chrono::sys_days const until, history_granularity const granularity,
+                            google::protobuf::RepeatedPtrField<StudyHistory>& history)
+{
+    std::map<std::tuple<std::chrono::sys_days, uint64_t, expertise_level>, std::pair<uint64_t, uint64_t>> periods{};
+
+    {
+        std::unique_lock lock{m_mutex};
+
+        for (auto const& [key, columns]: resident(lock, user_id).series)
+        {
+            std::vector<row> rows{decode(columns)};
+            rows.push_back(columns.open);
+
+            for (row const& day: rows)
+            {
+                std::chrono::sys_days const date{std::chrono::days{day.day}};
+
+                if (date > until)
+                {
+                    break;
+                }
+
+                if (date >= since)
+                {
+                    auto& period{periods[{period_of(date, granularity), key.subject_id, key.level}]};
+                    period.first += day.cards;
+                    period.second += day.seconds;
+                }
+            }
+        }
+    }
+
+    history.Reserve(static_cast<int>(periods.size()));
+
+    for (auto const& [period, totals]: periods)
+    {
+        auto const& [date, subject_id, level]{period};
+        StudyHistory* point{history.Add()};
+        point->set_timestamp(std::chrono::duration_cast<std::chrono::seconds>(date.time_since_epoch()).count());
+
+        if (subject_id != 0)
+        {
+            point->mutable_subject()->set_id(subject_id);
+        }
+
+        point->set_level(level);
+        point->set_cards(totals.first);
+        point->set_duration(totals.second);
+    }
+}
+
+void study_history::save()
+{
+    std::lock_guard const save_lock{m_save_mutex};
+    std::vector<std::tuple<uint64_t, uint64_t, std::string>> modified{};
+
+    // recording only waits for the modified users to be encoded, syncing happens without the lock
+    {
+        std::lock_guard const lock{m_mutex};
+
+        if (m_directory.empty())
+        {
+            return;
+        }
+
+        for (auto const& [user_id, user]: m_users)
+        {
+            if (user.version != user.saved_version)
+            {
+                modified.emplace_back(user_id, user.version, snapshot(user.series));
+            }
+        }
+    }
+
+    if (modified.empty())
+    {
+        return;
+    }
+
+    std::filesystem::create_directories(m_directory);
+
+    for (auto const& [user_id, version, contents]: modified)
+    {
+        std::filesystem::path const target{path_of(user_id)};
+        std::filesystem::path const staged{std::filesystem::path{target}.concat(".tmp")};
+        write_snapshot(staged, contents);
+        std::filesystem::rename(staged, target);
+
+        std::lock_guard const lock{m_mutex};
+        m_users.at(user_id).saved_version = version;
+    }
+
+    std::lock_guard const lock{m_mutex};
+    evict();
+}
+
+std::vector<study_history::row> study_history::decode(series const& columns)
+{
+    std::vector<row> rows{};
+    std::string_view days{columns.days};
+    std::string_view cards{columns.cards};
+    std::string_view seconds{columns.seconds};
+    uint64_t day{};
+
+    while (!days.empty())
+    {
+        day += take(days).value_or(0);
+        rows.push_back(row{day, take(cards).value_or(0), take(seconds).value_or(0)});
+    }
+
+    return rows;
+}
+
+void study_history::close(series& columns, row const& closed)
+{
+    put(columns.days, closed.day - columns.closed_day);
+    put(columns.cards, closed.cards);
+    put(columns.seconds, closed.seconds);
+    columns.closed_day = closed.day;
+}
+
+study_history::user_history& study_history::resident(std::unique_lock<std::mutex>& lock, uint64_t const user_id)
+{
+    auto user{m_users.find(user_id)};
+    user_series loaded{};
+
+    if (user == m_users.end() && !m_directory.empty())
+    {
+        lock.unlock();
+        loaded = load(user_id);
+        lock.lock();
+        user = m_users.find(user_id);
+    }
+
+    if (user != m_users.end())
+    {
+        m_recency.splice(m_recency.begin(), m_recency, user->second.recency);
+        return user->second;
+    }
+
+    m_recency.push_front(user_id);
+    user_history& created{m_users.emplace(user_id, user_history{std::move(loaded), 0, 0, m_recency.begin()}).first->second};
+    evict();
+    return created;
+}
+
+void study_history::evict()
+{
+    // the most recently used user is the one being worked on and is never evicted
+    for (auto candidate{m_recency.end()}; m_users.size() > m_capacity && std::prev(candidate) != m_recency.begin();)
+    {
+        --candidate;
+        auto const user{m_users.find(*candidate)};
+
+        // modified users wait for the next save, without a directory there is nowhere to save them and they are forgotten
+        if (m_directory.empty() || user->second.version == user->second.saved_version)
+        {
+            m_users.erase(user);
+            candidate = m_recency.erase(candidate);
+        }
+    }
+}
+
+std::filesystem::path study_history::path_of(uint64_t const user_id) const
+{
+    return (m_directory / std::to_string(user_id)).concat(".history");
+}
+
+study_history::user_series study_history::load(uint64_t const user_id) const
+{
+    std::filesystem::path const path{path_of(user_id)};
+    std::ifstream file{path, std::ios::binary};
+    std::string const contents{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    std::string_view remaining{contents};
+    user_series user{};
+
+    if (contents.empty())
+    {
+        return user;
+    }
+
+    bool valid{remaining.starts_with(snapshot_magic)};
+    remaining.remove_prefix(valid ? snapshot_magic.size() : remaining.size());
+    std::optional<uint64_t> const series_count{valid ? take(remaining) : std::nullopt};
+    valid = valid && series_count;
+
+    for (uint64_t loaded{}; valid && loaded < *series_count; ++loaded)
+    {
+        std::optional<uint64_t> const subject_id{take(remaining)};
+        std::optional<uint64_t> const level{take(remaining)};
+        std::optional<uint64_t> const closed_day{take(remaining)};
+        std::optional<uint64_t> const open_day{take(remaining)};
+        std::optional<uint64_t> const open_cards{take(remaining)};
+        std::optional<uint64_t> const open_seconds{take(remaining)};
+        std::optional<std::string> days{take_column(remaining)};
+        std::optional<std::string> cards{take_column(remaining)};
+        std::optional<std::string> seconds{take_column(remaining)};
+
+        valid = subject_id && level && closed_day && open_day && open_cards && open_seconds && days && cards && seconds &&
+                expertise_level_IsValid(static_cast<int>(*level));
+
+        if (valid)
+        {
+            std::optional<std::size_t> const rows{count_values(*days)};
+            valid = rows && rows == count_values(*cards) && rows == count_values(*seconds);
+        }
+
+        if (valid)
+        {
+            user.insert_or_assign(series_key{*subject_id, static_cast<expertise_level>(*level)},
+                                  series{std::move(*days), std::move(*cards), std::move(*seconds), *closed_day, row{*open_day, *open_cards, *open_seconds}});
+        }
+    }
+
+    if (!valid || !remaining.empty())
+    {
+        std::cerr << std::format("study history: {} is damaged, starting the user without history\n", path.string());
+        user.clear();
+    }
+
+    return user;
+}
+
+void study_history::save_periodically(std::stop_token const& stop)
+{
+    std::unique_lock lock{m_mutex};
+
+    while (!m_save_signal.wait_for(lock, stop, m_save_interval, [&stop] { return stop.stop_requested(); }))
+    {
+        lock.unlock();
+
+        try
+        {
+            save();
+        }
+        catch (std::exception const& exp)
+        {
+            std::cerr << std::format("study history: {}\n", exp.what());
+        }
+
+        lock.lock();
+    }
+}
+
+std::string study_history::snapshot(user_series const& user)
+{
+    std::string contents{snapshot_magic};
+    put(contents, user.size());
+
+    for (auto const& [key, columns]: user)
+    {
+        put(contents, key.subject_id);
+        put(contents, static_cast<uint64_t>(key.level));
+        put(contents, columns.closed_day);
+        put(contents, columns.open.day);
+        put(contents, columns.open.cards);
+        put(contents, columns.open.seconds);
+
+        for (std::string const* column: {&columns.days, &columns.cards, &columns.seconds})
+        {
+            put(contents, column->size());
+            contents.append(*column);
+        }
+    }
+
+    return contents;
+}
@@ -0,0 +1,62 @@
+#include <format>
+#include <iostream>
+#include <flashback/task_executor.hpp>
+
+using namespace flashback;
+
+task_executor::task_executor(std::size_t const workers)
+{
+    m_workers.reserve(workers);
+
+    for (std::size_t worker{}; worker < workers; ++worker)
+    {
+        m_workers.emplace_back([this](std::stop_token const& stop) { run(stop); });
+    }
+}
+
+task_executor::~task_executor()
+{
+    for (std::jthread& worker: m_workers)
+    {
+        worker.request_stop();
+    }
+
+    for (std::jthread& worker: m_workers)
+    {
+        worker.join();
+    }
+}
+
+void task_executor::submit(std::function<void()> task)
+{
+    {
+        std::lock_guard const lock{m_mutex};
+        m_tasks.push_back(std::move(task));
+    }
+
+    m_wake.notify_one();
+}
+
+void task_executor::run(std::stop_token const& stop)
+{
+    std::unique_lock lock{m_mutex};
+
+    // once stopped the wait no longer blocks, so the queue drains before the thread exits
+    while (m_wake.wait(lock, stop, [this] { return !m_tasks.empty(); }))
+    {
+        std::function<void()> task{std::move(m_tasks.front())};
+        m_tasks.pop_front();
+        lock.unlock();
+
+        try
+        {
+            task();
+        }
+        catch (std::exception const& exp)
+        {
+            std::cerr << std::format("executor: {}\n", exp.what());
+        }
+
+        lock.lock();
+    }
+}
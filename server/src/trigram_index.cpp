@@ -0,0 +1,61 @@
+#include <algorithm>
+#include <flashback/trigram_index.hpp>
+
+using namespace flashback;
+
+namespace
+{
+// multibyte characters are kept as word bytes so names outside ascii remain searchable
+[[nodiscard]] constexpr bool is_word_byte(unsigned char const c) noexcept
+{
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c >= 0x80;
+}
+
+[[nodiscard]] constexpr unsigned char lower(unsigned char const c) noexcept
+{
+    return c >= 'A' && c <= 'Z' ? static_cast<unsigned char>(c - 'A' + 'a') : c;
+}
+} // namespace
+
+std::vector<trigram> flashback::extract_trigrams(std::string_view const text)
+{
+    std::vector<trigram> trigrams{};
+    trigrams.reserve(text.size() + 2);
+    std::size_t position{};
+
+    while (position < text.size())
+    {
+        while (position < text.size() && !is_word_byte(static_cast<unsigned char>(text[position])))
+        {
+            ++position;
+        }
+
+        if (position == text.size())
+        {
+            break;
+        }
+
+        // each word is padded with two leading and one trailing space the way pg_trgm does
+        trigram window{static_cast<trigram>(' ') << 8 | ' '};
+
+        while (position < text.size() && is_word_byte(static_cast<unsigned char>(text[position])))
+        {
+            window = (window << 8 | lower(static_cast<unsigned char>(text[position]))) & 0xffffff;
+            trigrams.push_back(window);
+            ++position;
+        }
+
+        trigrams.push_back((window << 8 | ' ') & 0xffffff);
+    }
+
+    std::ranges::sort(trigrams);
+    trigrams.erase(std::ranges::unique(trigrams).begin(), trigrams.end());
+
+    return trigrams;
+}
+
+bool flashback::contains_ignoring_case(std::string_view const text, std::string_view const pattern) noexcept
+{
+    auto const equal = [](char const lhs, char const rhs) { return lower(static_cast<unsigned char>(lhs)) == lower(static_cast<unsigned char>(rhs)); };
+    return !pattern.empty() && !std::ranges::search(text, pattern, equal).empty();
+}
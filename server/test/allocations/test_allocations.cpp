@@ -0,0 +1,192 @@
+#include <new>
+#include <memory>
+#include <string>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <flashback/mock_database.hpp>
+#include <flashback/server.hpp>
+#include <flashback/arena_allocator.hpp>
+
+using testing::A;
+using testing::Le;
+using testing::Eq;
+using testing::Return;
+using testing::Invoke;
+using testing::IsTrue;
+
+namespace
+{
+// call arenas are expected to cut heap allocations of a handler by at least an order of magnitude
+constexpr std::size_t allocation_reduction{10};
+thread_local std::size_t* allocation_counter{nullptr};
+
+// counts heap allocations made by the current thread while a counter is armed
+class allocation_scope
+{
+public:
+    explicit allocation_scope(std::size_t& counter)
+    {
+        counter = 0;
+        allocation_counter = &counter;
+    }
+
+    ~allocation_scope()
+    {
+        allocation_counter = nullptr;
+    }
+
+    allocation_scope(allocation_scope const&) = delete;
+    allocation_scope& operator=(allocation_scope const&) = delete;
+};
+} // namespace
+
+void* operator new(std::size_t const size)
+{
+    if (allocation_counter != nullptr)
+    {
+        ++*allocation_counter;
+    }
+
+    if (void* pointer{std::malloc(size == 0 ? 1 : size)})
+    {
+        return pointer;
+    }
+
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+class test_allocations: public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        m_mock_database = std::make_shared<flashback::mock_database>();
+        m_server = std::make_shared<flashback::server>(m_mock_database);
+        m_user = std::make_shared<flashback::User>();
+        m_user->set_id(1);
+        m_user->set_device(R"(aaaaaaaa-bbbb-cccc-dddd-eeeeeeeeeeee)");
+        m_user->set_token(R"(iNFzgSaY2W+q42gM9lNVbB13v0odiLy6WnHbInbuvvE)");
+
+        EXPECT_CALL(*m_mock_database, get_user(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Invoke([this]() { return std::make_unique<flashback::User>(*m_user); }));
+        EXPECT_CALL(*m_mock_database, user_is_authorized(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Return(true));
+    }
+
+protected:
+    // runs the handler once with heap allocated messages and once with messages on a call arena
+    template <typename Request, typename Response, typename Handler>
+    std::pair<std::size_t, std::size_t> measure(Request const& prototype, Handler handler)
+    {
+        std::size_t heap_allocations{};
+        std::size_t arena_allocations{};
+
+        {
+            allocation_scope const scope{heap_allocations};
+            auto const request{std::make_unique<Request>(prototype)};
+            auto const response{std::make_unique<Response>()};
+            EXPECT_THAT(handler(request.get(), response.get()).ok(), IsTrue());
+        }
+
+        {
+            flashback::arena_allocator<Request, Response> allocator{};
+            allocation_scope const scope{arena_allocations};
+            grpc::MessageHolder<Request, Response>* holder{allocator.AllocateMessages()};
+            holder->request()->CopyFrom(prototype);
+            EXPECT_THAT(handler(holder->request(), holder->response()).ok(), IsTrue());
+            holder->Release();
+        }
+
+        return {heap_allocations, arena_allocations};
+    }
+
+    std::shared_ptr<flashback::server> m_server{nullptr};
+    std::shared_ptr<flashback::mock_database> m_mock_database{nullptr};
+    std::shared_ptr<flashback::User> m_user{nullptr};
+};
+
+TEST_F(test_allocations, GetBlocks)
+{
+    constexpr std::size_t blocks_count{256};
+    grpc::ServerContext context{};
+    flashback::GetBlocksRequest request{};
+    flashback::Block block{};
+    block.set_type(flashback::Block::code);
+    block.set_extension("cpp");
+    block.set_content("template <typename T> concept sortable = std::totally_ordered<T> && std::movable<T>;");
+    *request.mutable_user() = *m_user;
+    request.mutable_card()->set_id(1);
+
+    EXPECT_CALL(*m_mock_database, get_blocks(A<uint64_t>(), A<google::protobuf::RepeatedPtrField<flashback::Block>&>())).WillRepeatedly(
+        Invoke([&block](uint64_t, google::protobuf::RepeatedPtrField<flashback::Block>& blocks) {
+            blocks.Reserve(blocks_count);
+            for (std::size_t position{1}; position <= blocks_count; ++position)
+            {
+                flashback::Block* added{blocks.Add()};
+                *added = block;
+                added->set_position(position);
+            }
+        }));
+
+    auto const [heap, arena]{measure<flashback::GetBlocksRequest, flashback::GetBlocksResponse>(request, [&](auto const* request, auto* response) {
+        return m_server->GetBlocks(&context, request, response);
+    })};
+
+    RecordProperty("heap_allocations", std::to_string(heap));
+    RecordProperty("arena_allocations", std::to_string(arena));
+    EXPECT_THAT(arena, Le(heap / allocation_reduction)) << "Messages on a call arena should allocate an order of magnitude less often";
+}
+
+TEST_F(test_allocations, GetStudyResources)
+{
+    constexpr std::size_t resources_count{64};
+    grpc::ServerContext context{};
+    flashback::GetStudyResourcesRequest request{};
+    flashback::Resource resource{};
+    flashback::Provider provider{};
+    flashback::Presenter presenter{};
+    flashback::Milestone milestone{};
+    resource.set_name("Effective Modern C++");
+    resource.set_type(flashback::Resource::book);
+    resource.set_pattern(flashback::Resource::chapter);
+    resource.set_link("https://www.oreilly.com/library/view/effective-modern-c/9781491908419");
+    provider.set_id(1);
+    provider.set_name("O'Reilly Media");
+    presenter.set_id(1);
+    presenter.set_name("Scott Meyers");
+    milestone.set_id(1);
+    milestone.set_name("C++");
+    *request.mutable_user() = *m_user;
+
+    EXPECT_CALL(*m_mock_database, get_study_resources(A<uint64_t>(), A<google::protobuf::RepeatedPtrField<flashback::StudyResource>&>())).WillRepeatedly(
+        Invoke([&](uint64_t, google::protobuf::RepeatedPtrField<flashback::StudyResource>& resources) {
+            resources.Reserve(resources_count);
+            for (std::size_t id{1}; id <= resources_count; ++id)
+            {
+                flashback::StudyResource* study{resources.Add()};
+                flashback::Resource* added{study->mutable_resource()};
+                *added = resource;
+                added->set_id(id);
+                *added->add_providers() = provider;
+                *added->add_presenters() = presenter;
+                *study->mutable_milestone() = milestone;
+            }
+        }));
+
+    auto const [heap, arena]{measure<flashback::GetStudyResourcesRequest, flashback::GetStudyResourcesResponse>(request, [&](auto const* request, auto* response) {
+        return m_server->GetStudyResources(&context, request, response);
+    })};
+
+    RecordProperty("heap_allocations", std::to_string(heap));
+    RecordProperty("arena_allocations", std::to_string(arena));
+    EXPECT_THAT(arena, Le(heap / allocation_reduction)) << "Messages on a call arena should allocate an order of magnitude less often";
+}
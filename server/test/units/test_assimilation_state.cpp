@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <types.pb.h>
+#include <flashback/assimilation_state.hpp>
+
+using testing::Eq;
+using testing::Optional;
+
+namespace
+{
+flashback::assimilation_key make_key(uint64_t const topic_position)
+{
+    return flashback::assimilation_key{1, flashback::expertise_level::surface, topic_position};
+}
+} // namespace
+
+TEST(assimilation_state, keep_assigned_topics)
+{
+    flashback::assimilation_state state{8};
+
+    EXPECT_THAT(state.find(1, make_key(1)), Eq(std::nullopt)) << "Topics never loaded should be read from the database";
+    state.assign(1, make_key(1), true, state.generation());
+    state.assign(1, make_key(2), false, state.generation());
+    EXPECT_THAT(state.find(1, make_key(1)), Optional(true));
+    EXPECT_THAT(state.find(1, make_key(2)), Optional(false));
+    EXPECT_THAT(state.find(2, make_key(1)), Eq(std::nullopt)) << "Topics should be kept per user";
+}
+
+TEST(assimilation_state, invalidate_one_user)
+{
+    flashback::assimilation_state state{8};
+    state.assign(1, make_key(1), true, state.generation());
+    state.assign(2, make_key(1), true, state.generation());
+
+    state.invalidate(1);
+    EXPECT_THAT(state.find(1, make_key(1)), Eq(std::nullopt));
+    EXPECT_THAT(state.find(2, make_key(1)), Optional(true)) << "Progress of one user should not drop topics of others";
+
+    state.clear();
+    EXPECT_THAT(state.find(2, make_key(1)), Eq(std::nullopt));
+}
+
+TEST(assimilation_state, invalidate_edited_scope)
+{
+    flashback::assimilation_state state{8};
+    flashback::assimilation_key const other_subject{2, flashback::expertise_level::surface, 1};
+
+    for (uint64_t const user_id: {1, 2})
+    {
+        state.assign(user_id, make_key(1), true, state.generation());
+        state.assign(user_id, make_key(2), true, state.generation());
+        state.assign(user_id, other_subject, true, state.generation());
+    }
+
+    state.invalidate_topic(make_key(2));
+    EXPECT_THAT(state.find(2, make_key(2)), Eq(std::nullopt)) << "Every user's assimilation of an edited topic should be read again";
+    EXPECT_THAT(state.find(2, make_key(1)), Optional(true));
+
+    uint64_t const generation{state.generation()};
+    state.invalidate_subject(1);
+    state.assign(1, make_key(3), true, generation);
+    EXPECT_THAT(state.find(1, make_key(1)), Eq(std::nullopt));
+    EXPECT_THAT(state.find(1, make_key(3)), Eq(std::nullopt)) << "Loads racing an edit of their subject should not be kept";
+    EXPECT_THAT(state.find(1, other_subject), Optional(true)) << "Edits should not reach other subjects";
+}
+
+TEST(assimilation_state, skip_stale_loads)
+{
+    flashback::assimilation_state state{8};
+    uint64_t const generation{state.generation()};
+
+    state.invalidate(1);
+    state.assign(1, make_key(1), false, generation);
+    state.assign(2, make_key(1), false, generation);
+    EXPECT_THAT(state.find(1, make_key(1)), Eq(std::nullopt)) << "Loads racing an invalidation should not be kept";
+    EXPECT_THAT(state.find(2, make_key(1)), Optional(false)) << "Invalidating one user should not turn away loads of others";
+}
+
+TEST(assimilation_state, bound_users)
+{
+    flashback::assimilation_state state{2};
+    state.assign(1, make_key(1), true, state.generation());
+    state.assign(2, make_key(1), true, state.generation());
+    state.assign(3, make_key(1), true, state.generation());
+
+    int kept{};
+    for (uint64_t user_id{1}; user_id <= 3; ++user_id)
+    {
+        kept += state.find(user_id, make_key(1)).has_value() ? 1 : 0;
+    }
+    EXPECT_THAT(kept, Eq(2)) << "Users beyond the capacity should make room rather than grow the state";
+    EXPECT_THAT(state.find(3, make_key(1)), Optional(true));
+}
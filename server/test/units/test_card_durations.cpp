@@ -0,0 +1,92 @@
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <types.pb.h>
+#include <flashback/card_durations.hpp>
+
+using testing::Eq;
+
+TEST(card_durations, estimate_single_card)
+{
+    flashback::card_durations durations{{}, 16, std::chrono::seconds{30}, 50, std::chrono::minutes{5}};
+    flashback::duration_estimate estimate{durations.estimate(1)};
+    EXPECT_THAT(estimate.typical, Eq(std::chrono::seconds{30})) << "Without any recorded durations the fallback should be used";
+    EXPECT_THAT(estimate.measured, Eq(0));
+
+    durations.record(1, std::chrono::seconds{10});
+    durations.record(1, std::chrono::seconds{10});
+    durations.record(1, std::chrono::seconds{10});
+    estimate = durations.estimate(1);
+    EXPECT_THAT(estimate.typical, Eq(std::chrono::seconds{10}));
+    EXPECT_THAT(estimate.upper, Eq(std::chrono::seconds{10}));
+    EXPECT_THAT(estimate.measured, Eq(1));
+
+    estimate = durations.estimate(2);
+    EXPECT_THAT(estimate.typical, Eq(std::chrono::seconds{10})) << "Cards never studied should be estimated from all cards";
+    EXPECT_THAT(estimate.measured, Eq(0));
+}
+
+TEST(card_durations, estimate_many_cards)
+{
+    flashback::card_durations durations{{}, 16, std::chrono::seconds{30}, 50, std::chrono::minutes{5}};
+    google::protobuf::RepeatedPtrField<flashback::Card> cards{};
+    cards.Add()->set_id(1);
+    cards.Add()->set_id(2);
+    cards.Add()->set_id(3);
+
+    durations.record(1, std::chrono::seconds{20});
+    durations.record(2, std::chrono::seconds{40});
+    flashback::duration_estimate const estimate{durations.estimate(cards)};
+    EXPECT_THAT(estimate.cards, Eq(3));
+    EXPECT_THAT(estimate.measured, Eq(2));
+    EXPECT_THAT(estimate.typical, Eq(std::chrono::seconds{90}));
+}
+
+TEST(card_durations, forget_least_recent_cards)
+{
+    flashback::card_durations durations{{}, 2, std::chrono::seconds{30}, 50, std::chrono::minutes{5}};
+    durations.record(1, std::chrono::seconds{10});
+    durations.record(2, std::chrono::seconds{20});
+    durations.record(1, std::chrono::seconds{10});
+    durations.record(3, std::chrono::seconds{30});
+
+    EXPECT_THAT(durations.estimate(1).measured, Eq(1));
+    EXPECT_THAT(durations.estimate(2).measured, Eq(0)) << "The least recently studied card should be forgotten";
+    EXPECT_THAT(durations.estimate(3).measured, Eq(1));
+}
+
+TEST(card_durations, restore_saved_durations)
+{
+    std::filesystem::path const directory{std::filesystem::temp_directory_path() / "flashback-durations"};
+    std::filesystem::path const path{directory / "card.durations"};
+    std::filesystem::remove_all(directory);
+    flashback::duration_estimate recorded{};
+
+    {
+        flashback::card_durations durations{path, 16, std::chrono::seconds{30}, 50, std::chrono::minutes{5}};
+
+        for (int sample{}; sample < 120; ++sample)
+        {
+            durations.record(1, std::chrono::seconds{10 + sample % 10});
+        }
+
+        durations.record(2, std::chrono::seconds{40});
+        recorded = durations.estimate(1);
+    }
+
+    {
+        flashback::card_durations durations{path, 16, std::chrono::seconds{30}, 50, std::chrono::minutes{5}};
+        flashback::duration_estimate const estimate{durations.estimate(1)};
+        EXPECT_THAT(estimate.measured, Eq(1)) << "Sketches should survive a restart";
+        EXPECT_THAT(estimate.typical, Eq(recorded.typical));
+        EXPECT_THAT(estimate.upper, Eq(recorded.upper));
+        EXPECT_THAT(durations.estimate(2).typical, Eq(std::chrono::seconds{40}));
+        EXPECT_THAT(durations.estimate(3).measured, Eq(0));
+    }
+
+    std::ofstream{path, std::ios::binary | std::ios::trunc} << "damaged";
+    flashback::card_durations durations{path, 16, std::chrono::seconds{30}, 50, std::chrono::minutes{5}};
+    EXPECT_THAT(durations.estimate(1).typical, Eq(std::chrono::seconds{30})) << "Damaged snapshots should be ignored rather than stop the server";
+    std::filesystem::remove_all(directory);
+}
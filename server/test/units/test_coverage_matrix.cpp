@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <types.pb.h>
+#include <flashback/coverage_matrix.hpp>
+
+using testing::Eq;
+using testing::SizeIs;
+using testing::IsTrue;
+using testing::IsFalse;
+
+namespace
+{
+flashback::TopicCoverage make_topic(flashback::expertise_level const level, uint64_t const position, std::vector<uint64_t> const& assessments)
+{
+    flashback::TopicCoverage topic{};
+    topic.mutable_topic()->set_level(level);
+    topic.mutable_topic()->set_position(position);
+
+    for (uint64_t const assessment: assessments)
+    {
+        topic.add_assessment()->set_id(assessment);
+    }
+
+    return topic;
+}
+} // namespace
+
+TEST(coverage_matrix, count_covered_topics)
+{
+    flashback::coverage_matrix const matrix{{
+        make_topic(flashback::expertise_level::depth, 1, {1}),
+        make_topic(flashback::expertise_level::surface, 2, {1, 2}),
+        make_topic(flashback::expertise_level::surface, 1, {}),
+    }};
+
+    EXPECT_THAT(matrix.assessment_coverage(1), Eq(2));
+    EXPECT_THAT(matrix.assessment_coverage(2), Eq(1));
+    EXPECT_THAT(matrix.assessment_coverage(3), Eq(0));
+    EXPECT_THAT(matrix.topic_coverage(flashback::expertise_level::surface, 1), Eq(0));
+    EXPECT_THAT(matrix.topic_coverage(flashback::expertise_level::surface, 2), Eq(2));
+    EXPECT_THAT(matrix.topic_coverage(flashback::expertise_level::depth, 1), Eq(1));
+
+    google::protobuf::RepeatedPtrField<flashback::Topic> topics{};
+    matrix.topics_of(1, topics);
+    ASSERT_THAT(topics, SizeIs(2));
+    EXPECT_THAT(topics.at(0).level(), Eq(flashback::expertise_level::surface)) << "Topics should be listed by level and position";
+    EXPECT_THAT(topics.at(1).level(), Eq(flashback::expertise_level::depth));
+}
+
+TEST(coverage_matrix, assign_coverage)
+{
+    flashback::coverage_matrix matrix{{
+        make_topic(flashback::expertise_level::surface, 1, {1}),
+        make_topic(flashback::expertise_level::surface, 2, {2}),
+    }};
+
+    EXPECT_THAT(matrix.assign(1, flashback::expertise_level::surface, 2, true), IsTrue());
+    EXPECT_THAT(matrix.assessment_coverage(1), Eq(2));
+    EXPECT_THAT(matrix.topic_coverage(flashback::expertise_level::surface, 2), Eq(2));
+    EXPECT_THAT(matrix.assign(2, flashback::expertise_level::surface, 2, false), IsTrue());
+    EXPECT_THAT(matrix.assessment_coverage(2), Eq(0));
+    EXPECT_THAT(matrix.topic_coverage(flashback::expertise_level::surface, 2), Eq(1));
+    EXPECT_THAT(matrix.assign(3, flashback::expertise_level::surface, 1, true), IsFalse()) << "Unknown assessments need the matrix to be reloaded";
+    EXPECT_THAT(matrix.assign(1, flashback::expertise_level::origin, 1, true), IsFalse()) << "Unknown topics need the matrix to be reloaded";
+}
+
+TEST(coverage_matrix, fill_whole_subject)
+{
+    std::vector<flashback::TopicCoverage> topics{};
+
+    for (uint64_t position{1}; position <= 100; ++position)
+    {
+        topics.push_back(make_topic(flashback::expertise_level::surface, position, {position % 2 + 1, 3}));
+    }
+
+    flashback::coverage_matrix const matrix{topics};
+    google::protobuf::RepeatedPtrField<flashback::TopicCoverage> covered_topics{};
+    google::protobuf::RepeatedPtrField<flashback::Coverage> assessments{};
+    matrix.fill(covered_topics, assessments);
+
+    ASSERT_THAT(covered_topics, SizeIs(100));
+    EXPECT_THAT(covered_topics.at(99).assessment(), SizeIs(2));
+    ASSERT_THAT(assessments, SizeIs(3));
+    EXPECT_THAT(assessments.at(0).coverage(), Eq(50)) << "Rows spanning several words should be counted entirely";
+    EXPECT_THAT(assessments.at(1).coverage(), Eq(100));
+    EXPECT_THAT(assessments.at(2).coverage(), Eq(50));
+}
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <flashback/duration_sketch.hpp>
+
+using testing::Eq;
+using testing::DoubleEq;
+using testing::DoubleNear;
+
+TEST(duration_sketch, empty_and_single_sample)
+{
+    flashback::duration_sketch sketch{50};
+    EXPECT_THAT(sketch.count(), Eq(0));
+    EXPECT_THAT(sketch.quantile(0.5), DoubleEq(0));
+
+    sketch.add(42);
+    EXPECT_THAT(sketch.count(), Eq(1));
+    EXPECT_THAT(sketch.quantile(0), DoubleEq(42));
+    EXPECT_THAT(sketch.quantile(0.5), DoubleEq(42));
+    EXPECT_THAT(sketch.quantile(1), DoubleEq(42));
+}
+
+TEST(duration_sketch, approximate_quantiles)
+{
+    flashback::duration_sketch sketch{50};
+
+    // spread the samples so that the order they arrive in does not match their values
+    for (uint64_t sample{}; sample < 10000; ++sample)
+    {
+        sketch.add(static_cast<double>(sample * 7919 % 10000));
+    }
+
+    EXPECT_THAT(sketch.count(), Eq(10000));
+    EXPECT_THAT(sketch.quantile(0), DoubleEq(0));
+    EXPECT_THAT(sketch.quantile(1), DoubleEq(9999));
+    EXPECT_THAT(sketch.quantile(0.5), DoubleNear(5000, 150));
+    EXPECT_THAT(sketch.quantile(0.9), DoubleNear(9000, 100)) << "Tails should stay more accurate than the median";
+    EXPECT_THAT(sketch.quantile(0.99), DoubleNear(9900, 30));
+}
+
+TEST(duration_sketch, skewed_durations)
+{
+    flashback::duration_sketch sketch{50};
+
+    for (uint64_t sample{}; sample < 900; ++sample)
+    {
+        sketch.add(20);
+    }
+
+    for (uint64_t sample{}; sample < 100; ++sample)
+    {
+        sketch.add(600);
+    }
+
+    EXPECT_THAT(sketch.quantile(0.5), DoubleNear(20, 1)) << "A few long sessions should not drag the typical duration";
+    EXPECT_THAT(sketch.quantile(0.95), DoubleNear(600, 1));
+}
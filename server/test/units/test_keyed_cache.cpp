@@ -0,0 +1,106 @@
+#include <memory>
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <flashback/keyed_cache.hpp>
+
+using testing::Eq;
+using testing::IsTrue;
+using testing::IsFalse;
+
+TEST(keyed_cache, load_once)
+{
+    flashback::keyed_cache<uint64_t, int> cache{8};
+    int loads{};
+
+    EXPECT_THAT(*cache.load(1, [&loads] { ++loads; return std::make_shared<int const>(10); }), Eq(10));
+    EXPECT_THAT(*cache.load(1, [&loads] { ++loads; return std::make_shared<int const>(20); }), Eq(10)) << "Cached values should not be read again";
+    EXPECT_THAT(loads, Eq(1));
+
+    cache.invalidate(1);
+    EXPECT_THAT(*cache.load(1, [&loads] { ++loads; return std::make_shared<int const>(20); }), Eq(20));
+    EXPECT_THAT(loads, Eq(2));
+}
+
+TEST(keyed_cache, invalidate_racing_key_only)
+{
+    flashback::keyed_cache<uint64_t, int> cache{8};
+
+    // both loads are overtaken by a write while they read, only the one of the written key is stale
+    std::ignore = cache.load(1, [&cache] {
+        cache.invalidate(1);
+        return std::make_shared<int const>(10);
+    });
+    std::ignore = cache.load(2, [&cache] {
+        cache.invalidate(1);
+        return std::make_shared<int const>(20);
+    });
+
+    EXPECT_THAT(*cache.load(1, [] { return std::make_shared<int const>(11); }), Eq(11)) << "Loads racing a write to their key should not be kept";
+    EXPECT_THAT(*cache.load(2, [] { return std::make_shared<int const>(21); }), Eq(20)) << "Writes to other keys should not discard a load";
+
+    std::ignore = cache.load(3, [&cache] {
+        cache.clear();
+        return std::make_shared<int const>(30);
+    });
+    EXPECT_THAT(*cache.load(3, [] { return std::make_shared<int const>(31); }), Eq(31)) << "Clearing should turn away every load in flight";
+}
+
+TEST(keyed_cache, update_cached_value)
+{
+    flashback::keyed_cache<uint64_t, int> cache{8};
+    std::ignore = cache.load(1, [] { return std::make_shared<int const>(10); });
+
+    cache.update(1, [](int const value) { return std::make_shared<int const>(value + 1); });
+    EXPECT_THAT(*cache.load(1, [] { return std::make_shared<int const>(0); }), Eq(11));
+
+    cache.update(1, [](int) { return std::shared_ptr<int const>{}; });
+    EXPECT_THAT(*cache.load(1, [] { return std::make_shared<int const>(0); }), Eq(0)) << "Updates that cannot be applied should drop the value";
+}
+
+TEST(keyed_cache, invalidate_matching_values)
+{
+    flashback::keyed_cache<uint64_t, int> cache{8};
+    std::ignore = cache.load(1, [] { return std::make_shared<int const>(10); });
+    std::ignore = cache.load(2, [] { return std::make_shared<int const>(20); });
+
+    cache.invalidate_if([](int const value) { return value == 20; });
+    EXPECT_THAT(*cache.load(1, [] { return std::make_shared<int const>(11); }), Eq(10)) << "Values the predicate rejects should stay";
+    EXPECT_THAT(*cache.load(2, [] { return std::make_shared<int const>(21); }), Eq(21));
+}
+
+TEST(keyed_cache, bound_entries)
+{
+    flashback::keyed_cache<uint64_t, int> cache{2};
+    int loads{};
+
+    for (uint64_t key{1}; key <= 3; ++key)
+    {
+        std::ignore = cache.load(key, [key] { return std::make_shared<int const>(static_cast<int>(key)); });
+    }
+
+    std::ignore = cache.load(3, [&loads] { ++loads; return std::make_shared<int const>(3); });
+    EXPECT_THAT(loads, Eq(0)) << "The latest load should be kept";
+
+    for (uint64_t key{1}; key <= 2; ++key)
+    {
+        std::ignore = cache.load(key, [&loads, key] { ++loads; return std::make_shared<int const>(static_cast<int>(key)); });
+    }
+
+    EXPECT_THAT(loads, testing::Ge(1)) << "Entries beyond the capacity should make room rather than grow the cache";
+}
+
+TEST(invalidation_stamps, fold_beyond_capacity)
+{
+    flashback::invalidation_stamps<uint64_t> stamps{2};
+    uint64_t const generation{stamps.generation()};
+
+    stamps.invalidate(1);
+    EXPECT_THAT(stamps.admits(1, generation), IsFalse());
+    EXPECT_THAT(stamps.admits(2, generation), IsTrue());
+    EXPECT_THAT(stamps.admits(1, stamps.generation()), IsTrue()) << "Loads started after an invalidation should be kept";
+
+    stamps.invalidate(2);
+    stamps.invalidate(3);
+    EXPECT_THAT(stamps.admits(4, generation), IsFalse()) << "Overflowing stamps should turn away every older load";
+    EXPECT_THAT(stamps.admits(4, stamps.generation()), IsTrue());
+}
@@ -0,0 +1,160 @@
+#include <chrono>
+#include <vector>
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <types.pb.h>
+#include <flashback/practice_scheduler.hpp>
+
+using testing::IsFalse;
+using testing::IsEmpty;
+using testing::ElementsAre;
+using namespace std::chrono_literals;
+
+namespace
+{
+flashback::practice_key make_key(uint64_t const user_id, uint64_t const topic_position)
+{
+    return flashback::practice_key{user_id, 1, 1, flashback::expertise_level::surface, topic_position};
+}
+
+google::protobuf::RepeatedPtrField<flashback::Card> make_cards(std::vector<uint64_t> const& identifiers)
+{
+    google::protobuf::RepeatedPtrField<flashback::Card> cards{};
+
+    for (uint64_t const id: identifiers)
+    {
+        cards.Add()->set_id(id);
+    }
+
+    return cards;
+}
+
+std::vector<uint64_t> collect_ids(flashback::practice_scheduler& scheduler, flashback::practice_key const& key, flashback::practice_scheduler::clock::time_point const now)
+{
+    google::protobuf::RepeatedPtrField<flashback::Card> cards{};
+    std::vector<uint64_t> identifiers{};
+
+    if (scheduler.collect(key, now, cards))
+    {
+        for (flashback::Card const& card: cards)
+        {
+            identifiers.push_back(card.id());
+        }
+    }
+
+    return identifiers;
+}
+} // namespace
+
+TEST(practice_scheduler, serve_loaded_deck)
+{
+    flashback::practice_scheduler scheduler{8, 1h};
+    flashback::practice_scheduler::clock::time_point const start{};
+    google::protobuf::RepeatedPtrField<flashback::Card> cards{};
+
+    EXPECT_THAT(scheduler.collect(make_key(1, 1), start, cards), IsFalse()) << "Decks never loaded should be read from the database";
+    scheduler.assign(make_key(1, 1), make_cards({4, 2, 7}), scheduler.generation(), start);
+    EXPECT_THAT(collect_ids(scheduler, make_key(1, 1), start + 1min), ElementsAre(4, 2, 7)) << "Cards should keep the order the database gave them";
+    EXPECT_THAT(scheduler.collect(make_key(1, 2), start, cards), IsFalse());
+    EXPECT_THAT(scheduler.collect(make_key(1, 1), start + 1h, cards), IsFalse()) << "Expired decks should be read again for cards that became due";
+}
+
+TEST(practice_scheduler, drop_practiced_cards)
+{
+    flashback::practice_scheduler scheduler{8, 24h};
+    flashback::practice_scheduler::clock::time_point const start{};
+    scheduler.assign(make_key(1, 1), make_cards({1, 2, 3}), scheduler.generation(), start);
+    scheduler.assign(make_key(1, 2), make_cards({3, 4}), scheduler.generation(), start);
+
+    scheduler.record(1, 3, start + 1min);
+    scheduler.record(2, 1, start + 1min);
+    EXPECT_THAT(collect_ids(scheduler, make_key(1, 1), start + 2min), ElementsAre(1, 2)) << "Practiced cards should wait for the database to make them due";
+    EXPECT_THAT(collect_ids(scheduler, make_key(1, 2), start + 2min), ElementsAre(4)) << "Every deck holding the card should be updated";
+    EXPECT_THAT(collect_ids(scheduler, make_key(1, 1), start + 12h), ElementsAre(1, 2)) << "Cards should not come back before the deck is read again";
+}
+
+TEST(practice_scheduler, skip_stale_loads)
+{
+    flashback::practice_scheduler scheduler{8, 24h};
+    flashback::practice_scheduler::clock::time_point const start{};
+    google::protobuf::RepeatedPtrField<flashback::Card> cards{};
+    uint64_t const generation{scheduler.generation()};
+
+    scheduler.record(1, 1, start);
+    scheduler.assign(make_key(1, 1), make_cards({1, 2}), generation, start);
+    scheduler.assign(make_key(2, 1), make_cards({1, 2}), generation, start);
+    EXPECT_THAT(scheduler.collect(make_key(1, 1), start, cards), IsFalse()) << "Loads racing progress of their user should not be kept";
+    EXPECT_THAT(collect_ids(scheduler, make_key(2, 1), start), ElementsAre(1, 2)) << "Progress of one user should not turn away loads of others";
+
+    uint64_t const cleared{scheduler.generation()};
+    scheduler.clear();
+    scheduler.assign(make_key(2, 1), make_cards({1, 2}), cleared, start);
+    EXPECT_THAT(scheduler.collect(make_key(2, 1), start, cards), IsFalse());
+}
+
+TEST(practice_scheduler, reload_after_delivery)
+{
+    flashback::practice_scheduler scheduler{8, 24h};
+    flashback::practice_scheduler::clock::time_point const start{};
+    google::protobuf::RepeatedPtrField<flashback::Card> cards{};
+
+    // the deck was read after the card was practiced but before its progress reached the database
+    scheduler.record(1, 3, start);
+    scheduler.assign(make_key(1, 1), make_cards({1, 3}), scheduler.generation(), start);
+    scheduler.assign(make_key(2, 1), make_cards({1, 3}), scheduler.generation(), start);
+    uint64_t const generation{scheduler.generation()};
+
+    scheduler.invalidate(1);
+    EXPECT_THAT(scheduler.collect(make_key(1, 1), start + 1min, cards), IsFalse()) << "Decks read before delivery should be read again";
+    scheduler.assign(make_key(1, 1), make_cards({1, 3}), generation, start + 1min);
+    EXPECT_THAT(scheduler.collect(make_key(1, 1), start + 1min, cards), IsFalse()) << "Loads racing delivery should not be kept";
+    EXPECT_THAT(collect_ids(scheduler, make_key(2, 1), start + 1min), ElementsAre(1, 3)) << "Decks of other users should stay";
+}
+
+TEST(practice_scheduler, invalidate_edited_scope)
+{
+    flashback::practice_scheduler scheduler{8, 24h};
+    flashback::practice_scheduler::clock::time_point const start{};
+    google::protobuf::RepeatedPtrField<flashback::Card> cards{};
+    flashback::practice_key const other_subject{1, 1, 2, flashback::expertise_level::surface, 1};
+
+    for (uint64_t const user_id: {1, 2})
+    {
+        scheduler.assign(make_key(user_id, 1), make_cards({1, 2}), scheduler.generation(), start);
+        scheduler.assign(make_key(user_id, 2), make_cards({3}), scheduler.generation(), start);
+    }
+
+    scheduler.assign(other_subject, make_cards({4}), scheduler.generation(), start);
+
+    scheduler.invalidate_topic(1, flashback::expertise_level::surface, 2);
+    EXPECT_THAT(scheduler.collect(make_key(2, 2), start, cards), IsFalse()) << "Every user's deck of an edited topic should be read again";
+    EXPECT_THAT(collect_ids(scheduler, make_key(2, 1), start), ElementsAre(1, 2)) << "Other topics of the subject should stay";
+
+    scheduler.invalidate_card(2);
+    EXPECT_THAT(scheduler.collect(make_key(1, 1), start, cards), IsFalse()) << "Decks holding an edited card should be read again";
+    EXPECT_THAT(collect_ids(scheduler, other_subject, start), ElementsAre(4));
+
+    uint64_t const generation{scheduler.generation()};
+    scheduler.invalidate_subject(1);
+    scheduler.assign(make_key(1, 1), make_cards({1}), generation, start);
+    scheduler.assign(make_key(1, 3), make_cards({5}), generation, start);
+    EXPECT_THAT(scheduler.collect(make_key(1, 1), start, cards), IsFalse()) << "Loads racing an edit of their subject should not be kept";
+    EXPECT_THAT(collect_ids(scheduler, other_subject, start), ElementsAre(4)) << "Edits should not reach other subjects";
+}
+
+TEST(practice_scheduler, evict_idle_learners)
+{
+    flashback::practice_scheduler scheduler{2, 24h};
+    flashback::practice_scheduler::clock::time_point const start{};
+    scheduler.assign(make_key(1, 1), make_cards({1}), scheduler.generation(), start);
+    scheduler.assign(make_key(2, 1), make_cards({2}), scheduler.generation(), start + 1min);
+    EXPECT_THAT(collect_ids(scheduler, make_key(1, 1), start + 2min), ElementsAre(1));
+
+    scheduler.assign(make_key(3, 1), make_cards({3}), scheduler.generation(), start + 3min);
+    EXPECT_THAT(collect_ids(scheduler, make_key(2, 1), start + 4min), IsEmpty()) << "Least recently active learner should be evicted first";
+    EXPECT_THAT(collect_ids(scheduler, make_key(1, 1), start + 4min), ElementsAre(1));
+
+    scheduler.clear();
+    google::protobuf::RepeatedPtrField<flashback::Card> cards{};
+    EXPECT_THAT(scheduler.collect(make_key(3, 1), start + 5min, cards), IsFalse());
+}
@@ -0,0 +1,162 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <span>
+#include <string>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <pqxx/pqxx>
+#include <flashback/mock_database.hpp>
+#include <flashback/progress_journal.hpp>
+
+using testing::_;
+using testing::Eq;
+using testing::Throw;
+using testing::SizeIs;
+using testing::Invoke;
+using testing::ElementsAre;
+using testing::ContainerEq;
+using namespace std::chrono_literals;
+
+class test_progress_journal: public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        m_directory = std::filesystem::temp_directory_path() / "flashback-journal" / testing::UnitTest::GetInstance()->current_test_info()->name();
+        std::filesystem::remove_all(m_directory);
+        m_path = m_directory / "progress.journal";
+        m_database = std::make_shared<flashback::mock_database>();
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(m_directory);
+    }
+
+protected:
+    static flashback::progress_event make_event(uint64_t const card_id)
+    {
+        return flashback::progress_event{flashback::progress_event::kind::practice, 1, card_id, 2, flashback::expertise_level::depth, 10, 1700000000 + card_id};
+    }
+
+    std::filesystem::path m_directory;
+    std::filesystem::path m_path;
+    std::shared_ptr<flashback::mock_database> m_database;
+};
+
+TEST_F(test_progress_journal, flush_in_batches)
+{
+    std::vector<std::vector<flashback::progress_event>> batches{};
+    std::size_t delivered{};
+    EXPECT_CALL(*m_database, record_progress(_)).WillRepeatedly(Invoke([&batches](std::vector<flashback::progress_event> const& events) { batches.push_back(events); }));
+
+    {
+        flashback::progress_journal journal{m_path, m_database, 1h, [&delivered](std::span<flashback::progress_event const> events) { delivered += events.size(); }};
+        journal.append(make_event(1));
+        journal.append(make_event(2));
+        journal.append(make_event(3));
+        EXPECT_THAT(journal.pending(), Eq(3)) << "Appended events should wait for the flush interval";
+        EXPECT_THAT(std::filesystem::file_size(m_path), Eq(3 * 48)) << "Appended events should reach the file before returning";
+    }
+
+    ASSERT_THAT(batches, SizeIs(1)) << "Pending events should be written in one batch";
+    EXPECT_THAT(batches.front(), ElementsAre(make_event(1), make_event(2), make_event(3)));
+    EXPECT_THAT(delivered, Eq(3)) << "Delivered events should be reported once they are in the database";
+    EXPECT_THAT(std::filesystem::file_size(m_path), Eq(0)) << "Delivered events should be truncated from the file";
+}
+
+TEST_F(test_progress_journal, append_group)
+{
+    std::vector<flashback::progress_event> const events{make_event(1), make_event(2), make_event(3)};
+    std::vector<flashback::progress_event> delivered{};
+    EXPECT_CALL(*m_database, record_progress(_)).WillRepeatedly(Invoke([&delivered](std::vector<flashback::progress_event> const& batch) {
+        delivered.insert(delivered.end(), batch.begin(), batch.end());
+    }));
+
+    {
+        flashback::progress_journal journal{m_path, m_database, 1h};
+        journal.append(events);
+        journal.append(std::span<flashback::progress_event const>{});
+        EXPECT_THAT(journal.pending(), Eq(3));
+        EXPECT_THAT(std::filesystem::file_size(m_path), Eq(3 * 48)) << "Every event of a group should reach the file before returning";
+    }
+
+    EXPECT_THAT(delivered, ContainerEq(events));
+}
+
+TEST_F(test_progress_journal, replay_after_crash)
+{
+    EXPECT_CALL(*m_database, record_progress(_)).WillRepeatedly(Throw(std::runtime_error{"database is down"}));
+
+    {
+        flashback::progress_journal journal{m_path, m_database, 1h};
+        journal.append(make_event(1));
+        journal.append(make_event(2));
+    }
+
+    testing::Mock::VerifyAndClearExpectations(m_database.get());
+    EXPECT_THAT(std::filesystem::file_size(m_path), Eq(2 * 48)) << "Undelivered events should stay in the file";
+
+    std::vector<flashback::progress_event> delivered{};
+    EXPECT_CALL(*m_database, record_progress(_)).WillRepeatedly(Invoke([&delivered](std::vector<flashback::progress_event> const& events) {
+        delivered.insert(delivered.end(), events.begin(), events.end());
+    }));
+
+    {
+        flashback::progress_journal journal{m_path, m_database, 1h};
+        EXPECT_THAT(journal.pending(), Eq(2)) << "Events left in the file should be replayed";
+    }
+
+    EXPECT_THAT(delivered, ElementsAre(make_event(1), make_event(2)));
+}
+
+TEST_F(test_progress_journal, skip_torn_tail)
+{
+    EXPECT_CALL(*m_database, record_progress(_)).WillRepeatedly(Throw(std::runtime_error{"database is down"}));
+
+    {
+        flashback::progress_journal journal{m_path, m_database, 1h};
+        journal.append(make_event(1));
+        journal.append(make_event(2));
+    }
+
+    {
+        std::ofstream file{m_path, std::ios::binary | std::ios::app};
+        file << "partial record";
+    }
+
+    flashback::progress_journal journal{m_path, m_database, 1h};
+    EXPECT_THAT(journal.pending(), Eq(2)) << "Torn records at the end should be ignored";
+    EXPECT_THAT(std::filesystem::file_size(m_path), Eq(2 * 48)) << "Torn records should be cut off the file";
+}
+
+TEST_F(test_progress_journal, dead_letter_rejected_events)
+{
+    flashback::progress_event const rejected{make_event(2)};
+    std::vector<flashback::progress_event> delivered{};
+    EXPECT_CALL(*m_database, record_progress(_)).WillRepeatedly(Invoke([&](std::vector<flashback::progress_event> const& events) {
+        if (std::ranges::find(events, rejected) != events.end())
+        {
+            throw pqxx::sql_error{"card does not exist"};
+        }
+
+        delivered.insert(delivered.end(), events.begin(), events.end());
+    }));
+
+    {
+        flashback::progress_journal journal{m_path, m_database, 1h};
+        journal.append(make_event(1));
+        journal.append(rejected);
+        journal.append(make_event(3));
+    }
+
+    EXPECT_THAT(delivered, ElementsAre(make_event(1), make_event(3))) << "One refused event should not hold back the rest of its batch";
+    EXPECT_THAT(std::filesystem::file_size(m_path), Eq(0));
+    ASSERT_THAT(std::filesystem::exists(std::filesystem::path{m_path}.concat(".rejected")), testing::IsTrue());
+    EXPECT_THAT(std::filesystem::file_size(std::filesystem::path{m_path}.concat(".rejected")), Eq(48)) << "Events refused too many times should be set aside, not dropped";
+}
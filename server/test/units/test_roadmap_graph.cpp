@@ -0,0 +1,123 @@
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <types.pb.h>
+#include <flashback/roadmap_graph.hpp>
+
+using testing::Eq;
+using testing::IsTrue;
+using testing::IsFalse;
+using testing::IsEmpty;
+using testing::ElementsAre;
+
+namespace
+{
+flashback::Milestone make_milestone(uint64_t const id, uint64_t const position, std::string const& name, flashback::expertise_level const level = flashback::expertise_level::surface)
+{
+    flashback::Milestone milestone{};
+    milestone.set_id(id);
+    milestone.set_position(position);
+    milestone.set_name(name);
+    milestone.set_level(level);
+    return milestone;
+}
+
+flashback::Requirement make_requirement(flashback::Milestone const& milestone, flashback::Milestone const& required_milestone)
+{
+    flashback::Requirement requirement{};
+    requirement.set_milestone_id(milestone.id());
+    requirement.set_milestone_level(milestone.level());
+    *requirement.mutable_required_milestone() = required_milestone;
+    return requirement;
+}
+
+template <typename Milestones>
+std::vector<uint64_t> ids(Milestones const& milestones)
+{
+    std::vector<uint64_t> identifiers{};
+
+    for (flashback::Milestone const& milestone: milestones)
+    {
+        identifiers.push_back(milestone.id());
+    }
+
+    return identifiers;
+}
+} // namespace
+
+TEST(roadmap_graph, order_requirements_first)
+{
+    flashback::Milestone const kernel{make_milestone(1, 1, "Linux Kernel")};
+    flashback::Milestone const c{make_milestone(2, 2, "C")};
+    flashback::Milestone const assembly{make_milestone(3, 3, "Assembly")};
+    flashback::Milestone const shell{make_milestone(4, 4, "Shell")};
+    flashback::roadmap_graph const graph{{kernel, c, assembly, shell}, {make_requirement(kernel, c), make_requirement(kernel, assembly), make_requirement(c, assembly)}};
+
+    EXPECT_THAT(graph.is_acyclic(), IsTrue());
+    EXPECT_THAT(ids(graph.ordered_milestones()), ElementsAre(3, 2, 1, 4)) << "Independent milestones should keep their roadmap positions";
+}
+
+TEST(roadmap_graph, close_transitively)
+{
+    flashback::Milestone const drivers{make_milestone(1, 1, "Device Drivers")};
+    flashback::Milestone const kernel{make_milestone(2, 2, "Linux Kernel")};
+    flashback::Milestone const c{make_milestone(3, 3, "C")};
+    flashback::roadmap_graph const graph{{drivers, kernel, c}, {make_requirement(drivers, kernel), make_requirement(kernel, c)}};
+
+    EXPECT_THAT(graph.depends_on(drivers, c), IsTrue()) << "Requirements of requirements should be reachable";
+    EXPECT_THAT(graph.depends_on(c, drivers), IsFalse());
+    EXPECT_THAT(graph.depends_on(drivers, make_milestone(9, 9, "Rust")), IsFalse());
+
+    google::protobuf::RepeatedPtrField<flashback::MilestoneNode> nodes{};
+    graph.fill(nodes);
+    ASSERT_THAT(nodes.size(), Eq(3));
+    EXPECT_THAT(nodes.at(0).milestone().id(), Eq(3));
+    EXPECT_THAT(nodes.at(0).prerequisites(), IsEmpty());
+    EXPECT_THAT(nodes.at(2).milestone().id(), Eq(1));
+    ASSERT_THAT(nodes.at(2).requirements_size(), Eq(1));
+    EXPECT_THAT(nodes.at(2).requirements(0).id(), Eq(2));
+    EXPECT_THAT(ids(nodes.at(2).prerequisites()), ElementsAre(2, 3));
+}
+
+TEST(roadmap_graph, detect_cycles)
+{
+    flashback::Milestone const kernel{make_milestone(1, 1, "Linux Kernel")};
+    flashback::Milestone const c{make_milestone(2, 2, "C")};
+    flashback::Milestone const assembly{make_milestone(3, 3, "Assembly")};
+    flashback::roadmap_graph const graph{{kernel, c, assembly}, {make_requirement(kernel, c), make_requirement(c, assembly)}};
+
+    EXPECT_THAT(graph.would_form_cycle(assembly, kernel), IsTrue()) << "Requiring a dependent milestone should close a cycle";
+    EXPECT_THAT(graph.would_form_cycle(c, c), IsTrue());
+    EXPECT_THAT(graph.would_form_cycle(kernel, assembly), IsFalse()) << "Shortcuts to transitive requirements are not cycles";
+    EXPECT_THAT(graph.would_form_cycle(assembly, make_milestone(9, 9, "Rust")), IsFalse());
+}
+
+TEST(roadmap_graph, tolerate_stored_cycles)
+{
+    flashback::Milestone const kernel{make_milestone(1, 1, "Linux Kernel")};
+    flashback::Milestone const c{make_milestone(2, 2, "C")};
+    flashback::Milestone const shell{make_milestone(3, 3, "Shell")};
+    flashback::roadmap_graph const graph{{kernel, c, shell}, {make_requirement(kernel, c), make_requirement(c, kernel), make_requirement(make_milestone(4, 4, "Rust"), shell)}};
+
+    EXPECT_THAT(graph.is_acyclic(), IsFalse());
+    EXPECT_THAT(ids(graph.ordered_milestones()), ElementsAre(3, 1, 2)) << "Milestones caught in a cycle should still be listed";
+    EXPECT_THAT(graph.depends_on(kernel, kernel), IsTrue());
+    EXPECT_THAT(graph.depends_on(c, kernel), IsTrue());
+}
+
+TEST(roadmap_graph, separate_levels_of_one_subject)
+{
+    flashback::Milestone const c_surface{make_milestone(1, 1, "C")};
+    flashback::Milestone const kernel{make_milestone(2, 2, "Linux Kernel")};
+    flashback::Milestone const c_depth{make_milestone(1, 3, "C", flashback::expertise_level::depth)};
+    flashback::roadmap_graph const graph{{c_surface, kernel, c_depth}, {make_requirement(kernel, c_surface), make_requirement(c_depth, kernel)}};
+
+    EXPECT_THAT(graph.is_acyclic(), IsTrue()) << "A subject on two levels should be two milestones";
+    EXPECT_THAT(ids(graph.ordered_milestones()), ElementsAre(1, 2, 1));
+    EXPECT_THAT(graph.depends_on(c_depth, c_surface), IsTrue());
+    EXPECT_THAT(graph.depends_on(c_surface, c_depth), IsFalse());
+    EXPECT_THAT(graph.would_form_cycle(c_surface, c_depth), IsTrue()) << "The surface of a subject cannot require its depth once the depth requires the surface";
+    EXPECT_THAT(graph.would_form_cycle(kernel, c_depth), IsTrue());
+    EXPECT_THAT(graph.would_form_cycle(c_depth, c_surface), IsFalse());
+}
@@ -5,6 +5,7 @@
 #include <tuple>
 #include <optional>
 #include <algorithm>
+#include <format>
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 #include <flashback/mock_database.hpp>
@@ -498,6 +499,63 @@ TEST_F(test_server, GetRoadmaps)
     EXPECT_NO_THROW(m_server->GetRoadmaps(m_server_context.get(), request.get(), response.get()));
 }
 
+TEST_F(test_server, GetHomeBundle)
+{
+    grpc::Status status{};
+    grpc::ServerContext context{};
+    flashback::GetHomeBundleRequest request{};
+    flashback::GetHomeBundleResponse response{};
+    flashback::Roadmap roadmap{};
+    flashback::Resource studying{};
+    flashback::Resource nerve{};
+    flashback::Weight weight{};
+    flashback::Provider provider{};
+    roadmap.set_id(1);
+    roadmap.set_name("Overtime Working Specialist");
+    studying.set_id(1);
+    studying.set_name("C++ Book");
+    nerve.set_id(2);
+    nerve.set_name("Personal Knowledge");
+    provider.set_id(1);
+    provider.set_name("Flashback Publications");
+
+    EXPECT_CALL(*m_mock_database, get_user(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Invoke([this]() { return std::make_unique<flashback::User>(*m_user); }));
+    EXPECT_CALL(*m_mock_database, get_home_bundle(m_user->id(), A<google::protobuf::RepeatedPtrField<flashback::Roadmap>&>(),
+                                                  A<google::protobuf::RepeatedPtrField<flashback::StudyResource>&>(), A<google::protobuf::RepeatedPtrField<flashback::Nerve>&>()))
+        .Times(1)
+        .WillOnce(Invoke([&](uint64_t, google::protobuf::RepeatedPtrField<flashback::Roadmap>& roadmaps, google::protobuf::RepeatedPtrField<flashback::StudyResource>& studies,
+                             google::protobuf::RepeatedPtrField<flashback::Nerve>& nerves) {
+            *roadmaps.Add() = roadmap;
+            flashback::Resource* const study{studies.Add()->mutable_resource()};
+            *study = studying;
+            *study->add_providers() = provider;
+            flashback::Resource* const nerve_resource{nerves.Add()->mutable_resource()};
+            *nerve_resource = nerve;
+            *nerve_resource->add_providers() = provider;
+        }));
+    EXPECT_CALL(*m_mock_database, get_progress_weight(A<uint64_t>())).Times(1).WillOnce(Return(std::vector<flashback::Weight>{weight}));
+    EXPECT_CALL(*m_mock_database, get_roadmaps(A<uint64_t>())).Times(0);
+    EXPECT_CALL(*m_mock_database, get_providers(A<uint64_t>(), A<google::protobuf::RepeatedPtrField<flashback::Provider>&>())).Times(0);
+    EXPECT_CALL(*m_mock_database, get_related_milestone(A<uint64_t>(), A<uint64_t>())).Times(0);
+
+    request.clear_user();
+    EXPECT_NO_THROW(status = m_server->GetHomeBundle(&context, &request, &response));
+    EXPECT_THAT(status.error_code(), Eq(grpc::StatusCode::UNAUTHENTICATED));
+
+    *request.mutable_user() = *m_user;
+
+    EXPECT_NO_THROW(status = m_server->GetHomeBundle(&context, &request, &response));
+    EXPECT_THAT(status.ok(), IsTrue());
+    ASSERT_THAT(response.roadmap(), SizeIs(1));
+    EXPECT_THAT(response.roadmap(0).name(), Eq(roadmap.name()));
+    ASSERT_THAT(response.study(), SizeIs(1));
+    EXPECT_THAT(response.study(0).resource().providers(), SizeIs(1));
+    ASSERT_THAT(response.nerve(), SizeIs(1));
+    EXPECT_THAT(response.nerve(0).resource().name(), Eq(nerve.name()));
+    EXPECT_THAT(response.nerve(0).resource().providers(), SizeIs(1));
+    EXPECT_THAT(response.weight(), SizeIs(1));
+}
+
 TEST_F(test_server, RenameRoadmap)
 {
     auto request{std::make_unique<flashback::RenameRoadmapRequest>()};
@@ -572,7 +630,7 @@ TEST_F(test_server, SearchRoadmapsWithInvalidUser)
     auto search_request{std::make_unique<flashback::SearchRoadmapsRequest>()};
     auto search_response{std::make_unique<flashback::SearchRoadmapsResponse>()};
     EXPECT_CALL(*m_mock_database, get_user(testing::A<std::string_view>(), testing::A<std::string_view>())).Times(0);
-    EXPECT_CALL(*m_mock_database, search_roadmaps(m_user->id(), testing::A<std::string_view>())).Times(0);
+    EXPECT_CALL(*m_mock_database, search_roadmaps(m_user->id(), testing::A<std::string_view>(), testing::A<uint64_t>(), testing::A<uint64_t>())).Times(0);
     EXPECT_FALSE(search_request->has_user());
     EXPECT_NO_THROW(status = m_server->SearchRoadmaps(m_server_context.get(), search_request.get(), search_response.get()));
     EXPECT_THAT(status.ok(), IsFalse());
@@ -598,7 +656,7 @@ TEST_F(test_server, SearchRoadmapsWithUnauthenticatedUser)
     database_retrieved_user->clear_token();
     database_retrieved_user->clear_device();
     EXPECT_CALL(*m_mock_database, get_user(testing::A<std::string_view>(), testing::A<std::string_view>())).Times(1).WillRepeatedly(Invoke([] { return nullptr; }));
-    EXPECT_CALL(*m_mock_database, search_roadmaps(m_user->id(), testing::A<std::string_view>())).Times(0);
+    EXPECT_CALL(*m_mock_database, search_roadmaps(m_user->id(), testing::A<std::string_view>(), testing::A<uint64_t>(), testing::A<uint64_t>())).Times(0);
     EXPECT_THAT(search_request->has_user(), IsTrue());
     EXPECT_THAT(search_request->user().token(), IsEmpty());
     EXPECT_THAT(search_request->user().device(), IsEmpty());
@@ -620,7 +678,7 @@ TEST_F(test_server, SearchRoadmapsWithAuthenticatedUser)
     search_request->set_allocated_user(std::make_unique<flashback::User>(*m_user).release());
     search_request->set_token("work");
     EXPECT_CALL(*m_mock_database, get_user(m_user->token(), m_user->device())).Times(2).WillRepeatedly(Invoke([&database_retrieved_user] { return std::make_unique<flashback::User>(*database_retrieved_user); }));
-    EXPECT_CALL(*m_mock_database, search_roadmaps(m_user->id(), testing::A<std::string_view>())).Times(1).WillOnce(Return(std::map<uint64_t, flashback::Roadmap>{}));
+    EXPECT_CALL(*m_mock_database, search_roadmaps(m_user->id(), testing::A<std::string_view>(), testing::A<uint64_t>(), testing::A<uint64_t>())).Times(1).WillOnce(Return(std::vector<flashback::Roadmap>{}));
     EXPECT_THAT(search_request->has_user(), IsTrue());
     EXPECT_THAT(search_request->user().token(), Not(IsEmpty()));
     EXPECT_THAT(search_request->user().device(), Not(IsEmpty()));
@@ -642,7 +700,7 @@ TEST_F(test_server, SearchRoadmapsWithEmptyToken)
     search_request->set_allocated_user(std::make_unique<flashback::User>(*m_user).release());
     search_request->clear_token();
     EXPECT_CALL(*m_mock_database, get_user(m_user->token(), m_user->device())).Times(2).WillRepeatedly(Invoke([&database_retrieved_user] { return std::make_unique<flashback::User>(*database_retrieved_user); }));
-    EXPECT_CALL(*m_mock_database, search_roadmaps(m_user->id(), testing::A<std::string_view>())).Times(1).WillOnce(Return(std::map<uint64_t, flashback::Roadmap>{}));
+    EXPECT_CALL(*m_mock_database, search_roadmaps(m_user->id(), testing::A<std::string_view>(), testing::A<uint64_t>(), testing::A<uint64_t>())).Times(1).WillOnce(Return(std::vector<flashback::Roadmap>{}));
     EXPECT_THAT(search_request->has_user(), IsTrue());
     EXPECT_THAT(search_request->user().token(), Not(IsEmpty()));
     EXPECT_THAT(search_request->user().device(), Not(IsEmpty()));
@@ -682,7 +740,7 @@ TEST_F(test_server, SearchSubjects)
     auto returning_user{std::make_unique<flashback::User>(*m_user)};
     std::string const searching_pattern{"Linux"};
     std::vector<std::string> const subject_names{"Linux Kernel", "Linux System Administration", "Linux Network Administration"};
-    std::map<uint64_t, flashback::Subject> database_subjects;
+    std::vector<flashback::Subject> database_subjects;
 
     for (uint64_t index{}; auto const& name: subject_names)
     {
@@ -690,14 +748,16 @@ TEST_F(test_server, SearchSubjects)
         flashback::Subject subject;
         subject.set_id(index);
         subject.set_name(name);
-        database_subjects.insert({index, subject});
+        database_subjects.push_back(subject);
     }
 
     request.set_allocated_user(requesting_user.release());
     request.set_token(searching_pattern);
 
     EXPECT_CALL(*m_mock_database, get_user(testing::A<std::string_view>(), testing::A<std::string_view>())).Times(1).WillOnce(testing::Return(std::move(returning_user)));
-    EXPECT_CALL(*m_mock_database, search_subjects(testing::A<std::string_view>())).Times(1).WillOnce(testing::Return(database_subjects));
+    EXPECT_CALL(*m_mock_database, get_subjects()).Times(1).WillOnce(testing::Return(database_subjects));
+    EXPECT_CALL(*m_mock_database, search_subjects(testing::A<std::string_view>(), testing::A<uint64_t>(), testing::A<uint64_t>())).Times(0);
+    m_server = std::make_shared<flashback::server>(m_mock_database);
     EXPECT_NO_THROW(status = m_server->SearchSubjects(&context, &request, &response));
     EXPECT_TRUE(status.ok());
     ASSERT_EQ(response.subjects().size(), database_subjects.size());
@@ -706,11 +766,10 @@ TEST_F(test_server, SearchSubjects)
     {
         uint64_t const position{match.position()};
         flashback::Subject const& subject{match.subject()};
-        auto const& iter = std::ranges::find_if(database_subjects, [&match](std::pair<uint64_t, flashback::Subject> const& e)
-        {
-            return match.position() == e.first && match.subject().id() == e.second.id() && match.subject().name() == e.second.name();
-        });
-        EXPECT_NE(iter, database_subjects.cend());
+        ASSERT_THAT(position, testing::Gt(0));
+        ASSERT_THAT(position, testing::Le(database_subjects.size()));
+        EXPECT_EQ(subject.id(), database_subjects.at(position - 1).id());
+        EXPECT_EQ(subject.name(), database_subjects.at(position - 1).name());
     }
 
     request.clear_user();
@@ -721,6 +780,78 @@ TEST_F(test_server, SearchSubjects)
     ASSERT_EQ(response.subjects().size(), 0) << "Searching subject with no name should result empty set";
 }
 
+TEST_F(test_server, SearchSubjectsWithoutIndex)
+{
+    grpc::Status status{};
+    grpc::ServerContext context{};
+    flashback::SearchSubjectsRequest request{};
+    flashback::SearchSubjectsResponse response{};
+    flashback::Subject subject{};
+    subject.set_id(1);
+    subject.set_name("Calculus");
+
+    EXPECT_CALL(*m_mock_database, get_user(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Invoke([this]() { return std::make_unique<flashback::User>(*m_user); }));
+    EXPECT_CALL(*m_mock_database, user_is_authorized(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Return(true));
+    EXPECT_CALL(*m_mock_database, get_subjects()).Times(1).WillOnce(testing::Throw(std::runtime_error{"function get_subjects() does not exist"}));
+    EXPECT_CALL(*m_mock_database, search_subjects(A<std::string_view>(), A<uint64_t>(), A<uint64_t>())).Times(1).WillOnce(Return(std::vector<flashback::Subject>{subject}));
+    EXPECT_NO_THROW(m_server = std::make_shared<flashback::server>(m_mock_database)) << "A catalog that cannot be loaded should not stop the server";
+
+    *request.mutable_user() = *m_user;
+    request.set_token("lus");
+    EXPECT_NO_THROW(status = m_server->SearchSubjects(&context, &request, &response));
+    EXPECT_THAT(status.ok(), IsTrue());
+    ASSERT_THAT(response.subjects(), SizeIs(1)) << "Searches should fall back to the database";
+    EXPECT_THAT(response.subjects(0).subject().id(), Eq(1));
+}
+
+TEST_F(test_server, SearchSubjectsAfterWrites)
+{
+    grpc::Status status{};
+    grpc::ServerContext context{};
+    flashback::SearchSubjectsRequest request{};
+    flashback::SearchSubjectsResponse response{};
+    flashback::RenameSubjectRequest rename_request{};
+    flashback::RenameSubjectResponse rename_response{};
+    flashback::MergeSubjectsRequest merge_request{};
+    flashback::MergeSubjectsResponse merge_response{};
+    std::vector<flashback::Subject> subjects(2);
+    subjects[0].set_id(1);
+    subjects[0].set_name("Calculus");
+    subjects[1].set_id(2);
+    subjects[1].set_name("Algebra");
+
+    EXPECT_CALL(*m_mock_database, get_user(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Invoke([this]() { return std::make_unique<flashback::User>(*m_user); }));
+    EXPECT_CALL(*m_mock_database, user_is_verified(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Return(true));
+    EXPECT_CALL(*m_mock_database, user_is_authorized(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Return(true));
+    EXPECT_CALL(*m_mock_database, get_subjects()).Times(1).WillOnce(Return(subjects));
+    EXPECT_CALL(*m_mock_database, rename_subject(2, "Linear Algebra")).Times(1);
+    EXPECT_CALL(*m_mock_database, merge_subjects(1, 2)).Times(1);
+    m_server = std::make_shared<flashback::server>(m_mock_database);
+
+    *rename_request.mutable_user() = *m_user;
+    rename_request.set_id(2);
+    rename_request.set_name("Linear Algebra");
+    EXPECT_NO_THROW(status = m_server->RenameSubject(&context, &rename_request, &rename_response));
+    EXPECT_THAT(status.ok(), IsTrue());
+
+    *request.mutable_user() = *m_user;
+    request.set_token("Linear");
+    EXPECT_NO_THROW(status = m_server->SearchSubjects(&context, &request, &response));
+    ASSERT_THAT(response.subjects(), SizeIs(1)) << "Renamed subjects should be found by their new name";
+    EXPECT_THAT(response.subjects(0).subject().id(), Eq(2));
+
+    *merge_request.mutable_user() = *m_user;
+    merge_request.mutable_source_subject()->set_id(1);
+    merge_request.mutable_target_subject()->set_id(2);
+    EXPECT_NO_THROW(status = m_server->MergeSubjects(&context, &merge_request, &merge_response));
+    EXPECT_THAT(status.ok(), IsTrue());
+
+    response.Clear();
+    request.set_token("Calculus");
+    EXPECT_NO_THROW(status = m_server->SearchSubjects(&context, &request, &response));
+    EXPECT_THAT(response.subjects(), IsEmpty()) << "Merged subjects should no longer be found";
+}
+
 TEST_F(test_server, RenameSubject)
 {
     auto requesting_user{std::make_unique<flashback::User>(*m_user)};
@@ -828,7 +959,10 @@ TEST_F(test_server, GetMilestones)
     request.set_roadmap_id(requesting_roadmap.id());
 
     EXPECT_CALL(*m_mock_database, get_user(A<std::string_view>(), A<std::string_view>())).Times(1).WillOnce(Return(std::move(database_provided_user)));
-    EXPECT_CALL(*m_mock_database, get_milestones(A<uint64_t>())).Times(1).WillOnce(Return(database_provided_milestones));
+    EXPECT_CALL(*m_mock_database, get_milestones(A<uint64_t>(), A<uint64_t>(), A<uint64_t>(), A<google::protobuf::RepeatedPtrField<flashback::Milestone>&>())).Times(1).WillOnce(
+        Invoke([&database_provided_milestones](uint64_t, uint64_t, uint64_t, google::protobuf::RepeatedPtrField<flashback::Milestone>& milestones) {
+            milestones.Add(database_provided_milestones.begin(), database_provided_milestones.end());
+        }));
     EXPECT_NO_THROW(status = m_server->GetMilestones(&context, &request, &response));
     EXPECT_TRUE(status.ok());
     EXPECT_EQ(response.milestones().size(), database_provided_milestones.size());
@@ -870,17 +1004,58 @@ TEST_F(test_server, AddRequirement)
     required_milestone->set_name("C");
     required_milestone->set_position(1);
     required_milestone->set_level(flashback::expertise_level::origin);
+    milestones.push_back(*milestone);
+    milestones.push_back(*required_milestone);
     request.set_allocated_user(requesting_user.release());
     request.set_allocated_roadmap(roadmap.release());
     request.set_allocated_milestone(milestone.release());
     request.set_allocated_required_milestone(required_milestone.release());
 
     EXPECT_CALL(*m_mock_database, get_user(A<std::string_view>(), A<std::string_view>())).Times(1).WillOnce(Return(std::move(database_provided_user)));
+    EXPECT_CALL(*m_mock_database, user_is_authorized(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Return(true));
+    EXPECT_CALL(*m_mock_database, get_milestones(A<uint64_t>())).Times(1).WillOnce(Return(milestones));
+    EXPECT_CALL(*m_mock_database, get_roadmap_requirements(A<uint64_t>())).Times(1).WillOnce(Return(std::vector<flashback::Requirement>{}));
     EXPECT_CALL(*m_mock_database, add_requirement(A<uint64_t>(), A<flashback::Milestone>(), A<flashback::Milestone>())).Times(1);
     EXPECT_NO_THROW(status = m_server->AddRequirement(&context, &request, &response));
     EXPECT_TRUE(status.ok());
 }
 
+TEST_F(test_server, AddCyclicRequirement)
+{
+    using testing::A;
+    using testing::Eq;
+    using testing::Return;
+
+    grpc::Status status{};
+    grpc::ServerContext context{};
+    flashback::AddRequirementRequest request{};
+    flashback::AddRequirementResponse response{};
+    flashback::Milestone kernel{};
+    flashback::Milestone c{};
+    flashback::Requirement stored_requirement{};
+
+    kernel.set_id(1);
+    kernel.set_name("Linux Kernel");
+    kernel.set_position(2);
+    c.set_id(2);
+    c.set_name("C");
+    c.set_position(1);
+    stored_requirement.set_milestone_id(kernel.id());
+    *stored_requirement.mutable_required_milestone() = c;
+    *request.mutable_user() = *m_user;
+    request.mutable_roadmap()->set_id(1);
+    *request.mutable_milestone() = c;
+    *request.mutable_required_milestone() = kernel;
+
+    EXPECT_CALL(*m_mock_database, get_user(A<std::string_view>(), A<std::string_view>())).Times(1).WillOnce(Return(std::make_unique<flashback::User>(*m_user)));
+    EXPECT_CALL(*m_mock_database, user_is_authorized(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Return(true));
+    EXPECT_CALL(*m_mock_database, get_milestones(A<uint64_t>())).Times(1).WillOnce(Return(std::vector<flashback::Milestone>{c, kernel}));
+    EXPECT_CALL(*m_mock_database, get_roadmap_requirements(A<uint64_t>())).Times(1).WillOnce(Return(std::vector<flashback::Requirement>{stored_requirement}));
+    EXPECT_CALL(*m_mock_database, add_requirement(A<uint64_t>(), A<flashback::Milestone>(), A<flashback::Milestone>())).Times(0);
+    EXPECT_NO_THROW(status = m_server->AddRequirement(&context, &request, &response));
+    EXPECT_THAT(status.error_code(), Eq(grpc::StatusCode::FAILED_PRECONDITION)) << "Requiring a milestone that already depends on this one should be rejected";
+}
+
 TEST_F(test_server, GetRequirements)
 {
     using testing::A;
@@ -930,6 +1105,62 @@ WillOnce(Return(required_milestones));
     EXPECT_TRUE(status.ok());
 }
 
+TEST_F(test_server, GetRoadmapGraph)
+{
+    using testing::A;
+    using testing::Eq;
+    using testing::Return;
+    using testing::ElementsAre;
+
+    grpc::Status status{};
+    grpc::ServerContext context{};
+    flashback::GetRoadmapGraphRequest request{};
+    flashback::GetRoadmapGraphResponse response{};
+    flashback::Milestone drivers{};
+    flashback::Milestone kernel{};
+    flashback::Milestone c{};
+    flashback::Requirement drivers_requirement{};
+    flashback::Requirement kernel_requirement{};
+
+    drivers.set_id(1);
+    drivers.set_position(1);
+    kernel.set_id(2);
+    kernel.set_position(2);
+    c.set_id(3);
+    c.set_position(3);
+    drivers_requirement.set_milestone_id(drivers.id());
+    *drivers_requirement.mutable_required_milestone() = kernel;
+    kernel_requirement.set_milestone_id(kernel.id());
+    *kernel_requirement.mutable_required_milestone() = c;
+
+    EXPECT_CALL(*m_mock_database, get_user(A<std::string_view>(), A<std::string_view>())).Times(2).WillRepeatedly([this] { return std::make_unique<flashback::User>(*m_user); });
+    EXPECT_CALL(*m_mock_database, user_is_authorized(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Return(true));
+    EXPECT_CALL(*m_mock_database, get_milestones(A<uint64_t>())).Times(1).WillOnce(Return(std::vector<flashback::Milestone>{drivers, kernel, c}));
+    EXPECT_CALL(*m_mock_database, get_roadmap_requirements(A<uint64_t>())).Times(1).WillOnce(Return(std::vector<flashback::Requirement>{drivers_requirement, kernel_requirement}));
+
+    EXPECT_NO_THROW(status = m_server->GetRoadmapGraph(&context, &request, &response));
+    EXPECT_THAT(status.error_code(), Eq(grpc::StatusCode::UNAUTHENTICATED));
+
+    *request.mutable_user() = *m_user;
+    EXPECT_NO_THROW(status = m_server->GetRoadmapGraph(&context, &request, &response));
+    EXPECT_THAT(status.error_code(), Eq(grpc::StatusCode::INVALID_ARGUMENT));
+
+    request.mutable_roadmap()->set_id(1);
+    EXPECT_NO_THROW(status = m_server->GetRoadmapGraph(&context, &request, &response));
+    ASSERT_TRUE(status.ok());
+    ASSERT_THAT(response.nodes_size(), Eq(3));
+    EXPECT_THAT(response.nodes(0).milestone().id(), Eq(c.id()));
+    EXPECT_THAT(response.nodes(2).milestone().id(), Eq(drivers.id()));
+    ASSERT_THAT(response.nodes(2).prerequisites_size(), Eq(2));
+    EXPECT_THAT(response.nodes(2).prerequisites(0).id(), Eq(kernel.id()));
+    EXPECT_THAT(response.nodes(2).prerequisites(1).id(), Eq(c.id()));
+
+    response.clear_nodes();
+    EXPECT_NO_THROW(status = m_server->GetRoadmapGraph(&context, &request, &response));
+    EXPECT_TRUE(status.ok()) << "Second request should be served from the cached graph";
+    EXPECT_THAT(response.nodes_size(), Eq(3));
+}
+
 TEST_F(test_server, CloneRoadmap)
 {
     using testing::A;
@@ -1278,10 +1509,12 @@ TEST_F(test_server, SearchRsources)
     grpc::ServerContext context{};
     flashback::SearchResourcesRequest request{};
     flashback::SearchResourcesResponse response{};
-    std::map<uint64_t, flashback::Resource> const search_results{};
+    std::vector<flashback::Resource> const search_results{};
 
     EXPECT_CALL(*m_mock_database, get_user(A<std::string_view>(), A<std::string_view>())).Times(1).WillOnce(Return(std::make_unique<flashback::User>(*m_user)));
-    EXPECT_CALL(*m_mock_database, search_resources(A<std::string_view>())).Times(1).WillOnce(Return(search_results));
+    EXPECT_CALL(*m_mock_database, get_resources()).Times(1).WillOnce(Return(search_results));
+    EXPECT_CALL(*m_mock_database, search_resources(A<std::string_view>(), A<uint64_t>(), A<uint64_t>())).Times(0);
+    m_server = std::make_shared<flashback::server>(m_mock_database);
 
     request.clear_user();
     request.clear_search_token();
@@ -1421,7 +1654,13 @@ TEST_F(test_server, GetNerves)
     expected_nerves.push_back(nerve);
 
     EXPECT_CALL(*m_mock_database, get_user(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Invoke([this]() { return std::make_unique<flashback::User>(*m_user); }));
-    EXPECT_CALL(*m_mock_database, get_nerves(A<uint64_t>())).Times(1).WillRepeatedly(Return(expected_nerves));
+    EXPECT_CALL(*m_mock_database, get_nerves(A<uint64_t>(), A<google::protobuf::RepeatedPtrField<flashback::Nerve>&>())).Times(1).WillOnce(
+        Invoke([&expected_nerves](uint64_t, google::protobuf::RepeatedPtrField<flashback::Nerve>& nerves) {
+            for (flashback::Resource const& nerve: expected_nerves)
+            {
+                *nerves.Add()->mutable_resource() = nerve;
+            }
+        }));
 
     request.clear_user();
     EXPECT_NO_THROW(status = m_server->GetNerves(&context, &request, &response));
@@ -1532,15 +1771,17 @@ TEST_F(test_server, SearchProviders)
     grpc::ServerContext context{};
     flashback::SearchProvidersRequest request{};
     flashback::SearchProvidersResponse response{};
-    std::map<uint64_t, flashback::Provider> providers{};
+    std::vector<flashback::Provider> providers{};
     flashback::Provider provider{};
 
     provider.set_name("Brian Salehi");
     provider.set_id(1);
-    providers.insert({provider.id(), provider});
+    providers.push_back(provider);
 
     EXPECT_CALL(*m_mock_database, get_user(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Invoke([this]() { return std::make_unique<flashback::User>(*m_user); }));
-    EXPECT_CALL(*m_mock_database, search_providers(A<std::string_view>())).Times(1).WillOnce(Return(providers));
+    EXPECT_CALL(*m_mock_database, get_providers()).Times(1).WillOnce(Return(providers));
+    EXPECT_CALL(*m_mock_database, search_providers(A<std::string_view>(), A<uint64_t>(), A<uint64_t>())).Times(0);
+    m_server = std::make_shared<flashback::server>(m_mock_database);
 
     request.clear_user();
     EXPECT_NO_THROW(status = m_server->SearchProviders(&context, &request, &response));
@@ -1556,19 +1797,74 @@ TEST_F(test_server, SearchProviders)
     EXPECT_THAT(status.error_message(), IsEmpty());
 }
 
+TEST_F(test_server, SearchProvidersPaging)
+{
+    grpc::Status status{};
+    grpc::ServerContext context{};
+    flashback::SearchProvidersRequest request{};
+    flashback::SearchProvidersResponse response{};
+    std::vector<flashback::Provider> providers{};
+
+    for (uint64_t id{1}; id <= 3; ++id)
+    {
+        flashback::Provider provider{};
+        provider.set_id(id);
+        provider.set_name(std::format("Provider {}", id));
+        providers.push_back(provider);
+    }
+
+    EXPECT_CALL(*m_mock_database, get_user(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Invoke([this]() { return std::make_unique<flashback::User>(*m_user); }));
+    EXPECT_CALL(*m_mock_database, user_is_authorized(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Return(true));
+    EXPECT_CALL(*m_mock_database, get_providers()).Times(1).WillOnce(Return(providers));
+    m_server = std::make_shared<flashback::server>(m_mock_database);
+
+    *request.mutable_user() = *m_user;
+    request.set_search_token("Provider");
+    request.set_limit(2);
+    EXPECT_NO_THROW(status = m_server->SearchProviders(&context, &request, &response));
+    EXPECT_THAT(status.ok(), IsTrue());
+    ASSERT_THAT(response.result(), SizeIs(2)) << "Look-ahead row must not be returned";
+    EXPECT_THAT(response.result(0).position(), Eq(1));
+    EXPECT_THAT(response.result(1).position(), Eq(2));
+    EXPECT_THAT(response.next_page_token(), Not(IsEmpty()));
+
+    request.set_page_token(response.next_page_token());
+    response.Clear();
+    EXPECT_NO_THROW(status = m_server->SearchProviders(&context, &request, &response));
+    EXPECT_THAT(status.ok(), IsTrue());
+    ASSERT_THAT(response.result(), SizeIs(1));
+    EXPECT_THAT(response.result(0).position(), Eq(3)) << "Positions are ranks across pages";
+    EXPECT_THAT(response.result(0).provider().id(), Eq(3));
+    EXPECT_THAT(response.next_page_token(), IsEmpty()) << "Last page should not have a continuation";
+
+    request.set_page_token("not a token");
+    response.Clear();
+    EXPECT_NO_THROW(status = m_server->SearchProviders(&context, &request, &response));
+    EXPECT_THAT(status.error_code(), Eq(grpc::StatusCode::INVALID_ARGUMENT));
+
+    request.set_page_token("__________8");
+    response.Clear();
+    EXPECT_NO_THROW(status = m_server->SearchProviders(&context, &request, &response));
+    EXPECT_THAT(status.error_code(), Eq(grpc::StatusCode::INVALID_ARGUMENT)) << "Offsets whose next page would overflow should be refused";
+}
+
 TEST_F(test_server, RenameProvider)
 {
     grpc::Status status{};
     grpc::ServerContext context{};
     flashback::RenameProviderRequest request{};
     flashback::RenameProviderResponse response{};
+    flashback::SearchProvidersRequest search_request{};
+    flashback::SearchProvidersResponse search_response{};
     flashback::Provider provider{};
 
     provider.set_name("Brian Salehi");
     provider.set_id(1);
 
     EXPECT_CALL(*m_mock_database, get_user(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Invoke([this]() { return std::make_unique<flashback::User>(*m_user); }));
+    EXPECT_CALL(*m_mock_database, user_is_authorized(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Return(true));
     EXPECT_CALL(*m_mock_database, rename_provider(A<uint64_t>(), A<std::string>())).Times(1);
+    EXPECT_CALL(*m_mock_database, search_providers(A<std::string_view>(), A<uint64_t>(), A<uint64_t>())).Times(0);
 
     request.clear_user();
     EXPECT_NO_THROW(status = m_server->RenameProvider(&context, &request, &response));
@@ -1582,6 +1878,13 @@ TEST_F(test_server, RenameProvider)
     EXPECT_NO_THROW(status = m_server->RenameProvider(&context, &request, &response));
     EXPECT_THAT(status.ok(), IsTrue());
     EXPECT_THAT(status.error_message(), IsEmpty());
+
+    *search_request.mutable_user() = *m_user;
+    search_request.set_search_token("Salehi");
+    EXPECT_NO_THROW(status = m_server->SearchProviders(&context, &search_request, &search_response));
+    EXPECT_THAT(status.ok(), IsTrue());
+    ASSERT_THAT(search_response.result(), SizeIs(1)) << "Renaming a provider the index missed should index it under its new name";
+    EXPECT_THAT(search_response.result(0).provider().id(), Eq(1));
 }
 
 TEST_F(test_server, RemoveProvider)
@@ -1737,7 +2040,7 @@ TEST_F(test_server, SearchPresenters)
     grpc::ServerContext context{};
     flashback::SearchPresentersRequest request{};
     flashback::SearchPresentersResponse response{};
-    std::map<uint64_t, flashback::Presenter> presenters{};
+    std::vector<flashback::Presenter> presenters{};
     flashback::Presenter presenter{};
     flashback::Resource resource{};
 
@@ -1746,7 +2049,9 @@ TEST_F(test_server, SearchPresenters)
     resource.set_id(1);
 
     EXPECT_CALL(*m_mock_database, get_user(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Invoke([this]() { return std::make_unique<flashback::User>(*m_user); }));
-    EXPECT_CALL(*m_mock_database, search_presenters(A<std::string_view>())).Times(1).WillOnce(Return(presenters));
+    EXPECT_CALL(*m_mock_database, get_presenters()).Times(1).WillOnce(Return(presenters));
+    EXPECT_CALL(*m_mock_database, search_presenters(A<std::string_view>(), A<uint64_t>(), A<uint64_t>())).Times(0);
+    m_server = std::make_shared<flashback::server>(m_mock_database);
 
     request.clear_user();
     EXPECT_NO_THROW(status = m_server->SearchPresenters(&context, &request, &response));
@@ -1868,7 +2173,13 @@ TEST_F(test_server, GetTopics)
     topics.insert({topic.position(), topic});
 
     EXPECT_CALL(*m_mock_database, get_user(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Invoke([this]() { return std::make_unique<flashback::User>(*m_user); }));
-    EXPECT_CALL(*m_mock_database, get_topics(A<uint64_t>(), An<flashback::expertise_level>())).Times(1).WillOnce(Return(topics));
+    EXPECT_CALL(*m_mock_database, get_topics(A<uint64_t>(), An<flashback::expertise_level>(), A<uint64_t>(), A<uint64_t>(), A<google::protobuf::RepeatedPtrField<flashback::Topic>&>()))
+        .Times(1).WillOnce(Invoke([&topics](uint64_t, flashback::expertise_level, uint64_t, uint64_t, google::protobuf::RepeatedPtrField<flashback::Topic>& matched) {
+            for (auto const& [position, topic]: topics)
+            {
+                *matched.Add() = topic;
+            }
+        }));
 
     request.clear_user();
     EXPECT_NO_THROW(status = m_server->GetTopics(&context, &request, &response));
@@ -2087,7 +2398,7 @@ TEST_F(test_server, SearchTopics)
     flashback::SearchTopicsResponse response{};
     flashback::Subject subject{};
     flashback::Topic topic{};
-    std::map<uint64_t, flashback::Topic> results{};
+    std::vector<flashback::Topic> results{};
 
     subject.set_name("C++");
     subject.set_id(1);
@@ -2096,7 +2407,7 @@ TEST_F(test_server, SearchTopics)
     topic.set_level(flashback::expertise_level::origin);
 
     EXPECT_CALL(*m_mock_database, get_user(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Invoke([this]() { return std::make_unique<flashback::User>(*m_user); }));
-    EXPECT_CALL(*m_mock_database, search_topics(A<uint64_t>(), An<flashback::expertise_level>(), A<std::string_view>())).Times(1).WillOnce(Return(results));
+    EXPECT_CALL(*m_mock_database, search_topics(A<uint64_t>(), An<flashback::expertise_level>(), A<std::string_view>(), A<uint64_t>(), A<uint64_t>())).Times(1).WillOnce(Return(results));
 
     request.clear_user();
     EXPECT_NO_THROW(status = m_server->SearchTopics(&context, &request, &response));
@@ -2122,16 +2433,15 @@ TEST_F(test_server, GetSections)
     flashback::GetSectionsResponse response{};
     flashback::Resource resource{};
     flashback::Section section{};
-    std::map<uint64_t, flashback::Section> sections{};
 
     resource.set_name("C++ Resource");
     resource.set_id(1);
     section.set_name("Reflections");
     section.set_position(1);
-    sections.insert({section.position(), section});
 
     EXPECT_CALL(*m_mock_database, get_user(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Invoke([this]() { return std::make_unique<flashback::User>(*m_user); }));
-    EXPECT_CALL(*m_mock_database, get_sections(A<uint64_t>())).Times(1).WillOnce(Return(sections));
+    EXPECT_CALL(*m_mock_database, get_sections(A<uint64_t>(), A<uint64_t>(), A<uint64_t>(), A<google::protobuf::RepeatedPtrField<flashback::Section>&>())).Times(1).WillOnce(
+        Invoke([&section](uint64_t, uint64_t, uint64_t, google::protobuf::RepeatedPtrField<flashback::Section>& sections) { *sections.Add() = section; }));
 
     request.clear_user();
     EXPECT_NO_THROW(status = m_server->GetSections(&context, &request, &response));
@@ -2145,6 +2455,62 @@ TEST_F(test_server, GetSections)
     EXPECT_NO_THROW(status = m_server->GetSections(&context, &request, &response));
     EXPECT_THAT(status.ok(), IsTrue());
     EXPECT_THAT(status.error_message(), IsEmpty());
+    EXPECT_THAT(response.section(), SizeIs(1));
+    EXPECT_THAT(response.section(0).name(), Eq(section.name()));
+    EXPECT_THAT(response.next_page_token(), IsEmpty());
+}
+
+TEST_F(test_server, GetSectionsPaging)
+{
+    grpc::Status status{};
+    grpc::ServerContext context{};
+    flashback::GetSectionsRequest request{};
+    flashback::GetSectionsResponse response{};
+    flashback::Resource resource{};
+
+    resource.set_name("C++ Resource");
+    resource.set_id(1);
+
+    auto const provide_sections = [](uint64_t, uint64_t const after, uint64_t const limit, google::protobuf::RepeatedPtrField<flashback::Section>& sections) {
+        for (uint64_t position{after + 1}; position <= 5 && position <= after + limit; ++position)
+        {
+            flashback::Section* section{sections.Add()};
+            section->set_position(position);
+            section->set_name(std::format("Chapter {}", position));
+        }
+    };
+
+    EXPECT_CALL(*m_mock_database, get_user(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Invoke([this]() { return std::make_unique<flashback::User>(*m_user); }));
+    EXPECT_CALL(*m_mock_database, get_sections(1, 0, 3, A<google::protobuf::RepeatedPtrField<flashback::Section>&>())).Times(1).WillOnce(Invoke(provide_sections));
+    EXPECT_CALL(*m_mock_database, get_sections(1, 2, 3, A<google::protobuf::RepeatedPtrField<flashback::Section>&>())).Times(1).WillOnce(Invoke(provide_sections));
+    EXPECT_CALL(*m_mock_database, get_sections(1, 4, 3, A<google::protobuf::RepeatedPtrField<flashback::Section>&>())).Times(1).WillOnce(Invoke(provide_sections));
+
+    *request.mutable_user() = *m_user;
+    *request.mutable_resource() = resource;
+    request.set_page_size(2);
+
+    EXPECT_NO_THROW(status = m_server->GetSections(&context, &request, &response));
+    EXPECT_THAT(status.ok(), IsTrue());
+    EXPECT_THAT(response.section(), SizeIs(2)) << "Look-ahead row should be trimmed from the page";
+    EXPECT_THAT(response.next_page_token(), Ne(""));
+
+    request.set_page_token(response.next_page_token());
+    response.Clear();
+    EXPECT_NO_THROW(status = m_server->GetSections(&context, &request, &response));
+    EXPECT_THAT(status.ok(), IsTrue());
+    ASSERT_THAT(response.section(), SizeIs(2));
+    EXPECT_THAT(response.section(0).position(), Eq(3)) << "Next page should resume after the last position of the previous page";
+
+    request.set_page_token(response.next_page_token());
+    response.Clear();
+    EXPECT_NO_THROW(status = m_server->GetSections(&context, &request, &response));
+    EXPECT_THAT(status.ok(), IsTrue());
+    EXPECT_THAT(response.section(), SizeIs(1));
+    EXPECT_THAT(response.next_page_token(), IsEmpty());
+
+    request.set_page_token("not a cursor!");
+    EXPECT_NO_THROW(status = m_server->GetSections(&context, &request, &response));
+    EXPECT_THAT(status.error_code(), Eq(grpc::StatusCode::INVALID_ARGUMENT));
 }
 
 TEST_F(test_server, CreateSection)
@@ -2343,16 +2709,16 @@ TEST_F(test_server, SearchSections)
     flashback::SearchSectionsResponse response{};
     flashback::Resource resource{};
     flashback::Section section{};
-    std::map<uint64_t, flashback::Section> results{};
+    std::vector<flashback::Section> results{};
 
     resource.set_name("C++ Resource");
     resource.set_id(1);
     section.set_name("Reflections");
     section.set_position(1);
-    results.insert({section.position(), section});
+    results.push_back(section);
 
     EXPECT_CALL(*m_mock_database, get_user(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Invoke([this]() { return std::make_unique<flashback::User>(*m_user); }));
-    EXPECT_CALL(*m_mock_database, search_sections(A<uint64_t>(), A<std::string_view>())).Times(1).WillOnce(Return(results));
+    EXPECT_CALL(*m_mock_database, search_sections(A<uint64_t>(), A<std::string_view>(), A<uint64_t>(), A<uint64_t>())).Times(1).WillOnce(Return(results));
 
     request.clear_user();
     EXPECT_NO_THROW(status = m_server->SearchSections(&context, &request, &response));
@@ -2544,7 +2910,7 @@ TEST_F(test_server, SearchCards)
     flashback::Card card{};
     flashback::Subject subject{};
     auto constexpr level{flashback::expertise_level::depth};
-    std::map<uint64_t, flashback::Card> result{};
+    std::vector<flashback::Card> result{};
 
     auto constexpr state{flashback::Card::draft};
     auto constexpr headline{"Is it worth asking?"};
@@ -2553,10 +2919,10 @@ TEST_F(test_server, SearchCards)
     card.set_state(state);
     card.set_headline(headline);
     subject.set_id(1);
-    result.insert({1, card});
+    result.push_back(card);
 
     EXPECT_CALL(*m_mock_database, get_user(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Invoke([this]() { return std::make_unique<flashback::User>(*m_user); }));
-    EXPECT_CALL(*m_mock_database, search_cards(A<uint64_t>(), An<flashback::expertise_level>(), A<std::string_view>())).Times(1).WillOnce(Return(result));
+    EXPECT_CALL(*m_mock_database, search_cards(A<uint64_t>(), An<flashback::expertise_level>(), A<std::string_view>(), A<uint64_t>(), A<uint64_t>(), A<std::stop_token>())).Times(1).WillOnce(Return(result));
 
     request.clear_user();
     EXPECT_NO_THROW(status = m_server->SearchCards(&context, &request, &response));
@@ -2574,19 +2940,86 @@ TEST_F(test_server, SearchCards)
     EXPECT_THAT(status.error_message(), IsEmpty());
 }
 
+TEST_F(test_server, SearchBlocks)
+{
+    grpc::Status status{};
+    grpc::ServerContext context{};
+    flashback::SearchBlocksRequest request{};
+    flashback::SearchBlocksResponse response{};
+    std::vector<flashback::BlockSearchResult> matches{};
+
+    for (uint64_t position{1}; position <= 3; ++position)
+    {
+        flashback::BlockSearchResult match{};
+        match.mutable_card()->set_id(1);
+        match.mutable_block()->set_position(position);
+        match.mutable_block()->set_content("The borrow checker enforces ownership");
+        match.set_snippet("The <b>borrow</b> checker");
+        matches.push_back(match);
+    }
+
+    EXPECT_CALL(*m_mock_database, get_user(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Invoke([this]() { return std::make_unique<flashback::User>(*m_user); }));
+    EXPECT_CALL(*m_mock_database, user_is_authorized(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Return(true));
+    EXPECT_CALL(*m_mock_database, search_blocks(m_user->id(), A<std::string_view>(), Eq(3), Eq(0))).Times(1).WillOnce(Return(matches));
+
+    request.clear_user();
+    EXPECT_NO_THROW(status = m_server->SearchBlocks(&context, &request, &response));
+    EXPECT_THAT(status.error_code(), Eq(grpc::StatusCode::UNAUTHENTICATED));
+
+    *request.mutable_user() = *m_user;
+    EXPECT_NO_THROW(status = m_server->SearchBlocks(&context, &request, &response));
+    EXPECT_THAT(status.error_code(), Eq(grpc::StatusCode::INVALID_ARGUMENT)) << "Empty search token should be rejected";
+
+    request.set_search_token("borrow");
+    request.set_limit(2);
+    EXPECT_NO_THROW(status = m_server->SearchBlocks(&context, &request, &response));
+    EXPECT_THAT(status.ok(), IsTrue());
+    ASSERT_THAT(response.result(), SizeIs(2));
+    EXPECT_THAT(response.result(0).position(), Eq(1));
+    EXPECT_THAT(response.result(1).block().position(), Eq(2));
+    EXPECT_THAT(response.result(0).snippet(), Eq("The <b>borrow</b> checker"));
+    EXPECT_THAT(response.next_page_token(), Not(IsEmpty()));
+}
+
+TEST_F(test_server, ExportSubjectCards)
+{
+    grpc::Status status{};
+    grpc::ServerContext context{};
+    flashback::ExportSubjectCardsRequest request{};
+
+    EXPECT_CALL(*m_mock_database, get_user(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Invoke([this]() { return std::make_unique<flashback::User>(*m_user); }));
+    EXPECT_CALL(*m_mock_database, export_subject_cards(A<uint64_t>(), A<std::function<bool(flashback::Topic const&, flashback::Card const&)> const&>())).Times(0);
+
+    request.clear_user();
+    EXPECT_NO_THROW(status = m_server->ExportSubjectCards(&context, &request, nullptr));
+    EXPECT_THAT(status.error_code(), Eq(grpc::StatusCode::UNAUTHENTICATED));
+
+    *request.mutable_user() = *m_user;
+    EXPECT_NO_THROW(status = m_server->ExportSubjectCards(&context, &request, nullptr));
+    EXPECT_THAT(status.error_code(), Eq(grpc::StatusCode::INVALID_ARGUMENT)) << "Exports should be rejected before any row is fetched";
+}
+
 TEST_F(test_server, GetStudyResources)
 {
     grpc::Status status{};
     grpc::ServerContext context{};
     flashback::GetStudyResourcesRequest request{};
     flashback::GetStudyResourcesResponse response{};
-    std::map<uint64_t, flashback::Resource> result{};
     flashback::Resource resource{};
+    flashback::Provider provider{};
     resource.set_id(1);
-    result.insert({1, resource});
+    provider.set_id(1);
+    provider.set_name("Flashback Publications");
 
     EXPECT_CALL(*m_mock_database, get_user(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Invoke([this]() { return std::make_unique<flashback::User>(*m_user); }));
-    EXPECT_CALL(*m_mock_database, get_study_resources(A<uint64_t>())).Times(1).WillOnce(Return(result));
+    EXPECT_CALL(*m_mock_database, user_is_authorized(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Return(true));
+    EXPECT_CALL(*m_mock_database, get_study_resources(A<uint64_t>(), A<google::protobuf::RepeatedPtrField<flashback::StudyResource>&>())).Times(1).WillOnce(
+        Invoke([&resource, &provider](uint64_t, google::protobuf::RepeatedPtrField<flashback::StudyResource>& resources) {
+            flashback::Resource* const study{resources.Add()->mutable_resource()};
+            *study = resource;
+            *study->add_providers() = provider;
+        }));
+    EXPECT_CALL(*m_mock_database, get_providers(A<uint64_t>(), A<google::protobuf::RepeatedPtrField<flashback::Provider>&>())).Times(0);
 
     request.clear_user();
     EXPECT_NO_THROW(status = m_server->GetStudyResources(&context, &request, &response));
@@ -2599,6 +3032,9 @@ TEST_F(test_server, GetStudyResources)
     EXPECT_NO_THROW(status = m_server->GetStudyResources(&context, &request, &response));
     EXPECT_THAT(status.ok(), IsTrue());
     EXPECT_THAT(status.error_message(), IsEmpty());
+    EXPECT_THAT(response.study(), SizeIs(1));
+    EXPECT_THAT(response.study(0).resource().providers(), SizeIs(1));
+    EXPECT_THAT(response.study(0).resource().providers(0).name(), Eq(provider.name()));
 }
 
 TEST_F(test_server, MoveCardToSection)
@@ -2678,16 +3114,16 @@ TEST_F(test_server, GetPracticeCards)
     flashback::Subject subject{};
     flashback::Topic topic{};
     flashback::Card card{};
-    std::vector<flashback::Card> cards{};
     roadmap.set_id(1);
     subject.set_id(1);
     topic.set_position(1);
     topic.set_level(flashback::expertise_level::depth);
     card.set_id(1);
-    cards.push_back(card);
 
     EXPECT_CALL(*m_mock_database, get_user(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Invoke([this]() { return std::make_unique<flashback::User>(*m_user); }));
-    EXPECT_CALL(*m_mock_database, get_practice_cards(A<uint64_t>(), A<uint64_t>(), A<uint64_t>(), An<flashback::expertise_level>(), A<uint64_t>())).Times(1).WillOnce(Return(cards));
+    EXPECT_CALL(*m_mock_database, get_practice_cards(A<uint64_t>(), A<uint64_t>(), A<uint64_t>(), An<flashback::expertise_level>(), A<uint64_t>(),
+                                                     A<google::protobuf::RepeatedPtrField<flashback::Card>&>())).Times(1).WillOnce(
+        Invoke([&card](uint64_t, uint64_t, uint64_t, flashback::expertise_level, uint64_t, google::protobuf::RepeatedPtrField<flashback::Card>& cards) { *cards.Add() = card; }));
 
     request.clear_user();
     EXPECT_NO_THROW(status = m_server->GetPracticeCards(&context, &request, &response));
@@ -2703,6 +3139,100 @@ TEST_F(test_server, GetPracticeCards)
     EXPECT_NO_THROW(status = m_server->GetPracticeCards(&context, &request, &response));
     EXPECT_THAT(status.ok(), IsTrue());
     EXPECT_THAT(status.error_message(), IsEmpty());
+    EXPECT_THAT(response.card(), SizeIs(1));
+    EXPECT_THAT(response.card(0).id(), Eq(card.id()));
+}
+
+TEST_F(test_server, GetPracticeCardsWithBlocks)
+{
+    grpc::Status status{};
+    grpc::ServerContext context{};
+    flashback::GetPracticeCardsRequest request{};
+    flashback::GetPracticeCardsResponse response{};
+    flashback::Roadmap roadmap{};
+    flashback::Subject subject{};
+    flashback::Topic topic{};
+    roadmap.set_id(1);
+    subject.set_id(1);
+    topic.set_position(1);
+    topic.set_level(flashback::expertise_level::depth);
+
+    EXPECT_CALL(*m_mock_database, get_user(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Invoke([this]() { return std::make_unique<flashback::User>(*m_user); }));
+    EXPECT_CALL(*m_mock_database, get_practice_cards(A<uint64_t>(), A<uint64_t>(), A<uint64_t>(), An<flashback::expertise_level>(), A<uint64_t>(),
+                                                     A<google::protobuf::RepeatedPtrField<flashback::Card>&>())).Times(1).WillOnce(
+        Invoke([](uint64_t, uint64_t, uint64_t, flashback::expertise_level, uint64_t, google::protobuf::RepeatedPtrField<flashback::Card>& cards) {
+            cards.Add()->set_id(1);
+            cards.Add()->set_id(2);
+        }));
+    EXPECT_CALL(*m_mock_database, user_is_verified(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Return(true));
+    EXPECT_CALL(*m_mock_database, user_is_authorized(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Return(true));
+    EXPECT_CALL(*m_mock_database, get_blocks(A<std::vector<flashback::Card*> const&>())).Times(1).WillOnce(Invoke([](std::vector<flashback::Card*> const& cards) {
+        for (flashback::Card* card: cards)
+        {
+            flashback::Block* block{card->add_blocks()};
+            block->set_position(1);
+            block->set_content(std::format("Content of card {}", card->id()));
+        }
+    }));
+
+    *request.mutable_user() = *m_user;
+    *request.mutable_roadmap() = roadmap;
+    *request.mutable_subject() = subject;
+    *request.mutable_topic() = topic;
+    request.set_include_blocks(true);
+
+    EXPECT_NO_THROW(status = m_server->GetPracticeCards(&context, &request, &response));
+    EXPECT_THAT(status.ok(), IsTrue());
+    ASSERT_THAT(response.card(), SizeIs(2));
+    ASSERT_THAT(response.card(1).blocks(), SizeIs(1)) << "Blocks of every card should be collected in one database call";
+    EXPECT_THAT(response.card(1).blocks(0).content(), Eq("Content of card 2"));
+}
+
+TEST_F(test_server, GetPracticeCardsFromScheduler)
+{
+    grpc::Status status{};
+    grpc::ServerContext context{};
+    flashback::GetPracticeCardsRequest request{};
+    flashback::GetPracticeCardsResponse response{};
+    flashback::MakeProgressRequest progress_request{};
+    flashback::MakeProgressResponse progress_response{};
+    flashback::Topic topic{};
+    topic.set_position(1);
+    topic.set_level(flashback::expertise_level::depth);
+
+    EXPECT_CALL(*m_mock_database, get_user(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Invoke([this]() { return std::make_unique<flashback::User>(*m_user); }));
+    EXPECT_CALL(*m_mock_database, user_is_verified(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Return(true));
+    EXPECT_CALL(*m_mock_database, user_is_authorized(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Return(true));
+    EXPECT_CALL(*m_mock_database, get_practice_cards(A<uint64_t>(), A<uint64_t>(), A<uint64_t>(), An<flashback::expertise_level>(), A<uint64_t>(),
+                                                     A<google::protobuf::RepeatedPtrField<flashback::Card>&>())).Times(1).WillOnce(
+        Invoke([](uint64_t, uint64_t, uint64_t, flashback::expertise_level, uint64_t, google::protobuf::RepeatedPtrField<flashback::Card>& cards) {
+            cards.Add()->set_id(1);
+            cards.Add()->set_id(2);
+        }));
+    EXPECT_CALL(*m_mock_database, make_progress(A<uint64_t>(), A<uint64_t>(), An<flashback::expertise_level>(), A<uint64_t>(), A<uint64_t>())).Times(1);
+
+    *request.mutable_user() = *m_user;
+    request.mutable_roadmap()->set_id(1);
+    request.mutable_subject()->set_id(1);
+    *request.mutable_topic() = topic;
+
+    EXPECT_NO_THROW(status = m_server->GetPracticeCards(&context, &request, &response));
+    EXPECT_THAT(status.ok(), IsTrue());
+    EXPECT_THAT(response.card(), SizeIs(2));
+
+    *progress_request.mutable_user() = *m_user;
+    progress_request.mutable_milestone()->set_id(1);
+    progress_request.mutable_milestone()->set_level(topic.level());
+    progress_request.mutable_card()->set_id(1);
+    progress_request.set_duration(10);
+    EXPECT_NO_THROW(status = m_server->MakeProgress(&context, &progress_request, &progress_response));
+    EXPECT_THAT(status.ok(), IsTrue());
+
+    response.clear_card();
+    EXPECT_NO_THROW(status = m_server->GetPracticeCards(&context, &request, &response));
+    EXPECT_THAT(status.ok(), IsTrue());
+    ASSERT_THAT(response.card(), SizeIs(1)) << "Practiced cards should leave the deck without asking the database again";
+    EXPECT_THAT(response.card(0).id(), Eq(2));
 }
 
 TEST_F(test_server, MoveCardToTopic)
@@ -2800,7 +3330,11 @@ TEST_F(test_server, GetAssessments)
     assessments.push_back(assessment);
 
     EXPECT_CALL(*m_mock_database, get_user(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Invoke([this]() { return std::make_unique<flashback::User>(*m_user); }));
-    EXPECT_CALL(*m_mock_database, get_assessments(A<uint64_t>(), A<uint64_t>(), An<flashback::expertise_level>(), A<uint64_t>())).Times(1).WillOnce(Return(assessments));
+    EXPECT_CALL(*m_mock_database, get_assessments(A<uint64_t>(), A<uint64_t>(), An<flashback::expertise_level>(), A<uint64_t>(), A<uint64_t>(), A<uint64_t>(),
+                                                  A<google::protobuf::RepeatedPtrField<flashback::Assessment>&>())).Times(1).WillOnce(
+        Invoke([&assessments](uint64_t, uint64_t, flashback::expertise_level, uint64_t, uint64_t, uint64_t, google::protobuf::RepeatedPtrField<flashback::Assessment>& matched) {
+            matched.Add(assessments.begin(), assessments.end());
+        }));
 
     request.clear_user();
     EXPECT_NO_THROW(status = m_server->GetAssessments(&context, &request, &response));
@@ -2913,6 +3447,97 @@ TEST_F(test_server, IsAssimilated)
     EXPECT_THAT(status.error_message(), IsEmpty());
 }
 
+TEST_F(test_server, IsAssimilatedFromState)
+{
+    grpc::Status status{};
+    grpc::ServerContext context{};
+    flashback::IsAssimilatedRequest request{};
+    flashback::IsAssimilatedResponse response{};
+    flashback::MakeProgressRequest progress_request{};
+    flashback::MakeProgressResponse progress_response{};
+
+    EXPECT_CALL(*m_mock_database, get_user(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Invoke([this]() { return std::make_unique<flashback::User>(*m_user); }));
+    EXPECT_CALL(*m_mock_database, user_is_authorized(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Return(true));
+    EXPECT_CALL(*m_mock_database, user_is_verified(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Return(true));
+    EXPECT_CALL(*m_mock_database, make_progress(A<uint64_t>(), A<uint64_t>(), An<flashback::expertise_level>(), A<uint64_t>(), A<uint64_t>())).Times(1);
+    EXPECT_CALL(*m_mock_database, is_assimilated(A<uint64_t>(), A<uint64_t>(), An<flashback::expertise_level>(), A<uint64_t>())).Times(2).WillOnce(Return(false)).WillOnce(Return(true));
+
+    *request.mutable_user() = *m_user;
+    request.mutable_subject()->set_id(1);
+    request.mutable_topic()->set_position(1);
+    request.mutable_topic()->set_level(flashback::expertise_level::depth);
+    EXPECT_NO_THROW(status = m_server->IsAssimilated(&context, &request, &response));
+    EXPECT_THAT(status.ok(), IsTrue());
+    EXPECT_NO_THROW(status = m_server->IsAssimilated(&context, &request, &response));
+    EXPECT_THAT(status.ok(), IsTrue());
+    EXPECT_THAT(response.is_assimilated(), IsFalse()) << "Repeated checks should be answered from memory";
+
+    *progress_request.mutable_user() = *m_user;
+    progress_request.mutable_milestone()->set_id(1);
+    progress_request.mutable_card()->set_id(1);
+    progress_request.set_duration(100);
+    EXPECT_NO_THROW(status = m_server->MakeProgress(&context, &progress_request, &progress_response));
+    EXPECT_THAT(status.ok(), IsTrue());
+
+    EXPECT_NO_THROW(status = m_server->IsAssimilated(&context, &request, &response));
+    EXPECT_THAT(status.ok(), IsTrue());
+    EXPECT_THAT(response.is_assimilated(), IsTrue()) << "Progress should be reflected in the next check";
+}
+
+TEST_F(test_server, GetSubjectCoverage)
+{
+    grpc::Status status{};
+    grpc::ServerContext context{};
+    flashback::GetSubjectCoverageRequest request{};
+    flashback::GetSubjectCoverageResponse response{};
+    flashback::DiminishAssessmentRequest diminish_request{};
+    flashback::DiminishAssessmentResponse diminish_response{};
+    flashback::TopicCoverage topic{};
+    topic.mutable_topic()->set_position(1);
+    topic.mutable_topic()->set_level(flashback::expertise_level::surface);
+    topic.add_assessment()->set_id(1);
+    topic.add_assessment()->set_id(2);
+
+    EXPECT_CALL(*m_mock_database, get_user(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Invoke([this]() { return std::make_unique<flashback::User>(*m_user); }));
+    EXPECT_CALL(*m_mock_database, user_is_authorized(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Return(true));
+    EXPECT_CALL(*m_mock_database, user_is_verified(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Return(true));
+    EXPECT_CALL(*m_mock_database, get_subject_coverage(A<uint64_t>())).Times(1).WillOnce(Return(std::vector<flashback::TopicCoverage>{topic}));
+    EXPECT_CALL(*m_mock_database, diminish_assessment(A<uint64_t>(), A<uint64_t>(), An<flashback::expertise_level>(), A<uint64_t>())).Times(1);
+
+    EXPECT_NO_THROW(status = m_server->GetSubjectCoverage(&context, &request, &response));
+    EXPECT_THAT(status.ok(), IsFalse());
+    EXPECT_THAT(status.error_code(), Eq(grpc::StatusCode::UNAUTHENTICATED));
+
+    *request.mutable_user() = *m_user;
+    EXPECT_NO_THROW(status = m_server->GetSubjectCoverage(&context, &request, &response));
+    EXPECT_THAT(status.ok(), IsFalse());
+    EXPECT_THAT(status.error_code(), Eq(grpc::StatusCode::INVALID_ARGUMENT));
+
+    request.mutable_subject()->set_id(1);
+    EXPECT_NO_THROW(status = m_server->GetSubjectCoverage(&context, &request, &response));
+    EXPECT_THAT(status.ok(), IsTrue());
+    ASSERT_THAT(response.topic(), SizeIs(1));
+    EXPECT_THAT(response.topic(0).assessment(), SizeIs(2));
+    ASSERT_THAT(response.assessment(), SizeIs(2));
+    EXPECT_THAT(response.assessment(0).coverage(), Eq(1));
+
+    *diminish_request.mutable_user() = *m_user;
+    diminish_request.mutable_card()->set_id(1);
+    diminish_request.mutable_subject()->set_id(1);
+    diminish_request.mutable_topic()->set_position(1);
+    diminish_request.mutable_topic()->set_level(flashback::expertise_level::surface);
+    EXPECT_NO_THROW(status = m_server->DiminishAssessment(&context, &diminish_request, &diminish_response));
+    EXPECT_THAT(status.ok(), IsTrue());
+
+    response.Clear();
+    EXPECT_NO_THROW(status = m_server->GetSubjectCoverage(&context, &request, &response));
+    EXPECT_THAT(status.ok(), IsTrue());
+    ASSERT_THAT(response.topic(), SizeIs(1));
+    EXPECT_THAT(response.topic(0).assessment(), SizeIs(1)) << "Diminished assessments should be updated in memory without reloading the subject";
+    ASSERT_THAT(response.assessment(), SizeIs(2));
+    EXPECT_THAT(response.assessment(0).coverage(), Eq(0));
+}
+
 TEST_F(test_server, EditCard)
 {
     grpc::Status status{};
@@ -3000,7 +3625,6 @@ TEST_F(test_server, GetBlocks)
     flashback::GetBlocksResponse response{};
     flashback::Card card{};
     flashback::Block block{};
-    std::map<uint64_t, flashback::Block> blocks{};
 
     auto constexpr headline{"Is it worth criticizing it?"};
     auto constexpr state{flashback::Card::draft};
@@ -3016,10 +3640,10 @@ TEST_F(test_server, GetBlocks)
     block.set_extension(extension);
     block.set_content(content);
     block.set_metadata(metadata);
-    blocks.insert({block.position(), block});
 
     EXPECT_CALL(*m_mock_database, get_user(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Invoke([this]() { return std::make_unique<flashback::User>(*m_user); }));
-    EXPECT_CALL(*m_mock_database, get_blocks(A<uint64_t>())).Times(1).WillOnce(Return(blocks));
+    EXPECT_CALL(*m_mock_database, get_blocks(A<uint64_t>(), A<google::protobuf::RepeatedPtrField<flashback::Block>&>())).Times(1).WillOnce(
+        Invoke([&block](uint64_t, google::protobuf::RepeatedPtrField<flashback::Block>& blocks) { *blocks.Add() = block; }));
 
     request.clear_user();
     EXPECT_NO_THROW(status = m_server->GetBlocks(&context, &request, &response));
@@ -3033,6 +3657,8 @@ TEST_F(test_server, GetBlocks)
     EXPECT_NO_THROW(status = m_server->GetBlocks(&context, &request, &response));
     EXPECT_THAT(status.ok(), IsTrue());
     EXPECT_THAT(status.error_message(), IsEmpty());
+    EXPECT_THAT(response.block(), SizeIs(1));
+    EXPECT_THAT(response.block(0).content(), Eq(content));
 }
 
 TEST_F(test_server, RemoveBlock)
@@ -3191,6 +3817,84 @@ TEST_F(test_server, ReorderBlock)
     EXPECT_THAT(status.error_message(), IsEmpty());
 }
 
+TEST_F(test_server, ApplyBlockOrdering)
+{
+    grpc::Status status{};
+    grpc::ServerContext context{};
+    flashback::ApplyBlockOrderingRequest request{};
+    flashback::ApplyBlockOrderingResponse response{};
+
+    EXPECT_CALL(*m_mock_database, get_user(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Invoke([this]() { return std::make_unique<flashback::User>(*m_user); }));
+    EXPECT_CALL(*m_mock_database, user_is_verified(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Return(true));
+    EXPECT_CALL(*m_mock_database, user_is_authorized(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Return(true));
+    EXPECT_CALL(*m_mock_database, apply_block_ordering(1, std::vector<uint64_t>{3, 1, 2})).Times(1);
+
+    *request.mutable_user() = *m_user;
+    request.mutable_card()->set_id(1);
+    request.add_position(3);
+    request.add_position(1);
+    request.add_position(3);
+    EXPECT_NO_THROW(status = m_server->ApplyBlockOrdering(&context, &request, &response));
+    EXPECT_THAT(status.ok(), IsFalse());
+    EXPECT_THAT(status.error_code(), Eq(grpc::StatusCode::INVALID_ARGUMENT)) << "Repeated positions should not reach the database";
+
+    request.set_position(2, 2);
+    EXPECT_NO_THROW(status = m_server->ApplyBlockOrdering(&context, &request, &response));
+    EXPECT_THAT(status.ok(), IsTrue());
+    EXPECT_THAT(status.error_message(), IsEmpty());
+}
+
+TEST_F(test_server, ApplyCardEdits)
+{
+    grpc::Status status{};
+    grpc::ServerContext context{};
+    flashback::ApplyCardEditsRequest request{};
+    flashback::ApplyCardEditsResponse response{};
+
+    EXPECT_CALL(*m_mock_database, get_user(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Invoke([this]() { return std::make_unique<flashback::User>(*m_user); }));
+    EXPECT_CALL(*m_mock_database, user_is_verified(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Return(true));
+    EXPECT_CALL(*m_mock_database, user_is_authorized(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Return(true));
+    EXPECT_CALL(*m_mock_database, apply_card_edits(1, A<google::protobuf::RepeatedPtrField<flashback::CardEdit> const&>(),
+                                                   A<google::protobuf::RepeatedPtrField<flashback::Block>&>())).Times(1).WillOnce(
+        Invoke([](uint64_t, google::protobuf::RepeatedPtrField<flashback::CardEdit> const& edits, google::protobuf::RepeatedPtrField<flashback::Block>& blocks) {
+            EXPECT_THAT(edits, SizeIs(3));
+            blocks.Add()->set_position(1);
+            blocks.Add()->set_position(2);
+        }));
+
+    *request.mutable_user() = *m_user;
+    request.mutable_card()->set_id(1);
+    flashback::CardEdit* headline{request.add_edit()};
+    headline->set_type(flashback::CardEdit::edit_card);
+    headline->mutable_card()->set_headline("Is it worth criticizing it?");
+    flashback::CardEdit* creation{request.add_edit()};
+    creation->set_type(flashback::CardEdit::create_block);
+    creation->mutable_block()->set_content("auto main() -> int { }");
+    creation->mutable_block()->set_extension("cpp");
+    flashback::CardEdit* merge{request.add_edit()};
+    merge->set_type(flashback::CardEdit::merge_blocks);
+    merge->mutable_block()->set_position(1);
+
+    EXPECT_NO_THROW(status = m_server->ApplyCardEdits(&context, &request, &response));
+    EXPECT_THAT(status.ok(), IsFalse());
+    EXPECT_THAT(status.error_code(), Eq(grpc::StatusCode::INVALID_ARGUMENT)) << "Merging without a target should refuse the whole batch";
+
+    merge->mutable_target()->set_position(2);
+    headline->clear_type();
+    EXPECT_NO_THROW(status = m_server->ApplyCardEdits(&context, &request, &response));
+    EXPECT_THAT(status.error_code(), Eq(grpc::StatusCode::INVALID_ARGUMENT)) << "Edits without an operation should not default to editing the headline";
+
+    headline->set_type(flashback::CardEdit::edit_card);
+    headline->mutable_card()->clear_headline();
+    EXPECT_NO_THROW(status = m_server->ApplyCardEdits(&context, &request, &response));
+    EXPECT_THAT(status.error_code(), Eq(grpc::StatusCode::INVALID_ARGUMENT)) << "Headlines should not be wiped by a batch";
+
+    headline->mutable_card()->set_headline("Is it worth criticizing it?");
+    EXPECT_NO_THROW(status = m_server->ApplyCardEdits(&context, &request, &response));
+    EXPECT_THAT(status.ok(), IsTrue());
+    EXPECT_THAT(response.block(), SizeIs(2));
+}
+
 TEST_F(test_server, MergeBlocks)
 {
     grpc::Status status{};
@@ -3341,6 +4045,94 @@ TEST_F(test_server, Study)
     EXPECT_THAT(status.error_message(), IsEmpty());
 }
 
+TEST_F(test_server, EstimateSessionTime)
+{
+    grpc::Status status{};
+    grpc::ServerContext context{};
+    flashback::EstimateSessionTimeRequest request{};
+    flashback::EstimateSessionTimeResponse response{};
+    flashback::StudyRequest study_request{};
+    flashback::StudyResponse study_response{};
+
+    EXPECT_CALL(*m_mock_database, get_user(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Invoke([this]() { return std::make_unique<flashback::User>(*m_user); }));
+    EXPECT_CALL(*m_mock_database, user_is_authorized(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Return(true));
+    EXPECT_CALL(*m_mock_database, study(A<uint64_t>(), A<uint64_t>(), A<std::chrono::seconds>())).Times(2);
+    EXPECT_CALL(*m_mock_database, get_topic_cards(A<uint64_t>(), A<uint64_t>(), An<flashback::expertise_level>(), A<google::protobuf::RepeatedPtrField<flashback::Card>&>()))
+        .Times(1)
+        .WillOnce(Invoke([](uint64_t, uint64_t, flashback::expertise_level, google::protobuf::RepeatedPtrField<flashback::Card>& cards) {
+            cards.Add()->set_id(1);
+            cards.Add()->set_id(2);
+        }));
+
+    *request.mutable_user() = *m_user;
+    EXPECT_NO_THROW(status = m_server->EstimateSessionTime(&context, &request, &response));
+    EXPECT_THAT(status.ok(), IsFalse());
+    EXPECT_THAT(status.error_code(), Eq(grpc::StatusCode::INVALID_ARGUMENT));
+
+    request.mutable_milestone()->set_id(1);
+    EXPECT_NO_THROW(status = m_server->EstimateSessionTime(&context, &request, &response));
+    EXPECT_THAT(status.ok(), IsFalse());
+    EXPECT_THAT(status.error_code(), Eq(grpc::StatusCode::INVALID_ARGUMENT)) << "Either a topic or a roadmap should be given";
+
+    *study_request.mutable_user() = *m_user;
+    study_request.mutable_card()->set_id(1);
+    study_request.set_duration(40);
+    EXPECT_NO_THROW(status = m_server->Study(&context, &study_request, &study_response));
+    EXPECT_THAT(status.ok(), IsTrue());
+    study_request.set_duration(60);
+    EXPECT_NO_THROW(status = m_server->Study(&context, &study_request, &study_response));
+    EXPECT_THAT(status.ok(), IsTrue());
+
+    request.mutable_topic()->set_position(1);
+    EXPECT_NO_THROW(status = m_server->EstimateSessionTime(&context, &request, &response));
+    EXPECT_THAT(status.ok(), IsTrue());
+    EXPECT_THAT(response.cards(), Eq(2));
+    EXPECT_THAT(response.measured_cards(), Eq(1));
+    EXPECT_THAT(response.duration(), Eq(100)) << "Cards never studied should be estimated from durations of all cards";
+}
+
+TEST_F(test_server, GetStudyHistory)
+{
+    grpc::Status status{};
+    grpc::ServerContext context{};
+    flashback::GetStudyHistoryRequest request{};
+    flashback::GetStudyHistoryResponse response{};
+    flashback::StudyRequest study_request{};
+    flashback::StudyResponse study_response{};
+
+    EXPECT_CALL(*m_mock_database, get_user(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Invoke([this]() { return std::make_unique<flashback::User>(*m_user); }));
+    EXPECT_CALL(*m_mock_database, user_is_authorized(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Return(true));
+    EXPECT_CALL(*m_mock_database, study(A<uint64_t>(), A<uint64_t>(), A<std::chrono::seconds>())).Times(2);
+
+    EXPECT_NO_THROW(status = m_server->GetStudyHistory(&context, &request, &response));
+    EXPECT_THAT(status.ok(), IsFalse());
+    EXPECT_THAT(status.error_code(), Eq(grpc::StatusCode::UNAUTHENTICATED));
+
+    *request.mutable_user() = *m_user;
+    request.set_since(200);
+    request.set_until(100);
+    EXPECT_NO_THROW(status = m_server->GetStudyHistory(&context, &request, &response));
+    EXPECT_THAT(status.ok(), IsFalse());
+    EXPECT_THAT(status.error_code(), Eq(grpc::StatusCode::INVALID_ARGUMENT));
+
+    *study_request.mutable_user() = *m_user;
+    study_request.mutable_card()->set_id(1);
+    study_request.set_duration(40);
+    EXPECT_NO_THROW(status = m_server->Study(&context, &study_request, &study_response));
+    EXPECT_THAT(status.ok(), IsTrue());
+    EXPECT_NO_THROW(status = m_server->Study(&context, &study_request, &study_response));
+    EXPECT_THAT(status.ok(), IsTrue());
+
+    request.set_since(0);
+    request.set_until(0);
+    request.set_granularity(flashback::history_granularity::daily);
+    EXPECT_NO_THROW(status = m_server->GetStudyHistory(&context, &request, &response));
+    EXPECT_THAT(status.ok(), IsTrue());
+    ASSERT_THAT(response.history(), SizeIs(1));
+    EXPECT_THAT(response.history(0).cards(), Eq(2));
+    EXPECT_THAT(response.history(0).duration(), Eq(80));
+}
+
 TEST_F(test_server, MakeProgress)
 {
     grpc::Status status{};
@@ -3376,6 +4168,52 @@ TEST_F(test_server, MakeProgress)
     EXPECT_THAT(status.error_message(), IsEmpty());
 }
 
+TEST_F(test_server, SubmitStudyEvents)
+{
+    grpc::Status status{};
+    grpc::ServerContext context{};
+    flashback::SubmitStudyEventsRequest request{};
+    flashback::SubmitStudyEventsResponse response{};
+    std::vector<flashback::progress_event> recorded{};
+    flashback::StudyEvent* event{};
+
+    EXPECT_CALL(*m_mock_database, get_user(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Invoke([this]() { return std::make_unique<flashback::User>(*m_user); }));
+    EXPECT_CALL(*m_mock_database, user_is_authorized(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Return(true));
+    EXPECT_CALL(*m_mock_database, user_is_verified(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Return(true));
+    EXPECT_CALL(*m_mock_database, record_progress(A<std::vector<flashback::progress_event> const&>())).Times(1).WillOnce(Invoke([&recorded](std::vector<flashback::progress_event> const& events) { recorded = events; }));
+
+    request.clear_user();
+    EXPECT_NO_THROW(status = m_server->SubmitStudyEvents(&context, &request, &response));
+    EXPECT_THAT(status.ok(), IsFalse());
+    EXPECT_THAT(status.error_code(), Eq(grpc::StatusCode::UNAUTHENTICATED));
+
+    *request.mutable_user() = *m_user;
+    EXPECT_NO_THROW(status = m_server->SubmitStudyEvents(&context, &request, &response));
+    EXPECT_THAT(status.error_code(), Eq(grpc::StatusCode::INVALID_ARGUMENT)) << "Empty submissions should be rejected";
+
+    event = request.add_events();
+    event->mutable_card()->set_id(1);
+    event->set_duration(2);
+    event->set_timestamp(200);
+    EXPECT_NO_THROW(status = m_server->SubmitStudyEvents(&context, &request, &response));
+    EXPECT_THAT(status.error_code(), Eq(grpc::StatusCode::INVALID_ARGUMENT)) << "Every event should be validated";
+
+    event->set_duration(20);
+    event = request.add_events();
+    event->mutable_card()->set_id(2);
+    event->mutable_milestone()->set_id(3);
+    event->mutable_milestone()->set_level(flashback::expertise_level::depth);
+    event->set_duration(30);
+    event->set_timestamp(100);
+    EXPECT_NO_THROW(status = m_server->SubmitStudyEvents(&context, &request, &response));
+    EXPECT_THAT(status.ok(), IsTrue());
+    EXPECT_THAT(status.error_message(), IsEmpty());
+    EXPECT_THAT(recorded, ContainerEq(std::vector<flashback::progress_event>{
+        flashback::progress_event{flashback::progress_event::kind::practice, m_user->id(), 2, 3, flashback::expertise_level::depth, 30, 100},
+        flashback::progress_event{flashback::progress_event::kind::study, m_user->id(), 1, 0, flashback::expertise_level::surface, 20, 200},
+    })) << "Events should be recorded once, in the order they happened";
+}
+
 TEST_F(test_server, GetProgressWeight)
 {
     grpc::Status status{};
@@ -3406,6 +4244,43 @@ TEST_F(test_server, GetProgressWeight)
     EXPECT_THAT(status.error_message(), IsEmpty());
 }
 
+TEST_F(test_server, GetProgressWeightFromCache)
+{
+    grpc::Status status{};
+    grpc::ServerContext context{};
+    flashback::GetProgressWeightRequest request{};
+    flashback::GetProgressWeightResponse response{};
+    flashback::StudyRequest study_request{};
+    flashback::StudyResponse study_response{};
+    std::vector<flashback::Weight> weights(1);
+    weights.front().mutable_resource()->set_id(1);
+    weights.front().set_percentage(42);
+
+    EXPECT_CALL(*m_mock_database, get_user(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Invoke([this]() { return std::make_unique<flashback::User>(*m_user); }));
+    EXPECT_CALL(*m_mock_database, user_is_authorized(A<std::string_view>(), A<std::string_view>())).WillRepeatedly(Return(true));
+    EXPECT_CALL(*m_mock_database, study(A<uint64_t>(), A<uint64_t>(), A<std::chrono::seconds>())).Times(1);
+    EXPECT_CALL(*m_mock_database, get_progress_weight(A<uint64_t>())).Times(2).WillRepeatedly(Return(weights));
+
+    *request.mutable_user() = *m_user;
+    EXPECT_NO_THROW(status = m_server->GetProgressWeight(&context, &request, &response));
+    EXPECT_THAT(status.ok(), IsTrue());
+    EXPECT_NO_THROW(status = m_server->GetProgressWeight(&context, &request, &response));
+    EXPECT_THAT(status.ok(), IsTrue());
+    EXPECT_THAT(response.weight(), SizeIs(2)) << "Repeated calls should be served from the cache";
+
+    *study_request.mutable_user() = *m_user;
+    study_request.mutable_card()->set_id(1);
+    study_request.set_duration(100);
+    EXPECT_NO_THROW(status = m_server->Study(&context, &study_request, &study_response));
+    EXPECT_THAT(status.ok(), IsTrue());
+
+    response.clear_weight();
+    EXPECT_NO_THROW(status = m_server->GetProgressWeight(&context, &request, &response));
+    EXPECT_THAT(status.ok(), IsTrue()) << "Studying should refresh the weights of the user";
+    ASSERT_THAT(response.weight(), SizeIs(1));
+    EXPECT_THAT(response.weight(0).percentage(), Eq(42));
+}
+
 TEST_F(test_server, GetSectionCards)
 {
 }
@@ -0,0 +1,190 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <types.pb.h>
+#include <flashback/study_history.hpp>
+
+using testing::Eq;
+using testing::SizeIs;
+using testing::IsEmpty;
+using namespace std::chrono_literals;
+
+class test_study_history: public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        m_directory = std::filesystem::temp_directory_path() / "flashback-history" / testing::UnitTest::GetInstance()->current_test_info()->name();
+        std::filesystem::remove_all(m_directory);
+        m_path = m_directory / "study-history";
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(m_directory);
+    }
+
+protected:
+    // a monday
+    static constexpr std::chrono::sys_days first_day{std::chrono::year{2025} / std::chrono::January / 6};
+
+    std::filesystem::path m_directory;
+    std::filesystem::path m_path;
+};
+
+TEST_F(test_study_history, roll_up_days)
+{
+    flashback::study_history history{{}, 16, 5min};
+    google::protobuf::RepeatedPtrField<flashback::StudyHistory> points{};
+
+    history.record(1, 2, flashback::expertise_level::depth, first_day, 30);
+    history.record(1, 2, flashback::expertise_level::depth, first_day, 20);
+    history.record(1, 2, flashback::expertise_level::depth, first_day + std::chrono::days{2}, 10);
+    history.record(1, 0, flashback::expertise_level::surface, first_day + std::chrono::days{1}, 40);
+    history.record(2, 2, flashback::expertise_level::depth, first_day, 99);
+
+    history.collect(1, first_day, first_day + std::chrono::days{30}, flashback::history_granularity::daily, points);
+    ASSERT_THAT(points, SizeIs(3));
+    EXPECT_THAT(points.at(0).timestamp(), Eq(std::chrono::sys_seconds{first_day}.time_since_epoch().count()));
+    EXPECT_THAT(points.at(0).subject().id(), Eq(2));
+    EXPECT_THAT(points.at(0).cards(), Eq(2));
+    EXPECT_THAT(points.at(0).duration(), Eq(50));
+    EXPECT_THAT(points.at(1).has_subject(), Eq(false)) << "Plain studying should not be attributed to a subject";
+    EXPECT_THAT(points.at(2).duration(), Eq(10));
+
+    points.Clear();
+    history.collect(1, first_day + std::chrono::days{1}, first_day + std::chrono::days{1}, flashback::history_granularity::daily, points);
+    ASSERT_THAT(points, SizeIs(1)) << "Days outside of the range should not be collected";
+    EXPECT_THAT(points.at(0).duration(), Eq(40));
+
+    points.Clear();
+    history.collect(3, first_day, first_day + std::chrono::days{30}, flashback::history_granularity::daily, points);
+    EXPECT_THAT(points, IsEmpty());
+}
+
+TEST_F(test_study_history, group_by_period)
+{
+    flashback::study_history history{{}, 16, 5min};
+    google::protobuf::RepeatedPtrField<flashback::StudyHistory> points{};
+
+    for (int day{}; day < 60; ++day)
+    {
+        history.record(1, 2, flashback::expertise_level::surface, first_day + std::chrono::days{day}, 10);
+    }
+
+    history.collect(1, first_day, first_day + std::chrono::days{59}, flashback::history_granularity::weekly, points);
+    ASSERT_THAT(points, SizeIs(9));
+    EXPECT_THAT(points.at(0).cards(), Eq(7));
+    EXPECT_THAT(points.at(8).cards(), Eq(4));
+
+    points.Clear();
+    history.collect(1, first_day, first_day + std::chrono::days{59}, flashback::history_granularity::monthly, points);
+    ASSERT_THAT(points, SizeIs(3));
+    EXPECT_THAT(points.at(0).timestamp(), Eq(std::chrono::sys_seconds{std::chrono::sys_days{std::chrono::year{2025} / std::chrono::January / 1}}.time_since_epoch().count()));
+    EXPECT_THAT(points.at(0).cards(), Eq(26));
+    EXPECT_THAT(points.at(1).cards(), Eq(28));
+    EXPECT_THAT(points.at(2).cards(), Eq(6));
+}
+
+TEST_F(test_study_history, record_late_events)
+{
+    flashback::study_history history{{}, 16, 5min};
+    google::protobuf::RepeatedPtrField<flashback::StudyHistory> points{};
+
+    history.record(1, 2, flashback::expertise_level::surface, first_day, 10);
+    history.record(1, 2, flashback::expertise_level::surface, first_day + std::chrono::days{4}, 10);
+    history.record(1, 2, flashback::expertise_level::surface, first_day + std::chrono::days{2}, 10);
+    history.record(1, 2, flashback::expertise_level::surface, first_day, 10);
+
+    history.collect(1, first_day, first_day + std::chrono::days{4}, flashback::history_granularity::daily, points);
+    ASSERT_THAT(points, SizeIs(3)) << "Events of offline sessions arriving late should land on their own day";
+    EXPECT_THAT(points.at(0).cards(), Eq(2));
+    EXPECT_THAT(points.at(1).cards(), Eq(1));
+    EXPECT_THAT(points.at(2).cards(), Eq(1));
+}
+
+TEST_F(test_study_history, restore_saved_history)
+{
+    google::protobuf::RepeatedPtrField<flashback::StudyHistory> points{};
+
+    {
+        flashback::study_history history{m_path, 16, 5min};
+        history.record(1, 2, flashback::expertise_level::origin, first_day, 10);
+        history.record(1, 2, flashback::expertise_level::origin, first_day + std::chrono::days{300}, 20);
+        history.record(1, 3, flashback::expertise_level::surface, first_day, 30);
+    }
+
+    ASSERT_THAT(std::filesystem::exists(m_path / "1.history"), Eq(true));
+
+    {
+        flashback::study_history history{m_path, 16, 5min};
+        history.collect(1, first_day, first_day + std::chrono::days{300}, flashback::history_granularity::daily, points);
+        ASSERT_THAT(points, SizeIs(3));
+        EXPECT_THAT(points.at(2).level(), Eq(flashback::expertise_level::origin));
+        EXPECT_THAT(points.at(2).duration(), Eq(20));
+    }
+
+    std::ofstream{m_path / "1.history", std::ios::binary | std::ios::trunc} << "damaged";
+    flashback::study_history history{m_path, 16, 5min};
+    points.Clear();
+    history.collect(1, first_day, first_day + std::chrono::days{300}, flashback::history_granularity::daily, points);
+    EXPECT_THAT(points, IsEmpty()) << "Damaged snapshots should be ignored rather than stop the server";
+}
+
+TEST_F(test_study_history, save_in_background)
+{
+    flashback::study_history history{m_path, 16, 10ms};
+    history.record(1, 2, flashback::expertise_level::surface, first_day, 10);
+
+    for (int attempt{}; attempt < 200 && !std::filesystem::exists(m_path / "1.history"); ++attempt)
+    {
+        std::this_thread::sleep_for(10ms);
+    }
+
+    EXPECT_THAT(std::filesystem::exists(m_path / "1.history"), Eq(true)) << "Recorded history should be saved without waiting for the next record or shutdown";
+}
+
+TEST_F(test_study_history, evict_saved_users)
+{
+    flashback::study_history history{m_path, 2, 5min};
+    google::protobuf::RepeatedPtrField<flashback::StudyHistory> points{};
+
+    for (uint64_t user{1}; user <= 4; ++user)
+    {
+        history.record(user, 2, flashback::expertise_level::surface, first_day, user * 10);
+    }
+
+    EXPECT_THAT(std::filesystem::exists(m_path), Eq(false)) << "Modified users should stay resident until they are saved";
+
+    history.save();
+    ASSERT_THAT(std::filesystem::exists(m_path / "4.history"), Eq(true));
+
+    for (uint64_t user{1}; user <= 4; ++user)
+    {
+        points.Clear();
+        history.collect(user, first_day, first_day, flashback::history_granularity::daily, points);
+        ASSERT_THAT(points, SizeIs(1)) << "Evicted users should be read back from their file";
+        EXPECT_THAT(points.at(0).duration(), Eq(user * 10));
+    }
+}
+
+TEST_F(test_study_history, save_modified_users)
+{
+    flashback::study_history history{m_path, 16, 5min};
+    history.record(1, 2, flashback::expertise_level::surface, first_day, 10);
+    history.record(2, 2, flashback::expertise_level::surface, first_day, 10);
+    history.save();
+
+    auto const untouched{std::filesystem::last_write_time(m_path / "2.history")};
+    std::filesystem::remove(m_path / "1.history");
+    history.save();
+    EXPECT_THAT(std::filesystem::exists(m_path / "1.history"), Eq(false)) << "Users saved already should not be written again";
+
+    history.record(1, 2, flashback::expertise_level::surface, first_day, 10);
+    history.save();
+    EXPECT_THAT(std::filesystem::exists(m_path / "1.history"), Eq(true));
+    EXPECT_THAT(std::filesystem::last_write_time(m_path / "2.history"), Eq(untouched)) << "Only the modified user should be written";
+}
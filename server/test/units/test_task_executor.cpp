@@ -0,0 +1,56 @@
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <flashback/task_executor.hpp>
+
+using testing::Eq;
+using testing::Ne;
+
+TEST(task_executor, run_off_the_caller)
+{
+    flashback::task_executor executor{2};
+    std::promise<std::thread::id> worker{};
+    std::future<std::thread::id> ran{worker.get_future()};
+
+    executor.submit([&worker] { worker.set_value(std::this_thread::get_id()); });
+    EXPECT_THAT(ran.get(), Ne(std::this_thread::get_id())) << "Tasks should not block the submitting thread";
+}
+
+TEST(task_executor, drain_on_destruction)
+{
+    std::atomic<int> runs{};
+
+    {
+        flashback::task_executor executor{1};
+        std::promise<void> release{};
+        std::shared_future<void> released{release.get_future()};
+
+        // the only worker is held until every task is queued, so they are all still pending when the executor goes away
+        executor.submit([released] { released.wait(); });
+
+        for (int task{}; task < 16; ++task)
+        {
+            executor.submit([&runs] { ++runs; });
+        }
+
+        release.set_value();
+    }
+
+    EXPECT_THAT(runs.load(), Eq(16)) << "Queued tasks should run before the executor is destroyed";
+}
+
+TEST(task_executor, survive_failing_tasks)
+{
+    std::atomic<int> runs{};
+
+    {
+        flashback::task_executor executor{1};
+        executor.submit([] { throw std::runtime_error{"database is gone"}; });
+        executor.submit([&runs] { ++runs; });
+    }
+
+    EXPECT_THAT(runs.load(), Eq(1)) << "A throwing task should not take its worker down";
+}
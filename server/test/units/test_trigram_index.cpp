@@ -0,0 +1,101 @@
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <types.pb.h>
+#include <flashback/trigram_index.hpp>
+
+using testing::Eq;
+using testing::IsEmpty;
+using testing::SizeIs;
+using testing::ElementsAre;
+
+namespace
+{
+flashback::Provider make_provider(uint64_t const id, std::string const& name)
+{
+    flashback::Provider provider{};
+    provider.set_id(id);
+    provider.set_name(name);
+    return provider;
+}
+
+std::vector<uint64_t> ids(std::vector<flashback::Provider> const& providers)
+{
+    std::vector<uint64_t> identifiers{};
+
+    for (flashback::Provider const& provider: providers)
+    {
+        identifiers.push_back(provider.id());
+    }
+
+    return identifiers;
+}
+
+flashback::trigram pack(char const (&gram)[4])
+{
+    return static_cast<flashback::trigram>(static_cast<unsigned char>(gram[0])) << 16 | static_cast<unsigned char>(gram[1]) << 8 | static_cast<unsigned char>(gram[2]);
+}
+} // namespace
+
+TEST(trigram_index, extract_padded_words)
+{
+    EXPECT_THAT(flashback::extract_trigrams("Doe"), ElementsAre(pack("  d"), pack(" do"), pack("doe"), pack("oe ")));
+    EXPECT_THAT(flashback::extract_trigrams("doe, DOE!"), SizeIs(4)) << "Case and punctuation should not produce distinct trigrams";
+    EXPECT_THAT(flashback::extract_trigrams("a b"), SizeIs(4));
+    EXPECT_THAT(flashback::extract_trigrams(" .,; "), IsEmpty());
+}
+
+TEST(trigram_index, rank_by_similarity)
+{
+    flashback::trigram_index<flashback::Provider> index{};
+    index.assign({make_provider(1, "Brian Salehi"), make_provider(2, "John Doe"), make_provider(3, "Jane Doe"), make_provider(4, "Doe")});
+
+    EXPECT_THAT(index.size(), Eq(4));
+    EXPECT_THAT(ids(index.search("Doe", 10, 0)), ElementsAre(4, 2, 3)) << "Exact match first, equal scores ordered by id";
+    EXPECT_THAT(ids(index.search("brian", 10, 0)), ElementsAre(1));
+    EXPECT_THAT(index.search("Prompt Engineering", 10, 0), IsEmpty());
+    EXPECT_THAT(index.search("", 10, 0), IsEmpty());
+}
+
+TEST(trigram_index, page_through_matches)
+{
+    flashback::trigram_index<flashback::Provider> index{};
+    index.assign({make_provider(1, "Provider 1"), make_provider(2, "Provider 2"), make_provider(3, "Provider 3")});
+
+    EXPECT_THAT(ids(index.search("provider", 2, 0)), ElementsAre(1, 2));
+    EXPECT_THAT(ids(index.search("provider", 2, 2)), ElementsAre(3));
+    EXPECT_THAT(index.search("provider", 2, 4), IsEmpty());
+}
+
+TEST(trigram_index, follow_mutations)
+{
+    flashback::trigram_index<flashback::Provider> index{};
+    index.assign({make_provider(1, "John Doe"), make_provider(2, "Jane Doe")});
+
+    index.upsert(make_provider(1, "Brian Salehi"));
+    EXPECT_THAT(ids(index.search("Doe", 10, 0)), ElementsAre(2)) << "Previous name should no longer match after renaming";
+    EXPECT_THAT(ids(index.search("Salehi", 10, 0)), ElementsAre(1));
+
+    index.erase(2);
+    EXPECT_THAT(index.search("Doe", 10, 0), IsEmpty());
+    EXPECT_THAT(index.size(), Eq(1));
+
+    index.upsert(make_provider(3, "Jane Doe"));
+    EXPECT_THAT(ids(index.search("Doe", 10, 0)), ElementsAre(3)) << "Released slots should be reusable by new entries";
+    EXPECT_THAT(index.size(), Eq(2)) << "Renamed entries should replace rather than duplicate their previous name";
+}
+
+TEST(trigram_index, match_inside_names)
+{
+    flashback::trigram_index<flashback::Provider> index{};
+    EXPECT_THAT(index.loaded(), testing::IsFalse()) << "An index should not answer searches before its catalog is assigned";
+    index.assign({make_provider(1, "Calculus"), make_provider(2, "Linear Algebra"), make_provider(3, "Lua")});
+
+    EXPECT_THAT(index.loaded(), testing::IsTrue());
+    EXPECT_THAT(ids(index.search("lus", 10, 0)), ElementsAre(1)) << "Short tokens should keep matching inside names";
+    EXPECT_THAT(ids(index.search("alculu", 10, 0)), ElementsAre(1));
+    EXPECT_THAT(ids(index.search("LU", 10, 0)), ElementsAre(3, 1)) << "Names starting with the token should rank first";
+    EXPECT_THAT(ids(index.search("gebr", 10, 0)), ElementsAre(2));
+    EXPECT_THAT(index.search("xyz", 10, 0), IsEmpty());
+}
@@ -0,0 +1,75 @@
+#include <string>
+#include <thread>
+#include <optional>
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <flashback/typeahead_session.hpp>
+
+using testing::Eq;
+using testing::IsTrue;
+using testing::IsFalse;
+
+using session_type = flashback::typeahead_session<std::string>;
+
+TEST(typeahead_session, serve_latest_query)
+{
+    session_type session{};
+    session.submit("l");
+    session.submit("li");
+    session.submit("lin");
+
+    std::optional<session_type::ticket> const ticket{session.take()};
+    ASSERT_THAT(ticket.has_value(), IsTrue());
+    EXPECT_THAT(ticket->query, Eq("lin")) << "Queries superseded before being taken should never be looked up";
+    EXPECT_THAT(session.is_current(*ticket), IsTrue());
+}
+
+TEST(typeahead_session, outdate_running_lookup)
+{
+    session_type session{};
+    session.submit("lin");
+
+    std::optional<session_type::ticket> const running{session.take()};
+    ASSERT_THAT(running.has_value(), IsTrue());
+    EXPECT_THAT(running->stop.stop_requested(), IsFalse());
+    session.submit("linu");
+    EXPECT_THAT(session.is_current(*running), IsFalse()) << "Results of a lookup should be dropped once a newer prefix arrives";
+    EXPECT_THAT(running->stop.stop_requested(), IsTrue()) << "A running lookup should be asked to stop once a newer prefix arrives";
+
+    std::optional<session_type::ticket> const latest{session.take()};
+    ASSERT_THAT(latest.has_value(), IsTrue());
+    EXPECT_THAT(latest->query, Eq("linu"));
+    EXPECT_THAT(session.is_current(*latest), IsTrue());
+    EXPECT_THAT(latest->stop.stop_requested(), IsFalse());
+}
+
+TEST(typeahead_session, drain_before_closing)
+{
+    session_type session{};
+    session.submit("linux");
+    session.close();
+
+    std::optional<session_type::ticket> const last{session.take()};
+    ASSERT_THAT(last.has_value(), IsTrue()) << "Query sent right before half-close should still be answered";
+    EXPECT_THAT(last->query, Eq("linux"));
+    EXPECT_THAT(last->stop.stop_requested(), IsFalse()) << "Closing the session should not stop the last lookup";
+    EXPECT_THAT(session.take().has_value(), IsFalse());
+}
+
+TEST(typeahead_session, wake_waiting_worker)
+{
+    session_type session{};
+    std::optional<session_type::ticket> taken{};
+
+    std::jthread worker{[&session, &taken] { taken = session.take(); }};
+    session.submit("kernel");
+    worker.join();
+
+    ASSERT_THAT(taken.has_value(), IsTrue());
+    EXPECT_THAT(taken->query, Eq("kernel"));
+
+    std::jthread closing{[&session, &taken] { taken = session.take(); }};
+    session.close();
+    closing.join();
+    EXPECT_THAT(taken.has_value(), IsFalse());
+}
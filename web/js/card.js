@@ -1891,7 +1891,8 @@ async function loadPreviousTopic() {
             practiceState.roadmapId,
             practiceState.subjectId,
             prevTopic.level,
-            prevTopic.position
+            prevTopic.position,
+            true
         );
 
         if (cards.length === 0) {
@@ -1977,7 +1978,8 @@ async function loadNextTopic() {
             practiceState.roadmapId,
             practiceState.subjectId,
             nextTopic.level,
-            nextTopic.position
+            nextTopic.position,
+            true
         );
 
         if (cards.length === 0) {
@@ -2007,6 +2009,21 @@ async function loadNextTopic() {
     }
 }
 
+// Blocks delivered along with practice cards are used once, later reloads fetch them again to reflect edits
+function takePracticeBlocks(cardId) {
+    const practiceState = JSON.parse(sessionStorage.getItem('practiceState') || '{}');
+    const card = (practiceState.currentCards || []).find(card => String(card.id) === String(cardId));
+
+    if (!card || !card.blocks) {
+        return null;
+    }
+
+    const blocks = card.blocks;
+    delete card.blocks;
+    sessionStorage.setItem('practiceState', JSON.stringify(practiceState));
+    return blocks;
+}
+
 async function loadBlocks() {
     UI.toggleElement('loading', true);
     UI.toggleElement('card-content', false);
@@ -2014,7 +2031,7 @@ async function loadBlocks() {
 
     try {
         const cardId = UI.getUrlParam('cardId');
-        const blocks = await client.getBlocks(cardId);
+        const blocks = takePracticeBlocks(cardId) || await client.getBlocks(cardId);
 
         // Store blocks globally for editing
         currentBlocks = blocks;
@@ -560,6 +560,55 @@ class FlashbackClient {
         });
     }
 
+    // studied resources and nerves are listed the same way on the home page
+    toResourceEntry(resource, milestone) {
+        return {
+            id: resource && resource.getId(),
+            name: resource && resource.getName(),
+            type: resource && resource.getType(),
+            pattern: resource && resource.getPattern(),
+            link: resource && resource.getLink(),
+            providers: resource ? resource.getProvidersList().map(p => ({
+                id: p.getId(),
+                name: p.getName()
+            })) : [],
+            presenters: resource ? resource.getPresentersList().map(presenter => ({
+                id: presenter.getId(),
+                name: presenter.getName()
+            })) : [],
+            milestone: milestone ? {
+                id: milestone.getId(),
+                name: milestone.getName(),
+                level: milestone.getLevel()
+            } : null
+        };
+    }
+
+    // everything the home page shows in a single call, authenticated once
+    async getHomeBundle() {
+        return new Promise((resolve, reject) => {
+            const request = new proto.flashback.GetHomeBundleRequest();
+            const user = this.getAuthenticatedUser();
+            request.setUser(user);
+
+            this.client.getHomeBundle(request, this.getMetadata(), (err, response) => {
+                if (err) {
+                    console.error("GetHomeBundle error:", err);
+                    reject(this.handleError(err));
+                } else {
+                    resolve({
+                        roadmaps: response.getRoadmapList().map(roadmap => ({
+                            id: roadmap.getId(),
+                            name: roadmap.getName()
+                        })),
+                        studyResources: response.getStudyList().map(study => this.toResourceEntry(study.getResource(), study.getMilestone())),
+                        nerves: response.getNerveList().map(nerve => this.toResourceEntry(nerve.getResource(), nerve.getMilestone()))
+                    });
+                }
+            });
+        });
+    }
+
     async getStudyResources() {
         return new Promise((resolve, reject) => {
             const request = new proto.flashback.GetStudyResourcesRequest();
@@ -571,31 +620,7 @@ class FlashbackClient {
                     console.error("GetStudyResources error:", err);
                     reject(this.handleError(err));
                 } else {
-                    resolve(response.getStudyList().map(study => {
-                        const resource = study.getResource();
-                        const milestone = study.getMilestone();
-
-                        return {
-                            id: resource && resource.getId(),
-                            name: resource && resource.getName(),
-                            type: resource && resource.getType(),
-                            pattern: resource && resource.getPattern(),
-                            link: resource && resource.getLink(),
-                            providers: resource ? resource.getProvidersList().map(p => ({
-                                id: p.getId(),
-                                name: p.getName()
-                            })) : [],
-                            presenters: resource ? resource.getPresentersList().map(presenter => ({
-                                id: presenter.getId(),
-                                name: presenter.getName()
-                            })) : [],
-                            milestone: milestone ? {
-                                id: milestone.getId(),
-                                name: milestone.getName(),
-                                level: milestone.getLevel()
-                            } : null
-                        };
-                    }));
+                    resolve(response.getStudyList().map(study => this.toResourceEntry(study.getResource(), study.getMilestone())));
                 }
             });
         });
@@ -823,11 +848,13 @@ class FlashbackClient {
         });
     }
 
-    async getPracticeCards(roadmapId, subjectId, topicLevel, topicPosition) {
+    // blocks of every card can be collected in the same call so that practice needs no further round trips
+    async getPracticeCards(roadmapId, subjectId, topicLevel, topicPosition, includeBlocks = false) {
         return new Promise((resolve, reject) => {
             const request = new proto.flashback.GetPracticeCardsRequest();
             const user = this.getAuthenticatedUser();
             request.setUser(user);
+            request.setIncludeBlocks(includeBlocks);
             const roadmap = new proto.flashback.Roadmap();
             roadmap.setId(roadmapId);
             request.setRoadmap(roadmap);
@@ -847,7 +874,16 @@ class FlashbackClient {
                     resolve(response.getCardList().map(card => ({
                         id: card.getId(),
                         headline: card.getHeadline(),
-                        state: card.getState()
+                        state: card.getState(),
+                        ...(includeBlocks && {
+                            blocks: card.getBlocksList().map(block => ({
+                                position: block.getPosition(),
+                                type: block.getType(),
+                                extension: block.getExtension$(),
+                                content: block.getContent(),
+                                metadata: block.getMetadata()
+                            }))
+                        })
                     })));
                 }
             });
@@ -993,31 +1029,7 @@ class FlashbackClient {
                     console.error("GetNerves error:", err);
                     reject(this.handleError(err));
                 } else {
-                    resolve(response.getNerveList().map(nerve => {
-                        const resource = nerve.getResource();
-                        const milestone = nerve.getMilestone();
-
-                        return {
-                            id: resource && resource.getId(),
-                            name: resource && resource.getName(),
-                            type: resource && resource.getType(),
-                            pattern: resource && resource.getPattern(),
-                            link: resource && resource.getLink(),
-                            providers: resource ? resource.getProvidersList().map(p => ({
-                                id: p.getId(),
-                                name: p.getName()
-                            })) : [],
-                            presenters: resource ? resource.getPresentersList().map(presenter => ({
-                                id: presenter.getId(),
-                                name: presenter.getName()
-                            })) : [],
-                            milestone: milestone ? {
-                                id: milestone.getId(),
-                                name: milestone.getName(),
-                                level: milestone.getLevel()
-                            } : null
-                        };
-                    }));
+                    resolve(response.getNerveList().map(nerve => this.toResourceEntry(nerve.getResource(), nerve.getMilestone())));
                 }
             });
         });
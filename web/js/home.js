@@ -275,9 +275,7 @@ window.addEventListener('DOMContentLoaded', () => {
         });
     }
     
-    loadRoadmaps();
-    loadStudyingResources();
-    loadNerves();
+    loadHome();
     
     // Search event listeners
     const studyingSearchInput = document.getElementById('studying-search-input');
@@ -312,13 +310,28 @@ window.addEventListener('DOMContentLoaded', () => {
     }
 });
 
-async function loadRoadmaps() {
+// Falls back to the separate listings when the bundle cannot be fetched
+async function loadHome() {
+    try {
+        const bundle = await client.getHomeBundle();
+        loadRoadmaps(bundle.roadmaps);
+        loadStudyingResources(bundle.studyResources);
+        loadNerves(bundle.nerves);
+    } catch (err) {
+        console.error('Load home bundle failed:', err);
+        loadRoadmaps();
+        loadStudyingResources();
+        loadNerves();
+    }
+}
+
+async function loadRoadmaps(prefetched) {
     UI.toggleElement('loading', true);
     UI.toggleElement('roadmaps-container', false);
     UI.toggleElement('empty-state', false);
 
     try {
-        const roadmaps = await client.getRoadmaps();
+        const roadmaps = prefetched || await client.getRoadmaps();
 
         UI.toggleElement('loading', false);
 
@@ -335,7 +348,7 @@ async function loadRoadmaps() {
     }
 }
 
-async function loadStudyingResources() {
+async function loadStudyingResources(prefetched) {
     UI.toggleElement('studying-loading', true);
     UI.toggleElement('studying-resources', false);
     UI.toggleElement('studying-empty-state', false);
@@ -343,7 +356,7 @@ async function loadStudyingResources() {
     UI.toggleElement('studying-search-container', false);
 
     try {
-        currentStudyResources = await client.getStudyResources();
+        currentStudyResources = prefetched || await client.getStudyResources();
 
         UI.toggleElement('studying-loading', false);
 
@@ -466,7 +479,7 @@ function renderStudyingResources(resources) {
     });
 }
 
-async function loadNerves() {
+async function loadNerves(prefetched) {
     UI.toggleElement('nerves-loading', true);
     UI.toggleElement('nerves-resources', false);
     UI.toggleElement('nerves-empty-state', false);
@@ -474,7 +487,7 @@ async function loadNerves() {
     UI.toggleElement('nerves-search-container', false);
 
     try {
-        currentNerves = await client.getNerves();
+        currentNerves = prefetched || await client.getNerves();
 
         UI.toggleElement('nerves-loading', false);
 
@@ -1600,7 +1600,8 @@ async function startPracticeMode() {
                 parseInt(roadmapId),
                 parseInt(subjectId),
                 topic.level,
-                topic.position
+                topic.position,
+                true
             );
 
             if (topicCards.length > 0) {